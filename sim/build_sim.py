@@ -0,0 +1,5 @@
+# PlatformIO extra script for [env:native]: compiles the host stand-ins in
+# sim/src next to the firmware sources in src/.
+Import("env")
+
+env.BuildSources("$BUILD_DIR/sim", "$PROJECT_DIR/sim/src")
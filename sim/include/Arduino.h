@@ -0,0 +1,199 @@
+#pragma once
+// Host stand-in for the parts of the ESP32 Arduino core the firmware uses.
+// Implementations live in sim/src; time is virtual (see SimKernel.h).
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <string>
+#include "SimKernel.h"
+
+#define IRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+#define PROGMEM
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+typedef uint8_t byte;
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+// newlib has it, older glibc does not
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) { size_t n = len < size - 1 ? len : size - 1; memcpy(dst, src, n); dst[n] = 0; }
+  return len;
+}
+#endif
+using std::min;
+using std::max;
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ------------------------------------------
+//  FreeRTOS subset (1 ms tick)
+// ------------------------------------------
+typedef void *TaskHandle_t;
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef void (*TaskFunction_t)(void *);
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portMAX_DELAY 0xFFFFFFFFUL
+
+// Tasks never interleave in the simulation, so critical sections are no-ops
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) (void)(mux)
+#define portEXIT_CRITICAL(mux) (void)(mux)
+#define portENTER_CRITICAL_ISR(mux) (void)(mux)
+#define portEXIT_CRITICAL_ISR(mux) (void)(mux)
+#define portENTER_CRITICAL_SAFE(mux) (void)(mux)
+#define portEXIT_CRITICAL_SAFE(mux) (void)(mux)
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *param,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *param,
+                       UBaseType_t priority, TaskHandle_t *handle);
+TickType_t xTaskGetTickCount();
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *previousWake, TickType_t increment);
+void vTaskDelete(TaskHandle_t task);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+
+// Mutexes: a task that finds one taken sleeps in 1 ms steps of virtual time
+typedef void *SemaphoreHandle_t;
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex);
+
+// ------------------------------------------
+//  String (std::string backed)
+// ------------------------------------------
+class String {
+  public:
+    String() {}
+    String(const char *c) { if (c) _s = c; }
+    String(const std::string &s) : _s(s) {}
+    String(char c) : _s(1, c) {}
+    String(int v) : _s(std::to_string(v)) {}
+    String(unsigned v) : _s(std::to_string(v)) {}
+    String(long v) : _s(std::to_string(v)) {}
+    String(unsigned long v) : _s(std::to_string(v)) {}
+    String(long long v) : _s(std::to_string(v)) {}
+    String(unsigned long long v) : _s(std::to_string(v)) {}
+    String(float v, unsigned decimals = 2) { fmt(v, decimals); }
+    String(double v, unsigned decimals = 2) { fmt(v, decimals); }
+
+    String &operator=(const char *c) { _s = c ? c : ""; return *this; }
+
+    const char *c_str() const { return _s.c_str(); }
+    unsigned length() const { return _s.size(); }
+    bool isEmpty() const { return _s.empty(); }
+    void reserve(unsigned n) { _s.reserve(n); }
+    char charAt(unsigned i) const { return i < _s.size() ? _s[i] : 0; }
+    char operator[](unsigned i) const { return charAt(i); }
+    long toInt() const { return atol(_s.c_str()); }
+    float toFloat() const { return atof(_s.c_str()); }
+
+    bool concat(const char *c) { if (c) _s += c; return true; }
+    bool concat(const char *c, unsigned n) { if (c) _s.append(c, n); return true; }
+    bool concat(const String &o) { _s += o._s; return true; }
+    bool concat(char c) { _s += c; return true; }
+    String &operator+=(const String &o) { _s += o._s; return *this; }
+    String &operator+=(const char *c) { concat(c); return *this; }
+    String &operator+=(char c) { _s += c; return *this; }
+    friend String operator+(const String &a, const String &b) { return String(a._s + b._s); }
+    friend String operator+(const String &a, const char *b) { return String(a._s + (b ? b : "")); }
+    friend String operator+(const char *a, const String &b) { return String(std::string(a ? a : "") + b._s); }
+
+    bool operator==(const String &o) const { return _s == o._s; }
+    bool operator==(const char *c) const { return _s == (c ? c : ""); }
+    bool operator!=(const String &o) const { return _s != o._s; }
+    bool operator!=(const char *c) const { return !(*this == c); }
+    bool operator<(const String &o) const { return _s < o._s; }
+    bool equals(const String &o) const { return _s == o._s; }
+    bool equalsIgnoreCase(const String &o) const {
+      return _s.size() == o._s.size() && std::equal(_s.begin(), _s.end(), o._s.begin(), [](char x, char y) { return tolower(x) == tolower(y); });
+    }
+
+    int indexOf(char c, unsigned from = 0) const { size_t p = _s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+    int indexOf(const String &o, unsigned from = 0) const { size_t p = _s.find(o._s, from); return p == std::string::npos ? -1 : (int)p; }
+    bool startsWith(const String &p) const { return _s.compare(0, p._s.size(), p._s) == 0; }
+    bool endsWith(const String &p) const { return _s.size() >= p._s.size() && _s.compare(_s.size() - p._s.size(), p._s.size(), p._s) == 0; }
+    String substring(unsigned from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const { return from < _s.size() && to > from ? String(_s.substr(from, to - from)) : String(); }
+    void remove(unsigned index) { if (index < _s.size()) _s.erase(index); }
+    void remove(unsigned index, unsigned count) { if (index < _s.size()) _s.erase(index, count); }
+    void trim() {
+      size_t a = _s.find_first_not_of(" \t\r\n"), b = _s.find_last_not_of(" \t\r\n");
+      _s = (a == std::string::npos) ? std::string() : _s.substr(a, b - a + 1);
+    }
+    void toLowerCase() { for (char &c : _s) c = tolower(c); }
+    void toUpperCase() { for (char &c : _s) c = toupper(c); }
+
+  private:
+    void fmt(double v, unsigned decimals) { char b[48]; snprintf(b, sizeof(b), "%.*f", (int)decimals, v); _s = b; }
+    std::string _s;
+};
+
+// ------------------------------------------
+//  Core API
+// ------------------------------------------
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+
+double ledcSetup(uint8_t channel, double freq, uint8_t resolutionBits);
+void ledcAttachPin(uint8_t pin, uint8_t channel);
+void ledcWrite(uint8_t channel, uint32_t duty);
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+long random(long max);
+long random(long min, long max);
+
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+void configTzTime(const char *tz, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr);
+
+class HardwareSerial {
+  public:
+    void begin(unsigned long baud);
+    size_t print(const String &s);
+    size_t print(const char *s);
+    size_t print(long v);
+    size_t println(const String &s);
+    size_t println(const char *s);
+    size_t println(long v);
+    size_t println();
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+  public:
+    void restart();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getCpuFreqMHz();
+    uint32_t getCycleCount();
+};
+extern EspClass ESP;
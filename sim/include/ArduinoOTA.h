@@ -0,0 +1,10 @@
+#pragma once
+#include <Arduino.h>
+
+class ArduinoOTAClass {
+  public:
+    void setHostname(const char *name) { (void)name; }
+    void begin() {}
+    void handle() {}
+};
+extern ArduinoOTAClass ArduinoOTA;
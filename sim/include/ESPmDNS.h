@@ -0,0 +1,9 @@
+#pragma once
+#include <Arduino.h>
+
+class MDNSResponder {
+  public:
+    bool begin(const char *hostName) { (void)hostName; return true; }
+    void addService(const char *service, const char *proto, uint16_t port) { (void)service; (void)proto; (void)port; }
+};
+extern MDNSResponder MDNS;
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+
+// NVS namespaces kept in memory for the lifetime of the run (see sim::nvsSet)
+class Preferences {
+  public:
+    bool begin(const char *name, bool readOnly = false);
+    void end();
+    bool clear();
+    bool remove(const char *key);
+    bool isKey(const char *key);
+
+    size_t putBool(const char *key, bool value) { return putInt(key, value); }
+    size_t putInt(const char *key, int32_t value);
+    size_t putUInt(const char *key, uint32_t value) { return putInt(key, (int32_t)value); }
+    size_t putLong(const char *key, int32_t value) { return putInt(key, value); }
+    size_t putString(const char *key, const String &value);
+    size_t putBytes(const char *key, const void *value, size_t len);
+
+    bool getBool(const char *key, bool defaultValue = false) { return getInt(key, defaultValue) != 0; }
+    int32_t getInt(const char *key, int32_t defaultValue = 0);
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0) { return (uint32_t)getInt(key, (int32_t)defaultValue); }
+    int32_t getLong(const char *key, int32_t defaultValue = 0) { return getInt(key, defaultValue); }
+    String getString(const char *key, const String &defaultValue = String());
+    size_t getBytesLength(const char *key);
+    size_t getBytes(const char *key, void *buf, size_t maxLen);
+
+  private:
+    std::string _ns;
+    bool _open = false;
+    bool _readOnly = false;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <stdint.h>
+#include <functional>
+
+// ==========================================
+//      VIRTUAL TIME + COOPERATIVE TASKS
+// ==========================================
+// The native build runs every FreeRTOS task of the firmware as a coroutine on
+// one host thread. Time only moves when all tasks are blocked: the kernel
+// jumps straight to the next wake-up, timer alarm or harness hook, so an idle
+// clock costs next to nothing and days pass in seconds. Timer ISRs and hooks
+// run between tasks, never inside one, so the firmware's critical sections
+// are trivially satisfied.
+
+namespace sim {
+
+uint64_t nowUs();
+
+// Blocking (task context only)
+void sleepUntil(uint64_t us);
+void sleepFor(uint64_t us);
+bool inTask();
+const char *currentTaskName();
+
+void *createTask(void (*fn)(void *), const char *name, void *param, int priority);
+void *currentTask();
+
+// Task notifications: a give wakes a task blocked in take at once
+uint32_t notifyTake(bool clear, uint64_t timeoutUs);
+void notifyGive(void *task);
+
+// Harness hooks, run between tasks at their due time
+void at(uint64_t us, std::function<void()> fn);
+void every(uint64_t periodUs, std::function<void()> fn);
+
+// Source of timed events outside the task list (hardware timers)
+struct EventSource {
+  virtual uint64_t nextEventUs() const = 0;  // UINT64_MAX if none
+  virtual void fire(uint64_t us) = 0;
+};
+void addEventSource(EventSource *src);
+
+// Paced: virtual time keeps step with the host clock, for serving real
+// clients (--serve). Off by default: time jumps between events.
+void setRealTime(bool on);
+bool realTime();
+
+// Run until the given virtual time or until stop() is called
+void run(uint64_t untilUs);
+void stop(const char *reason);
+const char *stopReason();
+
+// Task watchdog (esp_task_wdt_*): worst gap between resets, per task
+struct WatchdogStats { const char *task; uint64_t worstGapUs; };
+int watchdogStats(WatchdogStats *out, int max);
+uint64_t watchdogTimeoutUs();
+
+}  // namespace sim
@@ -0,0 +1,110 @@
+#pragma once
+#include <stdint.h>
+#include <string>
+#include <map>
+#include <vector>
+#include <functional>
+
+// ==========================================
+//         SIMULATED CLOCK HARDWARE
+// ==========================================
+// The physical side of the clock: two spools driven by the coil patterns the
+// firmware writes to GPIO, a magnet on each spool, and the hall sensors the
+// I2S/ADC stand-in samples. The firmware's own idea of its position is never
+// consulted; everything here is derived from the pin writes.
+
+namespace sim {
+
+struct SpoolConfig {
+  const char *name;
+  int pins[4];            // IN1..IN4 as wired in main.cpp
+  int adcChannel;         // ADC1 channel of the spool's hall sensor
+  double stepsPerRev;     // Real gearing, need not be an integer
+  double magnetStep;      // Magnet position in steps from power-on position
+  double slipPpm;         // Steps that silently fail to move the spool
+  int baseline;           // Idle ADC level
+  int amplitude;          // Peak deviation right over the magnet
+  double width;           // Gaussian sigma in steps
+};
+
+struct Spool {
+  SpoolConfig cfg;
+  long position = 0;           // Physical steps (what the flaps show)
+  int lastPhase = -1;          // Last full coil pattern seen, -1 = never energized
+  bool energized = false;
+  uint64_t forwardSteps = 0, backwardSteps = 0;
+  uint64_t lostSteps = 0;      // Slipped or skipped (two phases at once)
+  uint64_t lastStepUs = 0;
+
+  // Position history so DMA samples can be taken "in the past"
+  static const int HISTORY = 256;
+  uint64_t histUs[HISTORY]; long histPos[HISTORY];
+  uint32_t histCount = 0;
+
+  long positionAt(uint64_t us) const;
+  double flap() const;            // 0..60, flap under the window (0 = magnet)
+  uint16_t field(long position);  // ADC reading without noise
+
+  long cachedFieldPos = 0x7FFFFFFF; uint16_t cachedField = 0;
+};
+
+const int SPOOLS = 2;  // 0 = hours, 1 = minutes
+Spool &spool(int i);
+void configureSpool(int i, const SpoolConfig &cfg);
+
+void gpioWrite(int bank, bool set, uint32_t mask);
+void setAdcNoise(int lsb);
+void setSeed(uint32_t seed);
+uint32_t random32();
+
+// NVS seeding before setup()
+void nvsSet(const char *ns, const char *key, int32_t value);
+void nvsSet(const char *ns, const char *key, const char *value);
+
+// HTTP: a request to the firmware's server over a local socket, sent from
+// the harness's own client task once the server listens
+struct HttpResult {
+  bool done = false;
+  int code = 0;       // 0: the connection failed
+  std::string contentType;
+  std::string body;
+  double hostUs = 0;  // Host time from sending to the whole response
+};
+void httpRequest(const char *method, const char *uri, const std::map<std::string, std::string> &args, HttpResult *result);
+// A JSON body, as a PATCH to /api/config
+void httpJson(const char *method, const char *uri, const std::string &json, HttpResult *result);
+// POST with a multipart file: body goes through the route's upload handler
+// in HTTP_UPLOAD_BUFLEN chunks, then the route's handler answers
+void httpUpload(const char *uri, const std::map<std::string, std::string> &args, const std::string &body, HttpResult *result);
+
+// Host port of the firmware's HTTP server (127.0.0.1), 0 until it listens.
+// serveOn() before setup() asks for a fixed one instead of any free port.
+int httpPort();
+void serveOn(int port);
+
+// Contents of the app partition the firmware runs from (esp_partition_read);
+// the rest of the slot reads as erased flash
+void setRunningImage(const std::string &image);
+
+// Counters the stand-ins keep for the report
+struct ServiceStats {
+  uint32_t restarts = 0;
+  uint32_t httpServed = 0;
+  uint32_t sntpSyncs = 0;
+  uint64_t adcSamples = 0;
+  uint64_t adcOverruns = 0;  // DMA buffers dropped because the reader fell behind
+  uint32_t lateAlarms = 0;   // Timer alarms programmed in the past
+  uint32_t bootSwitches = 0; // esp_ota_set_boot_partition() calls (rollbacks)
+};
+ServiceStats &stats();
+
+// LED PWM: called whenever a channel's duty actually changes
+void onLedcChange(std::function<void(int channel, uint32_t duty)> fn);
+
+void setSerialEcho(bool on);
+void setSntpDelayMs(uint32_t ms);
+void setEpoch(int64_t epoch);  // Wall-clock time at boot, applied on SNTP sync
+bool timeSynced();
+int64_t wallClock();           // Current epoch seconds (valid once synced)
+
+}  // namespace sim
@@ -0,0 +1,33 @@
+#pragma once
+#include <Arduino.h>
+#include <string>
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+
+// Keeps the image for the harness to check; the sim never reboots into it
+class UpdateClass {
+  public:
+    bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = 0) { (void)command; _size = size; _written = 0; _running = true; _error = 0; _image.clear(); _installed = false; return true; }
+    size_t write(uint8_t *data, size_t len) { _image.append((const char *)data, len); _written += len; return len; }
+    bool end(bool evenIfRemaining = false) {
+      _running = false;
+      _installed = evenIfRemaining || _size == UPDATE_SIZE_UNKNOWN || _written == _size;
+      return _installed;
+    }
+    void abort() { _running = false; _error = 1; _installed = false; }
+    bool hasError() { return _error != 0; }
+    uint8_t getError() { return _error; }
+    const char *errorString() { return _error ? "Aborted" : "No Error"; }
+    bool isRunning() { return _running; }
+    size_t progress() { return _written; }
+    // Sim only: the last image written, and whether end() made it the boot image
+    const std::string &image() const { return _image; }
+    bool installed() const { return _installed; }
+  private:
+    std::string _image;
+    bool _installed = false;
+    size_t _size = 0, _written = 0;
+    bool _running = false;
+    uint8_t _error = 0;
+};
+extern UpdateClass Update;
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+
+// Station that is always associated; RSSI wanders slowly with virtual time
+class IPAddress {
+  public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : _b{a, b, c, d} {}
+    uint8_t operator[](int i) const { return _b[i]; }
+    String toString() const;
+  private:
+    uint8_t _b[4];
+};
+
+#define WIFI_STA 1
+#define WIFI_AP 2
+#define WL_CONNECTED 3
+#define WL_DISCONNECTED 6
+
+class WiFiClass {
+  public:
+    IPAddress localIP();
+    String SSID();
+    int8_t RSSI();
+    int status();
+    bool isConnected() { return status() == WL_CONNECTED; }
+    bool mode(int m) { (void)m; return true; }
+    int begin();  // Saved credentials; associates a little later
+    bool setSleep(bool on) { (void)on; return true; }
+    bool setAutoReconnect(bool on) { (void)on; return true; }
+    bool disconnect(bool wifiOff = false) { (void)wifiOff; return true; }
+};
+extern WiFiClass WiFi;
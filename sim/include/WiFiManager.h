@@ -0,0 +1,20 @@
+#pragma once
+#include <Arduino.h>
+#include <functional>
+
+// Credentials are always stored, so the portal never opens: autoConnect()
+// associates after a short delay, WiFi.begin() in the background
+class WiFiManager {
+  public:
+    void setAPCallback(std::function<void(WiFiManager *)> fn) { _apCallback = fn; }
+    bool autoConnect(const char *apName);
+    void resetSettings() {}
+    void setConfigPortalBlocking(bool blocking) { _blocking = blocking; }
+    void setConnectTimeout(int seconds) { (void)seconds; }
+    bool process() { return true; }
+    bool getWiFiIsSaved() { return true; }
+    bool startConfigPortal(const char *apName) { (void)apName; if (_apCallback) _apCallback(this); return false; }
+  private:
+    std::function<void(WiFiManager *)> _apCallback;
+    bool _blocking = true;
+};
@@ -0,0 +1,15 @@
+#pragma once
+#include <stdint.h>
+
+// LEDC fade engine on top of the Arduino ledc* stand-ins. A fade applies its
+// target duty at once: the ramp is not simulated, only when it starts.
+typedef int esp_err_t;
+typedef enum { LEDC_HIGH_SPEED_MODE, LEDC_LOW_SPEED_MODE, LEDC_SPEED_MODE_MAX } ledc_mode_t;
+typedef enum { LEDC_CHANNEL_0, LEDC_CHANNEL_1, LEDC_CHANNEL_2, LEDC_CHANNEL_3,
+               LEDC_CHANNEL_4, LEDC_CHANNEL_5, LEDC_CHANNEL_6, LEDC_CHANNEL_7, LEDC_CHANNEL_MAX } ledc_channel_t;
+typedef enum { LEDC_FADE_NO_WAIT, LEDC_FADE_WAIT_DONE } ledc_fade_mode_t;
+
+esp_err_t ledc_fade_func_install(int intrAllocFlags);
+esp_err_t ledc_set_duty_and_update(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty, uint32_t hpoint);
+esp_err_t ledc_set_fade_time_and_start(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty, uint32_t maxFadeMs,
+                                       ledc_fade_mode_t wait);
@@ -0,0 +1,16 @@
+#pragma once
+#include <esp_partition.h>
+
+// Two app slots; the sim always runs from app0 and has no rollback
+// bootloader, so images are never PENDING_VERIFY (the NVS trial applies)
+typedef enum {
+  ESP_OTA_IMG_NEW = 0x0, ESP_OTA_IMG_PENDING_VERIFY = 0x1, ESP_OTA_IMG_VALID = 0x2,
+  ESP_OTA_IMG_INVALID = 0x3, ESP_OTA_IMG_ABORTED = 0x4, ESP_OTA_IMG_UNDEFINED = 0xFFFFFFFF,
+} esp_ota_img_states_t;
+
+const esp_partition_t *esp_ota_get_running_partition();
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *start);
+esp_err_t esp_ota_get_state_partition(const esp_partition_t *partition, esp_ota_img_states_t *state);
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *partition);  // Counted in sim::stats()
+esp_err_t esp_ota_mark_app_valid_cancel_rollback();
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot();
@@ -0,0 +1,10 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// The sim records the worst gap between resets instead of panicking
+typedef int esp_err_t;
+esp_err_t esp_task_wdt_init(uint32_t timeoutSeconds, bool panic);
+esp_err_t esp_task_wdt_add(void *task);
+esp_err_t esp_task_wdt_delete(void *task);
+esp_err_t esp_task_wdt_reset();
@@ -0,0 +1,26 @@
+#pragma once
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <errno.h>
+
+// lwIP's socket calls on host sockets (sim/src/SimNet.cpp). Servers listen
+// on 127.0.0.1 at the port sim::httpPort() reports, whatever they asked for.
+// select() never blocks the host: the task sleeps in virtual time until a
+// simulated socket sends, connects or closes, or the timeout passes.
+int lwip_socket(int domain, int type, int protocol);
+int lwip_bind(int s, const struct sockaddr *name, socklen_t namelen);
+int lwip_listen(int s, int backlog);
+int lwip_accept(int s, struct sockaddr *addr, socklen_t *addrlen);
+int lwip_connect(int s, const struct sockaddr *name, socklen_t namelen);
+ssize_t lwip_recv(int s, void *mem, size_t len, int flags);
+ssize_t lwip_send(int s, const void *data, size_t size, int flags);
+int lwip_close(int s);
+int lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptset, struct timeval *timeout);
+int lwip_fcntl(int s, int cmd, int val);
+int lwip_setsockopt(int s, int level, int optname, const void *optval, socklen_t optlen);
@@ -0,0 +1,10 @@
+#pragma once
+#include <stdbool.h>
+
+// configTzTime() starts the (simulated) SNTP client; sync lands a while after
+// the station associated
+typedef enum { SNTP_SYNC_STATUS_RESET, SNTP_SYNC_STATUS_COMPLETED, SNTP_SYNC_STATUS_IN_PROGRESS } sntp_sync_status_t;
+typedef void (*sntp_sync_time_cb_t)(struct timeval *tv);
+bool sntp_enabled();
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
+sntp_sync_status_t sntp_get_sync_status();
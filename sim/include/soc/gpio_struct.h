@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+
+// Only the write-1-to-set/clear output registers are modelled. Every store is
+// forwarded to the simulated coils (sim::gpioWrite).
+struct SimGpioStrobe {
+  int bank; bool set;
+  void operator=(uint32_t mask);
+};
+struct SimGpioStrobeHi { SimGpioStrobe val; };
+
+struct gpio_dev_t {
+  SimGpioStrobe out_w1ts { 0, true };
+  SimGpioStrobe out_w1tc { 0, false };
+  SimGpioStrobeHi out1_w1ts { { 1, true } };
+  SimGpioStrobeHi out1_w1tc { { 1, false } };
+};
+extern gpio_dev_t GPIO;
@@ -0,0 +1,10 @@
+#pragma once
+#include <stdint.h>
+
+// SAR ADC controller: the I2S stand-in reads the pattern table back to decide
+// which channel each DMA word comes from
+typedef struct {
+  struct { uint32_t sar1_patt_len : 4; } saradc_ctrl;
+  uint32_t saradc_sar1_patt_tab[4];
+} syscon_dev_t;
+extern syscon_dev_t SYSCON;
@@ -0,0 +1,441 @@
+#include <Arduino.h>
+#include <driver/timer.h>
+#include <driver/i2s.h>
+#include <driver/adc.h>
+#include <driver/ledc.h>
+#include <esp_timer.h>
+#include <soc/gpio_struct.h>
+#include <soc/syscon_struct.h>
+#include "SimWorld.h"
+
+gpio_dev_t GPIO;
+syscon_dev_t SYSCON;
+
+namespace sim {
+
+static ServiceStats serviceStats;
+ServiceStats &stats() { return serviceStats; }
+
+static uint32_t rngState = 0x12345678;
+void setSeed(uint32_t seed) { rngState = seed ? seed : 1; }
+uint32_t random32() {
+  rngState ^= rngState << 13; rngState ^= rngState >> 17; rngState ^= rngState << 5;
+  return rngState;
+}
+
+// ==========================================
+//  Spools
+// ==========================================
+// Same FULL4WIRE sequence the firmware drives (bit0 = IN1)
+static const uint8_t COIL_PATTERN[4] = { 0b0101, 0b0110, 0b1010, 0b1001 };
+
+static Spool spools[SPOOLS];
+static uint64_t gpioOut = 0;
+static int adcNoise = 4;
+
+Spool &spool(int i) { return spools[i]; }
+void configureSpool(int i, const SpoolConfig &cfg) { spools[i] = Spool(); spools[i].cfg = cfg; }
+void setAdcNoise(int lsb) { adcNoise = lsb; }
+
+long Spool::positionAt(uint64_t us) const {
+  if (histCount == 0) return position;
+  uint32_t newest = (histCount - 1) % HISTORY;
+  if (us >= histUs[newest]) return position;
+  uint32_t depth = histCount < (uint32_t)HISTORY ? histCount : HISTORY;
+  for (uint32_t k = 1; k < depth; k++) {
+    uint32_t i = (histCount - 1 - k) % HISTORY;
+    if (histUs[i] <= us) return histPos[i];
+  }
+  // Older than the history: one step before the oldest recorded move
+  uint32_t oldest = (histCount - depth) % HISTORY;
+  return histPos[oldest];
+}
+
+double Spool::flap() const {
+  double f = fmod((position - cfg.magnetStep) / cfg.stepsPerRev * 60.0, 60.0);
+  return f < 0 ? f + 60.0 : f;
+}
+
+uint16_t Spool::field(long pos) {
+  if (pos == cachedFieldPos) return cachedField;
+  double d = fmod(pos - cfg.magnetStep, cfg.stepsPerRev);
+  if (d < -cfg.stepsPerRev / 2) d += cfg.stepsPerRev;
+  if (d >= cfg.stepsPerRev / 2) d -= cfg.stepsPerRev;
+  double v = cfg.baseline + cfg.amplitude * exp(-0.5 * (d / cfg.width) * (d / cfg.width));
+  cachedFieldPos = pos;
+  cachedField = (uint16_t)std::min(4095.0, std::max(0.0, v));
+  return cachedField;
+}
+
+static void updateSpool(Spool &s) {
+  uint8_t bits = 0;
+  for (int i = 0; i < 4; i++) if (gpioOut & (1ULL << s.cfg.pins[i])) bits |= (1 << i);
+  s.energized = bits != 0;
+  int phase = -1;
+  for (int p = 0; p < 4; p++) if (bits == COIL_PATTERN[p]) phase = p;
+  if (phase < 0) return;  // Coils off or mid-update (clear before set)
+  if (s.lastPhase < 0 || phase == s.lastPhase) { s.lastPhase = phase; return; }
+
+  int delta = (phase - s.lastPhase) & 3;
+  s.lastPhase = phase;
+  if (delta == 2) { s.lostSteps++; return; }  // Rotor can't tell which way to go
+  int dir = (delta == 1) ? 1 : -1;
+  if (s.cfg.slipPpm > 0 && random32() % 1000000 < s.cfg.slipPpm) { s.lostSteps++; return; }
+
+  s.position += dir;
+  if (dir > 0) s.forwardSteps++; else s.backwardSteps++;
+  uint64_t t = nowUs();
+  uint32_t slot = s.histCount % Spool::HISTORY;
+  s.histUs[slot] = t; s.histPos[slot] = s.position;
+  s.histCount++;
+  s.lastStepUs = t;
+}
+
+void gpioWrite(int bank, bool set, uint32_t mask) {
+  uint64_t m = (uint64_t)mask << (bank * 32);
+  if (set) gpioOut |= m; else gpioOut &= ~m;
+  for (int i = 0; i < SPOOLS; i++) updateSpool(spools[i]);
+}
+
+static int spoolForAdcChannel(int channel) {
+  for (int i = 0; i < SPOOLS; i++) if (spools[i].cfg.adcChannel == channel) return i;
+  return -1;
+}
+
+static uint16_t sampleAdc(int channel, uint64_t us) {
+  int i = spoolForAdcChannel(channel);
+  if (i < 0) return 0;
+  int v = spools[i].field(spools[i].positionAt(us));
+  if (adcNoise > 0) v += (int)(random32() % (2 * adcNoise + 1)) - adcNoise;
+  return (uint16_t)std::min(4095, std::max(0, v));
+}
+
+// ==========================================
+//  Hardware timers
+// ==========================================
+struct SimTimer {
+  bool initialized = false;
+  bool running = false;
+  bool alarmEnabled = false;
+  bool autoReload = false;
+  uint32_t divider = 80;
+  uint64_t baseUs = 0;      // Virtual time at which the counter held baseValue
+  uint64_t baseValue = 0;
+  uint64_t reloadValue = 0;
+  uint64_t alarmValue = 0;
+  timer_isr_t isr = nullptr;
+  void *arg = nullptr;
+
+  uint64_t counterAt(uint64_t us) const { return running ? baseValue + (us - baseUs) * 80 / divider : baseValue; }
+  uint64_t alarmUs() const {
+    if (!running || !alarmEnabled) return UINT64_MAX;
+    if (alarmValue <= baseValue) return baseUs;  // Already passed
+    uint64_t ticks = alarmValue - baseValue;
+    if (ticks > (UINT64_MAX / 2) / divider) return UINT64_MAX;  // Parked far in the future
+    return baseUs + ticks * divider / 80;
+  }
+  void rebase() { uint64_t t = nowUs(); baseValue = counterAt(t); baseUs = t; }
+};
+
+class TimerBank : public EventSource {
+  public:
+    SimTimer timers[TIMER_GROUP_MAX][TIMER_MAX];
+
+    uint64_t nextEventUs() const override {
+      uint64_t next = UINT64_MAX;
+      for (auto &g : timers) for (auto &t : g) { uint64_t a = t.alarmUs(); if (a < next) next = a; }
+      return next;
+    }
+
+    void fire(uint64_t us) override {
+      for (auto &g : timers) for (auto &t : g) {
+        if (t.alarmUs() > us) continue;
+        t.alarmEnabled = false;  // Hardware clears the enable on every alarm
+        if (t.autoReload) { t.baseUs = us; t.baseValue = t.reloadValue; }
+        else t.rebase();
+        if (t.isr) t.isr(t.arg);
+        return;  // One ISR per dispatch keeps the ordering exact
+      }
+    }
+};
+
+static TimerBank timerBank;
+static bool timerBankRegistered = false;
+
+static SimTimer &timerAt(timer_group_t group, timer_idx_t idx) { return timerBank.timers[group][idx]; }
+
+static void checkLate(SimTimer &t) {
+  if (t.running && t.alarmEnabled && t.alarmValue < t.counterAt(nowUs())) serviceStats.lateAlarms++;
+}
+
+}  // namespace sim
+
+using namespace sim;
+
+void SimGpioStrobe::operator=(uint32_t mask) { gpioWrite(bank, set, mask); }
+
+esp_err_t timer_init(timer_group_t group, timer_idx_t idx, const timer_config_t *config) {
+  if (!timerBankRegistered) { addEventSource(&timerBank); timerBankRegistered = true; }
+  SimTimer &t = timerAt(group, idx);
+  t = SimTimer();
+  t.initialized = true;
+  t.divider = config->divider ? config->divider : 1;
+  t.autoReload = config->auto_reload == TIMER_AUTORELOAD_EN;
+  t.alarmEnabled = config->alarm_en == TIMER_ALARM_EN;
+  t.running = config->counter_en == TIMER_START;
+  t.baseUs = nowUs();
+  return 0;
+}
+
+esp_err_t timer_set_counter_value(timer_group_t group, timer_idx_t idx, uint64_t value) {
+  SimTimer &t = timerAt(group, idx);
+  t.baseUs = nowUs(); t.baseValue = value; t.reloadValue = value;
+  return 0;
+}
+
+esp_err_t timer_get_counter_value(timer_group_t group, timer_idx_t idx, uint64_t *value) {
+  *value = timerAt(group, idx).counterAt(nowUs());
+  return 0;
+}
+
+esp_err_t timer_set_alarm_value(timer_group_t group, timer_idx_t idx, uint64_t value) {
+  SimTimer &t = timerAt(group, idx);
+  t.rebase(); t.alarmValue = value; checkLate(t);
+  return 0;
+}
+
+esp_err_t timer_set_alarm(timer_group_t group, timer_idx_t idx, timer_alarm_t enable) {
+  SimTimer &t = timerAt(group, idx);
+  t.rebase(); t.alarmEnabled = enable == TIMER_ALARM_EN; checkLate(t);
+  return 0;
+}
+
+esp_err_t timer_start(timer_group_t group, timer_idx_t idx) {
+  SimTimer &t = timerAt(group, idx);
+  if (!t.running) { t.baseUs = nowUs(); t.running = true; }
+  return 0;
+}
+
+esp_err_t timer_pause(timer_group_t group, timer_idx_t idx) {
+  SimTimer &t = timerAt(group, idx);
+  t.rebase(); t.running = false;
+  return 0;
+}
+
+esp_err_t timer_isr_callback_add(timer_group_t group, timer_idx_t idx, timer_isr_t isr, void *arg, int flags) {
+  (void)flags;
+  SimTimer &t = timerAt(group, idx);
+  t.isr = isr; t.arg = arg;
+  return 0;
+}
+
+void timer_group_set_alarm_value_in_isr(timer_group_t group, timer_idx_t idx, uint64_t value) {
+  SimTimer &t = timerAt(group, idx);
+  t.alarmValue = value;
+}
+
+void timer_group_enable_alarm_in_isr(timer_group_t group, timer_idx_t idx) {
+  SimTimer &t = timerAt(group, idx);
+  t.alarmEnabled = true; checkLate(t);
+}
+
+uint64_t timer_group_get_counter_value_in_isr(timer_group_t group, timer_idx_t idx) {
+  return timerAt(group, idx).counterAt(nowUs());
+}
+
+// ==========================================
+//  I2S built-in ADC
+// ==========================================
+namespace sim {
+struct SimI2sAdc {
+  bool installed = false, enabled = false;
+  uint32_t sampleRate = 0;
+  int bufLen = 0, bufCount = 0;
+  uint64_t startUs = 0;
+  uint64_t consumed = 0;  // Samples handed to i2s_read so far
+
+  uint64_t sampleTimeUs(uint64_t index) const { return startUs + index * 1000000ULL / sampleRate; }
+  uint64_t samplesTakenBy(uint64_t us) const { return us < startUs ? 0 : (us - startUs) * sampleRate / 1000000ULL + 1; }
+};
+static SimI2sAdc i2sAdc;
+}
+
+esp_err_t i2s_driver_install(i2s_port_t port, const i2s_config_t *config, int queueSize, void *queue) {
+  (void)port; (void)queueSize; (void)queue;
+  i2sAdc = SimI2sAdc();
+  i2sAdc.installed = true;
+  i2sAdc.sampleRate = config->sample_rate;
+  i2sAdc.bufLen = config->dma_buf_len;
+  i2sAdc.bufCount = config->dma_buf_count;
+  return 0;
+}
+
+esp_err_t i2s_driver_uninstall(i2s_port_t port) { (void)port; i2sAdc = SimI2sAdc(); return 0; }
+
+esp_err_t i2s_set_adc_mode(adc_unit_t unit, adc1_channel_t channel) {
+  (void)unit;
+  SYSCON.saradc_ctrl.sar1_patt_len = 0;
+  SYSCON.saradc_sar1_patt_tab[0] = (uint32_t)(((channel & 0xF) << 4) | 0x0F) << 24;
+  return 0;
+}
+
+esp_err_t i2s_adc_enable(i2s_port_t port) {
+  (void)port;
+  i2sAdc.enabled = true; i2sAdc.startUs = nowUs(); i2sAdc.consumed = 0;
+  return 0;
+}
+
+esp_err_t i2s_adc_disable(i2s_port_t port) { (void)port; i2sAdc.enabled = false; return 0; }
+
+esp_err_t i2s_read(i2s_port_t port, void *dest, size_t size, size_t *bytesRead, uint32_t ticksToWait) {
+  (void)port; (void)ticksToWait;
+  SimI2sAdc &a = i2sAdc;
+  size_t want = size / sizeof(uint16_t);
+  *bytesRead = 0;
+  if (!a.enabled || want == 0) return -1;
+
+  // DMA completes whole buffers; the ring holds bufCount of them
+  uint64_t completed = (a.samplesTakenBy(nowUs()) / a.bufLen) * a.bufLen;
+  uint64_t ring = (uint64_t)a.bufLen * a.bufCount;
+  if (completed > a.consumed + ring) {
+    serviceStats.adcOverruns += (completed - ring - a.consumed) / a.bufLen;
+    a.consumed = completed - ring;
+  }
+  uint64_t needed = a.consumed + want;
+  uint64_t neededBuffers = (needed + a.bufLen - 1) / a.bufLen * a.bufLen;
+  if (completed < neededBuffers) sleepUntil(a.sampleTimeUs(neededBuffers - 1));
+
+  int pattLen = SYSCON.saradc_ctrl.sar1_patt_len + 1;
+  int channels[16];
+  for (int i = 0; i < pattLen; i++) {
+    uint32_t entry = (SYSCON.saradc_sar1_patt_tab[i / 4] >> (24 - 8 * (i % 4))) & 0xFF;
+    channels[i] = entry >> 4;
+  }
+  uint16_t *out = static_cast<uint16_t *>(dest);
+  for (size_t i = 0; i < want; i++) {
+    uint64_t index = a.consumed + i;
+    int ch = channels[index % pattLen];
+    out[i] = (uint16_t)((ch << 12) | sampleAdc(ch, a.sampleTimeUs(index)));
+  }
+  a.consumed += want;
+  serviceStats.adcSamples += want;
+  *bytesRead = want * sizeof(uint16_t);
+  return 0;
+}
+
+esp_err_t adc1_config_width(adc_bits_width_t width) { (void)width; return 0; }
+esp_err_t adc1_config_channel_atten(adc1_channel_t channel, adc_atten_t atten) { (void)channel; (void)atten; return 0; }
+int adc1_get_raw(adc1_channel_t channel) { return sampleAdc(channel, nowUs()); }
+
+// ==========================================
+//  Pins, ADC, LEDC
+// ==========================================
+static int adcChannelForPin(int pin) {
+  switch (pin) {
+    case 36: return 0; case 37: return 1; case 38: return 2; case 39: return 3;
+    case 32: return 4; case 33: return 5; case 34: return 6; case 35: return 7;
+    default: return -1;
+  }
+}
+
+void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  gpioWrite(pin / 32, value != LOW, 1UL << (pin % 32));
+}
+
+int digitalRead(uint8_t pin) { return (gpioOut >> pin) & 1; }
+
+uint16_t analogRead(uint8_t pin) {
+  int ch = adcChannelForPin(pin);
+  return ch < 0 ? 0 : sampleAdc(ch, nowUs());
+}
+
+namespace sim {
+static std::function<void(int, uint32_t)> ledcListener;
+void onLedcChange(std::function<void(int, uint32_t)> fn) { ledcListener = fn; }
+}
+
+static uint32_t ledcDuty[16];
+double ledcSetup(uint8_t channel, double freq, uint8_t resolutionBits) { (void)channel; (void)resolutionBits; return freq; }
+void ledcAttachPin(uint8_t pin, uint8_t channel) { (void)pin; (void)channel; }
+void ledcWrite(uint8_t channel, uint32_t duty) {
+  if (channel >= 16 || ledcDuty[channel] == duty) return;
+  ledcDuty[channel] = duty;
+  if (ledcListener) ledcListener(channel, duty);
+}
+
+esp_err_t ledc_fade_func_install(int intrAllocFlags) { (void)intrAllocFlags; return 0; }
+
+esp_err_t ledc_set_duty_and_update(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty, uint32_t hpoint) {
+  (void)hpoint;
+  ledcWrite(mode * 8 + channel, duty);
+  return 0;
+}
+
+esp_err_t ledc_set_fade_time_and_start(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty, uint32_t maxFadeMs,
+                                       ledc_fade_mode_t wait) {
+  (void)maxFadeMs; (void)wait;
+  ledcWrite(mode * 8 + channel, duty);
+  return 0;
+}
+
+// ==========================================
+//  esp_timer
+// ==========================================
+struct SimEspTimer {
+  esp_timer_cb_t callback;
+  void *arg;
+  uint64_t dueUs = UINT64_MAX;  // UINT64_MAX = stopped
+  uint64_t periodUs = 0;
+};
+
+namespace sim {
+class EspTimerBank : public EventSource {
+  public:
+    std::vector<SimEspTimer *> timers;
+
+    uint64_t nextEventUs() const override {
+      uint64_t next = UINT64_MAX;
+      for (SimEspTimer *t : timers) next = std::min(next, t->dueUs);
+      return next;
+    }
+
+    void fire(uint64_t us) override {
+      for (SimEspTimer *t : timers) {
+        if (t->dueUs > us) continue;
+        t->dueUs = t->periodUs ? t->dueUs + t->periodUs : UINT64_MAX;
+        t->callback(t->arg);
+        return;
+      }
+    }
+};
+static EspTimerBank espTimers;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out) {
+  if (espTimers.timers.empty()) addEventSource(&espTimers);
+  SimEspTimer *t = new SimEspTimer();
+  t->callback = args->callback; t->arg = args->arg;
+  espTimers.timers.push_back(t);
+  *out = t;
+  return 0;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs) {
+  timer->periodUs = periodUs; timer->dueUs = nowUs() + periodUs;
+  return 0;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+  timer->periodUs = 0; timer->dueUs = nowUs() + timeoutUs;
+  return 0;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  bool running = timer->dueUs != UINT64_MAX;
+  timer->dueUs = UINT64_MAX;
+  return running ? 0 : -1;
+}
+
+int64_t esp_timer_get_time() { return (int64_t)nowUs(); }
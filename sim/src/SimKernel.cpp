@@ -0,0 +1,279 @@
+#include <Arduino.h>
+#include <esp_task_wdt.h>
+#include <ucontext.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "SimKernel.h"
+
+namespace sim {
+
+static const size_t TASK_STACK = 512 * 1024; // Host code (std::string etc.) needs far more than on the chip
+
+struct Task {
+  const char *name;
+  void (*fn)(void *);
+  void *param;
+  int priority;
+  ucontext_t ctx;
+  std::vector<char> stack;
+  uint64_t wakeUs = 0;
+  uint32_t notified = 0;   // Task notification count (xTaskNotifyGive)
+  bool waiting = false;    // Blocked in ulTaskNotifyTake
+  bool finished = false;
+  bool watched = false;
+  uint64_t lastFeedUs = 0;
+  uint64_t worstGapUs = 0;
+};
+
+struct Hook { uint64_t dueUs; uint64_t periodUs; std::function<void()> fn; };
+
+static uint64_t now = 0;
+static std::vector<Task *> tasks;
+static std::vector<Hook> hooks;
+static std::vector<EventSource *> sources;
+static Task *current = nullptr;
+static ucontext_t schedulerCtx;
+static bool stopped = false;
+static const char *stopWhy = nullptr;
+static uint64_t wdtTimeoutUs = 5000000;
+static uint64_t runUntil = UINT64_MAX;
+static bool paced = false;
+static std::chrono::steady_clock::time_point paceWall;  // Host time at virtual paceUs
+static uint64_t paceUs = 0;
+
+uint64_t nowUs() { return now; }
+bool inTask() { return current != nullptr; }
+const char *currentTaskName() { return current ? current->name : "isr"; }
+
+static void taskEntry() {
+  Task *t = current;
+  t->fn(t->param);
+  t->finished = true;   // Returning from a task is an error on FreeRTOS; here it just ends
+  swapcontext(&t->ctx, &schedulerCtx);
+}
+
+void *createTask(void (*fn)(void *), const char *name, void *param, int priority) {
+  Task *t = new Task();
+  t->name = name; t->fn = fn; t->param = param; t->priority = priority;
+  t->stack.resize(TASK_STACK);
+  t->wakeUs = now;
+  getcontext(&t->ctx);
+  t->ctx.uc_stack.ss_sp = t->stack.data();
+  t->ctx.uc_stack.ss_size = t->stack.size();
+  t->ctx.uc_link = nullptr;
+  makecontext(&t->ctx, taskEntry, 0);
+  tasks.push_back(t);
+  return t;
+}
+
+void setRealTime(bool on) {
+  paced = on;
+  paceWall = std::chrono::steady_clock::now();
+  paceUs = now;
+}
+
+bool realTime() { return paced; }
+
+// Moves the clock, waiting for the host to catch up when paced
+static void advanceTo(uint64_t us) {
+  if (paced && us > now) std::this_thread::sleep_until(paceWall + std::chrono::microseconds(us - paceUs));
+  now = us;
+}
+
+void at(uint64_t us, std::function<void()> fn) { hooks.push_back({ us, 0, fn }); }
+void every(uint64_t periodUs, std::function<void()> fn) { hooks.push_back({ now + periodUs, periodUs, fn }); }
+void addEventSource(EventSource *src) { sources.push_back(src); }
+
+// Earliest thing that must happen before the current task may run on
+static uint64_t nextEventExcept(const Task *self) {
+  uint64_t next = runUntil;
+  for (Task *t : tasks) if (t != self && !t->finished && t->wakeUs < next) next = t->wakeUs;
+  for (const Hook &h : hooks) if (h.dueUs < next) next = h.dueUs;
+  for (EventSource *s : sources) { uint64_t e = s->nextEventUs(); if (e < next) next = e; }
+  return next;
+}
+
+void sleepUntil(uint64_t us) {
+  if (!current) { fprintf(stderr, "sim: blocking call outside of a task\n"); abort(); }
+  if (us < now) us = now;
+  // Fast path: nobody else is due before we wake, just move the clock
+  if (!stopped && us < nextEventExcept(current)) { advanceTo(us); return; }
+  Task *self = current;
+  self->wakeUs = us;
+  swapcontext(&self->ctx, &schedulerCtx);
+}
+
+void sleepFor(uint64_t us) { sleepUntil(now + us); }
+
+uint32_t notifyTake(bool clear, uint64_t timeoutUs) {
+  Task *self = current;
+  if (!self->notified) {
+    self->waiting = true;
+    sleepUntil(timeoutUs == UINT64_MAX ? UINT64_MAX : now + timeoutUs);
+    self->waiting = false;
+  }
+  uint32_t count = self->notified;
+  self->notified = clear ? 0 : (count ? count - 1 : 0);
+  return count;
+}
+
+void notifyGive(void *task) {
+  Task *t = static_cast<Task *>(task);
+  if (!t) return;
+  t->notified++;
+  if (t->waiting && t->wakeUs > now) t->wakeUs = now;
+}
+
+void *currentTask() { return current; }
+
+void run(uint64_t untilUs) {
+  runUntil = untilUs;
+  while (!stopped) {
+    // Pick the earliest event. Ties: timer ISRs, then tasks by priority, then hooks.
+    uint64_t best = UINT64_MAX;
+    EventSource *src = nullptr; Task *task = nullptr; int hook = -1;
+    for (EventSource *s : sources) {
+      uint64_t e = s->nextEventUs();
+      if (e < best) { best = e; src = s; }
+    }
+    for (Task *t : tasks) {
+      if (t->finished) continue;
+      if (t->wakeUs < best || (t->wakeUs == best && !src && task && t->priority > task->priority)) {
+        best = t->wakeUs; task = t; src = nullptr;
+      }
+    }
+    for (size_t i = 0; i < hooks.size(); i++) {
+      if (hooks[i].dueUs < best) { best = hooks[i].dueUs; hook = (int)i; src = nullptr; task = nullptr; }
+    }
+    if (best == UINT64_MAX || best > untilUs) { now = untilUs; break; }
+    if (best > now) advanceTo(best);
+
+    if (src) {
+      src->fire(now);
+    } else if (task) {
+      current = task;
+      swapcontext(&schedulerCtx, &task->ctx);
+      current = nullptr;
+    } else {
+      Hook h = hooks[hook];
+      if (h.periodUs) hooks[hook].dueUs += h.periodUs;
+      else hooks.erase(hooks.begin() + hook);
+      h.fn();
+    }
+  }
+}
+
+void stop(const char *reason) {
+  if (!stopped) stopWhy = reason;
+  stopped = true;
+}
+
+const char *stopReason() { return stopWhy; }
+
+int watchdogStats(WatchdogStats *out, int max) {
+  int n = 0;
+  for (Task *t : tasks) {
+    if (!t->watched || n >= max) continue;
+    uint64_t gap = now - t->lastFeedUs;
+    out[n++] = { t->name, gap > t->worstGapUs ? gap : t->worstGapUs };
+  }
+  return n;
+}
+
+uint64_t watchdogTimeoutUs() { return wdtTimeoutUs; }
+
+static void feedWatchdog() {
+  if (!current || !current->watched) return;
+  uint64_t gap = now - current->lastFeedUs;
+  if (gap > current->worstGapUs) current->worstGapUs = gap;
+  current->lastFeedUs = now;
+}
+
+}  // namespace sim
+
+// ------------------------------------------
+//  FreeRTOS / Arduino timing
+// ------------------------------------------
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *param,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core) {
+  (void)stack; (void)core;
+  void *task = sim::createTask(fn, name, param, (int)priority);
+  if (handle) *handle = task;
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *param,
+                       UBaseType_t priority, TaskHandle_t *handle) {
+  return xTaskCreatePinnedToCore(fn, name, stack, param, priority, handle, 0);
+}
+
+TickType_t xTaskGetTickCount() { return (TickType_t)(sim::nowUs() / 1000); }
+void vTaskDelay(TickType_t ticks) { sim::sleepFor((uint64_t)ticks * 1000); }
+
+void vTaskDelayUntil(TickType_t *previousWake, TickType_t increment) {
+  *previousWake += increment;
+  sim::sleepUntil((uint64_t)*previousWake * 1000);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  (void)task;
+  sim::sleepUntil(UINT64_MAX);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return sim::currentTask(); }
+
+struct SimMutex { void *owner = nullptr; };
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return new SimMutex(); }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t ticks) {
+  SimMutex *m = static_cast<SimMutex *>(mutex);
+  uint64_t deadline = ticks == portMAX_DELAY ? UINT64_MAX : sim::nowUs() + (uint64_t)ticks * 1000;
+  // Only a holder that blocks inside its section is ever waited for
+  while (m->owner) {
+    if (sim::nowUs() >= deadline) return pdFALSE;
+    sim::sleepFor(std::min<uint64_t>(1000, deadline - sim::nowUs()));
+  }
+  m->owner = sim::currentTask();
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex) {
+  static_cast<SimMutex *>(mutex)->owner = nullptr;
+  return pdTRUE;
+}
+BaseType_t xTaskNotifyGive(TaskHandle_t task) { sim::notifyGive(task); return pdPASS; }
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  return sim::notifyTake(clearOnExit, ticks == portMAX_DELAY ? UINT64_MAX : (uint64_t)ticks * 1000);
+}
+
+unsigned long millis() { return (unsigned long)(uint32_t)(sim::nowUs() / 1000); }
+unsigned long micros() { return (unsigned long)(uint32_t)sim::nowUs(); }
+void delay(uint32_t ms) { sim::sleepFor((uint64_t)ms * 1000); }
+void delayMicroseconds(uint32_t us) { sim::sleepFor(us); }
+void yield() { if (sim::inTask()) sim::sleepFor(0); }
+
+// ------------------------------------------
+//  Task watchdog
+// ------------------------------------------
+esp_err_t esp_task_wdt_init(uint32_t timeoutSeconds, bool panic) {
+  (void)panic;
+  sim::wdtTimeoutUs = (uint64_t)timeoutSeconds * 1000000;
+  return 0;
+}
+
+esp_err_t esp_task_wdt_add(void *task) {
+  (void)task;
+  if (sim::current) { sim::current->watched = true; sim::current->lastFeedUs = sim::now; }
+  return 0;
+}
+
+esp_err_t esp_task_wdt_delete(void *task) {
+  (void)task;
+  if (sim::current) sim::current->watched = false;
+  return 0;
+}
+
+esp_err_t esp_task_wdt_reset() { sim::feedWatchdog(); return 0; }
@@ -0,0 +1,705 @@
+#include <Arduino.h>
+#include <stdarg.h>
+#include <sys/time.h>
+#include <chrono>
+#include <vector>
+#include "SimWorld.h"
+#include "MotionLink.h"
+#include "StepBench.h"
+#include "MovePlanner.h"
+#include "DriftTracker.h"
+#include "ConfigStore.h"
+#include "TimeService.h"
+#include "TraceRecorder.h"
+#include "BenchSuite.h"
+#include "OtaUpdater.h"
+#include "WarmStart.h"
+#include <Update.h>
+#include <mbedtls/sha256.h>
+
+// ==========================================
+//          NATIVE SIMULATION HARNESS
+// ==========================================
+// Boots the unmodified firmware (setup()/loop() from src/main.cpp) on the
+// virtual kernel, lets it run for days of simulated time and checks the
+// physical flaps against the wall clock every 100 ms. Exits non-zero when the
+// clock showed the wrong time, lost its position, starved a watchdog or
+// rebooted, so the same binary serves as a CI gate.
+//
+//   .pio/build/native/program --days 3 --date --night 23-6 --auto-home 6
+
+void setup();
+void loop();
+int runTests();  // SimTests.cpp
+
+// Firmware state the probes look at (defined in main.cpp)
+extern Snapshot<MotionStatus> motionStatus;
+extern unsigned long lastLogicLoop;
+extern bool isShowingDate;
+extern MovePlanner planner;
+extern DriftTracker driftHours, driftMinutes;
+extern ConfigStore configStore;
+extern WarmStart warmStart;
+extern OtaUpdater otaUpdater;
+extern TimeService timeService;
+extern uint32_t loopWakes;
+extern BenchSuite benchSuite;
+extern bool dateDisplayEnabled, manualMode;
+extern int dateIntervalMinutes, dateDurationSeconds;
+extern unsigned long lastDateShowTime;
+extern int ipBlinkDigit;
+extern unsigned long ipBlinkNext;
+static const int COLON_CHANNEL = 1;  // PWM_CH_COLON
+static const double COLON_BLINK_MS = 500;
+// Both spools of a plan end on the same tick, give or take the few
+// instructions between starting the two timers
+static const double MAX_ARRIVAL_SKEW_MS = 0.1;
+// As in main.cpp: loop() sleeps at most MAX_SLEEP_MS, and wakes for the
+// next minute PREPOSITION_MS ahead of the boundary
+static const uint32_t MAX_SLEEP_MS = 500;
+static const uint32_t PREPOSITION_MS = 3000;
+
+struct Options {
+  double days = 2;
+  const char *start = "2026-03-07 18:00";  // Local time; crosses the March DST change
+  const char *tz = "EST5EDT,M3.2.0,M11.1.0";
+  bool hour12 = false;
+  bool date = false;
+  int nightStart = -1, nightEnd = -1;
+  int autoHome = 0;
+  int speed = 1000;
+  bool powerSaver = false;
+  double stepsRevH = 2048, stepsRevM = 2048;
+  double slipPpm = 0;
+  int noise = 4;
+  uint32_t seed = 1;
+  uint32_t loopUs = 1000;
+  double calibrateAt = -1;   // Seconds after boot, POST /calibrate_motors
+  double httpEvery = 3600;   // Seconds between GET /status probes
+  bool speedSwap = false;    // PATCH a new speed into every move that turns both spools
+  // Mechanical error that fails the run. Homing settles on the magnet centre,
+  // so what is left is the estimate (under 1 step), rounding of the flap
+  // targets (34.13 steps each) and, with --slip-ppm, the slip between
+  // corrections: about 4 steps at 300 ppm.
+  double maxErrorSteps = 6;
+  double graceS = 10;        // Time allowed for a flip to land
+  bool serial = false;
+  bool trace = false;
+  bool test = false;         // Only run the firmware unit tests
+  const char *traceFile = nullptr;  // Where to save the /trace download
+  bool benchSteps = false;   // Only run the step profile benchmark
+  bool bench = false;        // Boot, then run the firmware's benchmark suite
+  const char *benchOut = nullptr;
+  bool ota = false;          // Firmware uploads: a corrupt one, then a good one that restarts the clock
+  bool otaTrial = false;     // Boot as a freshly installed image that has to pass its trial
+  const char *otaBase = nullptr;    // Image the clock runs (what deltas apply to)
+  const char *otaFile = nullptr;    // Upload this instead of a generated image (.bin or .sfu)
+  const char *otaExpect = nullptr;  // Image that must end up installed (default: the upload)
+  int serve = 0;             // Real time, dashboard on this local port (tools/http_load.py)
+};
+
+static Options opt;
+
+// ------------------------------------------
+//  Statistics
+// ------------------------------------------
+struct Series {
+  std::vector<double> v;
+  void add(double x) { v.push_back(x); }
+  double pct(double p) {
+    if (v.empty()) return 0;
+    std::vector<double> s = v;
+    size_t k = std::min(s.size() - 1, (size_t)(p / 100.0 * s.size()));
+    std::nth_element(s.begin(), s.begin() + k, s.end());
+    return s[k];
+  }
+  double maxv() const { double m = 0; for (double x : v) m = std::max(m, x); return m; }
+  double mean() const { double t = 0; for (double x : v) t += x; return v.empty() ? 0 : t / v.size(); }
+};
+
+static Series logicGapMs, logicHostUs, loopHostUs, flipLatencyS, httpHostUs, arrivalSkewMs, correctedSkewMs, colonHalfMs;
+static Series minuteLateMs, dateLateMs, blinkLateMs;
+static double worstErrorSteps[2] = { 0, 0 };
+static double sumSqError[2] = { 0, 0 }; static uint64_t errorSamples[2] = { 0, 0 };
+static uint32_t flips = 0, dateShows = 0, homings = 0, homingErrors = 0, nights = 0, dstChanges = 0;
+static uint32_t staleIncidents = 0; static double staleSeconds = 0;
+static uint32_t httpErrors = 0;
+
+static void trace(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+static void trace(const char *fmt, ...) {
+  if (!opt.trace) return;
+  char buf[256];
+  va_list args; va_start(args, fmt); vsnprintf(buf, sizeof(buf), fmt, args); va_end(args);
+  time_t t = (time_t)sim::wallClock();
+  struct tm tm; localtime_r(&t, &tm);
+  char when[32]; strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S %Z", &tm);
+  printf("%s  %s\n", sim::timeSynced() ? when : "(unsynced)             ", buf);
+}
+
+// ------------------------------------------
+//  Arduino loopTask
+// ------------------------------------------
+// How late loop() gets to the deadlines it sleeps until. One read at the
+// start of a pass sees what the pass before left, so a deadline that pass
+// set counts if it lies after that pass began; it is late by however long
+// after it the first pass starts.
+struct Deadline {
+  unsigned long dueMs = 0;
+  bool armed = false;
+  void check(bool active, unsigned long due, unsigned long prevPassMs, unsigned long nowMs, Series &late) {
+    if (armed && (long)(nowMs - dueMs) >= 0) { late.add(nowMs - dueMs); armed = false; }
+    if (!active) { armed = false; return; }
+    if (due == dueMs) return;
+    dueMs = due;
+    armed = (long)(due - prevPassMs) > 0;
+    if (armed && (long)(nowMs - due) >= 0) { late.add(nowMs - due); armed = false; }
+  }
+};
+
+static Deadline dateDeadline, blinkDeadline;
+static unsigned long minuteDueMs = 0;
+static unsigned long prevPassMs = 0;
+
+static void checkDeadlines() {
+  unsigned long now = millis();
+  if (minuteDueMs && (long)(now - minuteDueMs) >= 0) { minuteLateMs.add(now - minuteDueMs); minuteDueMs = 0; }
+  if (sim::timeSynced() && !minuteDueMs) {
+    struct timeval tv; gettimeofday(&tv, nullptr);
+    uint32_t toBoundary = (uint32_t)(60 - tv.tv_sec % 60) * 1000 - tv.tv_usec / 1000;
+    minuteDueMs = now + (toBoundary > PREPOSITION_MS ? toBoundary - PREPOSITION_MS : toBoundary + 60000 - PREPOSITION_MS);
+  }
+  // As main.cpp: a pass acts once the hold or the interval is strictly over
+  unsigned long dateDue = lastDateShowTime + (isShowingDate ? dateDurationSeconds * 1000UL : dateIntervalMinutes * 60000UL) + 1;
+  dateDeadline.check(dateDisplayEnabled && !manualMode, dateDue, prevPassMs, now, dateLateMs);
+  blinkDeadline.check(ipBlinkDigit >= 0, ipBlinkNext, prevPassMs, now, blinkLateMs);
+  prevPassMs = now;
+}
+
+static void loopTask(void *) {
+  setup();
+  unsigned long lastLogic = lastLogicLoop;
+  uint64_t lastLogicUs = 0;
+  for (;;) {
+    checkDeadlines();
+    auto t0 = std::chrono::steady_clock::now();
+    loop();
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    if (lastLogicLoop != lastLogic) {
+      // The 50 ms logic block ran in this iteration
+      uint64_t now = sim::nowUs();
+      if (lastLogicUs) logicGapMs.add((now - lastLogicUs) / 1000.0);
+      lastLogicUs = now; lastLogic = lastLogicLoop;
+      logicHostUs.add(us);
+    } else {
+      loopHostUs.add(us);
+    }
+    sim::sleepFor(opt.loopUs);
+  }
+}
+
+// ------------------------------------------
+//  Probes
+// ------------------------------------------
+static double wrapFlaps(double d) {
+  while (d >= 30) d -= 60;
+  while (d < -30) d += 60;
+  return d;
+}
+
+static bool isNight(int hour) {
+  if (opt.nightStart < 0) return false;
+  if (opt.nightStart > opt.nightEnd) return hour >= opt.nightStart || hour < opt.nightEnd;
+  return hour >= opt.nightStart && hour < opt.nightEnd;
+}
+
+static int expectH = -1, expectM = -1;
+static uint64_t wrongSinceUs = 0;   // When the flaps stopped matching (0 = matching)
+static bool wrongIsFlip = false;    // ...because the expected value moved on
+static bool staleOpen = false;
+static bool wasCalibrating = false, wasShowingDate = false, wasNight = false;
+static bool homedOnce = false;      // Positions mean nothing before the first homing
+static char lastHomingStatus[48] = "";
+static int lastIsDst = -1;
+static uint64_t lastMoveUs[2] = { 0, 0 };
+static uint32_t syncedPlans = 0, correctionsSeen = 0;
+static uint32_t speedSwaps = 0, swappedPlan = UINT32_MAX;
+static sim::HttpResult speedSwapResult;
+static uint64_t firstCorrectUs = 0;  // Power-on to the flaps first reading the right time
+
+static void probe() {
+  MotionStatus st = motionStatus.read();
+  uint64_t now = sim::nowUs();
+
+  if (st.calibrating && !wasCalibrating) { homings++; trace("homing started"); }
+  if (!st.calibrating && wasCalibrating) {
+    trace("homing finished: %s", st.calibrationStatus);
+    if (strncmp(st.calibrationStatus, "Err", 3) == 0) homingErrors++;
+    strlcpy(lastHomingStatus, st.calibrationStatus, sizeof(lastHomingStatus));
+    homedOnce = true;
+  }
+  wasCalibrating = st.calibrating;
+  if (isShowingDate && !wasShowingDate) { dateShows++; trace("date shown"); }
+  wasShowingDate = isShowingDate;
+
+  for (int i = 0; i < sim::SPOOLS; i++) if (sim::spool(i).lastStepUs) lastMoveUs[i] = sim::spool(i).lastStepUs;
+  bool settled = !st.moving && now - std::max(lastMoveUs[0], lastMoveUs[1]) > 50000;
+
+  // Arrival skew of each plan that turned both spools, from the step ISR
+  // times. Not from the spools' idle gaps: a minute flip may start 10 ms
+  // after the previous plan landed, which the 100 ms probe can't tell apart.
+  // A drift correction during the move adds or trims steps of one spool
+  // only, so those plans are counted apart.
+  const SyncStats &sync = planner.sync();
+  uint32_t corrections = driftHours.history().corrected + driftMinutes.history().corrected;
+  if (sync.count != syncedPlans) {
+    syncedPlans = sync.count;
+    (corrections != correctionsSeen ? correctedSkewMs : arrivalSkewMs).add(sync.lastSkewUs / 1000.0);
+    correctionsSeen = corrections;
+  }
+
+  // --speed-swap: the firmware holds a new speed back until both spools
+  // stopped; taken mid-move, it would show up in the plan's arrival skew
+  bool bothTurning = now - lastMoveUs[0] < 20000 && now - lastMoveUs[1] < 20000;
+  if (opt.speedSwap && bothTurning && !st.calibrating && swappedPlan != sync.count) {
+    if (speedSwapResult.done && speedSwapResult.code != 200) httpErrors++;
+    swappedPlan = sync.count; speedSwaps++;
+    int spd = (speedSwaps & 1) ? opt.speed * 2 / 3 : opt.speed;
+    sim::httpJson("PATCH", "/api/config", "{\"spd\":" + std::to_string(spd) + "}", &speedSwapResult);
+  }
+
+  // Mechanical error: flap under the window vs. the value the firmware believes it shows
+  if (homedOnce && settled && !st.calibrating && st.displayedHour >= 0 && st.displayedMinute >= 0) {
+    int shown[2] = { st.displayedHour, st.displayedMinute };
+    for (int i = 0; i < sim::SPOOLS; i++) {
+      sim::Spool &s = sim::spool(i);
+      double err = fabs(wrapFlaps(s.flap() - shown[i])) * s.cfg.stepsPerRev / 60.0;
+      worstErrorSteps[i] = std::max(worstErrorSteps[i], err);
+      sumSqError[i] += err * err; errorSamples[i]++;
+    }
+  }
+
+  if (!sim::timeSynced()) return;
+  time_t t = (time_t)sim::wallClock();
+  struct tm tm; localtime_r(&t, &tm);
+  if (lastIsDst >= 0 && tm.tm_isdst != lastIsDst) { dstChanges++; trace("DST %s", tm.tm_isdst ? "starts" : "ends"); }
+  lastIsDst = tm.tm_isdst;
+
+  // Wall-clock check: what should the flaps read right now?
+  bool night = isNight(tm.tm_hour);
+  if (night != wasNight) { if (night) nights++; trace(night ? "night mode on" : "night mode off"); }
+  wasNight = night;
+  int h, m;
+  if (isShowingDate) { h = tm.tm_mon + 1; m = tm.tm_mday; }
+  else {
+    h = tm.tm_hour; m = tm.tm_min;
+    if (opt.hour12) { h %= 12; if (h == 0) h = 12; }
+  }
+  bool checking = homedOnce && !night && !st.calibrating;
+  if (!checking) { expectH = -1; wrongSinceUs = 0; staleOpen = false; return; }
+  if (h != expectH || m != expectM) { expectH = h; expectM = m; wrongSinceUs = now; wrongIsFlip = true; }
+
+  int physH = (int)lround(sim::spool(0).flap()) % 60, physM = (int)lround(sim::spool(1).flap()) % 60;
+  if (settled && physH == expectH && physM == expectM) {
+    if (!firstCorrectUs) firstCorrectUs = now;
+    if (wrongSinceUs && wrongIsFlip) {
+      // Last step of the move vs. the moment the new value became due;
+      // negative when the flap settled early
+      uint64_t landUs = std::max(lastMoveUs[0], lastMoveUs[1]);
+      double latency = (landUs + 10000000 > wrongSinceUs) ? ((double)landUs - (double)wrongSinceUs) / 1e6 : 0;
+      flipLatencyS.add(latency); flips++;
+      if (latency > 4.0) trace("slow flip to %02d:%02d: %.2f s", expectH, expectM, latency);
+    }
+    wrongSinceUs = 0; staleOpen = false;
+    return;
+  }
+  if (!wrongSinceUs) { wrongSinceUs = now; wrongIsFlip = false; }  // Lost it without a new target
+  if ((now - wrongSinceUs) / 1e6 > opt.graceS) {
+    if (!staleOpen) {
+      staleOpen = true; staleIncidents++;
+      trace("WRONG: showing %02d:%02d, expected %02d:%02d", physH, physM, expectH, expectM);
+    }
+    staleSeconds += 0.1;
+  }
+}
+
+static sim::HttpResult statusProbe;
+static void httpProbe() {
+  if (statusProbe.done) {
+    httpHostUs.add(statusProbe.hostUs);
+    if (statusProbe.code != 200) httpErrors++;
+  }
+  sim::httpRequest("GET", "/status", {}, &statusProbe);
+}
+
+static sim::HttpResult calibrateResult;
+static sim::HttpResult metricsResult;
+static sim::HttpResult traceResult;
+
+// --- Firmware update scenario (--ota, --ota-trial) ---
+static const uint64_t OTA_BAD_BEFORE_END_US = 120000000;
+static const uint64_t OTA_GOOD_BEFORE_END_US = 500000;
+static const size_t OTA_IMAGE_BYTES = 720 * 1024;
+static std::string otaImage;    // What --ota uploads
+static std::string otaExpected;  // What it must install
+static sim::HttpResult otaBadResult, otaGoodResult, otaTrialProbe;
+
+static std::string sha256Hex(const std::string &data) {
+  mbedtls_sha256_context ctx;
+  uint8_t digest[32];
+  mbedtls_sha256_init(&ctx);
+  mbedtls_sha256_starts_ret(&ctx, 0);
+  mbedtls_sha256_update_ret(&ctx, (const unsigned char *)data.data(), data.size());
+  mbedtls_sha256_finish_ret(&ctx, digest);
+  char hex[65];
+  for (int i = 0; i < 32; i++) snprintf(hex + 2 * i, 3, "%02x", digest[i]);
+  return hex;
+}
+
+// Not from sim::random32(), so the scenario leaves the rest of the run alone
+static std::string makeOtaImage() {
+  std::string image(OTA_IMAGE_BYTES, 0);
+  uint32_t x = 0x2545F491;
+  for (char &c : image) { x = x * 1664525 + 1013904223; c = (char)(x >> 24); }
+  return image;
+}
+
+static bool readFile(const char *path, std::string &out) {
+  FILE *f = fopen(path, "rb");
+  if (!f) { printf("cannot read %s\n", path); return false; }
+  char buf[65536]; size_t n;
+  out.clear();
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+// As the dashboard does it: an .sfu carries the digest of the image it makes
+static std::string uploadDigest(const std::string &upload) {
+  if (upload.size() >= sizeof(PackHeader) && upload.compare(0, 4, "SFU1") == 0) {
+    PackHeader h; memcpy(&h, upload.data(), sizeof(h));
+    char hex[65];
+    for (int i = 0; i < 32; i++) snprintf(hex + 2 * i, 3, "%02x", h.targetSha256[i]);
+    return hex;
+  }
+  return sha256Hex(upload);
+}
+
+// Value of one exposition line, e.g. `splitflap_step_lateness_seconds_count{axis="hours"}`
+static double metricValue(const std::string &body, const std::string &series) {
+  size_t at = body.find("\n" + series + " ");
+  return at == std::string::npos ? -1 : atof(body.c_str() + at + series.size() + 2);
+}
+
+// ------------------------------------------
+//  Setup + report
+// ------------------------------------------
+static void usage() {
+  printf("usage: program [--days N] [--start \"YYYY-MM-DD HH:MM\"] [--tz POSIX-TZ] [--12h]\n"
+         "               [--date] [--night START-END] [--auto-home HOURS] [--speed STEPS/S]\n"
+         "               [--power-saver] [--steps-rev-h F] [--steps-rev-m F] [--slip-ppm F]\n"
+         "               [--noise LSB] [--seed N] [--loop-us N] [--calibrate-at S]\n"
+         "               [--http-every S] [--max-error STEPS] [--grace S] [--serial] [--trace]\n"
+         "               [--trace-file PATH] [--speed-swap] [--ota] [--ota-trial]\n"
+         "               [--ota-base FILE] [--ota-file FILE] [--ota-expect FILE] [--serve PORT]\n"
+         "       program --test\n"
+         "       program --bench-steps [--speed STEPS/S]\n"
+         "       program --bench [--bench-out FILE]\n");
+}
+
+static bool parseArgs(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    auto next = [&]() -> const char * { return (i + 1 < argc) ? argv[++i] : ""; };
+    if (a == "--days") opt.days = atof(next());
+    else if (a == "--start") opt.start = next();
+    else if (a == "--tz") opt.tz = next();
+    else if (a == "--12h") opt.hour12 = true;
+    else if (a == "--date") opt.date = true;
+    else if (a == "--night") { if (sscanf(next(), "%d-%d", &opt.nightStart, &opt.nightEnd) != 2) return false; }
+    else if (a == "--auto-home") opt.autoHome = atoi(next());
+    else if (a == "--speed") opt.speed = atoi(next());
+    else if (a == "--power-saver") opt.powerSaver = true;
+    else if (a == "--steps-rev-h") opt.stepsRevH = atof(next());
+    else if (a == "--steps-rev-m") opt.stepsRevM = atof(next());
+    else if (a == "--slip-ppm") opt.slipPpm = atof(next());
+    else if (a == "--noise") opt.noise = atoi(next());
+    else if (a == "--seed") opt.seed = (uint32_t)atol(next());
+    else if (a == "--loop-us") opt.loopUs = (uint32_t)atol(next());
+    else if (a == "--calibrate-at") opt.calibrateAt = atof(next());
+    else if (a == "--http-every") opt.httpEvery = atof(next());
+    else if (a == "--speed-swap") opt.speedSwap = true;
+    else if (a == "--max-error") opt.maxErrorSteps = atof(next());
+    else if (a == "--grace") opt.graceS = atof(next());
+    else if (a == "--serial") opt.serial = true;
+    else if (a == "--trace") opt.trace = true;
+    else if (a == "--test") opt.test = true;
+    else if (a == "--trace-file") opt.traceFile = next();
+    else if (a == "--bench-steps") opt.benchSteps = true;
+    else if (a == "--bench") opt.bench = true;
+    else if (a == "--bench-out") { opt.bench = true; opt.benchOut = next(); }
+    else if (a == "--ota") opt.ota = true;
+    else if (a == "--ota-trial") opt.otaTrial = true;
+    else if (a == "--ota-base") opt.otaBase = next();
+    else if (a == "--ota-file") { opt.ota = true; opt.otaFile = next(); }
+    else if (a == "--ota-expect") opt.otaExpect = next();
+    else if (a == "--serve") opt.serve = atoi(next());
+    else return false;
+  }
+  return true;
+}
+
+static int64_t parseStart() {
+  struct tm tm = {};
+  if (sscanf(opt.start, "%d-%d-%d %d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min) != 5) return -1;
+  tm.tm_year -= 1900; tm.tm_mon -= 1; tm.tm_isdst = -1;
+  setenv("TZ", opt.tz, 1); tzset();
+  return (int64_t)mktime(&tm);
+}
+
+// Host numbers only compare the two approaches; /bench/steps on the ESP32
+// gives the real cycle counts
+static int benchSteps() {
+  StepBenchResult r = benchmarkStepProfiles(opt.speed, 1000, 40000);
+  printf("step profile @ %d steps/s, %u step move:\n", opt.speed, (unsigned)r.steps);
+  printf("  s-curve table lookup:     %8.1f cycles/step\n", r.tableCyclesPerStep);
+  printf("  accelstepper recurrence:  %8.1f cycles/step\n", r.accelStepperCyclesPerStep);
+  printf("  table build:              %8u us, %u ramp steps\n", (unsigned)r.buildUs, (unsigned)r.rampLength);
+  return 0;
+}
+
+// The suite main.cpp registers, run once the clock has booted and homed so
+// status, settings and profiles look like on a running clock. Host cycles
+// are host time scaled to 240 MHz: compare against a host baseline only.
+static const uint64_t BENCH_BOOT_US = 30000000;
+
+static int runBench() {
+  BenchResult results[BenchSuite::MAX_KERNELS];
+  int n = benchSuite.run(results, BenchSuite::MAX_KERNELS);
+  printf("benchmark suite (host, best of %d rounds):\n", BenchSuite::ROUNDS);
+  for (int i = 0; i < n; i++) {
+    printf("  %-18s %6u ops  %10.1f cycles/op  %9.1f ns/op\n", results[i].name, (unsigned)results[i].ops,
+           results[i].cyclesPerOp, results[i].cyclesPerOp * 1000.0 / ESP.getCpuFreqMHz());
+  }
+  if (!opt.benchOut) return 0;
+  JsonDocument doc;
+  BenchSuite::report(doc, "host", results, n);
+  String json; serializeJsonPretty(doc, json);
+  FILE *f = fopen(opt.benchOut, "w");
+  if (!f) { printf("cannot write %s\n", opt.benchOut); return 1; }
+  fwrite(json.c_str(), 1, json.length(), f); fclose(f);
+  printf("results written to %s\n", opt.benchOut);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (!parseArgs(argc, argv)) { usage(); return 2; }
+  if (opt.test) return runTests();
+  if (opt.benchSteps) return benchSteps();
+  int64_t epoch = parseStart();
+  if (epoch < 0) { usage(); return 2; }
+
+  sim::setEpoch(epoch);
+  sim::setSeed(opt.seed);
+  sim::setAdcNoise(opt.noise);
+  sim::setSerialEcho(opt.serial);
+
+  // The physical clock: wiring as in main.cpp, magnets somewhere on the spools
+  sim::configureSpool(0, { "hours", { 26, 33, 25, 32 }, 7, opt.stepsRevH, 700.3, opt.slipPpm, 1830, 1200, 25 });
+  sim::configureSpool(1, { "minutes", { 27, 12, 14, 13 }, 6, opt.stepsRevM, 1311.6, opt.slipPpm, 1830, 1200, 25 });
+
+  // Settings as if saved from the dashboard by a firmware that still used one
+  // key per setting: every run also goes through the blob migration
+  sim::nvsSet("clock-conf", "tz", opt.tz);
+  sim::nvsSet("clock-conf", "12h", opt.hour12);
+  sim::nvsSet("clock-conf", "spd", opt.speed);
+  sim::nvsSet("clock-conf", "idle", opt.powerSaver);
+  sim::nvsSet("clock-conf", "homeInt", opt.autoHome);
+  sim::nvsSet("clock-conf", "dEn", opt.date);
+  sim::nvsSet("clock-conf", "dInt", 5);
+  sim::nvsSet("clock-conf", "dDur", 10);
+  sim::nvsSet("clock-conf", "nEn", opt.nightStart >= 0);
+  if (opt.nightStart >= 0) { sim::nvsSet("clock-conf", "nSt", opt.nightStart); sim::nvsSet("clock-conf", "nEd", opt.nightEnd); }
+  // As left by a successful /update: first boot of the new image, the spools
+  // parked where they stand (magnets at step 0, 39:21 under the window).
+  // The image must still home to pass its trial.
+  if (opt.otaTrial) {
+    sim::nvsSet("clock-ota", "boots", 0);
+    WarmStart parked;
+    parked.update(-700, -1312, 0, 0, 39, 21, 2048, 2048);
+    parked.park();
+  }
+
+  sim::createTask(loopTask, "loopTask", nullptr, 1);
+  sim::every(100000, probe);
+  sim::onLedcChange([](int channel, uint32_t duty) {
+    // Half periods of the colon blink: how late the loop got to each toggle
+    static uint64_t lastUs = 0;
+    if (channel != COLON_CHANNEL) return;
+    if (lastUs) colonHalfMs.add((sim::nowUs() - lastUs) / 1000.0);
+    lastUs = sim::nowUs();
+  });
+  if (opt.httpEvery > 0) sim::every((uint64_t)(opt.httpEvery * 1e6), httpProbe);
+  if (opt.calibrateAt >= 0) {
+    sim::at((uint64_t)(opt.calibrateAt * 1e6), []() { sim::httpRequest("POST", "/calibrate_motors", {}, &calibrateResult); });
+  }
+
+  if (opt.bench) {
+    sim::run(BENCH_BOOT_US);
+    return runBench();
+  }
+
+  auto wallStart = std::chrono::steady_clock::now();
+  uint64_t until = (uint64_t)(opt.days * 86400e6);
+  sim::at(until - 2000000, []() { sim::httpRequest("GET", "/metrics", {}, &metricsResult); });
+  // Record the last minute of moves without hall samples, so a flip is in it
+  sim::at(until - 65000000, []() {
+    static sim::HttpResult armResult;
+    char mask[16]; snprintf(mask, sizeof(mask), "%lu", (unsigned long)(TRACE_ALL & ~(1UL << TRACE_HALL)));
+    sim::httpRequest("POST", "/trace/arm", { { "mask", mask } }, &armResult);
+  });
+  sim::at(until - 1000000, []() { sim::httpRequest("GET", "/trace", {}, &traceResult); });
+  if (opt.ota) {
+    // The digest of another image: must be refused, motion picks up again.
+    // Then the real one, last thing in the run since it restarts the clock.
+    if (opt.otaFile) { if (!readFile(opt.otaFile, otaImage)) return 2; }
+    else otaImage = makeOtaImage();
+    otaExpected = otaImage;
+    if (opt.otaExpect && !readFile(opt.otaExpect, otaExpected)) return 2;
+    if (opt.otaBase) {
+      std::string base;
+      if (!readFile(opt.otaBase, base)) return 2;
+      sim::setRunningImage(base);
+    }
+    sim::at(until - OTA_BAD_BEFORE_END_US, []() {
+      std::string other = otaExpected; other[other.size() / 2] ^= 1;
+      sim::httpUpload("/update", { { "sha256", sha256Hex(other) } }, otaImage, &otaBadResult);
+    });
+    sim::at(until - OTA_GOOD_BEFORE_END_US, []() {
+      sim::httpUpload("/update", { { "sha256", uploadDigest(otaImage) } }, otaImage, &otaGoodResult);
+    });
+  }
+  // The trial needs a request answered: one at 30 s, then check at 60 s
+  if (opt.otaTrial) {
+    sim::at(30000000, []() { sim::httpRequest("GET", "/status", {}, &otaTrialProbe); });
+    sim::at(60000000, []() { sim::httpRequest("GET", "/status", {}, &otaTrialProbe); });
+  }
+  if (opt.serve) {
+    sim::serveOn(opt.serve);
+    sim::setRealTime(true);
+    printf("serving:          http://127.0.0.1:%d/ once WiFi is up, in real time\n", opt.serve);
+    fflush(stdout);
+  }
+  sim::run(until);
+  double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double simS = sim::nowUs() / 1e6;
+  if (statusProbe.done) httpProbe();
+
+  // ---- Report ----
+  printf("simulated:        %.2f days in %.1f s (%.0fx real time)\n", simS / 86400, wallS, simS / std::max(wallS, 1e-6));
+  if (sim::stopReason()) printf("stopped:          %s\n", sim::stopReason());
+  for (int i = 0; i < sim::SPOOLS; i++) {
+    sim::Spool &s = sim::spool(i);
+    double rms = errorSamples[i] ? sqrt(sumSqError[i] / errorSamples[i]) : 0;
+    printf("steps %-8s    %llu fwd, %llu back, %llu lost; error vs firmware: max %.1f, rms %.2f steps\n",
+           s.cfg.name, (unsigned long long)s.forwardSteps, (unsigned long long)s.backwardSteps,
+           (unsigned long long)s.lostSteps, worstErrorSteps[i], rms);
+  }
+  printf("flips:            %u, latency avg %.3f s, p50 %.3f s, p99 %.3f s, max %.3f s\n", flips, flipLatencyS.mean(), flipLatencyS.pct(50), flipLatencyS.pct(99), flipLatencyS.maxv());
+  const LandingStats &land = planner.landing();
+  printf("boundary landing: %u pre-positioned, %u within %u ms, mean |err| %.2f ms, max %.2f ms\n",
+         (unsigned)land.count, (unsigned)land.onTime, (unsigned)(MovePlanner::LAND_TOLERANCE_US / 1000),
+         land.meanAbsErrorUs / 1000.0, land.maxAbsErrorUs / 1000.0);
+  printf("two-spool moves:  %zu, arrival skew p50 %.3f ms, max %.3f ms; %zu drift-corrected, skew max %.3f ms\n",
+         arrivalSkewMs.v.size(), arrivalSkewMs.pct(50), arrivalSkewMs.maxv(), correctedSkewMs.v.size(), correctedSkewMs.maxv());
+  printf("boot:             correct time shown %.1f s after power-on\n", firstCorrectUs / 1e6);
+  printf("wrong display:    %u incidents, %.1f s total\n", staleIncidents, staleSeconds);
+  DriftTracker *trackers[] = { &driftHours, &driftMinutes };
+  for (int i = 0; i < sim::SPOOLS; i++) {
+    DriftHistory h = trackers[i]->history();
+    printf("drift %-8s    %u magnet passes, %u corrected, %u rejected, %+d steps total\n",
+           sim::spool(i).cfg.name, (unsigned)h.passes, (unsigned)h.corrected, (unsigned)h.rejected, (int)h.totalSteps);
+  }
+  printf("events:           %u homings (%u failed), %u date shows, %u nights, %u DST changes\n", homings, homingErrors, dateShows, nights, dstChanges);
+  if (opt.speedSwap) printf("speed swaps:      %u, sent while both spools turned\n", speedSwaps);
+  printf("local time:       %u conversions, %.2f per second\n", (unsigned)timeService.conversions(), timeService.conversions() / (sim::nowUs() / 1e6));
+  printf("nvs writes:       %u config blob, %u warm start park, %u firmware trial\n",
+         (unsigned)configStore.writes(), (unsigned)warmStart.nvsWrites(), (unsigned)otaUpdater.nvsWrites());
+  printf("loop logic tick:  gap p50 %.1f ms, p99 %.1f ms, max %.1f ms\n", logicGapMs.pct(50), logicGapMs.pct(99), logicGapMs.maxv());
+  printf("loop wakes:       %.1f per second; colon half period p50 %.1f ms, max %.1f ms\n",
+         loopWakes / (sim::nowUs() / 1e6), colonHalfMs.pct(50), colonHalfMs.maxv());
+  printf("loop deadlines:   late by max %.0f ms (minute, %zu), %.0f ms (date, %zu), %.0f ms (IP blink, %zu)\n",
+         minuteLateMs.maxv(), minuteLateMs.v.size(), dateLateMs.maxv(), dateLateMs.v.size(), blinkLateMs.maxv(), blinkLateMs.v.size());
+  printf("loop host cost:   logic p50 %.1f us, p99 %.1f us, max %.1f us; idle pass p50 %.2f us\n",
+         logicHostUs.pct(50), logicHostUs.pct(99), logicHostUs.maxv(), loopHostUs.pct(50));
+  printf("http /status:     %zu served, %u errors, host p50 %.1f us\n", httpHostUs.v.size(), httpErrors, httpHostUs.pct(50));
+  if (metricsResult.done) {
+    const std::string &m = metricsResult.body;
+    printf("http /metrics:    %zu bytes, %.0f steps timed (hours), loop overruns %.0f, homing %.1f s\n", m.size(),
+           metricValue(m, "splitflap_step_lateness_seconds_count{axis=\"hours\"}"),
+           metricValue(m, "splitflap_loop_overruns_total"),
+           metricValue(m, "splitflap_homing_seconds_sum{kind=\"home\"}"));
+    printf("http server:      %.0f connections, %.0f requests, %.0f evictions\n",
+           metricValue(m, "splitflap_http_connections_total"), metricValue(m, "splitflap_http_requests_total"),
+           metricValue(m, "splitflap_http_evictions_total"));
+  }
+  bool traceOk = false;
+  if (traceResult.done && traceResult.code == 200) {
+    // Check it the way tools/decode_trace.py reads it
+    const std::string &t = traceResult.body;
+    TraceHeader h = {};
+    if (t.size() >= sizeof(h)) memcpy(&h, t.data(), sizeof(h));
+    traceOk = memcmp(h.magic, "SFTR", 4) == 0 && t.size() == sizeof(h) + h.count * sizeof(TraceEvent);
+    uint32_t steps = 0;
+    for (uint32_t i = 0; traceOk && i < h.count; i++) {
+      TraceEvent e;
+      memcpy(&e, t.data() + sizeof(h) + i * sizeof(e), sizeof(e));
+      steps += e.type == TRACE_STEP;
+    }
+    printf("http /trace:      %zu bytes, %u events (%u steps), %u overwritten\n", t.size(), (unsigned)h.count, (unsigned)steps, (unsigned)h.dropped);
+    if (opt.traceFile) {
+      FILE *f = fopen(opt.traceFile, "wb");
+      if (f) { fwrite(t.data(), 1, t.size(), f); fclose(f); }
+    }
+  }
+  bool otaOk = true;
+  if (opt.ota) {
+    bool intact = Update.installed() && Update.image() == otaExpected;
+    printf("ota:              wrong digest -> %d \"%s\"; upload of %zu bytes -> %d \"%s\", %zu bytes %s\n", otaBadResult.code,
+           otaBadResult.body.c_str(), otaImage.size(), otaGoodResult.code, otaGoodResult.body.c_str(), Update.image().size(),
+           intact ? "installed intact" : "NOT INSTALLED INTACT");
+    otaOk = otaBadResult.code == 400 && otaGoodResult.code == 200 && intact &&
+            sim::stopReason() && strcmp(sim::stopReason(), "ESP.restart()") == 0;
+  }
+  if (opt.otaTrial) {
+    bool confirmed = otaTrialProbe.body.find("\"ota_trial\":false") != std::string::npos;
+    printf("ota trial:        %s after 60 s (%u homings), %u rollbacks\n", confirmed ? "confirmed" : "NOT CONFIRMED",
+           homings, (unsigned)sim::stats().bootSwitches);
+    otaOk &= confirmed && homings > 0 && sim::stats().bootSwitches == 0;
+  }
+  if (opt.calibrateAt >= 0) printf("calibration:      %s, last homing \"%s\"\n", calibrateResult.done ? "requested" : "never served", lastHomingStatus);
+  sim::ServiceStats &ss = sim::stats();
+  printf("adc:              %llu samples, %llu DMA overruns; %u late timer alarms\n",
+         (unsigned long long)ss.adcSamples, (unsigned long long)ss.adcOverruns, ss.lateAlarms);
+
+  bool ok = true;
+  sim::WatchdogStats wdt[8];
+  int nw = sim::watchdogStats(wdt, 8);
+  for (int i = 0; i < nw; i++) {
+    bool starved = wdt[i].worstGapUs > sim::watchdogTimeoutUs();
+    printf("watchdog %-9s worst gap %.1f ms%s\n", wdt[i].task, wdt[i].worstGapUs / 1000.0, starved ? "  ** STARVED **" : "");
+    ok &= !starved;
+  }
+
+  ok &= opt.ota || sim::stopReason() == nullptr;  // --ota ends in the update's restart
+  ok &= otaOk;
+  ok &= staleIncidents == 0 && homingErrors == 0 && httpErrors == 0;
+  ok &= metricsResult.done && metricsResult.code == 200;
+  ok &= traceOk;
+  ok &= colonHalfMs.maxv() <= COLON_BLINK_MS + 1;  // Blink timed by hardware, not by loop()
+  ok &= arrivalSkewMs.maxv() <= MAX_ARRIVAL_SKEW_MS;
+  // Woken for each of them; a missed wake is caught by the next timeout
+  ok &= std::max({ minuteLateMs.maxv(), dateLateMs.maxv(), blinkLateMs.maxv() }) <= MAX_SLEEP_MS;
+  ok &= worstErrorSteps[0] <= opt.maxErrorSteps && worstErrorSteps[1] <= opt.maxErrorSteps;
+  printf("result:           %s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+#include <Arduino.h>
+#include <lwip/sockets.h>
+#include <unistd.h>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include "SimWorld.h"
+
+// ==========================================
+//  Sockets (lwIP stand-in)
+// ==========================================
+namespace sim {
+static std::vector<void *> selectWaiters;  // Tasks asleep in lwip_select()
+static int listenPort = 0;                 // Host port the firmware's server got
+static int servePort = 0;                  // Asked for with serveOn(), else any free one
+
+int httpPort() { return listenPort; }
+void serveOn(int port) { servePort = port; }
+
+// Something changed on a simulated socket: every task in select() looks again
+static void socketActivity() {
+  std::vector<void *> waiters = selectWaiters;
+  for (void *task : waiters) notifyGive(task);
+}
+}
+
+int lwip_socket(int domain, int type, int protocol) { return ::socket(domain, type, protocol); }
+
+int lwip_bind(int s, const struct sockaddr *name, socklen_t namelen) {
+  (void)namelen;
+  struct sockaddr_in addr = *(const struct sockaddr_in *)name;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(sim::servePort);
+  if (::bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0) return -1;
+  socklen_t len = sizeof(addr);
+  ::getsockname(s, (struct sockaddr *)&addr, &len);
+  sim::listenPort = ntohs(addr.sin_port);
+  return 0;
+}
+
+int lwip_listen(int s, int backlog) { return ::listen(s, backlog); }
+int lwip_accept(int s, struct sockaddr *addr, socklen_t *addrlen) { return ::accept(s, addr, addrlen); }
+
+int lwip_connect(int s, const struct sockaddr *name, socklen_t namelen) {
+  int r = ::connect(s, name, namelen);
+  sim::socketActivity();
+  return r;
+}
+
+ssize_t lwip_recv(int s, void *mem, size_t len, int flags) {
+  ssize_t n = ::recv(s, mem, len, flags);
+  if (n > 0 && !(flags & MSG_PEEK)) sim::socketActivity();  // Room for the sender again
+  return n;
+}
+
+ssize_t lwip_send(int s, const void *data, size_t size, int flags) {
+  ssize_t n = ::send(s, data, size, flags | MSG_NOSIGNAL);  // lwIP has no SIGPIPE
+  if (n > 0) sim::socketActivity();
+  return n;
+}
+
+int lwip_close(int s) {
+  int r = ::close(s);
+  sim::socketActivity();
+  return r;
+}
+
+int lwip_fcntl(int s, int cmd, int val) { return ::fcntl(s, cmd, val); }
+
+int lwip_setsockopt(int s, int level, int optname, const void *optval, socklen_t optlen) {
+  return ::setsockopt(s, level, optname, optval, optlen);
+}
+
+int lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptset, struct timeval *timeout) {
+  fd_set r, w, e;
+  if (readset) r = *readset;
+  if (writeset) w = *writeset;
+  if (exceptset) e = *exceptset;
+  uint64_t deadline = timeout ? sim::nowUs() + (uint64_t)timeout->tv_sec * 1000000 + timeout->tv_usec : UINT64_MAX;
+  for (;;) {
+    if (readset) *readset = r;
+    if (writeset) *writeset = w;
+    if (exceptset) *exceptset = e;
+    struct timeval now = { 0, 0 };
+    int ready = ::select(maxfdp1, readset, writeset, exceptset, &now);
+    if (ready != 0 || sim::nowUs() >= deadline) return ready;
+    // Sockets of the simulation wake us; real clients (--serve) are only
+    // seen by looking again every millisecond
+    uint64_t wait = deadline - sim::nowUs();
+    if (sim::realTime() && wait > 1000) wait = 1000;
+    void *self = sim::currentTask();
+    sim::selectWaiters.push_back(self);
+    sim::notifyTake(true, wait);
+    sim::selectWaiters.erase(std::find(sim::selectWaiters.begin(), sim::selectWaiters.end(), self));
+  }
+}
+
+// ==========================================
+//  HTTP client (harness requests)
+// ==========================================
+// Requests go to the firmware's server over keep-alive connections, from a
+// task of their own, so they are parsed and answered like a browser's.
+namespace sim {
+struct ClientRequest { std::string bytes; HttpResult *result; };
+
+struct ClientConnection {
+  int fd = -1;
+  bool busy = false;
+  bool reused = false;        // Served a request before: the server may have closed it
+  ClientRequest req;
+  size_t sent = 0;
+  std::string in;
+  std::chrono::steady_clock::time_point started;
+};
+
+static const int CLIENT_CONNECTIONS = 8;
+static std::deque<ClientRequest> queuedRequests;
+static ClientConnection clientConnections[CLIENT_CONNECTIONS];
+static void *clientTask = nullptr;
+static int wakeFds[2] = { -1, -1 };  // enqueue() -> clientLoop(): new requests to send
+
+static std::string urlEncode(const std::string &s) {
+  static const char HEX[] = "0123456789ABCDEF";
+  std::string out;
+  for (unsigned char c : s) {
+    if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') out += (char)c;
+    else { out += '%'; out += HEX[c >> 4]; out += HEX[c & 15]; }
+  }
+  return out;
+}
+
+static std::string target(const char *uri, const std::map<std::string, std::string> &args) {
+  std::string t = uri;
+  char sep = '?';
+  for (auto &kv : args) { t += sep; t += urlEncode(kv.first) + "=" + urlEncode(kv.second); sep = '&'; }
+  return t;
+}
+
+static std::string headerValue(const std::string &head, const char *name) {
+  std::string lower = head;
+  for (char &c : lower) c = tolower(c);
+  size_t at = lower.find(std::string("\r\n") + name + ":");
+  if (at == std::string::npos) return "";
+  at += strlen(name) + 3;
+  size_t eol = head.find("\r\n", at);
+  std::string v = head.substr(at, eol - at);
+  v.erase(0, v.find_first_not_of(' '));
+  return v;
+}
+
+static void closeClient(ClientConnection &c) {
+  if (c.fd >= 0) lwip_close(c.fd);
+  c.fd = -1;
+  c.reused = false;
+  c.in.clear();
+}
+
+static bool openClient(ClientConnection &c) {
+  c.fd = lwip_socket(AF_INET, SOCK_STREAM, 0);
+  if (c.fd < 0) return false;
+  lwip_fcntl(c.fd, F_SETFL, O_NONBLOCK);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(listenPort);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (lwip_connect(c.fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 && errno != EINPROGRESS) { closeClient(c); return false; }
+  return true;
+}
+
+// Whole response in c.in (closed: the server hung up)? Fills the result.
+static bool parseResponse(ClientConnection &c, bool closed) {
+  for (;;) {
+    size_t headEnd = c.in.find("\r\n\r\n");
+    if (headEnd == std::string::npos) return false;
+    std::string head = c.in.substr(0, headEnd);
+    int code = c.in.size() > 12 ? atoi(c.in.c_str() + 9) : 0;
+    if (code == 100) { c.in.erase(0, headEnd + 4); continue; }  // Continue, the answer follows
+
+    std::string body;
+    size_t end;
+    if (headerValue(head, "transfer-encoding") == "chunked") {
+      size_t at = headEnd + 4;
+      for (;;) {
+        size_t eol = c.in.find("\r\n", at);
+        if (eol == std::string::npos) return false;
+        size_t len = strtoul(c.in.c_str() + at, nullptr, 16);
+        if (c.in.size() < eol + 2 + len + 2) return false;
+        body.append(c.in, eol + 2, len);
+        at = eol + 2 + len + 2;
+        if (!len) break;
+      }
+      end = at;
+    } else if (!headerValue(head, "content-length").empty()) {
+      size_t len = strtoul(headerValue(head, "content-length").c_str(), nullptr, 10);
+      if (c.in.size() < headEnd + 4 + len) return false;
+      body = c.in.substr(headEnd + 4, len);
+      end = headEnd + 4 + len;
+    } else {
+      if (!closed) return false;  // Ends with the connection
+      body = c.in.substr(headEnd + 4);
+      end = c.in.size();
+    }
+    HttpResult *r = c.req.result;
+    r->code = code;
+    r->contentType = headerValue(head, "content-type");
+    r->body = body;
+    r->hostUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - c.started).count();
+    r->done = true;
+    stats().httpServed++;
+    c.in.erase(0, end);
+    c.busy = false;
+    c.reused = true;
+    if (headerValue(head, "connection") == "close") closeClient(c);
+    return true;
+  }
+}
+
+static void failRequest(ClientConnection &c) {
+  if (c.reused && c.in.empty()) {
+    // Kept-alive connection the server had closed meanwhile: a fresh one
+    queuedRequests.push_front(c.req);
+  } else {
+    c.req.result->code = 0;
+    c.req.result->done = true;
+  }
+  c.busy = false;
+  closeClient(c);
+}
+
+static void clientLoop(void *) {
+  static char buf[65536];
+  for (;;) {
+    // Requests made before the server listens wait for it, as on a real network
+    for (ClientConnection &c : clientConnections) {
+      if (queuedRequests.empty() || !listenPort) break;
+      if (c.busy || (c.fd < 0 && !openClient(c))) continue;
+      c.req = queuedRequests.front();
+      queuedRequests.pop_front();
+      c.busy = true;
+      c.sent = 0;
+      c.started = std::chrono::steady_clock::now();
+    }
+
+    fd_set rd, wr;
+    FD_ZERO(&rd); FD_ZERO(&wr);
+    FD_SET(wakeFds[0], &rd);
+    int maxFd = wakeFds[0];
+    for (ClientConnection &c : clientConnections) {
+      if (c.fd < 0) continue;
+      FD_SET(c.fd, &rd);
+      if (c.busy && c.sent < c.req.bytes.size()) FD_SET(c.fd, &wr);
+      maxFd = std::max(maxFd, c.fd);
+    }
+    struct timeval tv = { 1, 0 };
+    lwip_select(maxFd + 1, &rd, &wr, nullptr, &tv);
+    if (FD_ISSET(wakeFds[0], &rd)) while (lwip_recv(wakeFds[0], buf, sizeof(buf), MSG_DONTWAIT) > 0) {}
+
+    for (ClientConnection &c : clientConnections) {
+      if (c.fd < 0) continue;
+      if (c.busy && FD_ISSET(c.fd, &wr)) {
+        ssize_t n = lwip_send(c.fd, c.req.bytes.data() + c.sent, c.req.bytes.size() - c.sent, MSG_DONTWAIT);
+        if (n > 0) c.sent += n;
+        else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) { failRequest(c); continue; }
+      }
+      if (!FD_ISSET(c.fd, &rd)) continue;
+      bool closed = false;
+      for (;;) {
+        ssize_t n = lwip_recv(c.fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n > 0) { c.in.append(buf, n); continue; }
+        closed = n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+        break;
+      }
+      if (c.busy && !parseResponse(c, closed) && closed) failRequest(c);
+      else if (closed) closeClient(c);
+    }
+  }
+}
+
+static void enqueue(std::string bytes, HttpResult *result) {
+  *result = HttpResult();
+  queuedRequests.push_back({ std::move(bytes), result });
+  if (!clientTask) {
+    ::socketpair(AF_UNIX, SOCK_STREAM, 0, wakeFds);
+    clientTask = createTask(clientLoop, "httpclient", nullptr, 1);
+  } else {
+    lwip_send(wakeFds[1], "", 1, MSG_DONTWAIT);
+  }
+}
+
+void httpRequest(const char *method, const char *uri, const std::map<std::string, std::string> &args, HttpResult *result) {
+  std::string req = std::string(method) + " " + target(uri, args) + " HTTP/1.1\r\nHost: clock\r\n";
+  if (strcmp(method, "GET") != 0) req += "Content-Length: 0\r\n";
+  enqueue(req + "\r\n", result);
+}
+
+void httpJson(const char *method, const char *uri, const std::string &json, HttpResult *result) {
+  std::string req = std::string(method) + " " + uri + " HTTP/1.1\r\nHost: clock\r\n"
+    "Content-Type: application/json\r\nContent-Length: " + std::to_string(json.size()) + "\r\n\r\n";
+  enqueue(req + json, result);
+}
+
+void httpUpload(const char *uri, const std::map<std::string, std::string> &args, const std::string &body, HttpResult *result) {
+  static const char BOUNDARY[] = "----SimClockUpload";
+  std::string part = std::string("--") + BOUNDARY + "\r\n"
+    "Content-Disposition: form-data; name=\"update\"; filename=\"firmware.bin\"\r\n"
+    "Content-Type: application/octet-stream\r\n\r\n" + body + "\r\n--" + BOUNDARY + "--\r\n";
+  std::string req = "POST " + target(uri, args) + " HTTP/1.1\r\nHost: clock\r\n"
+    "Content-Type: multipart/form-data; boundary=" + BOUNDARY + "\r\n"
+    "Content-Length: " + std::to_string(part.size()) + "\r\n\r\n";
+  enqueue(req + part, result);
+}
+}  // namespace sim
@@ -0,0 +1,348 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include <Preferences.h>
+#include <WiFiManager.h>
+#include <ESPmDNS.h>
+#include <ArduinoOTA.h>
+#include <Update.h>
+#include <esp_ota_ops.h>
+#include <mbedtls/sha256.h>
+#include <sntp.h>
+#include <stdarg.h>
+#include <sys/time.h>
+#include <chrono>
+#include "SimWorld.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+MDNSResponder MDNS;
+ArduinoOTAClass ArduinoOTA;
+UpdateClass Update;
+
+// ==========================================
+//  Wall clock + SNTP
+// ==========================================
+namespace sim {
+static int64_t bootEpoch = 1772924400;  // Overridden by setEpoch()
+static bool synced = false;
+static bool sntpStarted = false;
+static uint32_t sntpDelayMs = 1500;
+static sntp_sync_time_cb_t sntpCallback = nullptr;
+static bool wifiConnected = false;
+
+void setEpoch(int64_t epoch) { bootEpoch = epoch; }
+void setSntpDelayMs(uint32_t ms) { sntpDelayMs = ms; }
+bool timeSynced() { return synced; }
+
+// Before SNTP lands the RTC counts from 1970, exactly like the chip
+int64_t wallClock() { return (synced ? bootEpoch : 0) + (int64_t)(nowUs() / 1000000); }
+}
+
+// The firmware calls time() and gettimeofday() directly; route them to the
+// virtual clock
+extern "C" time_t time(time_t *out) noexcept {
+  time_t t = (time_t)sim::wallClock();
+  if (out) *out = t;
+  return t;
+}
+
+extern "C" int gettimeofday(struct timeval *__restrict tv, void *__restrict tz) noexcept {
+  (void)tz;
+  tv->tv_sec = (time_t)sim::wallClock();
+  tv->tv_usec = (suseconds_t)(sim::nowUs() % 1000000);
+  return 0;
+}
+
+namespace sim {
+// The first request goes out once the station is associated
+static void scheduleSntp() {
+  if (!wifiConnected) { at(nowUs() + 100000, scheduleSntp); return; }
+  at(nowUs() + (uint64_t)sntpDelayMs * 1000, []() {
+    synced = true; stats().sntpSyncs++;
+    if (sntpCallback) { struct timeval tv; gettimeofday(&tv, nullptr); sntpCallback(&tv); }
+  });
+}
+}
+
+void configTzTime(const char *tz, const char *server1, const char *server2, const char *server3) {
+  (void)server1; (void)server2; (void)server3;
+  setenv("TZ", tz, 1);
+  tzset();
+  if (sim::sntpStarted) return;
+  sim::sntpStarted = true;
+  sim::scheduleSntp();
+}
+
+bool getLocalTime(struct tm *info, uint32_t ms) {
+  uint32_t start = millis();
+  while ((millis() - start) <= ms) {
+    time_t now = time(nullptr);
+    localtime_r(&now, info);
+    if (info->tm_year > (2016 - 1900)) return true;
+    delay(10);
+  }
+  return false;
+}
+
+bool sntp_enabled() { return sim::sntpStarted; }
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) { sim::sntpCallback = callback; }
+sntp_sync_status_t sntp_get_sync_status() { return sim::synced ? SNTP_SYNC_STATUS_COMPLETED : SNTP_SYNC_STATUS_RESET; }
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+long random(long max) { return max > 0 ? (long)(sim::random32() % (uint32_t)max) : 0; }
+long random(long min, long max) { return max > min ? min + random(max - min) : min; }
+
+// ==========================================
+//  Serial / ESP
+// ==========================================
+namespace sim {
+static bool serialEcho = false;
+static std::string serialLine;
+void setSerialEcho(bool on) { serialEcho = on; }
+
+static size_t serialWrite(const char *s, bool newline) {
+  serialLine += s;
+  if (newline) {
+    if (serialEcho) {
+      uint64_t ms = nowUs() / 1000;
+      printf("[%8llu.%03llu] %s\n", (unsigned long long)(ms / 1000), (unsigned long long)(ms % 1000), serialLine.c_str());
+    }
+    serialLine.clear();
+  }
+  return strlen(s) + (newline ? 1 : 0);
+}
+}
+
+void HardwareSerial::begin(unsigned long baud) { (void)baud; }
+size_t HardwareSerial::print(const String &s) { return sim::serialWrite(s.c_str(), false); }
+size_t HardwareSerial::print(const char *s) { return sim::serialWrite(s, false); }
+size_t HardwareSerial::print(long v) { return print(String(v)); }
+size_t HardwareSerial::println(const String &s) { return sim::serialWrite(s.c_str(), true); }
+size_t HardwareSerial::println(const char *s) { return sim::serialWrite(s, true); }
+size_t HardwareSerial::println(long v) { return println(String(v)); }
+size_t HardwareSerial::println() { return sim::serialWrite("", true); }
+size_t HardwareSerial::printf(const char *fmt, ...) {
+  char buf[256];
+  va_list args; va_start(args, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  // Split on newlines so the timestamps stay per line
+  char *line = buf; char *nl;
+  while ((nl = strchr(line, '\n'))) { *nl = 0; sim::serialWrite(line, true); line = nl + 1; }
+  if (*line) sim::serialWrite(line, false);
+  return strlen(buf);
+}
+
+void EspClass::restart() {
+  sim::stats().restarts++;
+  sim::stop("ESP.restart()");
+  if (sim::inTask()) sim::sleepUntil(UINT64_MAX);
+}
+uint32_t EspClass::getFreeHeap() { return 200000; }
+uint32_t EspClass::getMinFreeHeap() { return 180000; }
+uint32_t EspClass::getMaxAllocHeap() { return 110000; }
+uint32_t EspClass::getCpuFreqMHz() { return 240; }
+// Host time scaled to a 240 MHz cycle count: only used to measure code cost,
+// which virtual time knows nothing about
+uint32_t EspClass::getCycleCount() {
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+  return (uint32_t)(ns.count() * 240 / 1000);
+}
+
+// ==========================================
+//  WiFi
+// ==========================================
+
+String IPAddress::toString() const {
+  char b[16]; snprintf(b, sizeof(b), "%u.%u.%u.%u", _b[0], _b[1], _b[2], _b[3]);
+  return String(b);
+}
+
+IPAddress WiFiClass::localIP() { return sim::wifiConnected ? IPAddress(192, 168, 1, 42) : IPAddress(); }
+String WiFiClass::SSID() { return sim::wifiConnected ? String("SimNet") : String(); }
+int WiFiClass::status() { return sim::wifiConnected ? WL_CONNECTED : WL_DISCONNECTED; }
+
+// Slow drift across the "Good"/"Fair" boundary so RSSI buckets do change
+int8_t WiFiClass::RSSI() {
+  if (!sim::wifiConnected) return 0;
+  double hours = sim::nowUs() / 3.6e9;
+  return (int8_t)lround(-60 + 8 * sin(hours * 2 * M_PI / 5));
+}
+
+// Association + DHCP with the saved credentials
+static const uint64_t WIFI_ASSOCIATE_US = 2000000;
+
+int WiFiClass::begin() {
+  sim::at(sim::nowUs() + WIFI_ASSOCIATE_US, []() { sim::wifiConnected = true; });
+  return WL_DISCONNECTED;
+}
+
+bool WiFiManager::autoConnect(const char *apName) {
+  (void)apName;
+  delay(WIFI_ASSOCIATE_US / 1000);
+  sim::wifiConnected = true;
+  return true;
+}
+
+// ==========================================
+//  Preferences (NVS)
+// ==========================================
+namespace sim {
+struct NvsValue { bool isString; int32_t i; std::string s; };
+static std::map<std::string, std::map<std::string, NvsValue>> nvs;
+
+void nvsSet(const char *ns, const char *key, int32_t value) { nvs[ns][key] = { false, value, "" }; }
+void nvsSet(const char *ns, const char *key, const char *value) { nvs[ns][key] = { true, 0, value }; }
+}
+
+bool Preferences::begin(const char *name, bool readOnly) { _ns = name; _open = true; _readOnly = readOnly; return true; }
+void Preferences::end() { _open = false; }
+bool Preferences::clear() { if (!_open || _readOnly) return false; sim::nvs[_ns].clear(); return true; }
+bool Preferences::remove(const char *key) { if (!_open || _readOnly) return false; return sim::nvs[_ns].erase(key) > 0; }
+bool Preferences::isKey(const char *key) { return _open && sim::nvs[_ns].count(key) > 0; }
+
+size_t Preferences::putInt(const char *key, int32_t value) {
+  if (!_open || _readOnly) return 0;
+  sim::nvs[_ns][key] = { false, value, "" };
+  return sizeof(value);
+}
+
+size_t Preferences::putString(const char *key, const String &value) {
+  if (!_open || _readOnly) return 0;
+  sim::nvs[_ns][key] = { true, 0, value.c_str() };
+  return value.length();
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) {
+  if (!_open || _readOnly) return 0;
+  sim::nvs[_ns][key] = { true, 0, std::string(static_cast<const char *>(value), len) };
+  return len;
+}
+
+int32_t Preferences::getInt(const char *key, int32_t defaultValue) {
+  if (!_open) return defaultValue;
+  auto it = sim::nvs[_ns].find(key);
+  return (it == sim::nvs[_ns].end() || it->second.isString) ? defaultValue : it->second.i;
+}
+
+String Preferences::getString(const char *key, const String &defaultValue) {
+  if (!_open) return defaultValue;
+  auto it = sim::nvs[_ns].find(key);
+  return (it == sim::nvs[_ns].end() || !it->second.isString) ? defaultValue : String(it->second.s);
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+  if (!_open) return 0;
+  auto it = sim::nvs[_ns].find(key);
+  return (it == sim::nvs[_ns].end() || !it->second.isString) ? 0 : it->second.s.size();
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+  size_t len = getBytesLength(key);
+  if (len == 0 || len > maxLen) return 0;
+  memcpy(buf, sim::nvs[_ns][key].s.data(), len);
+  return len;
+}
+
+// ==========================================
+//  OTA partitions
+// ==========================================
+namespace sim {
+static const esp_partition_t appSlots[2] = { { "app0", 0x10000, 0x140000 }, { "app1", 0x150000, 0x140000 } };
+static std::string runningImage;
+
+void setRunningImage(const std::string &image) { runningImage = image; }
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t offset, void *dst, size_t size) {
+  if (partition != &sim::appSlots[0] || offset + size > partition->size) return ESP_ERR_INVALID_SIZE;
+  memset(dst, 0xFF, size);
+  if (offset < sim::runningImage.size()) {
+    memcpy(dst, sim::runningImage.data() + offset, std::min(size, sim::runningImage.size() - offset));
+  }
+  return ESP_OK;
+}
+
+const esp_partition_t *esp_ota_get_running_partition() { return &sim::appSlots[0]; }
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *start) { (void)start; return &sim::appSlots[1]; }
+esp_err_t esp_ota_get_state_partition(const esp_partition_t *partition, esp_ota_img_states_t *state) {
+  (void)partition; (void)state;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *partition) { (void)partition; sim::stats().bootSwitches++; return ESP_OK; }
+esp_err_t esp_ota_mark_app_valid_cancel_rollback() { return ESP_OK; }
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot() { return ESP_FAIL; }
+
+// ==========================================
+//  SHA-256 (FIPS 180-4)
+// ==========================================
+namespace sim {
+static const uint32_t SHA_K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t ror(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+static void shaBlock(uint32_t state[8], const uint8_t *p) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++) w[i] = (uint32_t)p[4 * i] << 24 | (uint32_t)p[4 * i + 1] << 16 | (uint32_t)p[4 * i + 2] << 8 | p[4 * i + 3];
+  for (int i = 16; i < 64; i++) {
+    uint32_t s0 = ror(w[i - 15], 7) ^ ror(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = ror(w[i - 2], 17) ^ ror(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+  for (int i = 0; i < 64; i++) {
+    uint32_t t1 = h + (ror(e, 6) ^ ror(e, 11) ^ ror(e, 25)) + ((e & f) ^ (~e & g)) + SHA_K[i] + w[i];
+    uint32_t t2 = (ror(a, 2) ^ ror(a, 13) ^ ror(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+    h = g; g = f; f = e; e = d + t1; d = c; c = b; b = a; a = t1 + t2;
+  }
+  state[0] += a; state[1] += b; state[2] += c; state[3] += d; state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context *ctx) { memset(ctx, 0, sizeof(*ctx)); }
+void mbedtls_sha256_free(mbedtls_sha256_context *ctx) { memset(ctx, 0, sizeof(*ctx)); }
+
+int mbedtls_sha256_starts_ret(mbedtls_sha256_context *ctx, int is224) {
+  static const uint32_t init[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+  (void)is224;
+  memcpy(ctx->state, init, sizeof(init));
+  ctx->total = 0;
+  return 0;
+}
+
+int mbedtls_sha256_update_ret(mbedtls_sha256_context *ctx, const unsigned char *input, size_t ilen) {
+  while (ilen) {
+    size_t used = ctx->total & 63, n = std::min<size_t>(64 - used, ilen);
+    memcpy(ctx->buffer + used, input, n);
+    ctx->total += n; input += n; ilen -= n;
+    if ((ctx->total & 63) == 0) sim::shaBlock(ctx->state, ctx->buffer);
+  }
+  return 0;
+}
+
+int mbedtls_sha256_finish_ret(mbedtls_sha256_context *ctx, unsigned char output[32]) {
+  uint64_t bits = ctx->total * 8;
+  uint8_t pad[72] = { 0x80 };
+  size_t used = ctx->total & 63;
+  size_t padLen = (used < 56 ? 56 : 120) - used;
+  for (int i = 0; i < 8; i++) pad[padLen + i] = (uint8_t)(bits >> (56 - 8 * i));
+  mbedtls_sha256_update_ret(ctx, pad, padLen + 8);
+  for (int i = 0; i < 8; i++) {
+    output[4 * i] = ctx->state[i] >> 24; output[4 * i + 1] = ctx->state[i] >> 16;
+    output[4 * i + 2] = ctx->state[i] >> 8; output[4 * i + 3] = ctx->state[i];
+  }
+  return 0;
+}
@@ -0,0 +1,313 @@
+#include <Arduino.h>
+#include <stdarg.h>
+#include <vector>
+#include "SimWorld.h"
+#include "StepperAxis.h"
+#include "HallSampler.h"
+#include "MagnetEstimator.h"
+
+// ==========================================
+//          FIRMWARE UNIT TESTS
+// ==========================================
+// Checks of single firmware classes against their own contracts, on the
+// same virtual hardware as the clock run: program --test. Prints one line
+// per check and exits non-zero if any failed.
+
+namespace simtests {
+
+static int checks = 0, failures = 0;
+
+static void check(bool ok, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static void check(bool ok, const char *fmt, ...) {
+  char buf[256];
+  va_list args; va_start(args, fmt); vsnprintf(buf, sizeof(buf), fmt, args); va_end(args);
+  printf("  %-4s %s\n", ok ? "ok" : "FAIL", buf);
+  checks++; failures += !ok;
+}
+
+// ------------------------------------------
+//  StepperAxis
+// ------------------------------------------
+// The axis drives the hours spool's pins from a timer the clock leaves
+// free. The spool stamps every step it takes, so a move is a list of step
+// times read back from its position history.
+static const int TEST_TIMER = 3;
+static StepperAxis axis;
+
+struct Step { uint64_t us; long position; };
+static std::vector<Step> steps;
+static uint32_t stepsSeen = 0;
+
+static void recordSteps() { steps.clear(); stepsSeen = sim::spool(0).histCount; }
+
+// Called often enough that the history ring never laps
+static void collectSteps() {
+  const sim::Spool &s = sim::spool(0);
+  for (; stepsSeen < s.histCount; stepsSeen++) {
+    uint32_t slot = stepsSeen % sim::Spool::HISTORY;
+    steps.push_back({ s.histUs[slot], s.histPos[slot] });
+  }
+}
+
+static void waitIdle() {
+  while (axis.isRunning()) { sim::sleepFor(1000); collectSteps(); }
+  collectSteps();
+}
+
+// Each step's delay against the table: accel, cruise and decel all come
+// out of the ISR exactly as MotionProfile::interval() gives them
+static void checkProfileMove(const char *name, long distance) {
+  const MotionProfile &p = axis.profile();
+  uint32_t total = (uint32_t)labs(distance), ramp = p.rampLength();
+  recordSteps();
+  uint64_t startUs = sim::nowUs();
+  long startPos = axis.currentPosition();
+  axis.move(distance);
+  waitIdle();
+
+  uint32_t bad[3] = { 0, 0, 0 }, seen[3] = { 0, 0, 0 };
+  uint64_t prevUs = startUs;
+  for (uint32_t i = 0; i < steps.size() && i < total; i++) {
+    int seg = (i < ramp && i < total - 1 - i) ? 0 : (total - 1 - i < ramp) ? 2 : 1;
+    seen[seg]++;
+    if (steps[i].us - prevUs != p.interval(i, total)) bad[seg]++;
+    if (seg == 1 && p.interval(i, total) != p.cruiseInterval()) bad[seg]++;
+    prevUs = steps[i].us;
+  }
+  check(steps.size() == total && axis.currentPosition() == startPos + distance && sim::spool(0).position == axis.currentPosition(),
+        "%s: %zu of %u steps, ends at %ld", name, steps.size(), (unsigned)total, axis.currentPosition());
+  check(bad[0] == 0 && bad[1] == 0 && bad[2] == 0,
+        "%s: intervals match the table (accel %u/%u, cruise %u/%u, decel %u/%u off)", name,
+        (unsigned)bad[0], (unsigned)seen[0], (unsigned)bad[1], (unsigned)seen[1], (unsigned)bad[2], (unsigned)seen[2]);
+}
+
+// A stretched move ends on the requested tick, the delay included
+static void checkPreparedMove() {
+  const MotionProfile &p = axis.profile();
+  const uint32_t distance = 300, delay = 5000;
+  uint32_t duration = p.moveTicks(distance) * 3 / 2;
+  recordSteps();
+  uint64_t startUs = sim::nowUs();
+  axis.prepareMove(distance, duration, delay);
+  axis.startPrepared();
+  waitIdle();
+  int64_t endUs = steps.empty() ? 0 : (int64_t)(steps.back().us - startUs);
+  check(steps.size() == distance && endUs == (int64_t)duration + delay,
+        "stretched move: last step after %lld us, asked for %u", (long long)endUs, (unsigned)(duration + delay));
+}
+
+// A move the other way mid-accel ramps down along the table before turning
+static void checkReversal() {
+  const MotionProfile &p = axis.profile();
+  uint32_t ramp = p.rampLength();
+  long start = axis.currentPosition();
+  recordSteps();
+  axis.move(4 * ramp);
+  while (axis.currentPosition() < start + (long)ramp / 2) { sim::sleepFor(100); collectSteps(); }
+  long turnAt = axis.currentPosition();
+  uint32_t done = (uint32_t)(turnAt - start), decel = (done < ramp) ? done : ramp;
+  long target = turnAt - 200;
+  axis.move(-200);
+  check(axis.targetPosition() == target, "reversal: target %ld while ramping down, asked for %ld",
+        axis.targetPosition(), target);
+  waitIdle();
+
+  // steps[done] was armed before the reversal; the rest is decel, then a
+  // fresh move of the remaining distance from its first table entry
+  long peak = start; uint32_t bad = 0;
+  for (uint32_t i = done + 1; i < done + decel && i < steps.size(); i++) {
+    if (steps[i].us - steps[i - 1].us != p.interval(i, done + decel)) bad++;
+  }
+  for (const Step &st : steps) peak = std::max(peak, st.position);
+  uint32_t back = (uint32_t)(turnAt + decel - target);
+  uint32_t turn = done + decel;
+  bool fresh = steps.size() > turn && steps[turn].us - steps[turn - 1].us == p.interval(0, back) &&
+               steps[turn].position == peak - 1;
+  for (uint32_t i = turn + 1; i < steps.size(); i++) {
+    if (steps[i].us - steps[i - 1].us != p.interval(i - turn, back)) bad++;
+  }
+  check(peak == turnAt + (long)decel, "reversal: turned at %ld after %u decel steps, expected %ld",
+        peak, (unsigned)decel, turnAt + (long)decel);
+  check(fresh && bad == 0, "reversal: way back starts from standstill, %u intervals off the table", (unsigned)bad);
+  check(axis.currentPosition() == target && sim::spool(0).position == target, "reversal: ends at %ld, spool at %ld",
+        axis.currentPosition(), sim::spool(0).position);
+}
+
+static void stepperTests() {
+  printf("StepperAxis\n");
+  sim::SpoolConfig cfg = { "hours", { 26, 33, 25, 32 }, 7, 2048, 700.3, 0, 1830, 1200, 25 };
+  sim::configureSpool(0, cfg);
+  axis.begin(TEST_TIMER, 26, 33, 25, 32);
+  axis.setMaxSpeed(1000); axis.setAcceleration(2000); axis.setJerk(40000);
+  axis.enableOutputs();
+  uint32_t ramp = axis.profile().rampLength();
+  check(ramp > 0, "profile: %u ramp steps, cruise %u us", (unsigned)ramp, (unsigned)axis.profile().cruiseInterval());
+  checkProfileMove("long move", 2 * ramp + 400);
+  checkProfileMove("short move", ramp);
+  checkProfileMove("backwards", -(long)ramp / 3);
+  checkPreparedMove();
+  checkReversal();
+}
+
+// ------------------------------------------
+//  MagnetEstimator
+// ------------------------------------------
+// Synthetic passes use the simulated spool's field shape: a Gaussian of
+// sigma 25 steps, 1200 LSB over a 1830 baseline, sampled twice per step as
+// homing does at 500 steps/s and 1 kHz
+static const int EST_BASELINE = 1830, EST_THRESHOLD = 300;
+static const int CLOCK_THRESHOLD = 807;  // sensorThreshold() at the default sensitivity
+
+struct Pass {
+  double center = 700.3, amplitude = 1200, width = 25;
+  int32_t from = 500, to = 900;
+  int perStep = 2;
+  int noise = 0;
+  uint32_t seed = 1;
+};
+
+static uint16_t passValue(const Pass &p, int32_t position, uint32_t &rng) {
+  double d = (position - p.center) / p.width;
+  int v = (int)lround(EST_BASELINE + p.amplitude * exp(-0.5 * d * d));
+  if (p.noise) { rng = rng * 1664525 + 1013904223; v += (int)((rng >> 8) % (2 * p.noise + 1)) - p.noise; }
+  return (uint16_t)std::min(4095, std::max(0, v));
+}
+
+static MagnetEstimator::State feedPass(MagnetEstimator &est, const Pass &p) {
+  uint32_t rng = p.seed;
+  int dir = (p.to >= p.from) ? 1 : -1;
+  for (int32_t pos = p.from; pos != p.to; pos += dir) {
+    for (int k = 0; k < p.perStep; k++) est.add(pos, passValue(p, pos, rng));
+  }
+  return est.state();
+}
+
+static float estimate(const Pass &p, int threshold = EST_THRESHOLD) {
+  static MagnetEstimator est;
+  est.begin(EST_BASELINE, threshold);
+  return feedPass(est, p) == MagnetEstimator::DONE ? est.center() : NAN;
+}
+
+static void syntheticEstimatorTests() {
+  Pass clean;
+  float c = estimate(clean);
+  check(fabs(c - clean.center) < 0.02, "clean pass: center %.3f, magnet at %.3f", c, clean.center);
+
+  Pass back = clean; back.from = 900; back.to = 500;
+  float b = estimate(back);
+  check(fabs(b - c) < 0.02, "clean pass backwards: center %.3f", b);
+
+  Pass south = clean; south.amplitude = -1200;
+  float sc = estimate(south);
+  check(fabs(sc - clean.center) < 0.02, "south pole (below baseline): center %.3f", sc);
+
+  // Only samples above 25% of the peak count, so the trigger level doesn't move the result
+  float lo = estimate(clean, 150), mid = estimate(clean, CLOCK_THRESHOLD), hi = estimate(clean, 1000);
+  check(fabs(lo - c) < 0.02 && fabs(mid - c) < 0.02 && fabs(hi - c) < 0.02,
+        "threshold 150 / 807 / 1000: center %.3f / %.3f / %.3f", lo, mid, hi);
+
+  // 40 LSB of noise is ten times what the sensors show on the clock
+  double worst = 0; int missed = 0;
+  for (uint32_t seed = 1; seed <= 50; seed++) {
+    Pass noisy = clean; noisy.noise = 40; noisy.seed = seed;
+    noisy.center = 700 + seed * 0.37 - floor(seed * 0.37);
+    float n = estimate(noisy);
+    if (std::isnan(n)) missed++;
+    else worst = std::max(worst, fabs(n - noisy.center));
+  }
+  check(missed == 0 && worst < 0.25, "noisy passes (+-40 LSB, 50 seeds): worst error %.3f steps, %d missed", worst, missed);
+
+  // A magnet strong enough to rail the ADC: the flat top stays symmetric
+  Pass clipped = clean; clipped.amplitude = 3500;
+  float cl = estimate(clipped);
+  check(fabs(cl - clipped.center) < 0.1, "clipped pass (rails at 4095): center %.3f", cl);
+
+  // Parked on the magnet: the half pulse it starts in must not count
+  static MagnetEstimator est;
+  est.begin(EST_BASELINE, EST_THRESHOLD);
+  Pass parked = clean; parked.from = 705;
+  MagnetEstimator::State afterHalf = feedPass(est, parked);
+  Pass next = clean; next.center += 2048; next.from = 900; next.to = 2900;
+  MagnetEstimator::State afterNext = feedPass(est, next);
+  check(afterHalf == MagnetEstimator::WAITING && afterNext == MagnetEstimator::DONE && fabs(est.center() - next.center) < 0.02,
+        "starting on the magnet: skips the half pulse, next pass at %.3f", est.center());
+
+  // The sweep stops inside the pulse: no center from half a pulse
+  est.begin(EST_BASELINE, EST_THRESHOLD);
+  Pass cut = clean; cut.to = 710;
+  MagnetEstimator::State cutState = feedPass(est, cut);
+  check(cutState == MagnetEstimator::CAPTURING, "pass cut off at the center: still capturing (state %d)", (int)cutState);
+
+  // Too slow for the buffer: reported, not estimated from the first part
+  est.begin(EST_BASELINE, EST_THRESHOLD);
+  Pass slow = clean; slow.perStep = 10;
+  MagnetEstimator::State slowState = feedPass(est, slow);
+  check(slowState == MagnetEstimator::OVERFLOW, "pass longer than %d samples: overflow (state %d)",
+        MagnetEstimator::MAX_SAMPLES, (int)slowState);
+}
+
+// Recorded passes: the spool swept past its magnet at homing speed, the
+// hall signal coming through the I2S/DMA sampler with sensor noise, fed to
+// the estimator the way homing does, against where the magnet really is
+static HallSampler sampler;
+
+static float recordedPass(float speed, std::vector<ProfilePoint> &trace) {
+  static MagnetEstimator est;
+  est.begin(EST_BASELINE, CLOCK_THRESHOLD);
+  uint32_t cursor = sampler.sequence(0);
+  axis.runAtSpeed(speed);
+  uint64_t giveUp = sim::nowUs() + 10000000;
+  while (est.state() < MagnetEstimator::DONE && sim::nowUs() < giveUp) {
+    sim::sleepFor(10000);
+    HallSample h;
+    for (uint32_t newest = sampler.sequence(0); cursor < newest; cursor++) {
+      if (!sampler.history(0, cursor, h)) continue;
+      est.add(h.position, h.value);
+    }
+  }
+  axis.halt();
+  trace.assign(est.samples(), est.samples() + est.count());
+  return est.done() ? est.center() : NAN;
+}
+
+static void recordedEstimatorTests() {
+  sim::setAdcNoise(4);
+  sampler.begin(35, &axis, 34, nullptr);
+  sampler.setBaseline(0, EST_BASELINE);
+  sim::sleepFor(100000);
+  const sim::Spool &spool = sim::spool(0);
+  std::vector<ProfilePoint> trace;
+  for (float speed : { 500.0f, -500.0f }) {
+    float c = recordedPass(speed, trace);
+    double magnet = spool.cfg.magnetStep + spool.cfg.stepsPerRev * lround((c - spool.cfg.magnetStep) / spool.cfg.stepsPerRev);
+    check(fabs(c - magnet) < 0.25, "recorded pass at %+.0f steps/s: %zu samples, center %.2f, magnet at %.2f",
+          speed, trace.size(), c, magnet);
+    // Same samples in the other order: the centroid has no direction
+    std::vector<ProfilePoint> reversed(trace.rbegin(), trace.rend());
+    float r = MagnetEstimator::centroid(reversed.data(), (int)reversed.size(), EST_BASELINE);
+    float f = MagnetEstimator::centroid(trace.data(), (int)trace.size(), EST_BASELINE);
+    check(fabs(r - f) < 0.001, "recorded pass replayed backwards: %.3f vs %.3f", r, f);
+  }
+}
+
+static void estimatorTests() {
+  printf("MagnetEstimator\n");
+  syntheticEstimatorTests();
+  recordedEstimatorTests();
+}
+
+static void testTask(void *) {
+  stepperTests();
+  estimatorTests();
+  sim::stop("tests done");
+  for (;;) sim::sleepFor(1000000);
+}
+
+}  // namespace simtests
+
+int runTests() {
+  sim::createTask(simtests::testTask, "tests", nullptr, 1);
+  sim::run(3600000000ULL);
+  printf("%d checks, %d failed\n", simtests::checks, simtests::failures);
+  return simtests::failures ? 1 : 0;
+}
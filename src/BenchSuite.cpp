@@ -0,0 +1,36 @@
+#include "BenchSuite.h"
+
+void BenchSuite::add(const char *name, uint32_t ops, Kernel kernel) {
+  if (_count == MAX_KERNELS) return;
+  _kernels[_count++] = { name, ops, kernel };
+}
+
+int BenchSuite::run(BenchResult *out, int max) const {
+  int n = 0;
+  for (int i = 0; i < _count && n < max; i++) {
+    const Entry &e = _kernels[i];
+    e.kernel(e.ops);  // Warm-up: caches, first-use allocations
+    float best = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+      uint32_t started = ESP.getCycleCount(), elapsed, calls = 0;
+      do { e.kernel(e.ops); calls++; } while ((elapsed = ESP.getCycleCount() - started) < ROUND_CYCLES);
+      float perOp = (float)elapsed / ((float)calls * e.ops);
+      if (round == 0 || perOp < best) best = perOp;
+    }
+    out[n++] = { e.name, e.ops, best };
+  }
+  return n;
+}
+
+void BenchSuite::report(JsonDocument &doc, const char *platform, const BenchResult *results, int n) {
+  uint32_t mhz = ESP.getCpuFreqMHz();
+  doc["platform"] = platform;
+  doc["cpuMHz"] = mhz;
+  JsonObject all = doc["results"].to<JsonObject>();
+  for (int i = 0; i < n; i++) {
+    JsonObject r = all[results[i].name].to<JsonObject>();
+    r["ops"] = results[i].ops;
+    r["cyclesPerOp"] = results[i].cyclesPerOp;
+    r["nsPerOp"] = results[i].cyclesPerOp * 1000.0f / mhz;
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <functional>
+
+// ==========================================
+//        HOT PATH BENCHMARK SUITE
+// ==========================================
+// Named kernels timed in CPU cycles (ESP.getCycleCount()). The firmware
+// registers its hot functions once; GET /bench runs them on the clock and
+// the simulator's --bench runs the very same kernels on the host. A round
+// repeats a kernel for at least ROUND_CYCLES, so even a few-cycle kernel is
+// timed over milliseconds; the fastest of ROUNDS rounds counts, so an
+// interrupt or a WiFi burst landing in one round does not read as a
+// regression.
+// report() gives the machine-readable form tools/bench_compare.py checks
+// against a saved baseline.
+
+struct BenchResult {
+  const char *name;
+  uint32_t ops;          // Operations per round
+  float cyclesPerOp;     // Fastest round
+};
+
+class BenchSuite {
+  public:
+    static const int MAX_KERNELS = 12;
+    static const int ROUNDS = 9;
+    static const uint32_t ROUND_CYCLES = 1200000;  // 5 ms at 240 MHz
+
+    // kernel(ops) performs ops operations of whatever it measures
+    typedef std::function<void(uint32_t ops)> Kernel;
+    void add(const char *name, uint32_t ops, Kernel kernel);
+
+    // All kernels, in registration order; returns the number of results
+    int run(BenchResult *out, int max) const;
+
+    // {"platform", "cpuMHz", "results": {name: {"ops", "cyclesPerOp", "nsPerOp"}}}
+    static void report(JsonDocument &doc, const char *platform, const BenchResult *results, int n);
+
+  private:
+    struct Entry { const char *name; uint32_t ops; Kernel kernel; };
+    Entry _kernels[MAX_KERNELS];
+    int _count = 0;
+};
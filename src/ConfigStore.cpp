@@ -0,0 +1,110 @@
+#include "ConfigStore.h"
+
+static const char *BLOB_KEY = "cfg";
+static const size_t MAX_PAYLOAD = 512;  // Room for later versions to grow
+
+// One key per setting, as written before the blob existed
+static const char *const LEGACY_KEYS[] = {
+  "12h", "tz", "idle", "spd", "sens", "nEn", "nSt", "nEd", "homeInt", "dEn", "dInt", "dDur",
+  "baseH", "baseM", "stepsRev", "stepsRevH", "lSe", "lSb", "lCe", "lCb", "lXe", "lXb", "lAe", "lAb"
+};
+static const char LED_KEYS[4] = { 'S', 'C', 'X', 'A' };
+
+static uint32_t crc32(const uint8_t *data, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  while (len--) {
+    crc ^= *data++;
+    for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+ConfigStore::Source ConfigStore::load(const char *ns, ClockConfig &cfg) {
+  _ns = ns;
+  Preferences prefs;
+  prefs.begin(_ns, false);
+  Source source = FROM_DEFAULTS;
+  uint16_t version = 0;
+  if (readBlob(prefs, cfg, version)) {
+    if (version < VERSION) writeBlob(prefs, cfg);  // Store the new fields' defaults
+    source = FROM_BLOB;
+  } else if (readLegacy(prefs, cfg)) {
+    // Drop the old keys only once the blob is safely written
+    if (writeBlob(prefs, cfg)) {
+      for (const char *key : LEGACY_KEYS) if (prefs.remove(key)) _writes++;
+    }
+    source = FROM_LEGACY;
+  }
+  prefs.end();
+  _stored = cfg;
+  _haveStored = (source != FROM_DEFAULTS);
+  return source;
+}
+
+bool ConfigStore::save(const ClockConfig &cfg) {
+  if (_haveStored && memcmp(&cfg, &_stored, sizeof(cfg)) == 0) return false;
+  Preferences prefs;
+  prefs.begin(_ns, false);
+  bool ok = writeBlob(prefs, cfg);
+  prefs.end();
+  if (ok) { _stored = cfg; _haveStored = true; }
+  return ok;
+}
+
+bool ConfigStore::readBlob(Preferences &prefs, ClockConfig &cfg, uint16_t &version) {
+  static uint8_t buf[sizeof(Header) + MAX_PAYLOAD];
+  size_t len = prefs.getBytesLength(BLOB_KEY);
+  if (len < sizeof(Header) || len > sizeof(buf)) return false;
+  if (prefs.getBytes(BLOB_KEY, buf, len) != len) return false;
+
+  Header header;
+  memcpy(&header, buf, sizeof(header));
+  if (header.magic != MAGIC || header.size != len - sizeof(Header)) return false;
+  if (crc32(buf + sizeof(Header), header.size) != header.crc) return false;
+
+  // Older layouts are a prefix of this one; a newer one has extra tail bytes
+  memcpy(&cfg, buf + sizeof(Header), min((size_t)header.size, sizeof(cfg)));
+  cfg.timeZone[sizeof(cfg.timeZone) - 1] = '\0';
+  version = header.version;
+  return true;
+}
+
+bool ConfigStore::readLegacy(Preferences &prefs, ClockConfig &cfg) {
+  bool found = false;
+  for (const char *key : LEGACY_KEYS) found |= prefs.isKey(key);
+  if (!found) return false;
+
+  String tz = prefs.getString("tz", cfg.timeZone);
+  strncpy(cfg.timeZone, tz.c_str(), sizeof(cfg.timeZone) - 1);
+  cfg.is12Hour = prefs.getBool("12h", cfg.is12Hour);
+  cfg.powerSaver = prefs.getBool("idle", cfg.powerSaver);
+  cfg.motorMaxSpeed = prefs.getInt("spd", cfg.motorMaxSpeed);
+  cfg.sensorSensitivity = prefs.getInt("sens", cfg.sensorSensitivity);
+  cfg.nightEnabled = prefs.getBool("nEn", cfg.nightEnabled);
+  cfg.nightStartHour = prefs.getInt("nSt", cfg.nightStartHour);
+  cfg.nightEndHour = prefs.getInt("nEd", cfg.nightEndHour);
+  cfg.autoHomeHours = prefs.getInt("homeInt", cfg.autoHomeHours);
+  cfg.dateEnabled = prefs.getBool("dEn", cfg.dateEnabled);
+  cfg.dateIntervalMinutes = prefs.getInt("dInt", cfg.dateIntervalMinutes);
+  cfg.dateDurationSeconds = prefs.getInt("dDur", cfg.dateDurationSeconds);
+  cfg.baselineHours = prefs.getInt("baseH", cfg.baselineHours);
+  cfg.baselineMinutes = prefs.getInt("baseM", cfg.baselineMinutes);
+  cfg.stepsRev = prefs.getInt("stepsRev", cfg.stepsRev);
+  cfg.stepsRevH = prefs.getInt("stepsRevH", cfg.stepsRevH);
+  for (int i = 0; i < 4; i++) {
+    char en[4] = { 'l', LED_KEYS[i], 'e', 0 }, br[4] = { 'l', LED_KEYS[i], 'b', 0 };
+    cfg.ledEnabled[i] = prefs.getBool(en, cfg.ledEnabled[i]);
+    cfg.ledBrightness[i] = prefs.getInt(br, cfg.ledBrightness[i]);
+  }
+  return true;
+}
+
+bool ConfigStore::writeBlob(Preferences &prefs, const ClockConfig &cfg) {
+  uint8_t buf[sizeof(Header) + sizeof(ClockConfig)];
+  Header header = { MAGIC, VERSION, (uint16_t)sizeof(cfg), 0 };
+  memcpy(buf + sizeof(Header), &cfg, sizeof(cfg));
+  header.crc = crc32(buf + sizeof(Header), sizeof(cfg));
+  memcpy(buf, &header, sizeof(header));
+  _writes++;
+  return prefs.putBytes(BLOB_KEY, buf, sizeof(buf)) == sizeof(buf);
+}
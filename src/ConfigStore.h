@@ -0,0 +1,74 @@
+#pragma once
+#include <Arduino.h>
+#include <Preferences.h>
+
+// ==========================================
+//          SETTINGS IN ONE NVS BLOB
+// ==========================================
+// Every setting of the "clock-conf" namespace, calibration included, lives
+// in one packed struct stored under a single key behind a small header
+// (magic, layout version, payload size, CRC-32). Boot is one read; a save
+// compares against what is already in flash and writes nothing if equal.
+//
+// Layout rule: fields are only ever appended. An older blob is copied over
+// the defaults as far as it goes, so new fields start at their defaults and
+// nothing needs a per-version converter. Bump VERSION when appending.
+//
+// Units predating the blob have one key per setting; the first boot reads
+// those once, writes the blob and removes them.
+
+struct __attribute__((packed)) ClockConfig {
+  char timeZone[64] = "EST5EDT,M3.2.0,M11.1.0";
+  bool is12Hour = false;
+  bool powerSaver = false;
+  int32_t motorMaxSpeed = 1000;
+  int32_t sensorSensitivity = 50;
+  bool nightEnabled = false;
+  int32_t nightStartHour = 22;
+  int32_t nightEndHour = 7;
+  int32_t autoHomeHours = 0;
+  bool dateEnabled = false;
+  int32_t dateIntervalMinutes = 5;
+  int32_t dateDurationSeconds = 5;
+  // Calibration, written after homing
+  int32_t baselineHours = 1800;
+  int32_t baselineMinutes = 1800;
+  int32_t stepsRev = 2048;
+  int32_t stepsRevH = 2048;
+  // LEDs: status, colon, aux, AM/PM
+  bool ledEnabled[4] = { true, true, true, true };
+  int32_t ledBrightness[4] = { 255, 255, 255, 255 };
+  // Version 2: LedEffect per LED (the status LED only ever shows status)
+  uint8_t ledEffect[4] = { 0, 1, 0, 0 };
+};
+
+class ConfigStore {
+  public:
+    static const uint16_t VERSION = 2;
+    enum Source : uint8_t { FROM_BLOB, FROM_LEGACY, FROM_DEFAULTS };
+
+    // cfg holds the defaults on entry. A corrupt blob counts as missing.
+    Source load(const char *ns, ClockConfig &cfg);
+    // Writes only when cfg differs from the stored copy; true if it wrote
+    bool save(const ClockConfig &cfg);
+
+    uint32_t writes() const { return _writes; }
+
+  private:
+    struct __attribute__((packed)) Header {
+      uint16_t magic;
+      uint16_t version;
+      uint16_t size;      // Payload bytes that follow
+      uint32_t crc;       // CRC-32 of the payload
+    };
+    static const uint16_t MAGIC = 0xC10C;
+
+    bool readBlob(Preferences &prefs, ClockConfig &cfg, uint16_t &version);
+    bool readLegacy(Preferences &prefs, ClockConfig &cfg);
+    bool writeBlob(Preferences &prefs, const ClockConfig &cfg);
+
+    const char *_ns = nullptr;
+    ClockConfig _stored;
+    bool _haveStored = false;
+    uint32_t _writes = 0;
+};
@@ -0,0 +1,79 @@
+#include "DeltaPatcher.h"
+
+void DeltaPatcher::begin(uint32_t sourceSize, uint32_t targetSize, Reader reader, Sink sink) {
+  _reader = reader; _sink = sink;
+  _sourceSize = sourceSize; _targetSize = targetSize;
+  _produced = 0; _cursor = 0;
+  _phase = LITERAL_LENGTH;
+  _value = 0; _shift = 0;
+  _remaining = 0; _copyLength = 0;
+  _error = nullptr;
+}
+
+bool DeltaPatcher::write(const uint8_t *data, size_t len) {
+  while (len && !_error) {
+    if (_phase == LITERAL) {
+      size_t n = min<size_t>(len, _remaining);
+      if (!_sink(data, n)) return fail("Output refused");
+      _produced += n; _remaining -= n; _cursor += n;
+      data += n; len -= n;
+      if (!_remaining) _phase = COPY_LENGTH;
+      continue;
+    }
+    bool complete;
+    if (!varint(*data++, complete)) return false;
+    len--;
+    if (!complete) continue;
+    switch (_phase) {
+      case LITERAL_LENGTH:
+        if (_value > _targetSize - _produced) return fail("Literal runs past the image");
+        _remaining = _value;
+        _phase = _remaining ? LITERAL : COPY_LENGTH;
+        break;
+      case COPY_LENGTH:
+        if (_value > _targetSize - _produced) return fail("Copy runs past the image");
+        _copyLength = _value;
+        _phase = COPY_OFFSET;
+        break;
+      case COPY_OFFSET: {
+        int64_t offset = (int64_t)(_value >> 1) ^ -(int64_t)(_value & 1);
+        if (!copy((int64_t)_cursor + offset, _copyLength)) return false;
+        _phase = LITERAL_LENGTH;
+        break;
+      }
+      default: break;
+    }
+  }
+  return !_error;
+}
+
+bool DeltaPatcher::finish() {
+  if (_error) return false;
+  if (_phase != LITERAL_LENGTH || _shift) return fail("Delta ends inside a record");
+  if (_produced != _targetSize) return fail("Delta ends before the image does");
+  return true;
+}
+
+// LEB128, at most 64 bits
+bool DeltaPatcher::varint(uint8_t b, bool &complete) {
+  if (_shift == 0) _value = 0;
+  if (_shift > 63) return fail("Varint too long");
+  _value |= (uint64_t)(b & 0x7F) << _shift;
+  complete = !(b & 0x80);
+  _shift = complete ? 0 : _shift + 7;
+  return true;
+}
+
+bool DeltaPatcher::copy(int64_t from, uint32_t len) {
+  if (!len) return true;  // Literal-only record, such as the closing one: the cursor may be past the end
+  if (from < 0 || from + len > _sourceSize) return fail("Copy outside the running image");
+  uint32_t at = from;
+  while (len) {
+    size_t n = min<size_t>(len, COPY_CHUNK);
+    if (!_reader(at, _buf, n)) return fail("Reading the running image failed");
+    if (!_sink(_buf, n)) return fail("Output refused");
+    at += n; len -= n; _produced += n;
+  }
+  _cursor = at;
+  return true;
+}
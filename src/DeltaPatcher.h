@@ -0,0 +1,51 @@
+#pragma once
+#include <Arduino.h>
+#include <functional>
+
+// ==========================================
+//          STREAMING BINARY PATCHER
+// ==========================================
+// Rebuilds a firmware image from the one that is running plus a delta made
+// by tools/ota_pack.py. The delta is a list of records, each
+//
+//   varint literal length, literal bytes,
+//   varint copy length, zigzag varint copy offset
+//
+// where the copy offset is relative to the source cursor: the end of the
+// previous copy, moved on by the literal in between (so a few changed bytes
+// inside otherwise equal code cost a zero offset). Records arrive in any
+// split through write(); copies are read from flash in small pieces, so
+// RAM use does not depend on the image size.
+
+class DeltaPatcher {
+  public:
+    typedef std::function<bool(uint32_t offset, uint8_t *buf, size_t len)> Reader;  // Source image
+    typedef std::function<bool(const uint8_t *data, size_t len)> Sink;              // Target image
+
+    void begin(uint32_t sourceSize, uint32_t targetSize, Reader reader, Sink sink);
+    bool write(const uint8_t *data, size_t len);
+    bool finish();   // Exactly the target, on a record boundary
+    const char *error() const { return _error; }
+    uint32_t produced() const { return _produced; }
+
+  private:
+    enum Phase : uint8_t { LITERAL_LENGTH, LITERAL, COPY_LENGTH, COPY_OFFSET };
+    static const size_t COPY_CHUNK = 512;
+
+    bool varint(uint8_t b, bool &complete);
+    bool copy(int64_t from, uint32_t len);
+    bool fail(const char *why) { if (!_error) _error = why; return false; }
+
+    Reader _reader;
+    Sink _sink;
+    uint32_t _sourceSize = 0, _targetSize = 0;
+    uint32_t _produced = 0;
+    uint32_t _cursor = 0;     // Source position the next copy offset counts from
+    Phase _phase = LITERAL_LENGTH;
+    uint64_t _value = 0;      // Varint being read
+    uint8_t _shift = 0;
+    uint32_t _remaining = 0;  // Literal bytes still to come
+    uint32_t _copyLength = 0;
+    const char *_error = nullptr;
+    uint8_t _buf[COPY_CHUNK];
+};
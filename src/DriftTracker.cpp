@@ -0,0 +1,55 @@
+#include "DriftTracker.h"
+
+void DriftTracker::begin(HallSampler *sampler, int channel, StepperAxis *stepper) {
+  _sampler = sampler; _channel = channel; _stepper = stepper;
+  _published.publish(_history);
+}
+
+void DriftTracker::arm(int baseline, int threshold) {
+  _baseline = baseline; _threshold = threshold;
+  _estimator.begin(baseline, threshold);
+  _cursor = _sampler->sequence(_channel);
+  _lastFed = INT32_MIN;
+  _armed = true;
+}
+
+void DriftTracker::tick(int stepsPerRev) {
+  if (!_armed) return;
+  uint32_t newest = _sampler->sequence(_channel);
+  HallSample s;
+  while (_cursor < newest && _estimator.state() < MagnetEstimator::DONE) {
+    if (_sampler->history(_channel, _cursor, s) && s.position != _lastFed) {
+      _estimator.add(s.position, s.value);
+      _lastFed = s.position;
+    }
+    _cursor++;
+  }
+  if (_estimator.state() < MagnetEstimator::DONE) return;
+
+  if (_estimator.done()) {
+    // Home is the nearest whole revolution to the pass; more than one flap
+    // off is more likely a bogus pass than drift, leave that to auto-home
+    float center = _estimator.center();
+    float error = center - roundf(center / stepsPerRev) * stepsPerRev;
+    bool plausible = fabsf(error) <= stepsPerRev / 60.0f;
+    long steps = lroundf(error);
+    bool apply = plausible && fabsf(error) >= DEAD_BAND && steps != 0;
+    if (apply) _stepper->correctPosition(steps);
+    _history.passes++;
+    if (plausible) _history.lastPassMs = millis(); else _history.rejected++;
+    if (apply) { _history.corrected++; _history.totalSteps += steps; }
+    record(error, apply);
+  }
+  // Positions before a correction are in the old frame: start over from now
+  arm(_baseline, _threshold);
+}
+
+void DriftTracker::record(float error, bool applied) {
+  if (_history.count == DriftHistory::SIZE) {
+    memmove(_history.entries, _history.entries + 1, sizeof(DriftEntry) * (DriftHistory::SIZE - 1));
+    _history.count--;
+  }
+  time_t now = time(nullptr);
+  _history.entries[_history.count++] = { now > 1600000000 ? (uint32_t)now : 0, error, applied };
+  _published.publish(_history);
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <Arduino.h>
+#include "HallSampler.h"
+#include "MagnetEstimator.h"
+#include "MotionLink.h"
+#include "StepperAxis.h"
+
+// ==========================================
+//        PASSIVE DRIFT CORRECTION
+// ==========================================
+// Watches the hall stream while the clock moves normally. Every time a spool
+// carries its magnet past the sensor (the minute spool once an hour, the hour
+// spool once a day) the pass centre is compared with where the step count
+// says home is, and the difference is taken out of the position without
+// stopping. Only one sample per step position is fed to the estimator, so a
+// spool parked on its magnet (00) just waits for the next move to close the
+// pass.
+
+struct DriftEntry {
+  uint32_t epoch;       // Wall clock of the pass (0 before NTP)
+  float error;          // Pass centre - expected home, steps (positive = lost steps)
+  bool applied;
+};
+
+struct DriftHistory {
+  static const int SIZE = 16;
+  uint32_t passes;      // Magnet passes seen
+  uint32_t corrected;   // ...that moved the position
+  uint32_t rejected;    // ...too far off to trust
+  int32_t totalSteps;   // Sum of applied corrections
+  uint32_t lastPassMs;  // millis() of the last accepted pass
+  uint8_t count;
+  DriftEntry entries[SIZE];  // Oldest first
+};
+
+class DriftTracker {
+  public:
+    static constexpr float DEAD_BAND = 1.0f;  // Steps; below this nothing is touched
+
+    void begin(HallSampler *sampler, int channel, StepperAxis *stepper);
+    void arm(int baseline, int threshold);    // After homing or a baseline change
+    void pause() { _armed = false; }
+
+    // Motion task: feed new samples, correct on a finished pass
+    void tick(int stepsPerRev);
+
+    DriftHistory history() const { return _published.read(); }
+    // Motion task only
+    bool confirmed() const { return _history.lastPassMs != 0; }  // A trusted pass since boot
+    uint32_t rejected() const { return _history.rejected; }
+
+  private:
+    void record(float error, bool applied);
+
+    HallSampler *_sampler = nullptr;
+    int _channel = 0;
+    StepperAxis *_stepper = nullptr;
+    MagnetEstimator _estimator;
+    int _baseline = 0, _threshold = 0;
+    bool _armed = false;
+    uint32_t _cursor = 0;
+    int32_t _lastFed = 0;
+    DriftHistory _history = {};
+    Snapshot<DriftHistory> _published;
+};
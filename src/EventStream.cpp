@@ -0,0 +1,81 @@
+#include "EventStream.h"
+#include <lwip/sockets.h>
+
+static const char SSE_HEADERS[] =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/event-stream\r\n"
+  "Cache-Control: no-cache\r\n"
+  "Connection: keep-alive\r\n"
+  "\r\n"
+  "retry: 3000\n\n";
+
+bool EventStream::full() {
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (_fds[i] >= 0 && !connected(i)) drop(i);
+  }
+  return _count == MAX_CLIENTS;
+}
+
+int EventStream::add(int fd) {
+  if (fd < 0 || full()) return -1;
+  int slot = 0;
+  while (_fds[slot] >= 0) slot++;
+  _fds[slot] = fd;
+  _count++;
+  int one = 1;
+  lwip_setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  if (!sendAll(slot, SSE_HEADERS, sizeof(SSE_HEADERS) - 1)) { drop(slot); return -1; }
+  return slot;
+}
+
+void EventStream::send(const char *event, const char *data) {
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (_fds[i] >= 0 && !write(i, event, data)) drop(i);
+  }
+  _lastWrite = millis();
+}
+
+void EventStream::sendTo(int slot, const char *event, const char *data) {
+  if (slot < 0 || slot >= MAX_CLIENTS || _fds[slot] < 0) return;
+  if (!write(slot, event, data)) drop(slot);
+}
+
+void EventStream::tick() {
+  if (_count == 0 || millis() - _lastWrite < KEEPALIVE_MS) return;
+  // SSE comment line: ignored by the browser, fails fast on a dead socket
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (_fds[i] < 0) continue;
+    if (!connected(i) || !sendAll(i, ":\n\n", 3)) drop(i);
+  }
+  _lastWrite = millis();
+}
+
+bool EventStream::write(int slot, const char *event, const char *data) {
+  if (!connected(slot)) return false;
+  // Head, data and the blank line leave as one segment (MSG_MORE), without
+  // copying the data. A piece that does not fit drops the client, and the
+  // browser discards an event cut off by the close.
+  char head[40];
+  int n = event ? snprintf(head, sizeof(head), "event: %s\ndata: ", event) : snprintf(head, sizeof(head), "data: ");
+  if (n >= (int)sizeof(head)) return false;
+  return sendAll(slot, head, n, MSG_MORE) && sendAll(slot, data, strlen(data), MSG_MORE) && sendAll(slot, "\n\n", 2);
+}
+
+// The socket is non-blocking: a frame that does not fit the send buffer at
+// once means the client stopped reading, and it is dropped
+bool EventStream::sendAll(int slot, const char *data, size_t len, int flags) {
+  return lwip_send(_fds[slot], data, len, flags | MSG_DONTWAIT) == (int)len;
+}
+
+// Dashboards never send anything after the request: readable means closed
+bool EventStream::connected(int slot) {
+  char c;
+  int n = lwip_recv(_fds[slot], &c, 1, MSG_PEEK | MSG_DONTWAIT);
+  return n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+}
+
+void EventStream::drop(int slot) {
+  lwip_close(_fds[slot]);
+  _fds[slot] = -1;
+  _count--;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <Arduino.h>
+
+// ==========================================
+//          SERVER-SENT EVENTS CHANNEL
+// ==========================================
+// Keeps the sockets of dashboards that opened /events and pushes text frames
+// to them. Handing a client over is a one-off in the HTTP handler; after that
+// the HttpServer forgets the socket and the owner pushes from loop(). Nothing
+// is written unless there is something to say (plus a rare keepalive that
+// also weeds out dead connections).
+
+class EventStream {
+  public:
+    static const int MAX_CLIENTS = 4;
+    static const uint32_t KEEPALIVE_MS = 15000;
+
+    bool full();  // Also drops clients that went away
+    // Adopt a socket (HttpServer::detachClient). Returns the slot, or -1.
+    int add(int fd);
+    int clientCount() const { return _count; }
+
+    // event == nullptr sends a default "message" event
+    void send(const char *event, const char *data);
+    void sendTo(int slot, const char *event, const char *data);
+
+    void tick();  // Keepalive + reap disconnected clients
+
+  private:
+    bool write(int slot, const char *event, const char *data);
+    bool connected(int slot);
+    bool sendAll(int slot, const char *data, size_t len, int flags = 0);
+    void drop(int slot);
+
+    int _fds[MAX_CLIENTS] = { -1, -1, -1, -1 };
+    int _count = 0;
+    uint32_t _lastWrite = 0;
+};
@@ -0,0 +1,162 @@
+#include "HallSampler.h"
+#include <driver/i2s.h>
+#include <driver/adc.h>
+#include <soc/syscon_struct.h>
+
+static const i2s_port_t HALL_I2S_PORT = I2S_NUM_0;
+static const int HALL_DMA_BUF_LEN = 128;
+static const int HALL_TASK_PRIORITY = 4;   // Just below the motion task
+static const int HALL_TASK_CORE = 1;
+
+static const uint32_t HALL_HISTORY_MARGIN = 8; // Slots the writer may be reusing
+
+static adc1_channel_t adcChannelForPin(int pin) {
+  switch (pin) {
+    case 36: return ADC1_CHANNEL_0; case 37: return ADC1_CHANNEL_1;
+    case 38: return ADC1_CHANNEL_2; case 39: return ADC1_CHANNEL_3;
+    case 32: return ADC1_CHANNEL_4; case 33: return ADC1_CHANNEL_5;
+    case 34: return ADC1_CHANNEL_6; case 35: return ADC1_CHANNEL_7;
+    default: return ADC1_CHANNEL_MAX;
+  }
+}
+
+// Pattern table entry: [7:4] channel, [3:2] width (3 = 12 bit), [1:0] atten (3 = 11 dB)
+static uint32_t patternEntry(int adcChannel) { return ((adcChannel & 0xF) << 4) | 0x0F; }
+
+void hallSamplerTask(void *param) {
+  HallSampler &sampler = *static_cast<HallSampler *>(param);
+  static uint16_t raw[HALL_DMA_BUF_LEN];
+  for (;;) {
+    size_t bytesRead = 0;
+    i2s_read(HALL_I2S_PORT, raw, sizeof(raw), &bytesRead, portMAX_DELAY);
+    uint32_t started = micros();
+
+    // The buffer covers the time since the previous one, so spread the step
+    // positions across it instead of stamping everything with "now". Rounded,
+    // not truncated: the spool steps somewhere within each step period, so
+    // truncation would stamp samples half a step behind on average.
+    int32_t from[HallSampler::CHANNELS], to[HallSampler::CHANNELS];
+    for (int ch = 0; ch < HallSampler::CHANNELS; ch++) {
+      from[ch] = sampler._bufferPosition[ch];
+      to[ch] = sampler._axis[ch] ? sampler._axis[ch]->currentPosition() : 0;
+      sampler._bufferPosition[ch] = to[ch];
+    }
+    int n = bytesRead / sizeof(uint16_t);
+    for (int i = 0; i < n; i++) {
+      int adcChannel = raw[i] >> 12;
+      uint16_t value = raw[i] & 0x0FFF;
+      for (int ch = 0; ch < HallSampler::CHANNELS; ch++) {
+        if (sampler._adcChannel[ch] != adcChannel) continue;
+        int32_t moved = (to[ch] - from[ch]) * 2 * (i + 1);
+        sampler.ingest(ch, value, from[ch] + (moved + (moved < 0 ? -n : n)) / (2 * n));
+        break;
+      }
+    }
+    sampler._bufferTime.add(micros() - started);
+  }
+}
+
+void HallSampler::begin(int pin0, const StepperAxis *axis0, int pin1, const StepperAxis *axis1) {
+  _axis[0] = axis0; _axis[1] = axis1;
+  adc1_channel_t ch0 = adcChannelForPin(pin0), ch1 = adcChannelForPin(pin1);
+  _adcChannel[0] = ch0; _adcChannel[1] = ch1;
+
+  adc1_config_width(ADC_WIDTH_BIT_12);
+  adc1_config_channel_atten(ch0, ADC_ATTEN_DB_11);
+  adc1_config_channel_atten(ch1, ADC_ATTEN_DB_11);
+
+  i2s_config_t cfg = {};
+  cfg.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+  cfg.sample_rate = SAMPLE_RATE;
+  cfg.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  cfg.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+  cfg.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+  cfg.dma_buf_count = 4;
+  cfg.dma_buf_len = HALL_DMA_BUF_LEN;
+  i2s_driver_install(HALL_I2S_PORT, &cfg, 0, NULL);
+  i2s_set_adc_mode(ADC_UNIT_1, ch0);
+  i2s_adc_enable(HALL_I2S_PORT);
+
+  // The driver only programs a single-channel pattern. Widen it to two
+  // entries so the DMA stream alternates between both sensors.
+  SYSCON.saradc_ctrl.sar1_patt_len = 1; // Entries - 1
+  SYSCON.saradc_sar1_patt_tab[0] = (patternEntry(ch0) << 24) | (patternEntry(ch1) << 16);
+
+  xTaskCreatePinnedToCore(hallSamplerTask, "hall", 4096, this, HALL_TASK_PRIORITY, NULL, HALL_TASK_CORE);
+}
+
+// ------------------------------------------
+//  Writer side
+// ------------------------------------------
+void HallSampler::ingest(int ch, uint16_t raw, int32_t position) {
+  _rawSum[ch] += raw;
+  if (++_rawCount[ch] == DECIMATION / 2) _rawPosition[ch] = position;
+  if (_rawCount[ch] < DECIMATION) return;
+  HallSample sample;
+  sample.value = _rawSum[ch] / _rawCount[ch];
+  sample.position = _rawPosition[ch];
+  _rawSum[ch] = 0; _rawCount[ch] = 0;
+  publish(ch, sample);
+}
+
+void HallSampler::publish(int ch, const HallSample &sample) {
+  uint32_t seq = _seq[ch];
+  HallSample *hist = _history[ch];
+
+  // Rolling average (add newest, drop the one leaving the window)
+  _avgSum[ch] += sample.value;
+  if (seq >= (uint32_t)AVG_WINDOW) _avgSum[ch] -= hist[(seq - AVG_WINDOW) & (HISTORY - 1)].value;
+  hist[seq & (HISTORY - 1)] = sample;
+  uint32_t filled = min(seq + 1, (uint32_t)AVG_WINDOW);
+
+  // Sliding peak of |value - baseline| via a monotonic queue
+  int base = _baseline[ch];
+  uint32_t *queue = _peakQueue[ch];
+  int &head = _peakHead[ch]; int &count = _peakCount[ch];
+  if (_baselineChanged[ch]) {
+    _baselineChanged[ch] = false; count = 0;
+  }
+  int dev = abs((int)sample.value - base);
+  while (count > 0 && queue[head] + PEAK_WINDOW <= seq) { head = (head + 1) % PEAK_WINDOW; count--; }
+  while (count > 0) {
+    uint32_t back = queue[(head + count - 1) % PEAK_WINDOW];
+    if (abs((int)hist[back & (HISTORY - 1)].value - base) > dev) break;
+    count--;
+  }
+  queue[(head + count) % PEAK_WINDOW] = seq; count++;
+
+  HallChannelState st;
+  st.sequence = seq + 1;
+  st.latest = sample;
+  st.average = _avgSum[ch] / filled;
+  st.peak = hist[queue[head] & (HISTORY - 1)];
+  _seq[ch] = seq + 1;
+  _state[ch].publish(st);
+  if (_trace && seq % TraceRecorder::HALL_EVERY == 0) _trace->record(TRACE_HALL, ch, sample.value, sample.position);
+}
+
+// ------------------------------------------
+//  Reader side
+// ------------------------------------------
+void HallSampler::setBaseline(int ch, int baseline) {
+  if (_baseline[ch] == baseline) return;
+  _baseline[ch] = baseline;
+  _baselineChanged[ch] = true; // Peak window restarts on the next sample
+}
+
+bool HallSampler::history(int ch, uint32_t seq, HallSample &out) const {
+  uint32_t newest = sequence(ch);
+  if (seq >= newest || newest - seq > HISTORY - HALL_HISTORY_MARGIN) return false;
+  out = _history[ch][seq & (HISTORY - 1)];
+  return sequence(ch) - seq <= HISTORY - HALL_HISTORY_MARGIN; // Still valid after the copy
+}
+
+int HallSampler::mean(int ch, int samples) const {
+  uint32_t newest = sequence(ch);
+  long sum = 0; int n = 0;
+  for (uint32_t seq = newest - min((uint32_t)samples, newest); seq < newest; seq++) {
+    HallSample s;
+    if (history(ch, seq, s)) { sum += s.value; n++; }
+  }
+  return n ? sum / n : 0;
+}
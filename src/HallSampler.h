@@ -0,0 +1,82 @@
+#pragma once
+#include <Arduino.h>
+#include "MotionLink.h"
+#include "StepperAxis.h"
+#include "Metrics.h"
+#include "TraceRecorder.h"
+
+// ==========================================
+//        CONTINUOUS HALL SENSOR SAMPLER
+// ==========================================
+// The I2S0 peripheral drives ADC1 in DMA mode, alternating between both hall
+// sensors through the SAR pattern table. A reader task decimates the raw
+// stream, stamps every sample with the spool's step position and keeps a
+// short history per channel. Queries are O(1) snapshot reads, so the motion
+// path never waits on the ADC.
+
+struct HallSample {
+  int32_t position;  // Step position of the spool when the sample was taken
+  uint16_t value;    // 12-bit ADC value (decimated)
+};
+
+struct HallChannelState {
+  uint32_t sequence;   // Decimated samples produced so far
+  HallSample latest;
+  uint16_t average;    // Rolling mean over AVG_WINDOW samples
+  HallSample peak;     // Largest |value - baseline| within PEAK_WINDOW samples
+};
+
+class HallSampler {
+  public:
+    static const int CHANNELS = 2;
+    static const uint32_t SAMPLE_RATE = 20000; // Raw ADC rate, shared by both channels
+    static const int DECIMATION = 10;          // -> 1 kHz per channel
+    static const int AVG_WINDOW = 4;
+    static const int PEAK_WINDOW = 32;
+    static const int HISTORY = 256;            // Power of two
+
+    void begin(int pin0, const StepperAxis *axis0, int pin1, const StepperAxis *axis1);
+
+    // Readers (any task)
+    HallChannelState state(int ch) const { return _state[ch].read(); }
+    int average(int ch) const { return state(ch).average; }
+    int deviation(int ch) const { return abs((int)state(ch).average - _baseline[ch]); }
+    uint32_t sequence(int ch) const { return state(ch).sequence; }
+    bool history(int ch, uint32_t seq, HallSample &out) const;  // False once overwritten
+    int mean(int ch, int samples) const;
+
+    void setBaseline(int ch, int baseline);
+    // Every TraceRecorder::HALL_EVERY-th sample per channel goes to the trace
+    void attachTrace(TraceRecorder *trace) { _trace = trace; }
+
+    // Reader task time per DMA buffer (16 us .. 16 ms buckets)
+    const Histogram &bufferTime() const { return _bufferTime; }
+
+    // Feed one raw reading taken at a given spool position (reader task; also used by host builds)
+    void ingest(int ch, uint16_t raw, int32_t position);
+
+  private:
+    void publish(int ch, const HallSample &sample);
+
+    const StepperAxis *_axis[CHANNELS] = { nullptr, nullptr };
+    int _adcChannel[CHANNELS] = { 0, 0 };
+    volatile int _baseline[CHANNELS] = { 0, 0 };
+
+    // Writer-side state (reader task only)
+    uint32_t _rawSum[CHANNELS] = { 0, 0 };
+    int _rawCount[CHANNELS] = { 0, 0 };
+    int32_t _rawPosition[CHANNELS] = { 0, 0 };   // Stamp for the window (its middle sample)
+    int32_t _bufferPosition[CHANNELS] = { 0, 0 }; // Spool position at the previous DMA buffer
+    uint32_t _avgSum[CHANNELS] = { 0, 0 };
+    uint32_t _seq[CHANNELS] = { 0, 0 };
+    uint32_t _peakQueue[CHANNELS][PEAK_WINDOW]; // Monotonic queue of sequence numbers
+    int _peakHead[CHANNELS] = { 0, 0 }; int _peakCount[CHANNELS] = { 0, 0 };
+    bool _baselineChanged[CHANNELS] = { false, false };
+
+    HallSample _history[CHANNELS][HISTORY];
+    Snapshot<HallChannelState> _state[CHANNELS];
+    Histogram _bufferTime{4, 14};
+    TraceRecorder *_trace = nullptr;
+
+    friend void hallSamplerTask(void *param);
+};
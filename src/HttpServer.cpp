@@ -0,0 +1,659 @@
+#include "HttpServer.h"
+#include <lwip/sockets.h>
+
+static HTTPMethod parseMethod(const String &m) {
+  if (m == "GET") return HTTP_GET;
+  if (m == "POST") return HTTP_POST;
+  if (m == "PUT") return HTTP_PUT;
+  if (m == "PATCH") return HTTP_PATCH;
+  if (m == "DELETE") return HTTP_DELETE;
+  if (m == "HEAD") return HTTP_HEAD;
+  if (m == "OPTIONS") return HTTP_OPTIONS;
+  return HTTP_ANY;  // Unknown: only routes for any method take it
+}
+
+static const char *reason(int code) {
+  switch (code) {
+    case 100: return "Continue";
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 303: return "See Other";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 409: return "Conflict";
+    case 411: return "Length Required";
+    case 413: return "Payload Too Large";
+    case 422: return "Unprocessable Entity";
+    case 431: return "Request Header Fields Too Large";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default: return code < 400 ? "OK" : "Error";
+  }
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static String urlDecode(const String &s) {
+  String out;
+  out.reserve(s.length());
+  for (unsigned i = 0; i < s.length(); i++) {
+    char c = s.charAt(i);
+    int hi, lo;
+    if (c == '+') out += ' ';
+    else if (c == '%' && i + 2 < s.length() && (hi = hexValue(s.charAt(i + 1))) >= 0 && (lo = hexValue(s.charAt(i + 2))) >= 0) {
+      out += (char)(hi << 4 | lo);
+      i += 2;
+    } else out += c;
+  }
+  return out;
+}
+
+// Value of key="..." in a Content-Disposition line; empty if absent
+static bool quotedParam(const String &text, const char *key, String &value) {
+  String pattern = String(key) + "=\"";
+  int at = -1;
+  while ((at = text.indexOf(pattern, at + 1)) >= 0) {
+    char before = at ? text.charAt(at - 1) : ' ';
+    if (before == ' ' || before == ';') break;  // Not the tail of a longer name
+  }
+  if (at < 0) return false;
+  int start = at + pattern.length();
+  int end = text.indexOf('"', start);
+  if (end < 0) return false;
+  value = text.substring(start, end);
+  return true;
+}
+
+// ------------------------------------------
+//  Setup
+// ------------------------------------------
+void HttpServer::begin(SemaphoreHandle_t lock) {
+  _lock = lock;
+  _listenFd = lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (_listenFd < 0) { Serial.println("HTTP: no socket"); return; }
+  int one = 1;
+  lwip_setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(_port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (lwip_bind(_listenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || lwip_listen(_listenFd, MAX_CONNECTIONS) < 0) {
+    Serial.printf("HTTP: cannot listen on port %d\n", _port);
+    lwip_close(_listenFd);
+    _listenFd = -1;
+    return;
+  }
+  lwip_fcntl(_listenFd, F_SETFL, O_NONBLOCK);
+  xTaskCreatePinnedToCore(serverTask, "http", TASK_STACK, this, TASK_PRIORITY, nullptr, 0);
+}
+
+void HttpServer::on(const String &uri, HTTPMethod method, THandlerFunction fn, THandlerFunction upload) {
+  _routes.push_back({ uri, method, fn, upload });
+}
+
+void HttpServer::collectHeaders(const char *headerKeys[], size_t count) {
+  _wantedHeaders.clear();
+  for (size_t i = 0; i < count; i++) _wantedHeaders.push_back(headerKeys[i]);
+}
+
+// ------------------------------------------
+//  Event loop
+// ------------------------------------------
+void HttpServer::serverTask(void *param) { static_cast<HttpServer *>(param)->run(); }
+
+void HttpServer::run() {
+  for (;;) {
+    fd_set rd, wr;
+    FD_ZERO(&rd); FD_ZERO(&wr);
+    int maxFd = -1;
+    // A new client gets a free slot, or the one of the longest idle keep-alive
+    bool room = _open < MAX_CONNECTIONS;
+    for (Connection &c : _conns) room = room || (c.phase != FREE && evictable(c));
+    if (room) { FD_SET(_listenFd, &rd); maxFd = _listenFd; }
+
+    uint32_t now = millis(), wait = 1000;
+    for (Connection &c : _conns) {
+      if (c.phase == FREE) continue;
+      if (hasOutput(c)) FD_SET(c.fd, &wr);
+      if (c.phase != DRAIN) FD_SET(c.fd, &rd);
+      if (c.fd > maxFd) maxFd = c.fd;
+      uint32_t limit = idle(c) ? IDLE_MS : STALL_MS, age = now - c.lastActivity;
+      wait = min(wait, age < limit ? limit - age : 0);
+    }
+    struct timeval tv = { (time_t)(wait / 1000), (suseconds_t)(wait % 1000) * 1000 };
+    if (lwip_select(maxFd + 1, &rd, &wr, nullptr, &tv) < 0) { delay(10); continue; }
+
+    for (Connection &c : _conns) {
+      if (c.phase != FREE && FD_ISSET(c.fd, &wr)) {
+        if (!flushSome(c)) closeConnection(c);
+        else if (c.phase == DRAIN && !hasOutput(c)) afterResponse(c);
+      }
+      if (c.phase != FREE && c.phase != DRAIN && FD_ISSET(c.fd, &rd)) readFrom(c);
+      if (c.phase != FREE && millis() - c.lastActivity >= (idle(c) ? IDLE_MS : STALL_MS)) closeConnection(c);
+    }
+    if (room && FD_ISSET(_listenFd, &rd)) acceptClient();
+  }
+}
+
+void HttpServer::acceptClient() {
+  int fd = lwip_accept(_listenFd, nullptr, nullptr);
+  if (fd < 0) return;
+  Connection *slot = nullptr, *oldest = nullptr;
+  for (Connection &c : _conns) {
+    if (c.phase == FREE) { slot = &c; break; }
+    if (evictable(c) && (!oldest || (int32_t)(c.lastActivity - oldest->lastActivity) < 0)) oldest = &c;
+  }
+  if (!slot && oldest) { closeConnection(*oldest); slot = oldest; _evicted++; }
+  if (!slot) { lwip_close(fd); return; }
+
+  lwip_fcntl(fd, F_SETFL, O_NONBLOCK);
+  int one = 1;
+  lwip_setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  slot->fd = fd;
+  slot->phase = HEAD;
+  slot->lastActivity = millis();
+  _open++;
+  _accepted++;
+}
+
+// The route of an upload cut short still runs, to clean up; its answer goes nowhere
+void HttpServer::closeConnection(Connection &c) {
+  if (c.phase == MULTIPART) {
+    if (c.fileOpen) { c.fileOpen = false; uploadCall(c, UPLOAD_FILE_ABORTED); }
+    _uploading = -1;
+    c.dead = true;
+    callHandler(c);
+  }
+  lwip_close(c.fd);
+  release(c);
+}
+
+void HttpServer::release(Connection &c) {
+  c = Connection();
+  _open--;
+}
+
+void HttpServer::readFrom(Connection &c) {
+  // A few segments per wake, then the other connections get their turn
+  for (int i = 0; i < 4 && c.phase != FREE && c.phase != DRAIN; i++) {
+    int n = lwip_recv(c.fd, _rx, sizeof(_rx), MSG_DONTWAIT);
+    if (n > 0) { c.lastActivity = millis(); process(c, _rx, n); continue; }
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) closeConnection(c);
+    return;
+  }
+}
+
+// ------------------------------------------
+//  Request parsing
+// ------------------------------------------
+void HttpServer::process(Connection &c, const char *data, size_t len) {
+  if (c.phase == MULTIPART) { feedMultipart(c, data, len); return; }
+  if (len) c.in.concat(data, len);
+  while (c.phase == HEAD || c.phase == BODY) {
+    if (c.phase == HEAD) {
+      if (!c.in.length()) return;
+      int end = c.in.indexOf("\r\n\r\n");
+      if (end < 0) {
+        if (c.in.length() > MAX_HEAD) reply(c, 431, "Request head too large");
+        return;
+      }
+      if (!parseHead(c, end)) return;
+      if (c.phase == MULTIPART && c.in.length()) {
+        // Body bytes that came with the head
+        String rest = c.in;
+        c.in = String();
+        feedMultipart(c, rest.c_str(), rest.length());
+      }
+      continue;
+    }
+    if (c.in.length() < c.bodyLeft) return;
+    String body = c.in.substring(0, c.bodyLeft);
+    c.in.remove(0, c.bodyLeft);
+    c.bodyLeft = 0;
+    if (c.contentType.startsWith("application/x-www-form-urlencoded")) addArgs(c, body);
+    else c.args.push_back({ "plain", body });  // As WebServer hands over JSON and text bodies
+    c.phase = HEAD;
+    dispatch(c);
+  }
+}
+
+// Request line and headers, then what the body needs. False if answered already.
+bool HttpServer::parseHead(Connection &c, int end) {
+  String head = c.in.substring(0, end);
+  c.in.remove(0, end + 4);
+
+  int lineEnd = head.indexOf("\r\n");
+  if (lineEnd < 0) lineEnd = head.length();
+  int sp1 = head.indexOf(' '), sp2 = head.indexOf(' ', sp1 + 1);
+  if (sp1 <= 0 || sp2 < 0 || sp2 > lineEnd) { reply(c, 400, "Bad request line"); return false; }
+  c.method = parseMethod(head.substring(0, sp1));
+  String target = head.substring(sp1 + 1, sp2);
+  c.http11 = head.substring(sp2 + 1, lineEnd) == "HTTP/1.1";
+  c.keepAlive = c.http11;
+  int q = target.indexOf('?');
+  c.uri = urlDecode(q < 0 ? target : target.substring(0, q));
+  if (q >= 0) addArgs(c, target.substring(q + 1));
+
+  size_t contentLength = 0;
+  bool chunkedBody = false, expectContinue = false;
+  for (int at = lineEnd + 2; at < (int)head.length();) {
+    int eol = head.indexOf("\r\n", at);
+    if (eol < 0) eol = head.length();
+    int colon = head.indexOf(':', at);
+    if (colon > at && colon < eol) {
+      String name = head.substring(at, colon), value = head.substring(colon + 1, eol);
+      value.trim();
+      if (name.equalsIgnoreCase("Content-Length")) contentLength = strtoul(value.c_str(), nullptr, 10);
+      else if (name.equalsIgnoreCase("Content-Type")) c.contentType = value;
+      else if (name.equalsIgnoreCase("Transfer-Encoding")) chunkedBody = true;
+      else if (name.equalsIgnoreCase("Expect")) expectContinue = value.equalsIgnoreCase("100-continue");
+      else if (name.equalsIgnoreCase("Connection")) {
+        value.toLowerCase();
+        if (value.indexOf("close") >= 0) c.keepAlive = false;
+        else if (value.indexOf("keep-alive") >= 0) c.keepAlive = true;
+      }
+      for (const String &wanted : _wantedHeaders) {
+        if (name.equalsIgnoreCase(wanted)) c.headers.push_back({ wanted, value });
+      }
+    }
+    at = eol + 2;
+  }
+
+  c.route = -1;
+  for (size_t i = 0; i < _routes.size(); i++) {
+    if (_routes[i].uri == c.uri && (_routes[i].method == HTTP_ANY || _routes[i].method == c.method)) { c.route = i; break; }
+  }
+  if (chunkedBody) { reply(c, 411, "Chunked request bodies are not supported"); return false; }
+  bool multipart = c.route >= 0 && _routes[c.route].upload && c.contentType.startsWith("multipart/form-data");
+  if (!multipart && contentLength > MAX_BODY) { reply(c, 413, "Request body too large"); return false; }
+  if (multipart) {
+    int b = c.contentType.indexOf("boundary=");
+    String boundary = b < 0 ? String() : c.contentType.substring(b + 9);
+    int semi = boundary.indexOf(';');
+    if (semi >= 0) boundary = boundary.substring(0, semi);
+    boundary.trim();
+    if (boundary.startsWith("\"")) boundary = boundary.substring(1, boundary.length() - 1);
+    if (!boundary.length() || boundary.length() > 70) { reply(c, 400, "Bad multipart boundary"); return false; }
+    if (_uploading >= 0) { reply(c, 503, "Another upload is in progress"); return false; }
+    _uploading = &c - _conns;
+    c.delimiter = "\r\n--";
+    c.delimiter += boundary;
+    c.matched = 2;  // The first boundary has no CRLF before it
+    c.part = PART_PREAMBLE;
+  }
+  if (expectContinue && contentLength) {
+    static const char CONTINUE[] = "HTTP/1.1 100 Continue\r\n\r\n";
+    queue(c, CONTINUE, sizeof(CONTINUE) - 1);
+  }
+  c.bodyLeft = contentLength;
+  if (multipart) {
+    c.phase = MULTIPART;
+    if (!contentLength) feedMultipart(c, nullptr, 0);
+  } else if (contentLength) {
+    c.phase = BODY;
+  } else {
+    dispatch(c);
+  }
+  return true;
+}
+
+void HttpServer::addArgs(Connection &c, const String &query) {
+  int at = 0;
+  while (at < (int)query.length()) {
+    int amp = query.indexOf('&', at);
+    if (amp < 0) amp = query.length();
+    int eq = query.indexOf('=', at);
+    if (amp > at) {
+      if (eq < 0 || eq > amp) c.args.push_back({ urlDecode(query.substring(at, amp)), String() });
+      else c.args.push_back({ urlDecode(query.substring(at, eq)), urlDecode(query.substring(eq + 1, amp)) });
+    }
+    at = amp + 1;
+  }
+}
+
+// ------------------------------------------
+//  Multipart uploads
+// ------------------------------------------
+// Parts are cut at the delimiter as bytes arrive; a partial delimiter at
+// the end of one read is carried to the next as a count, never copied
+void HttpServer::feedMultipart(Connection &c, const char *data, size_t len) {
+  size_t take = min(len, c.bodyLeft), i = 0;
+  const char *delim = c.delimiter.c_str();
+  size_t delimLen = c.delimiter.length();
+  while (i < take) {
+    if (c.part == PART_PREAMBLE || c.part == PART_DATA) {
+      if (c.matched) {
+        if (data[i] == delim[c.matched]) {
+          i++;
+          if (++c.matched < delimLen) continue;
+          c.matched = 0;
+          if (c.part == PART_DATA) endPart(c);
+          c.part = PART_AFTER_BOUNDARY;
+          c.in = String();
+          continue;
+        }
+        partData(c, delim, c.matched);  // Looked like the delimiter, was data
+        c.matched = 0;
+        continue;
+      }
+      // '\r' only starts the delimiter: everything up to the next one is data
+      const char *cr = (const char *)memchr(data + i, '\r', take - i);
+      size_t n = cr ? cr - (data + i) : take - i;
+      partData(c, data + i, n);
+      i += n;
+      if (cr) { c.matched = 1; i++; }
+    } else if (c.part == PART_AFTER_BOUNDARY) {
+      c.in += data[i++];
+      if (c.in.length() < 2) continue;
+      if (c.in == "--") c.part = PART_END;
+      else if (c.in == "\r\n") c.part = PART_HEADERS;
+      else c.part = PART_END;  // Malformed: the route sees an incomplete upload
+      c.in = String();
+    } else if (c.part == PART_HEADERS) {
+      c.in += data[i++];
+      if (c.in.endsWith("\r\n\r\n")) {
+        partHeaders(c, c.in);
+        c.in = String();
+        c.part = PART_DATA;
+      } else if (c.in.length() > MAX_HEAD) {
+        c.part = PART_END;
+        c.in = String();
+      }
+    } else {
+      i = take;  // Epilogue
+    }
+  }
+  c.bodyLeft -= take;
+  if (c.bodyLeft) return;
+
+  if (c.fileOpen) { c.fileOpen = false; uploadCall(c, UPLOAD_FILE_ABORTED); }
+  _uploading = -1;
+  c.in = String();
+  if (len > take) c.in.concat(data + take, len - take);  // Next request, pipelined
+  c.phase = HEAD;
+  dispatch(c);
+}
+
+void HttpServer::partHeaders(Connection &c, const String &text) {
+  String name, filename;
+  quotedParam(text, "name", name);
+  if (quotedParam(text, "filename", filename)) {
+    _upload.filename = filename;
+    _upload.name = name;
+    _upload.type = String();
+    int t = text.indexOf("Content-Type:");
+    if (t < 0) t = text.indexOf("content-type:");
+    if (t >= 0) {
+      int eol = text.indexOf("\r\n", t);
+      _upload.type = text.substring(t + 13, eol);
+      _upload.type.trim();
+    }
+    _upload.totalSize = 0;
+    _upload.currentSize = 0;
+    _uploadFill = 0;
+    c.fileOpen = true;
+    uploadCall(c, UPLOAD_FILE_START);
+  } else {
+    c.field = name;
+    c.fieldValue = String();
+  }
+}
+
+void HttpServer::partData(Connection &c, const char *data, size_t len) {
+  if (c.part != PART_DATA || !len) return;
+  if (!c.fileOpen) {
+    if (c.fieldValue.length() + len <= MAX_BODY) c.fieldValue.concat(data, len);
+    return;
+  }
+  while (len) {
+    size_t n = min(len, (size_t)HTTP_UPLOAD_BUFLEN - _uploadFill);
+    memcpy(_upload.buf + _uploadFill, data, n);
+    _uploadFill += n; data += n; len -= n;
+    if (_uploadFill == HTTP_UPLOAD_BUFLEN) uploadCall(c, UPLOAD_FILE_WRITE);
+  }
+}
+
+void HttpServer::endPart(Connection &c) {
+  if (c.fileOpen) {
+    if (_uploadFill) uploadCall(c, UPLOAD_FILE_WRITE);
+    c.fileOpen = false;
+    uploadCall(c, UPLOAD_FILE_END);
+  } else if (c.field.length()) {
+    c.args.push_back({ c.field, c.fieldValue });
+  }
+  c.field = String();
+  c.fieldValue = String();
+}
+
+void HttpServer::uploadCall(Connection &c, HTTPUploadStatus status) {
+  _upload.status = status;
+  if (status == UPLOAD_FILE_WRITE) {
+    _upload.currentSize = _uploadFill;
+    _upload.totalSize += _uploadFill;
+    _uploadFill = 0;
+  }
+  if (c.route < 0 || !_routes[c.route].upload) return;
+  _cur = &c;
+  lock(); _inHandler = true;
+  _routes[c.route].upload();
+  _inHandler = false; unlock();
+  _cur = nullptr;
+}
+
+// ------------------------------------------
+//  Handlers
+// ------------------------------------------
+void HttpServer::callHandler(Connection &c) {
+  _responseHeaders = String();
+  _contentLength = CONTENT_LENGTH_UNKNOWN;
+  _lengthSet = false;
+  _detached = false;
+  c.responded = false;
+  c.chunked = false;
+  _cur = &c;
+  lock(); _inHandler = true;
+  if (c.route >= 0 && _routes[c.route].fn) _routes[c.route].fn();
+  else if (_notFound) _notFound();
+  else send(404, "text/plain", "Not found");
+  if (!c.responded && !_detached) send(500, "text/plain", "No response");
+  _inHandler = false; unlock();
+  _cur = nullptr;
+}
+
+void HttpServer::dispatch(Connection &c) {
+  _requests++;
+  callHandler(c);
+  if (_detached) { release(c); return; }  // The socket is someone else's now
+  finishRequest(c);
+}
+
+void HttpServer::finishRequest(Connection &c) {
+  if (c.chunked) {
+    queue(c, "0\r\n\r\n", 5);  // The handler never ended the chunked body
+    c.chunked = false;
+  }
+  // Keep the connection and any pipelined bytes, drop the request
+  c.uri = String();
+  c.args.clear();
+  c.headers.clear();
+  c.contentType = String();
+  c.route = -1;
+  c.bodyLeft = 0;
+  c.delimiter = String();
+  c.phase = DRAIN;
+  if (c.dead) { lwip_close(c.fd); release(c); }
+  else if (!hasOutput(c)) afterResponse(c);
+}
+
+void HttpServer::afterResponse(Connection &c) {
+  if (c.keepAlive && !c.dead) { c.phase = HEAD; c.served = true; }
+  else { lwip_close(c.fd); release(c); return; }
+  if (c.in.length()) process(c, nullptr, 0);
+}
+
+// Errors found by the parser: answered without a handler, then closed
+void HttpServer::reply(Connection &c, int code, const char *text) {
+  c.keepAlive = false;
+  c.in = String();
+  _responseHeaders = String();
+  _lengthSet = false;
+  c.responded = false;
+  _cur = &c;
+  send(code, "text/plain", text);
+  _cur = nullptr;
+  finishRequest(c);
+}
+
+// ------------------------------------------
+//  Request accessors
+// ------------------------------------------
+String HttpServer::arg(const String &name) const {
+  if (_cur) for (const Param &p : _cur->args) if (p.name == name) return p.value;
+  return String();
+}
+
+String HttpServer::arg(int i) const {
+  return _cur && i >= 0 && i < (int)_cur->args.size() ? _cur->args[i].value : String();
+}
+
+String HttpServer::argName(int i) const {
+  return _cur && i >= 0 && i < (int)_cur->args.size() ? _cur->args[i].name : String();
+}
+
+bool HttpServer::hasArg(const String &name) const {
+  if (_cur) for (const Param &p : _cur->args) if (p.name == name) return true;
+  return false;
+}
+
+String HttpServer::header(const String &name) const {
+  if (_cur) for (const Param &p : _cur->headers) if (p.name.equalsIgnoreCase(name)) return p.value;
+  return String();
+}
+
+bool HttpServer::hasHeader(const String &name) const {
+  if (_cur) for (const Param &p : _cur->headers) if (p.name.equalsIgnoreCase(name)) return true;
+  return false;
+}
+
+int HttpServer::detachClient() {
+  if (!_cur || _cur->responded || hasOutput(*_cur)) return -1;
+  _detached = true;
+  return _cur->fd;
+}
+
+// ------------------------------------------
+//  Responses
+// ------------------------------------------
+void HttpServer::sendHeader(const String &name, const String &value, bool first) {
+  if (!_cur) return;
+  if (name.equalsIgnoreCase("Connection")) {
+    // Framing headers are ours; a handler can only ask to close
+    if (value.equalsIgnoreCase("close")) _cur->keepAlive = false;
+    return;
+  }
+  String line = name;
+  line += ": "; line += value; line += "\r\n";
+  if (first) { line += _responseHeaders; _responseHeaders = line; }
+  else _responseHeaders += line;
+}
+
+void HttpServer::startResponse(Connection &c, int code, const char *contentType, size_t length) {
+  c.responded = true;
+  c.chunked = length == CONTENT_LENGTH_UNKNOWN && c.http11;
+  if (length == CONTENT_LENGTH_UNKNOWN && !c.http11) c.keepAlive = false;  // HTTP/1.0: the close ends it
+  String head;
+  head.reserve(128 + _responseHeaders.length());
+  head = "HTTP/1.1 ";
+  head += String(code); head += ' '; head += reason(code); head += "\r\n";
+  if (contentType && *contentType) { head += "Content-Type: "; head += contentType; head += "\r\n"; }
+  if (c.chunked) head += "Transfer-Encoding: chunked\r\n";
+  else if (length != CONTENT_LENGTH_UNKNOWN) { head += "Content-Length: "; head += String((unsigned long)length); head += "\r\n"; }
+  head += c.keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+  head += _responseHeaders;
+  head += "\r\n";
+  queue(c, head.c_str(), head.length(), false);
+}
+
+void HttpServer::send(int code, const char *contentType, const String &content) {
+  if (!_cur || _cur->responded) return;
+  startResponse(*_cur, code, contentType, _lengthSet ? _contentLength : content.length());
+  if (content.length()) sendContent(content.c_str(), content.length());
+  else if (!flushSome(*_cur)) _cur->dead = true;
+}
+
+void HttpServer::send_P(int code, const char *contentType, const char *content, size_t length) {
+  if (!_cur || _cur->responded) return;
+  Connection &c = *_cur;
+  startResponse(c, code, contentType, length);
+  if (c.dead) return;
+  c.tail = content;
+  c.tailLen = length;
+  if (!flushSome(c)) c.dead = true;
+}
+
+void HttpServer::sendContent(const char *content, size_t length) {
+  if (!_cur || !_cur->responded) return;
+  Connection &c = *_cur;
+  if (!c.chunked) { queue(c, content, length); return; }
+  if (!length) { queue(c, "0\r\n\r\n", 5); c.chunked = false; return; }
+  char size[12];
+  int n = snprintf(size, sizeof(size), "%x\r\n", (unsigned)length);
+  queue(c, size, n, false);
+  queue(c, content, length, false);
+  queue(c, "\r\n", 2);
+}
+
+// Appends to the connection's output and writes what the socket takes now.
+// Only a handler holds the lock waitWritable() hands back; outside one
+// (parser errors, the closing chunk) run() flushes the rest.
+void HttpServer::queue(Connection &c, const char *data, size_t len, bool flush) {
+  if (c.dead || !len) return;
+  c.out.concat(data, len);
+  if (!flush) return;
+  if (!flushSome(c)) { c.dead = true; return; }
+  if (_inHandler && c.out.length() - c.outSent > OUT_LIMIT) waitWritable(c);
+}
+
+// Non-blocking; false once the connection is gone
+bool HttpServer::flushSome(Connection &c) {
+  if (c.dead) return false;
+  while (c.outSent < c.out.length()) {
+    int n = lwip_send(c.fd, c.out.c_str() + c.outSent, c.out.length() - c.outSent, MSG_DONTWAIT);
+    if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK;
+    c.outSent += n;
+    c.lastActivity = millis();
+  }
+  if (c.outSent) { c.out = String(); c.outSent = 0; }
+  while (c.tailLen) {
+    int n = lwip_send(c.fd, c.tail, c.tailLen, MSG_DONTWAIT);
+    if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK;
+    c.tail += n;
+    c.tailLen -= n;
+    c.lastActivity = millis();
+  }
+  c.tail = nullptr;
+  return true;
+}
+
+// A handler streaming more than the socket takes: loop() gets the lock back
+// while the network catches up
+void HttpServer::waitWritable(Connection &c) {
+  unlock();
+  while (!c.dead && c.out.length() - c.outSent > OUT_LIMIT) {
+    fd_set wr;
+    FD_ZERO(&wr);
+    FD_SET(c.fd, &wr);
+    struct timeval tv = { 0, 100000 };
+    if (lwip_select(c.fd + 1, nullptr, &wr, nullptr, &tv) > 0 && !flushSome(c)) c.dead = true;
+    if (millis() - c.lastActivity > STALL_MS) c.dead = true;
+  }
+  if (c.dead) { c.out = String(); c.outSent = 0; c.tail = nullptr; c.tailLen = 0; }
+  lock();
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include <Arduino.h>
+#include <WebServer.h>   // HTTPMethod, HTTPUpload, CONTENT_LENGTH_UNKNOWN: handlers read as before
+#include <functional>
+#include <vector>
+
+// ==========================================
+//          EVENT-DRIVEN HTTP SERVER
+// ==========================================
+// Serves the dashboard from its own task instead of loop(): one select()
+// over the listening socket and up to MAX_CONNECTIONS keep-alive
+// connections, all non-blocking. Requests are parsed as their bytes arrive,
+// so a slow client only holds up its own connection, and an upload streams
+// to the route's upload handler packet by packet. Handlers keep the
+// WebServer calls (arg(), send(), ...) and run under the lock loop() holds
+// for a clock pass: they see the same state as before, and loop() and the
+// handlers remain the only producers of motion commands, one at a time.
+// Responses are queued and written as the socket takes them; a handler only
+// waits for the network (lock released) once it queued more than OUT_LIMIT.
+
+class HttpServer {
+  public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    static const int MAX_CONNECTIONS = 4;    // lwIP has 10 sockets; EventStream keeps up to 4
+    static const uint32_t IDLE_MS = 15000;   // Keep-alive connection with no request
+    static const uint32_t STALL_MS = 10000;  // Request or response making no progress
+    static const size_t MAX_HEAD = 2048;     // Request line and headers
+    static const size_t MAX_BODY = 4096;     // Bodies parsed whole (forms, JSON)
+    static const size_t OUT_LIMIT = 8192;    // Queued response bytes before a handler waits
+    static const uint32_t TASK_STACK = 8192; // Handlers ran on loop()'s 8 KB before
+    static const int TASK_PRIORITY = 2;      // Above loop(): a request is served as it comes in
+
+    explicit HttpServer(int port = 80) : _port(port) {}
+    // Listens and starts the server task on core 0; handlers run holding lock
+    void begin(SemaphoreHandle_t lock);
+
+    void on(const String &uri, THandlerFunction fn) { on(uri, HTTP_ANY, fn); }
+    void on(const String &uri, HTTPMethod method, THandlerFunction fn) { on(uri, method, fn, nullptr); }
+    void on(const String &uri, HTTPMethod method, THandlerFunction fn, THandlerFunction upload);
+    void onNotFound(THandlerFunction fn) { _notFound = fn; }
+    void collectHeaders(const char *headerKeys[], size_t count);
+
+    // --- Request being handled ---
+    String uri() const { return _cur ? _cur->uri : String(); }
+    HTTPMethod method() const { return _cur ? _cur->method : HTTP_GET; }
+    String arg(const String &name) const;
+    String arg(int i) const;
+    String argName(int i) const;
+    int args() const { return _cur ? (int)_cur->args.size() : 0; }
+    bool hasArg(const String &name) const;
+    String header(const String &name) const;
+    bool hasHeader(const String &name) const;
+    HTTPUpload &upload() { return _upload; }
+    // The request's socket, which from now on belongs to the caller
+    // (EventStream); nothing may have been sent on it yet. -1 outside a handler.
+    int detachClient();
+
+    // --- Response ---
+    void sendHeader(const String &name, const String &value, bool first = false);
+    void setContentLength(size_t length) { _contentLength = length; _lengthSet = true; }  // CONTENT_LENGTH_UNKNOWN = chunked
+    void send(int code, const char *contentType = nullptr, const String &content = String());
+    void send(int code, const String &contentType, const String &content) { send(code, contentType.c_str(), content); }
+    void send(int code, const char *contentType, const char *content) { send(code, contentType, String(content)); }
+    // Body straight from flash, never copied; it must be the whole response
+    void send_P(int code, const char *contentType, const char *content, size_t length);
+    void send_P(int code, const char *contentType, const char *content) { send_P(code, contentType, content, strlen(content)); }
+    void sendContent(const String &content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char *content, size_t length);  // Empty ends a chunked response
+    void sendContent_P(const char *content, size_t length) { sendContent(content, length); }
+
+    // --- Counters (/metrics) ---
+    uint32_t accepted() const { return _accepted; }
+    uint32_t requests() const { return _requests; }
+    uint32_t evicted() const { return _evicted; }   // Idle keep-alives closed to admit a new client
+    int openConnections() const { return _open; }
+
+  private:
+    enum Phase : uint8_t { FREE, HEAD, BODY, MULTIPART, DRAIN };
+    enum PartState : uint8_t { PART_PREAMBLE, PART_AFTER_BOUNDARY, PART_HEADERS, PART_DATA, PART_END };
+    struct Route { String uri; HTTPMethod method; THandlerFunction fn; THandlerFunction upload; };
+    struct Param { String name; String value; };
+
+    struct Connection {
+      int fd = -1;
+      Phase phase = FREE;
+      String in;                 // Unparsed request text
+      String out;                // Queued response bytes
+      size_t outSent = 0;
+      const char *tail = nullptr;  // send_P body, after out
+      size_t tailLen = 0;
+      uint32_t lastActivity = 0;
+      bool keepAlive = false;
+      bool http11 = false;
+      bool chunked = false;      // Response framing
+      bool responded = false;
+      bool dead = false;         // Write failed or stalled: close once the handler returns
+      bool served = false;       // Answered a request: idle now, it is a keep-alive
+      // Request
+      String uri;
+      HTTPMethod method = HTTP_GET;
+      std::vector<Param> args;
+      std::vector<Param> headers;  // Only those asked for with collectHeaders()
+      String contentType;
+      size_t bodyLeft = 0;
+      int route = -1;
+      // Multipart upload
+      String delimiter;          // "\r\n--" boundary
+      size_t matched = 0;        // Delimiter bytes seen at the end of the data so far
+      PartState part = PART_PREAMBLE;
+      bool fileOpen = false;
+      String field;              // Non-file part: name, then value in fieldValue
+      String fieldValue;
+    };
+
+    static void serverTask(void *param);
+    void run();
+    void acceptClient();
+    void closeConnection(Connection &c);
+    void release(Connection &c);
+    void readFrom(Connection &c);
+    void process(Connection &c, const char *data, size_t len);
+    bool parseHead(Connection &c, int end);
+    void feedMultipart(Connection &c, const char *data, size_t len);
+    void partHeaders(Connection &c, const String &text);
+    void partData(Connection &c, const char *data, size_t len);
+    void endPart(Connection &c);
+    void uploadCall(Connection &c, HTTPUploadStatus status);
+    void callHandler(Connection &c);
+    void dispatch(Connection &c);
+    void finishRequest(Connection &c);
+    void afterResponse(Connection &c);
+    void reply(Connection &c, int code, const char *text);
+    void startResponse(Connection &c, int code, const char *contentType, size_t length);
+    void queue(Connection &c, const char *data, size_t len, bool flush = true);
+    bool flushSome(Connection &c);
+    void waitWritable(Connection &c);
+    void lock() { if (_lock) xSemaphoreTake(_lock, portMAX_DELAY); }
+    void unlock() { if (_lock) xSemaphoreGive(_lock); }
+    static void addArgs(Connection &c, const String &query);
+    static bool idle(const Connection &c) { return c.phase == HEAD && !c.in.length() && !hasOutput(c); }
+    // Kept alive after a response, nothing since: closed to admit a new client
+    static bool evictable(const Connection &c) { return c.served && idle(c); }
+    static bool hasOutput(const Connection &c) { return c.outSent < c.out.length() || c.tailLen; }
+
+    int _port;
+    int _listenFd = -1;
+    SemaphoreHandle_t _lock = nullptr;
+    std::vector<Route> _routes;
+    THandlerFunction _notFound;
+    std::vector<String> _wantedHeaders;
+    Connection _conns[MAX_CONNECTIONS];
+    int _open = 0;
+    int _uploading = -1;         // Connection streaming an upload: one at a time
+
+    // Request being handled: one at a time, all in the server task
+    Connection *_cur = nullptr;
+    HTTPUpload _upload;
+    size_t _uploadFill = 0;      // Bytes in _upload.buf
+    String _responseHeaders;
+    size_t _contentLength = CONTENT_LENGTH_UNKNOWN;
+    bool _lengthSet = false;
+    bool _detached = false;
+    bool _inHandler = false;     // The app lock is held for a handler
+
+    char _rx[1460];              // One TCP segment
+    uint32_t _accepted = 0, _requests = 0, _evicted = 0;
+};
@@ -0,0 +1,189 @@
+#include "Inflater.h"
+
+// Length symbols 257..285 and distance symbols 0..29: base value, extra bits
+static const uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                          35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                          3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t DIST_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t DIST_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+bool Inflater::begin(uint8_t windowBits) {
+  free(_window);
+  _window = nullptr;
+  _error = nullptr;
+  _pos = _flushed = 0;
+  _in = nullptr; _inLen = 0;
+  _bitBuf = 0; _bitCount = 0;
+  if (windowBits < MIN_WINDOW_BITS || windowBits > MAX_WINDOW_BITS) return fail("Unsupported window size");
+  _size = 1UL << windowBits;
+  _window = (uint8_t *)malloc(_size);
+  return _window ? true : fail("Out of memory for the window");
+}
+
+bool Inflater::run(Source source, Sink sink) {
+  if (!_window) return fail("Not started");
+  _source = source;
+  _sink = sink;
+  int last;
+  do {
+    last = bits(1);
+    int type = bits(2);
+    if (last < 0 || type < 0) return false;
+    bool ok;
+    switch (type) {
+      case 0: ok = stored(); break;
+      case 1: ok = fixedTables() && codes(_lengths, _distances); break;
+      case 2: ok = dynamicTables() && codes(_lengths, _distances); break;
+      default: ok = fail("Bad block type");
+    }
+    if (!ok) return false;
+  } while (!last);
+  return flush();
+}
+
+// Up to 16 bits, LSB first; -1 once the input ran out
+int Inflater::bits(int n) {
+  while (_bitCount < n) {
+    if (!_inLen) {
+      _inLen = _source(&_in);
+      if (!_inLen) { fail("Compressed data ends early"); return -1; }
+    }
+    _bitBuf |= (uint32_t)*_in++ << _bitCount;
+    _inLen--;
+    _bitCount += 8;
+  }
+  int value = _bitBuf & ((1UL << n) - 1);
+  _bitBuf >>= n;
+  _bitCount -= n;
+  return value;
+}
+
+// Canonical codes: walk the lengths, one bit at a time
+int Inflater::decode(const Huffman &h) {
+  int code = 0, first = 0, index = 0;
+  for (int len = 1; len < 16; len++) {
+    int b = bits(1);
+    if (b < 0) return -1;
+    code |= b;
+    int count = h.count[len];
+    if (code < first + count) return h.symbol[index + code - first];
+    index += count;
+    first = (first + count) << 1;
+    code <<= 1;
+  }
+  fail("Bad Huffman code");
+  return -1;
+}
+
+bool Inflater::build(Huffman &h, const uint8_t *lengths, int n) {
+  memset(h.count, 0, sizeof(h.count));
+  for (int s = 0; s < n; s++) h.count[lengths[s]]++;
+  h.count[0] = 0;
+  int left = 1;
+  for (int len = 1; len < 16; len++) {
+    left = (left << 1) - h.count[len];
+    if (left < 0) return fail("Over-subscribed code");
+  }
+  uint16_t offsets[16];
+  offsets[1] = 0;
+  for (int len = 1; len < 15; len++) offsets[len + 1] = offsets[len] + h.count[len];
+  for (int s = 0; s < n; s++) if (lengths[s]) h.symbol[offsets[lengths[s]]++] = s;
+  return true;
+}
+
+bool Inflater::stored() {
+  _bitBuf = 0; _bitCount = 0;  // Rest of the current byte
+  int lo = bits(8), hi = bits(8), nlo = bits(8), nhi = bits(8);
+  if (nhi < 0) return false;
+  uint16_t len = lo | hi << 8;
+  if (len != (uint16_t)~(nlo | nhi << 8)) return fail("Stored block length check");
+  while (len--) {
+    int b = bits(8);
+    if (b < 0 || !put(b)) return false;
+  }
+  return true;
+}
+
+bool Inflater::codes(const Huffman &lengths, const Huffman &distances) {
+  uint32_t mask = _size - 1;
+  for (;;) {
+    int sym = decode(lengths);
+    if (sym < 0) return false;
+    if (sym < 256) { if (!put(sym)) return false; continue; }
+    if (sym == 256) return true;
+    sym -= 257;
+    if (sym >= 29) return fail("Bad length symbol");
+    int extra = bits(LENGTH_EXTRA[sym]);
+    int dsym = decode(distances);
+    if (extra < 0 || dsym < 0) return false;
+    if (dsym >= 30) return fail("Bad distance symbol");
+    int dextra = bits(DIST_EXTRA[dsym]);
+    if (dextra < 0) return false;
+    uint32_t len = LENGTH_BASE[sym] + extra, dist = DIST_BASE[dsym] + dextra;
+    if (dist > _pos || dist > _size) return fail("Distance beyond the window");
+    while (len--) if (!put(_window[(_pos - dist) & mask])) return false;
+  }
+}
+
+bool Inflater::fixedTables() {
+  uint8_t lengths[288];
+  memset(lengths, 8, 144); memset(lengths + 144, 9, 112); memset(lengths + 256, 7, 24); memset(lengths + 280, 8, 8);
+  if (!build(_lengths, lengths, 288)) return false;
+  memset(lengths, 5, 30);
+  return build(_distances, lengths, 30);
+}
+
+bool Inflater::dynamicTables() {
+  static const uint8_t ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+  int nlen = bits(5) + 257, ndist = bits(5) + 1, ncode = bits(4) + 4;
+  if (ncode < 4) return false;
+  if (nlen > 286 || ndist > 30) return fail("Bad table counts");
+
+  uint8_t lengths[286 + 30] = {};
+  for (int i = 0; i < ncode; i++) {
+    int b = bits(3);
+    if (b < 0) return false;
+    lengths[ORDER[i]] = b;
+  }
+  if (!build(_lengths, lengths, 19)) return false;  // Code length code, for now
+
+  int index = 0;
+  while (index < nlen + ndist) {
+    int sym = decode(_lengths);
+    if (sym < 0) return false;
+    if (sym < 16) { lengths[index++] = sym; continue; }
+    int len = 0, repeat;
+    if (sym == 16) {
+      if (index == 0) return fail("Repeat with no length");
+      len = lengths[index - 1];
+      repeat = 3 + bits(2);
+    } else if (sym == 17) {
+      repeat = 3 + bits(3);
+    } else {
+      repeat = 11 + bits(7);
+    }
+    if (repeat < 3) return false;
+    if (index + repeat > nlen + ndist) return fail("Too many lengths");
+    while (repeat--) lengths[index++] = len;
+  }
+  if (lengths[256] == 0) return fail("No end-of-block code");
+  memset(lengths + index, 0, sizeof(lengths) - index);
+  return build(_lengths, lengths, nlen) && build(_distances, lengths + nlen, ndist);
+}
+
+bool Inflater::put(uint8_t b) {
+  _window[_pos & (_size - 1)] = b;
+  _pos++;
+  return _pos - _flushed < _size || flush();
+}
+
+// Only ever whole windows, then the tail: never wraps
+bool Inflater::flush() {
+  uint32_t n = _pos - _flushed;
+  if (!n) return true;
+  _flushed = _pos;
+  return _sink(_window, n) || fail("Output refused");
+}
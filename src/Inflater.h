@@ -0,0 +1,58 @@
+#pragma once
+#include <Arduino.h>
+#include <functional>
+
+// ==========================================
+//          STREAMING DEFLATE DECODER
+// ==========================================
+// Raw deflate (RFC 1951) with the output window as the only buffer: input is
+// pulled chunk by chunk from a Source, output goes to a Sink each time the
+// window fills. RAM is the window (1 << windowBits, chosen by the encoder)
+// plus ~1.3 KB of code tables, whatever the size of the stream. Decoding is
+// the canonical-Huffman walk of zlib's puff: slow next to zlib proper, but
+// far ahead of what WiFi delivers.
+
+class Inflater {
+  public:
+    typedef std::function<size_t(const uint8_t **data)> Source;      // Next input chunk, 0 = end
+    typedef std::function<bool(const uint8_t *data, size_t len)> Sink;  // false stops decoding
+
+    static const uint8_t MIN_WINDOW_BITS = 8;
+    static const uint8_t MAX_WINDOW_BITS = 15;
+
+    ~Inflater() { free(_window); }
+    bool begin(uint8_t windowBits);  // Allocates the window
+    bool run(Source source, Sink sink);  // The whole stream, up to its final block
+    const char *error() const { return _error; }
+    uint32_t produced() const { return _pos; }
+
+  private:
+    struct Huffman {
+      uint16_t count[16];   // Codes per length
+      uint16_t symbol[288]; // Symbols ordered by code
+    };
+
+    int bits(int n);
+    int decode(const Huffman &h);
+    bool build(Huffman &h, const uint8_t *lengths, int n);
+    bool stored();
+    bool codes(const Huffman &lengths, const Huffman &distances);
+    bool fixedTables();
+    bool dynamicTables();
+    bool put(uint8_t b);
+    bool flush();
+    bool fail(const char *why) { if (!_error) _error = why; return false; }
+
+    uint8_t *_window = nullptr;
+    uint32_t _size = 0;           // Window bytes, power of two
+    uint32_t _pos = 0;            // Bytes produced
+    uint32_t _flushed = 0;        // Bytes handed to the sink
+    Source _source;
+    Sink _sink;
+    const uint8_t *_in = nullptr;
+    size_t _inLen = 0;
+    uint32_t _bitBuf = 0;
+    int _bitCount = 0;
+    const char *_error = nullptr;
+    Huffman _lengths, _distances;
+};
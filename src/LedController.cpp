@@ -0,0 +1,98 @@
+#include "LedController.h"
+#include <driver/ledc.h>
+
+static uint16_t gammaTable[256];
+static bool fadeInstalled = false;
+
+static void buildGamma() {
+  const uint32_t maxDuty = (1 << LedController::RESOLUTION) - 1;
+  for (int i = 0; i < 256; i++) {
+    uint32_t duty = lroundf(powf(i / 255.0f, 2.2f) * maxDuty);
+    gammaTable[i] = (i > 0 && duty == 0) ? 1 : duty;  // Lowest slider step stays lit
+  }
+}
+
+uint32_t LedController::gamma(int brightness) { return gammaTable[constrain(brightness, 0, 255)]; }
+
+// Arduino channels 0-7 are the high speed group, 8-15 the low speed one
+static ledc_mode_t modeOf(int channel) { return (ledc_mode_t)(channel / 8); }
+static ledc_channel_t channelOf(int channel) { return (ledc_channel_t)(channel % 8); }
+
+void LedController::begin(int pin, int channel, bool pwm) {
+  _pin = pin; _channel = channel; _pwm = pwm;
+  if (_pwm) {
+    if (!fadeInstalled) { buildGamma(); ledc_fade_func_install(0); fadeInstalled = true; }
+    ledcSetup(_channel, FREQUENCY, RESOLUTION);
+    ledcAttachPin(_pin, _channel);
+  } else {
+    pinMode(_pin, OUTPUT);
+  }
+  esp_timer_create_args_t args = {};
+  args.callback = onTimer;
+  args.arg = this;
+  args.name = "led";
+  esp_timer_create(&args, &_timer);
+  _applied = false;
+  write(0);
+}
+
+void LedController::set(bool enabled, int brightness, LedEffect effect) {
+  if (_applied && enabled == _enabled && brightness == _brightness && effect == _effect) return;
+  bool restart = !_applied || enabled != _enabled || effect != _effect;
+  _applied = true; _enabled = enabled; _brightness = brightness; _effect = effect;
+
+  if (!enabled || effect == LED_SOLID) {
+    stopEffect();
+    fadeTo(enabled ? gamma(brightness) : 0, FADE_MS);
+    return;
+  }
+  if (!restart) return;  // New brightness: taken up by the next step
+  stopEffect();
+  _phase = 0;
+  effectStep();
+  int stepMs = (effect == LED_BLINK) ? BLINK_MS / 2 : BREATHE_MS / BREATHE_SEGMENTS;
+  esp_timer_start_periodic(_timer, stepMs * 1000ULL);
+}
+
+void LedController::forceOn(int brightness) {
+  stopEffect();
+  write(gamma(brightness));
+  _applied = false;
+}
+
+void LedController::forceOff() {
+  stopEffect();
+  write(0);
+  _applied = false;
+}
+
+void LedController::onTimer(void *arg) { static_cast<LedController *>(arg)->effectStep(); }
+
+void LedController::stopEffect() {
+  if (_timer) esp_timer_stop(_timer);  // Not running is fine
+}
+
+void LedController::write(uint32_t duty) {
+  if (!_pwm) { digitalWrite(_pin, duty ? HIGH : LOW); return; }
+  ledc_set_duty_and_update(modeOf(_channel), channelOf(_channel), duty, 0);
+}
+
+void LedController::fadeTo(uint32_t duty, int ms) {
+  if (!_pwm) { write(duty); return; }
+  ledc_set_fade_time_and_start(modeOf(_channel), channelOf(_channel), duty, ms, LEDC_FADE_NO_WAIT);
+}
+
+void LedController::effectStep() {
+  uint32_t step = _phase++;
+  if (_effect == LED_BLINK || !_pwm) {
+    // Edges land on the timer, no ramp: a blink has to look crisp
+    write(step % 2 == 0 ? gamma(_brightness) : 0);
+    return;
+  }
+  // Breathe: ramp to the next point of a triangle in brightness, so each
+  // segment follows the gamma curve and the whole cycle looks even
+  const int half = BREATHE_SEGMENTS / 2;
+  int k = step % BREATHE_SEGMENTS;
+  int rise = (k < half) ? k + 1 : BREATHE_SEGMENTS - 1 - k;
+  fadeTo(gamma(_brightness * rise / half), BREATHE_MS / BREATHE_SEGMENTS);
+}
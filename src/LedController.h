@@ -0,0 +1,58 @@
+#pragma once
+#include <Arduino.h>
+#include <esp_timer.h>
+
+// ==========================================
+//             LED CONTROLLER
+// ==========================================
+// One LED on an LEDC channel. Brightness (0-255, as on the dashboard) goes
+// through a gamma table into 12-bit duty, so the sliders look even and dim
+// settings stay visible. Changes and effects run on the LEDC fade engine:
+// the peripheral ramps the duty on its own, and an esp_timer only kicks off
+// the next ramp (or blink edge) at exact intervals. Neither depends on
+// loop(), so a blocking handler cannot stall or stretch the blink.
+//
+// Not thread safe: set() / forceOn() / forceOff() from one task (loop()).
+// The timer callback runs in the esp_timer task on the same core.
+
+enum LedEffect : uint8_t { LED_SOLID, LED_BLINK, LED_BREATHE, LED_EFFECTS };
+inline LedEffect ledEffectOf(int value) { return (value >= 0 && value < LED_EFFECTS) ? (LedEffect)value : LED_SOLID; }
+
+class LedController {
+  public:
+    static const int FREQUENCY = 5000;
+    static const int RESOLUTION = 12;
+    static const int FADE_MS = 250;       // Solid: brightness changes and on/off
+    static const int BLINK_MS = 1000;     // Full on/off cycle
+    static const int BREATHE_MS = 4000;   // Full up/down cycle
+
+    void begin(int pin, int channel, bool pwm);
+
+    // Cheap when nothing changed, so it can be called every pass
+    void set(bool enabled, int brightness, LedEffect effect = LED_SOLID);
+
+    // Immediate, no fade; stops any effect until the next set()
+    void forceOn(int brightness);
+    void forceOff();
+
+    static uint32_t gamma(int brightness);
+
+  private:
+    static const int BREATHE_SEGMENTS = 8;  // Linear ramps per cycle, following the gamma curve
+
+    static void onTimer(void *arg);
+    void stopEffect();
+    void write(uint32_t duty);
+    void fadeTo(uint32_t duty, int ms);
+    void effectStep();
+
+    int _pin = -1, _channel = 0;
+    bool _pwm = false;
+    esp_timer_handle_t _timer = nullptr;
+    // What the LED currently shows, as last requested through set()
+    bool _applied = false;
+    bool _enabled = false;
+    int _brightness = 0;
+    LedEffect _effect = LED_SOLID;
+    uint32_t _phase = 0;  // Effect steps since the effect started
+};
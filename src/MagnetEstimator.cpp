@@ -0,0 +1,91 @@
+#include "MagnetEstimator.h"
+
+void MagnetEstimator::begin(int baseline, int threshold) {
+  _baseline = baseline;
+  _threshold = threshold;
+  _release = threshold / 2;
+  _state = ARMING;
+  _clearRun = 0;
+  _preCount = 0; _preHead = 0;
+  _count = 0; _peakDev = 0; _center = 0;
+}
+
+MagnetEstimator::State MagnetEstimator::add(int32_t position, uint16_t value) {
+  int dev = deviation(value);
+  ProfilePoint pt = { position, value };
+
+  switch (_state) {
+    case ARMING:
+      // Don't start mid-pulse (e.g. when already parked on the magnet)
+      _clearRun = (dev < _release) ? _clearRun + 1 : 0;
+      if (_clearRun >= ARM_SAMPLES) _state = WAITING;
+      break;
+
+    case WAITING:
+      if (dev >= _threshold) {
+        // Trigger: keep the recent rising flank, oldest first
+        for (int i = 0; i < _preCount; i++) {
+          _samples[_count++] = _pre[(_preHead + PRE_SAMPLES - _preCount + i) % PRE_SAMPLES];
+        }
+        _samples[_count++] = pt;
+        _peakDev = dev;
+        _clearRun = 0;
+        _state = CAPTURING;
+      } else {
+        _pre[_preHead] = pt;
+        _preHead = (_preHead + 1) % PRE_SAMPLES;
+        if (_preCount < PRE_SAMPLES) _preCount++;
+      }
+      break;
+
+    case CAPTURING:
+      if (_count >= MAX_SAMPLES && !compact()) { _state = OVERFLOW; break; }
+      _samples[_count++] = pt;
+      if (dev > _peakDev) _peakDev = dev;
+      // Clear means under the release level and the 25% floor, so a high
+      // threshold doesn't cut off a falling flank the centroid still weighs
+      _clearRun = (dev < _release && dev * 4 <= _peakDev) ? _clearRun + 1 : 0;
+      if (_clearRun >= TAIL_SAMPLES) finish();
+      break;
+
+    default:
+      break;
+  }
+  return _state;
+}
+
+// Full buffer: drop the samples under the current 25% floor. The peak only
+// grows, so they would get no weight in the centroid anyway.
+bool MagnetEstimator::compact() {
+  int kept = 0;
+  for (int i = 0; i < _count; i++) {
+    if (deviation(_samples[i].value) * 4 > _peakDev) _samples[kept++] = _samples[i];
+  }
+  bool freed = kept < _count;
+  _count = kept;
+  return freed;
+}
+
+void MagnetEstimator::finish() {
+  _center = centroid(_samples, _count, _baseline);
+  _state = DONE;
+}
+
+float MagnetEstimator::centroid(const ProfilePoint *pts, int n, int baseline, float floorFraction) {
+  int peak = 0;
+  for (int i = 0; i < n; i++) {
+    int d = (int)pts[i].value - baseline; if (d < 0) d = -d;
+    if (d > peak) peak = d;
+  }
+  float floor = peak * floorFraction;
+
+  double sumW = 0, sumWP = 0;
+  for (int i = 0; i < n; i++) {
+    int d = (int)pts[i].value - baseline; if (d < 0) d = -d;
+    float w = d - floor;
+    if (w <= 0) continue;
+    sumW += w; sumWP += w * (double)pts[i].position;
+  }
+  if (sumW <= 0) return n ? (float)pts[n / 2].position : 0.0f;
+  return (float)(sumWP / sumW);
+}
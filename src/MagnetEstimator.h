@@ -0,0 +1,61 @@
+#pragma once
+#include <stdint.h>
+
+// ==========================================
+//        MAGNET CENTER ESTIMATOR
+// ==========================================
+// Records the hall signal against step position while a spool sweeps past
+// its magnet and returns the weighted centroid of the pulse. Only samples
+// above 25% of the peak deviation carry weight, so the result does not
+// depend on the detection threshold and is symmetric in both flanks.
+// Plain C++ (no Arduino dependencies) so it can be fed recorded traces on a
+// host machine.
+
+struct ProfilePoint {
+  int32_t position;
+  uint16_t value;
+};
+
+class MagnetEstimator {
+  public:
+    static const int MAX_SAMPLES = 256;
+    // Rising flank kept from before the trigger: at homing speed it reaches
+    // back to the 25% floor for triggers up to ~85% of the peak
+    static const int PRE_SAMPLES = 64;
+    static const int ARM_SAMPLES = 8;    // Clear samples required before a pass counts
+    static const int TAIL_SAMPLES = 8;   // Clear samples that close a pass
+
+    enum State : uint8_t { ARMING, WAITING, CAPTURING, DONE, OVERFLOW };
+
+    void begin(int baseline, int threshold);
+    State add(int32_t position, uint16_t value);
+
+    State state() const { return _state; }
+    bool done() const { return _state == DONE; }
+    int count() const { return _count; }
+    const ProfilePoint *samples() const { return _samples; }
+    int peakDeviation() const { return _peakDev; }
+    float center() const { return _center; }
+
+    // Weighted centroid of |value - baseline| above floorFraction * peak
+    static float centroid(const ProfilePoint *pts, int n, int baseline, float floorFraction = 0.25f);
+
+  private:
+    int deviation(uint16_t value) const { int d = (int)value - _baseline; return d < 0 ? -d : d; }
+    void finish();
+    bool compact();
+
+    int _baseline = 0;
+    int _threshold = 0;
+    int _release = 0;     // Hysteresis: below this the sensor counts as clear
+    State _state = ARMING;
+    int _clearRun = 0;
+
+    ProfilePoint _pre[PRE_SAMPLES];
+    int _preCount = 0; int _preHead = 0;
+
+    ProfilePoint _samples[MAX_SAMPLES];
+    int _count = 0;
+    int _peakDev = 0;
+    float _center = 0;
+};
@@ -0,0 +1,46 @@
+#include "Metrics.h"
+
+void MetricsWriter::family(const char *name, const char *type, const char *help) {
+  char text[192];
+  snprintf(text, sizeof(text), "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+  line(text);
+}
+
+void MetricsWriter::sample(const char *name, const char *labels, double value) {
+  char text[160];
+  if (labels[0]) snprintf(text, sizeof(text), "%s{%s} %.10g\n", name, labels, value);
+  else snprintf(text, sizeof(text), "%s %.10g\n", name, value);
+  line(text);
+}
+
+void MetricsWriter::histogram(const char *name, const char *labels, const Histogram &h) {
+  // A sample landing mid-render can put _count one off the +Inf bucket;
+  // report the larger so a scraper never sees the buckets exceed the total
+  char text[192];
+  const char *sep = labels[0] ? "," : "";
+  uint32_t cumulative = 0;
+  for (int i = 0; i <= h.buckets(); i++) {
+    cumulative += h.bucket(i);
+    if (i < h.buckets()) {
+      snprintf(text, sizeof(text), "%s_bucket{%s%sle=\"%.9g\"} %u\n", name, labels, sep, h.bound(i) / 1e6, (unsigned)cumulative);
+    } else {
+      snprintf(text, sizeof(text), "%s_bucket{%s%sle=\"+Inf\"} %u\n", name, labels, sep, (unsigned)cumulative);
+    }
+    line(text);
+  }
+  char suffixed[96];
+  snprintf(suffixed, sizeof(suffixed), "%s_sum", name);
+  sample(suffixed, labels, h.sum() / 1e6);
+  snprintf(suffixed, sizeof(suffixed), "%s_count", name);
+  sample(suffixed, labels, max(h.count(), cumulative));
+}
+
+void MetricsWriter::finish() {
+  if (_buf.length()) _sink(_buf);
+  _buf = "";
+}
+
+void MetricsWriter::line(const char *text) {
+  _buf += text;
+  if (_buf.length() >= CHUNK) finish();
+}
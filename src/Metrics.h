@@ -0,0 +1,61 @@
+#pragma once
+#include <Arduino.h>
+#include <functional>
+
+// ==========================================
+//      METRICS (PROMETHEUS TEXT FORMAT)
+// ==========================================
+// Histograms with power-of-two microsecond buckets: add() is a count of
+// leading zeros and three increments, cheap enough for the step ISR. Each
+// histogram has exactly one writer (a task or an ISR); readers on the other
+// core may see a sample half-counted, which a scraper shrugs off.
+// MetricsWriter renders them (and plain values) as Prometheus text, in
+// chunks, so /metrics never holds the whole page in RAM.
+
+class Histogram {
+  public:
+    static const int MAX_BUCKETS = 24;
+
+    // Buckets le = 2^minLog2 .. 2^maxLog2 us, then +Inf
+    explicit Histogram(uint8_t minLog2 = 6, uint8_t maxLog2 = 20)
+      : _min(minLog2), _max(min<int>(maxLog2, minLog2 + MAX_BUCKETS - 1)) {}
+
+    inline void IRAM_ATTR add(uint32_t us) {
+      int log2 = us <= 1 ? 0 : 32 - __builtin_clz(us - 1);  // Smallest k with us <= 2^k
+      int i = log2 <= _min ? 0 : log2 - _min;
+      if (i > _max - _min) i = _max - _min + 1;
+      _counts[i]++; _sum += us; _count++;
+    }
+
+    int buckets() const { return _max - _min + 1; }          // Finite ones
+    uint32_t bound(int i) const { return 1UL << (_min + i); } // us
+    uint32_t bucket(int i) const { return _counts[i]; }       // Not cumulative; buckets() = +Inf
+    uint32_t count() const { return _count; }
+    uint64_t sum() const { return _sum; }
+
+  private:
+    uint8_t _min, _max;
+    volatile uint32_t _counts[MAX_BUCKETS + 1] = {};
+    volatile uint64_t _sum = 0;
+    volatile uint32_t _count = 0;
+};
+
+class MetricsWriter {
+  public:
+    typedef std::function<void(const String &)> Sink;
+    explicit MetricsWriter(Sink sink) : _sink(sink) {}
+
+    // Once per metric name, before its samples
+    void family(const char *name, const char *type, const char *help);
+    // labels: "" or e.g. axis="hours"
+    void sample(const char *name, const char *labels, double value);
+    void histogram(const char *name, const char *labels, const Histogram &h);  // In seconds
+    void finish();
+
+  private:
+    static const size_t CHUNK = 1024;
+    void line(const char *text);
+
+    Sink _sink;
+    String _buf;
+};
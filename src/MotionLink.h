@@ -0,0 +1,110 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+
+// ==========================================
+//        CORE 0 <-> CORE 1 MOTION LINK
+// ==========================================
+// The clock/HTTP side (core 0) talks to the motion task (core 1) through a
+// lock-free single-producer/single-consumer queue and reads back a status
+// snapshot guarded by a sequence counter. Neither side ever blocks the other.
+
+template <typename T, uint32_t N>
+class SpscQueue {
+  static_assert((N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+  public:
+    bool push(const T &item) {
+      uint32_t head = _head.load(std::memory_order_relaxed);
+      if (head - _tail.load(std::memory_order_acquire) >= N) return false; // Full
+      _items[head & (N - 1)] = item;
+      _head.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool pop(T &item) {
+      uint32_t tail = _tail.load(std::memory_order_relaxed);
+      if (tail == _head.load(std::memory_order_acquire)) return false; // Empty
+      item = _items[tail & (N - 1)];
+      _tail.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+  private:
+    T _items[N];
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _tail{0};
+};
+
+// Single writer, any number of readers. Readers retry if they raced a publish.
+template <typename T>
+class Snapshot {
+  public:
+    void publish(const T &value) {
+      uint32_t seq = _seq.load(std::memory_order_relaxed);
+      _seq.store(seq + 1, std::memory_order_relaxed); // Odd = write in progress
+      std::atomic_thread_fence(std::memory_order_release);
+      _data = value;
+      std::atomic_thread_fence(std::memory_order_release);
+      _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    T read() const {
+      T copy;
+      uint32_t before, after;
+      do {
+        before = _seq.load(std::memory_order_acquire);
+        copy = _data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = _seq.load(std::memory_order_relaxed);
+      } while ((before & 1) || before != after);
+      return copy;
+    }
+
+  private:
+    T _data = {};
+    std::atomic<uint32_t> _seq{0};
+};
+
+// --- Commands (core 0 -> core 1) ---
+enum MotionCommandType : uint8_t {
+  MOTION_SHOW,        // a = hour value, b = minute value, c = hold (ms) before the next queued target
+  MOTION_SHOW_AT,     // a = hour value, b = minute value, c = micros() the flaps should settle at
+  MOTION_HOME,        // a = measure baseline, b = count steps
+  MOTION_CANCEL_HOME, // Abort a running homing/calibration
+  MOTION_SET_SPEED,   // a = max speed (steps/s)
+  MOTION_OUTPUTS,     // a = 1 energize / 0 release coils
+  MOTION_POWER_SAVER, // a = 1 release coils 2s after each move
+  MOTION_PARK         // a = 1 finish the current move, then ignore targets; 0 = resume
+};
+
+struct MotionCommand {
+  uint32_t id;
+  MotionCommandType type;
+  int32_t a;
+  int32_t b;
+  int32_t c;
+};
+
+// --- Status (core 1 -> core 0) ---
+struct MotionStatus {
+  uint32_t lastCommandId;      // Last command consumed by the motion task
+  int32_t positionHours;
+  int32_t positionMinutes;
+  int16_t displayedHour;
+  int16_t displayedMinute;
+  int16_t sensorHours;         // Hall readings (sampler rolling average)
+  int16_t sensorMinutes;
+  bool moving;
+  bool queued;                 // Planner still has targets or a hold to play
+  bool calibrating;
+  bool parked;                 // MOTION_PARK taken and the spools at rest
+  uint8_t calibrationProgress;
+  char calibrationStatus[48];
+  // Pre-positioned minute flips: landing vs. the minute boundary
+  uint32_t landings;
+  uint32_t landingsOnTime;
+  int32_t landingErrorUs;      // Last one, negative = early
+  uint32_t landingMeanAbsUs;
+  uint32_t landingMaxAbsUs;
+  uint32_t moveUs[3];          // Last measured duration: minute, rollover, other
+};
@@ -0,0 +1,73 @@
+#include "MotionProfile.h"
+
+// Position and velocity of the accel half at time t. Three phases of the
+// S-curve (jerk up, constant accel, jerk down), then cruise.
+struct SCurve {
+  float jerk, accel, vMax;
+  float t1, t2;          // Jerk phase and constant accel phase durations
+  float s1, v1, s2, v2, s3;
+
+  void eval(float t, float &s, float &v) const {
+    if (t < t1) {
+      v = jerk * t * t / 2; s = jerk * t * t * t / 6;
+    } else if (t < t1 + t2) {
+      float u = t - t1;
+      v = v1 + accel * u; s = s1 + v1 * u + accel * u * u / 2;
+    } else if (t < 2 * t1 + t2) {
+      float u = t - t1 - t2;
+      v = v2 + accel * u - jerk * u * u / 2; s = s2 + v2 * u + accel * u * u / 2 - jerk * u * u * u / 6;
+    } else {
+      v = vMax; s = s3 + vMax * (t - 2 * t1 - t2);
+    }
+  }
+};
+
+void MotionProfile::build(float maxSpeed, float accel, float jerk, uint32_t timerHz) {
+  SCurve c;
+  c.jerk = jerk; c.vMax = maxSpeed;
+  // Low speeds never reach full accel: the jerk phases meet in the middle
+  c.accel = min(accel, sqrtf(maxSpeed * jerk));
+  c.t1 = c.accel / jerk;
+  c.t2 = (maxSpeed - c.accel * c.t1) / c.accel;
+  c.v1 = c.accel * c.t1 / 2; c.s1 = jerk * c.t1 * c.t1 * c.t1 / 6;
+  c.v2 = c.v1 + c.accel * c.t2; c.s2 = c.s1 + c.v1 * c.t2 + c.accel * c.t2 * c.t2 / 2;
+  c.s3 = c.s2 + c.v2 * c.t1 + c.accel * c.t1 * c.t1 / 2 - jerk * c.t1 * c.t1 * c.t1 / 6;
+
+  // Solve s(t) = n for every step with a few Newton iterations from the
+  // previous step's time; s is monotonic so this converges immediately
+  float cMin = (float)timerHz / maxSpeed;
+  float tPrev = 0, t = cbrtf(6.0f / jerk);
+  uint32_t n = 0;
+  while (n < RAMP_MAX) {
+    float s, v;
+    for (int i = 0; i < 6; i++) {
+      c.eval(t, s, v);
+      float dt = (s - (n + 1)) / v;
+      t -= dt;
+      if (t <= tPrev) t = (tPrev + t + dt) / 2;
+      if (fabsf(dt) < 1e-7f) break;
+    }
+    float ticks = (t - tPrev) * timerHz;
+    if (ticks <= cMin) break;
+    _ramp[n++] = (uint16_t)min(ticks, 65535.0f);
+    tPrev = t;
+    c.eval(t, s, v);
+    t += 1.0f / v;
+  }
+  _rampLen = n;
+  // A table that fills up before cruise caps the top speed at its last
+  // entry rather than jumping straight to maxSpeed
+  _cruise = (n == RAMP_MAX) ? _ramp[n - 1] : (uint32_t)cMin;
+}
+
+uint32_t IRAM_ATTR MotionProfile::interval(uint32_t stepIndex, uint32_t totalSteps) const {
+  uint32_t fromEnd = totalSteps - 1 - stepIndex;
+  uint32_t d = (stepIndex < fromEnd) ? stepIndex : fromEnd;
+  return (d < _rampLen) ? _ramp[d] : _cruise;
+}
+
+uint32_t MotionProfile::moveTicks(uint32_t steps) const {
+  uint32_t total = 0;
+  for (uint32_t i = 0; i < steps; i++) total += interval(i, steps);
+  return total;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <Arduino.h>
+
+// ==========================================
+//        JERK-LIMITED MOTION PROFILE
+// ==========================================
+// Step-interval table for the acceleration half of an S-curve move: jerk
+// ramps the acceleration up, holds it, then ramps it down into cruise, so
+// the motor never sees a torque step. The table is solved once per speed
+// setting; the step ISR only indexes it (decel reads it backwards).
+
+class MotionProfile {
+  public:
+    static const int RAMP_MAX = 1536;  // Max accel steps kept in the table
+
+    // Units are steps/s, steps/s^2, steps/s^3 and timer ticks per second
+    void build(float maxSpeed, float accel, float jerk, uint32_t timerHz);
+
+    // Interval (timer ticks) between step stepIndex and stepIndex + 1 of a
+    // totalSteps long move. stepIndex 0 is the delay before the first step.
+    uint32_t interval(uint32_t stepIndex, uint32_t totalSteps) const;
+
+    // Duration of a whole move from standstill to standstill
+    uint32_t moveTicks(uint32_t steps) const;
+
+    uint32_t rampLength() const { return _rampLen; }
+    uint32_t cruiseInterval() const { return _cruise; }
+
+  private:
+    uint16_t _ramp[RAMP_MAX];
+    uint32_t _rampLen = 0;
+    uint32_t _cruise = 1000;
+};
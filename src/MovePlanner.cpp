@@ -0,0 +1,119 @@
+#include "MovePlanner.h"
+
+void MovePlanner::begin(StepperAxis *hours, StepperAxis *minutes, StepsFn steps) {
+  _hours = hours; _minutes = minutes; _steps = steps;
+  clear();
+}
+
+bool MovePlanner::push(const MoveTarget &target) {
+  if (_count >= MAX_TARGETS) {
+    // A last target without a hold would only be passed through anyway
+    MoveTarget &last = _queue[(_head + _count - 1) % MAX_TARGETS];
+    if (last.holdMs != 0 || last.landAtUs != 0) return false;
+    last = target;
+    return true;
+  }
+  _queue[(_head + _count) % MAX_TARGETS] = target;
+  _count++;
+  return true;
+}
+
+void MovePlanner::clear() {
+  _head = 0; _count = 0;
+  _holdMs = 0; _holding = false;
+  _active = false;
+}
+
+bool MovePlanner::pending() const { return _count > 0 || _holdMs > 0 || _holding; }
+
+bool MovePlanner::next(uint32_t nowUs, int shownH, int shownM, MovePlan &plan) {
+  if (_hours->isRunning() || _minutes->isRunning()) return false;
+  if (_active) finishPlan();
+  if (_holdMs > 0) { _holding = true; _holdUntilUs = nowUs + _holdMs * 1000; _holdMs = 0; } // Just arrived
+  if (_holding && (int32_t)(nowUs - _holdUntilUs) < 0) return false;
+  _holding = false;
+  if (_count == 0) return false;
+
+  // Lookahead: fold targets that would only be passed through into one move.
+  // A timed target always ends the chain, it has its own start time.
+  long posH = _hours->currentPosition(), posM = _minutes->currentPosition();
+  long stepsH = 0, stepsM = 0;
+  int h = shownH, m = shownM;
+  uint8_t used = 0;
+  MoveTarget t;
+  for (;;) {
+    t = _queue[(_head + used) % MAX_TARGETS]; used++;
+    stepsH += _steps(posH + stepsH, h, t.hour, true);
+    stepsM += _steps(posM + stepsM, m, t.minute, false);
+    h = t.hour; m = t.minute;
+    if (t.holdMs != 0 || t.landAtUs != 0 || used >= _count) break;
+    if (_queue[(_head + used) % MAX_TARGETS].landAtUs != 0) break;
+  }
+
+  MoveKind kind = (h == shownH) ? MOVE_MINUTE : (shownM == 59 && m == 0) ? MOVE_ROLLOVER : MOVE_OTHER;
+  uint32_t movesUs = max(_hours->profile().moveTicks((uint32_t)labs(stepsH)),
+                         _minutes->profile().moveTicks((uint32_t)labs(stepsM)));
+  uint32_t durationUs = movesUs;
+  if (t.landAtUs) {
+    int32_t bias = _timing[kind].biasUs;
+    int32_t untilLand = (int32_t)(t.landAtUs - nowUs);
+    if (untilLand > (int32_t)movesUs + bias + (int32_t)START_MARGIN_US) return false; // Not due yet
+    // Due within the margin: hold the first step back so the last one lands on time
+    if (untilLand - bias > (int32_t)movesUs) durationUs = untilLand - bias;
+  }
+
+  _head = (_head + used) % MAX_TARGETS; _count -= used;
+  plan = { (int16_t)h, (int16_t)m, stepsH, stepsM, t.holdMs, t.landAtUs, durationUs, kind };
+  return true;
+}
+
+void MovePlanner::start(const MovePlan &plan) {
+  // The longer move sets the pace, the other one is stretched to land with it
+  uint32_t ticksH = _hours->profile().moveTicks((uint32_t)labs(plan.stepsHours));
+  uint32_t ticksM = _minutes->profile().moveTicks((uint32_t)labs(plan.stepsMinutes));
+  uint32_t syncUs = max(ticksH, ticksM);
+  uint32_t delayUs = (plan.durationUs > syncUs) ? plan.durationUs - syncUs : 0;
+
+  // Preparing takes a pass over the table per axis, so do both before either
+  // timer starts; the starts themselves are a few instructions apart
+  _hours->prepareMove(plan.stepsHours, syncUs, delayUs);
+  _minutes->prepareMove(plan.stepsMinutes, syncUs, delayUs);
+  _startUs = micros();
+  _hours->startPrepared();
+  _minutes->startPrepared();
+
+  _holdMs = plan.holdMs;
+  _plan = plan;
+  _plannedUs = syncUs + delayUs;
+  _active = (plan.stepsHours != 0 || plan.stepsMinutes != 0);
+}
+
+// Scores a plan once both spools stopped: actual duration per kind feeds the
+// next prediction, the landing time vs. target feeds the statistics
+void MovePlanner::finishPlan() {
+  _active = false;
+  uint32_t landedUs = _plan.stepsHours ? _hours->lastStepMicros() : _minutes->lastStepMicros();
+  if (_plan.stepsHours && _plan.stepsMinutes) {
+    int32_t skew = (int32_t)(_minutes->lastStepMicros() - landedUs);
+    if (skew > 0) landedUs = _minutes->lastStepMicros();
+    _sync.count++;
+    _sync.lastSkewUs = (uint32_t)abs(skew);
+    if (_sync.lastSkewUs > _sync.maxSkewUs) _sync.maxSkewUs = _sync.lastSkewUs;
+  }
+
+  MoveTiming &timing = _timing[_plan.kind];
+  timing.lastUs = landedUs - _startUs;
+  int32_t bias = (int32_t)(timing.lastUs - _plannedUs);
+  timing.biasUs = timing.count ? timing.biasUs + (bias - timing.biasUs) / 8 : bias;
+  timing.count++;
+
+  if (!_plan.landAtUs) return;
+  int32_t error = (int32_t)(landedUs - _plan.landAtUs);
+  uint32_t absError = (uint32_t)abs(error);
+  _landing.count++;
+  if (absError <= LAND_TOLERANCE_US) _landing.onTime++;
+  _landing.lastErrorUs = error;
+  _absErrorSumUs += absError;
+  _landing.meanAbsErrorUs = (uint32_t)(_absErrorSumUs / _landing.count);
+  if (absError > _landing.maxAbsErrorUs) _landing.maxAbsErrorUs = absError;
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <Arduino.h>
+#include "StepperAxis.h"
+
+// ==========================================
+//        COORDINATED TWO-AXIS PLANNER
+// ==========================================
+// Turns (hour, minute) targets into one move per spool that arrive on the
+// same timer tick: the longer move runs its full S-curve, the shorter one is
+// stretched in time to match. Targets are queued with an optional hold, so
+// a known sequence (date for dateDurationSeconds, then back to the time) is
+// played by the motion task itself. Consecutive targets without a hold in
+// between are merged into one continuous move instead of stopping at each.
+//
+// A target may also carry the micros() time it should settle at (the next
+// minute boundary). The planner then starts it early by the predicted move
+// time, corrected by what earlier moves of the same kind actually took, and
+// keeps score of how close the landings were.
+
+struct MoveTarget {
+  int16_t hour;
+  int16_t minute;
+  uint32_t holdMs;    // Stay on this target before the next one starts
+  uint32_t landAtUs;  // micros() to settle at, 0 = as soon as possible
+};
+
+enum MoveKind : uint8_t {
+  MOVE_MINUTE,        // Minute spool only
+  MOVE_ROLLOVER,      // :59 -> :00, both spools
+  MOVE_OTHER,         // Hour only, date, catch-up after night, manual
+  MOVE_KINDS
+};
+
+struct MovePlan {
+  int16_t hour;       // Values shown once the plan completes
+  int16_t minute;
+  long stepsHours;
+  long stepsMinutes;
+  uint32_t holdMs;
+  uint32_t landAtUs;
+  uint32_t durationUs; // Start to last step; longer than the moves = delayed start
+  MoveKind kind;
+};
+
+struct MoveTiming {
+  uint32_t count;
+  uint32_t lastUs;     // Measured start-to-last-step time
+  int32_t biasUs;      // Running average of measured - planned
+};
+
+struct LandingStats {
+  uint32_t count;
+  uint32_t onTime;     // Within LAND_TOLERANCE_US of the target
+  int32_t lastErrorUs; // Achieved - target, negative = early
+  uint32_t meanAbsErrorUs;
+  uint32_t maxAbsErrorUs;
+};
+
+struct SyncStats {
+  uint32_t count;      // Plans that turned both spools
+  uint32_t lastSkewUs; // Between the last steps of the two spools
+  uint32_t maxSkewUs;
+};
+
+class MovePlanner {
+  public:
+    static const int MAX_TARGETS = 4;
+    static const uint32_t LAND_TOLERANCE_US = 20000;
+    static const uint32_t START_MARGIN_US = 20000; // Covers the motion task period
+    // Steps to go from a position showing one value to the next (0 if equal)
+    typedef long (*StepsFn)(long fromPosition, int fromValue, int toValue, bool isHour);
+
+    void begin(StepperAxis *hours, StepperAxis *minutes, StepsFn steps);
+
+    bool push(const MoveTarget &target);  // false when the queue is full
+    void clear();                         // Drops pending targets and any hold
+    bool pending() const;                 // Targets queued or a hold not over yet
+
+    // Pops the next target(s) once both spools stopped, the previous hold ran
+    // out and a timed target is due. shownH/shownM are the values displayed.
+    bool next(uint32_t nowUs, int shownH, int shownM, MovePlan &plan);
+    void start(const MovePlan &plan);
+
+    const MoveTiming &timing(MoveKind kind) const { return _timing[kind]; }
+    const LandingStats &landing() const { return _landing; }
+    const SyncStats &sync() const { return _sync; }
+
+  private:
+    void finishPlan();
+
+    StepperAxis *_hours = nullptr;
+    StepperAxis *_minutes = nullptr;
+    StepsFn _steps = nullptr;
+    MoveTarget _queue[MAX_TARGETS];
+    uint8_t _head = 0, _count = 0;
+    uint32_t _holdMs = 0;         // Hold of the running plan, starts on arrival
+    bool _holding = false;
+    uint32_t _holdUntilUs = 0;
+
+    bool _active = false;         // A started plan whose landing isn't scored yet
+    MovePlan _plan = {};
+    uint32_t _startUs = 0;
+    uint32_t _plannedUs = 0;
+    MoveTiming _timing[MOVE_KINDS] = {};
+    LandingStats _landing = {};
+    SyncStats _sync = {};
+    uint64_t _absErrorSumUs = 0;
+};
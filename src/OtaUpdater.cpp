@@ -0,0 +1,320 @@
+#include "OtaUpdater.h"
+#include <Update.h>
+#include <Preferences.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include "Inflater.h"
+#include "DeltaPatcher.h"
+
+static const char *OTA_NS = "clock-ota";
+static const char *BOOTS_KEY = "boots";   // Present while a new image is on trial
+
+// Arduino core: leave a PENDING_VERIFY image for us to confirm, instead of
+// marking it valid before setup() runs
+extern "C" bool verifyRollbackLater() { return true; }
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// ==========================================
+//                  TRIAL
+// ==========================================
+
+void OtaUpdater::begin() {
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  esp_ota_img_states_t state;
+  _idfPending = running && esp_ota_get_state_partition(running, &state) == ESP_OK && state == ESP_OTA_IMG_PENDING_VERIFY;
+
+  // Without bootloader rollback, count the boots ourselves: an image that
+  // crashes before loop() never gets to fail its trial by time
+  Preferences prefs;
+  prefs.begin(OTA_NS, false);
+  uint32_t boots = 0;
+  if (prefs.isKey(BOOTS_KEY)) {
+    boots = prefs.getUInt(BOOTS_KEY) + 1;
+    prefs.putUInt(BOOTS_KEY, boots);
+    _nvsWrites++;
+  }
+  prefs.end();
+  _trial = _idfPending || boots > 0;
+  if (!_trial) return;
+
+  Serial.printf("Firmware on trial (%s, boot %u of %u)\n", running ? running->label : "?", (unsigned)boots, (unsigned)TRIAL_BOOTS);
+  if (boots > TRIAL_BOOTS) {
+    Serial.println("Firmware never passed its trial, rolling back");
+    rollback();
+  }
+}
+
+OtaUpdater::Verdict OtaUpdater::checkTrial(bool homed, bool serving) {
+  if (!_trial) return TRIAL_PASSED;
+  if (homed && serving) {
+    if (_idfPending) esp_ota_mark_app_valid_cancel_rollback();
+    Preferences prefs;
+    prefs.begin(OTA_NS, false);
+    prefs.remove(BOOTS_KEY);
+    prefs.end();
+    _nvsWrites++;
+    _trial = false;
+    Serial.printf("Firmware confirmed after %lu ms\n", millis());
+    return TRIAL_PASSED;
+  }
+  return millis() > TRIAL_MS ? TRIAL_FAILED : TRIAL_RUNNING;
+}
+
+void OtaUpdater::rollback() {
+  Preferences prefs;
+  prefs.begin(OTA_NS, false);
+  prefs.remove(BOOTS_KEY);   // The old image is not on trial
+  prefs.end();
+  _nvsWrites++;
+  if (_idfPending) esp_ota_mark_app_invalid_rollback_and_reboot();  // Returns only on error
+  // Two OTA slots: the "next" one is the image we came from
+  const esp_partition_t *previous = esp_ota_get_next_update_partition(nullptr);
+  if (previous) esp_ota_set_boot_partition(previous);
+  ESP.restart();
+}
+
+// ==========================================
+//                 UPLOAD
+// ==========================================
+
+bool OtaUpdater::start(const String &sha256Hex) {
+  if (_state == RECEIVING) abort("Superseded by a new upload", 409);
+  _state = RECEIVING;
+  _error = "";
+  _received = 0;
+
+  if (sha256Hex.length() != 64) { fail("sha256 missing (64 hex digits)", 400); return false; }
+  for (int i = 0; i < 32; i++) {
+    int hi = hexDigit(sha256Hex.charAt(2 * i)), lo = hexDigit(sha256Hex.charAt(2 * i + 1));
+    if (hi < 0 || lo < 0) { fail("sha256 is not hex", 400); return false; }
+    _expected[i] = (hi << 4) | lo;
+  }
+
+  _blocks[0] = (uint8_t *)malloc(BLOCK);
+  _blocks[1] = (uint8_t *)malloc(BLOCK);
+  if (!_blocks[0] || !_blocks[1]) { release(); fail("Out of memory for the write buffers", 503); return false; }
+  if (!Update.begin(UPDATE_SIZE_UNKNOWN)) { release(); fail(String("Update.begin: ") + Update.errorString(), 500); return false; }
+
+  mbedtls_sha256_init(&_sha);
+  mbedtls_sha256_starts_ret(&_sha, 0);
+  int8_t b;
+  while (_toWriter.pop(b) || _toFill.pop(b)) {}
+  _toFill.push(0); _toFill.push(1);
+  _fill = -1;
+  _writeFailed = false; _writerDone = false; _writeError[0] = 0; _writeErrorCode = 0;
+  _inBlock = -1; _inputEnded = false; _written = 0;
+  _producer = xTaskGetCurrentTaskHandle();
+  // Core 0 next to the web server; above it and loop() so a full block never waits
+  xTaskCreatePinnedToCore(writerTask, "ota", 6144, this, 3, &_writer, 0);
+  return true;
+}
+
+void OtaUpdater::write(const uint8_t *data, size_t len) {
+  if (_state != RECEIVING) return;
+  _received += len;
+  if (_writeFailed) return;   // finish() reports it
+  while (len) {
+    if (_fill < 0) takeBlock();
+    size_t n = min(len, BLOCK - _lengths[_fill]);
+    memcpy(_blocks[_fill] + _lengths[_fill], data, n);
+    _lengths[_fill] += n; data += n; len -= n;
+    if (_lengths[_fill] == BLOCK) submit();
+  }
+}
+
+bool OtaUpdater::finish() {
+  if (_state != RECEIVING) return false;
+  if (_fill >= 0 && _lengths[_fill]) submit();
+  stopWriter();
+  if (_writeFailed) { mbedtls_sha256_free(&_sha); Update.abort(); release(); fail(_writeError, _writeErrorCode); return false; }
+
+  uint8_t digest[32];
+  mbedtls_sha256_finish_ret(&_sha, digest);
+  mbedtls_sha256_free(&_sha);
+  release();
+  if (memcmp(digest, _expected, sizeof(digest)) != 0) { Update.abort(); fail("SHA-256 mismatch, image discarded", 400); return false; }
+  if (!Update.end(true)) { fail(String("Update.end: ") + Update.errorString(), 500); return false; }
+
+  Preferences prefs;
+  prefs.begin(OTA_NS, false);
+  prefs.putUInt(BOOTS_KEY, 0);
+  prefs.end();
+  _nvsWrites++;
+  _state = DONE;
+  Serial.printf("Firmware update: %u bytes received, %u written, digest OK\n", (unsigned)_received, (unsigned)_written);
+  return true;
+}
+
+void OtaUpdater::abort(const String &why, int code) {
+  if (_state != RECEIVING) return;
+  stopWriter();
+  mbedtls_sha256_free(&_sha);
+  Update.abort();
+  release();
+  fail(why, code);
+}
+
+void OtaUpdater::fail(const String &why, int code) {
+  _state = FAILED;
+  _error = why;
+  _errorCode = code;
+  Serial.printf("Firmware update failed: %s\n", why.c_str());
+}
+
+// Backpressure: waits for the writer to hand a block back (one flash write)
+void OtaUpdater::takeBlock() {
+  int8_t b;
+  while (!_toFill.pop(b)) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+  _fill = b;
+  _lengths[b] = 0;
+}
+
+void OtaUpdater::submit() {
+  _toWriter.push(_fill);   // Never full: only two blocks exist
+  xTaskNotifyGive(_writer);
+  _fill = -1;
+}
+
+void OtaUpdater::stopWriter() {
+  if (!_writer) return;
+  while (!_toWriter.push(-1)) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+  xTaskNotifyGive(_writer);
+  while (!_writerDone) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+  _writer = nullptr;
+}
+
+void OtaUpdater::release() {
+  free(_blocks[0]); free(_blocks[1]);
+  _blocks[0] = _blocks[1] = nullptr;
+  _fill = -1;
+}
+
+// ==========================================
+//              WRITER TASK
+// ==========================================
+
+void OtaUpdater::writerTask(void *param) {
+  OtaUpdater &ota = *static_cast<OtaUpdater *>(param);
+  ota.runWriter();
+  ota._writerDone = true;
+  xTaskNotifyGive(ota._producer);
+  vTaskDelete(nullptr);
+}
+
+void OtaUpdater::runWriter() {
+  const uint8_t *data;
+  size_t len = nextInput(&data);
+  if (len >= sizeof(((PackHeader *)0)->magic) && memcmp(data, "SFU1", 4) == 0) {
+    unpack(data, len);
+  } else {
+    while (len && emit(data, len)) len = nextInput(&data);
+  }
+  while (nextInput(&data)) {}  // After a failure: hand the rest back unread
+}
+
+// The next full block of the upload, returning the one before; 0 = the end
+size_t OtaUpdater::nextInput(const uint8_t **data) {
+  if (_inBlock >= 0) {
+    _toFill.push(_inBlock);
+    xTaskNotifyGive(_producer);
+    _inBlock = -1;
+  }
+  if (_inputEnded) return 0;
+  int8_t b;
+  while (!_toWriter.pop(b)) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  if (b < 0) { _inputEnded = true; return 0; }
+  _inBlock = b;
+  *data = _blocks[b];
+  return _lengths[b];
+}
+
+// Image bytes, in order, to the digest and to flash
+bool OtaUpdater::emit(const uint8_t *data, size_t len) {
+  if (_writeFailed) return false;
+  mbedtls_sha256_update_ret(&_sha, data, len);
+  if (Update.write(const_cast<uint8_t *>(data), len) != len) {
+    char why[64];
+    snprintf(why, sizeof(why), "Flash write: %s", Update.errorString());
+    return writeFailed(why, 500);
+  }
+  _written += len;
+  return true;
+}
+
+bool OtaUpdater::writeFailed(const char *why, int code) {
+  if (!_writeFailed) {
+    strlcpy(_writeError, why, sizeof(_writeError));
+    _writeErrorCode = code;
+    _writeFailed = true;
+  }
+  return false;
+}
+
+// .sfu upload: header, then deflate of the image or of a delta
+bool OtaUpdater::unpack(const uint8_t *data, size_t len) {
+  PackHeader h;
+  if (len < sizeof(h)) return writeFailed("Truncated .sfu header", 400);
+  memcpy(&h, data, sizeof(h));
+  if (h.version != 1 || (h.kind != PACK_IMAGE && h.kind != PACK_DELTA)) return writeFailed("Unsupported .sfu version", 400);
+  if (memcmp(h.targetSha256, _expected, sizeof(_expected)) != 0) return writeFailed("sha256 does not match the .sfu header", 400);
+  if (h.kind == PACK_DELTA && !runningImageIs(h.sourceSize, h.sourceSha256)) {
+    return writeFailed("Delta was made for other firmware than the running one", 409);
+  }
+
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  Inflater *inflater = new Inflater();
+  DeltaPatcher *patcher = h.kind == PACK_DELTA ? new DeltaPatcher() : nullptr;
+  bool ok = inflater->begin(h.windowBits);
+  if (ok) {
+    const uint8_t *rest = data + sizeof(h);
+    size_t restLen = len - sizeof(h);
+    Inflater::Source source = [this, &rest, &restLen](const uint8_t **in) -> size_t {
+      if (restLen) { *in = rest; size_t n = restLen; restLen = 0; return n; }
+      return nextInput(in);
+    };
+    Inflater::Sink sink = [this](const uint8_t *out, size_t n) { return emit(out, n); };
+    if (patcher) {
+      patcher->begin(h.sourceSize, h.targetSize,
+                     [running](uint32_t offset, uint8_t *buf, size_t n) { return esp_partition_read(running, offset, buf, n) == ESP_OK; },
+                     sink);
+      sink = [patcher](const uint8_t *out, size_t n) { return patcher->write(out, n); };
+    }
+    ok = inflater->run(source, sink) && (!patcher || patcher->finish());
+  }
+  // A flash error comes first; else whichever stage choked on the data
+  if (!ok && !_writeFailed) {
+    const char *why = patcher && patcher->error() ? patcher->error() : inflater->error();
+    char text[64];
+    snprintf(text, sizeof(text), "%s: %s", patcher && patcher->error() ? "Delta" : "Inflate", why ? why : "failed");
+    writeFailed(text, 400);
+  }
+  if (ok && _written != h.targetSize) ok = writeFailed("Image size differs from the .sfu header", 400);
+  delete patcher;
+  delete inflater;
+  return ok;
+}
+
+// Digest of the first `size` bytes of the app partition we run from
+bool OtaUpdater::runningImageIs(uint32_t size, const uint8_t *sha256) {
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  if (!running || size > running->size) return false;
+  mbedtls_sha256_context ctx;
+  uint8_t buf[1024], digest[32];
+  mbedtls_sha256_init(&ctx);
+  mbedtls_sha256_starts_ret(&ctx, 0);
+  bool ok = true;
+  for (uint32_t at = 0; ok && at < size; at += sizeof(buf)) {
+    size_t n = min<size_t>(sizeof(buf), size - at);
+    ok = esp_partition_read(running, at, buf, n) == ESP_OK;
+    if (ok) mbedtls_sha256_update_ret(&ctx, buf, n);
+  }
+  mbedtls_sha256_finish_ret(&ctx, digest);
+  mbedtls_sha256_free(&ctx);
+  return ok && memcmp(digest, sha256, sizeof(digest)) == 0;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <Arduino.h>
+#include <mbedtls/sha256.h>
+#include "MotionLink.h"
+
+// ==========================================
+//         VERIFIED FIRMWARE UPDATES
+// ==========================================
+// POST /update streams the image through two 16 KB blocks: the web server
+// fills one while a writer task hashes the other and writes it to flash, so
+// a slow erase no longer stalls the upload one 1.4 KB packet at a time. The
+// image only becomes the boot partition if its SHA-256 matches the digest
+// sent with it. The first boots of a new image are a trial: it must home the
+// spools without errors and answer an HTTP request within TRIAL_MS, or the
+// clock goes back to the previous image (also after TRIAL_BOOTS boots that
+// never got there).
+//
+// Besides plain images, uploads can be .sfu files from tools/ota_pack.py:
+// a deflated image, or a deflated delta against the running image (see
+// DeltaPatcher). The writer task inflates and patches them on the way to
+// flash with a few KB of RAM; the digest is always that of the image that
+// ends up in flash, which .sfu files carry in their header.
+//
+// The upload side (start / write / finish / abort) runs in the HTTP server
+// task only.
+
+struct PackHeader {
+  char magic[4];          // "SFU1"
+  uint8_t version;
+  uint8_t kind;           // PACK_IMAGE / PACK_DELTA
+  uint8_t windowBits;     // Deflate window: RAM needed to inflate
+  uint8_t reserved;
+  uint32_t targetSize;
+  uint8_t targetSha256[32];
+  uint32_t sourceSize;    // Delta: the image it applies to
+  uint8_t sourceSha256[32];
+};
+static_assert(sizeof(PackHeader) == 80, "pack header layout");
+
+const uint8_t PACK_IMAGE = 1;
+const uint8_t PACK_DELTA = 2;
+
+class OtaUpdater {
+  public:
+    static const size_t BLOCK = 16384;
+    static const uint32_t TRIAL_MS = 180000;
+    static const uint32_t TRIAL_BOOTS = 3;
+
+    enum State : uint8_t { IDLE, RECEIVING, DONE, FAILED };
+    enum Verdict : uint8_t { TRIAL_RUNNING, TRIAL_PASSED, TRIAL_FAILED };
+
+    // --- Trial (boot / loop()) ---
+    void begin();                     // Early in setup(); rolls back itself after TRIAL_BOOTS
+    bool onTrial() const { return _trial; }
+    // Once per pass while onTrial(): confirms the image, or says to roll back
+    Verdict checkTrial(bool homed, bool serving);
+    void rollback();                  // Boots the previous image; does not return
+    uint32_t nvsWrites() const { return _nvsWrites; }  // Trial boot counter, since boot
+
+    // --- Upload ---
+    bool start(const String &sha256Hex);  // Expected digest, 64 hex digits
+    void write(const uint8_t *data, size_t len);
+    bool finish();                    // Digest check, then the new boot partition
+    void abort(const String &why, int code = 400);
+    void reject(const String &why, int code) { fail(why, code); }  // Instead of start()
+    void reset() { if (_state != RECEIVING) _state = IDLE; }           // Result was reported
+
+    State state() const { return _state; }
+    const String &error() const { return _error; }
+    int errorCode() const { return _errorCode; }   // HTTP status to report it with
+    size_t received() const { return _received; }
+
+  private:
+    static void writerTask(void *param);
+    // Writer task side
+    void runWriter();
+    size_t nextInput(const uint8_t **data);
+    bool emit(const uint8_t *data, size_t len);
+    bool unpack(const uint8_t *data, size_t len);
+    bool runningImageIs(uint32_t size, const uint8_t *sha256);
+    bool writeFailed(const char *why, int code);
+
+    void takeBlock();
+    void submit();
+    void stopWriter();
+    void release();
+    void fail(const String &why, int code);
+
+    // --- Trial ---
+    bool _trial = false;
+    bool _idfPending = false;   // Bootloader rollback armed (CONFIG_APP_ROLLBACK_ENABLE)
+    uint32_t _nvsWrites = 0;
+
+    // --- Upload ---
+    State _state = IDLE;
+    String _error;
+    int _errorCode = 0;
+    size_t _received = 0;
+    uint8_t _expected[32];
+    mbedtls_sha256_context _sha;
+
+    uint8_t *_blocks[2] = { nullptr, nullptr };
+    size_t _lengths[2] = { 0, 0 };
+    int8_t _fill = -1;                 // Block being filled, -1 = none free yet
+    SpscQueue<int8_t, 2> _toWriter;    // Full blocks; -1 = end of image
+    SpscQueue<int8_t, 2> _toFill;      // Written blocks, free again
+    TaskHandle_t _writer = nullptr;
+    TaskHandle_t _producer = nullptr;
+    volatile bool _writeFailed = false;
+    volatile bool _writerDone = false;
+    char _writeError[64] = "";
+    int _writeErrorCode = 0;
+    int8_t _inBlock = -1;              // Writer: block being consumed
+    bool _inputEnded = false;
+    size_t _written = 0;               // Image bytes that went to flash
+};
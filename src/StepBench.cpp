@@ -0,0 +1,60 @@
+#include "StepBench.h"
+#include "MotionProfile.h"
+#include "StepperAxis.h"
+
+static const uint32_t BENCH_STEPS = 2048;  // One spool revolution
+static const int BENCH_ROUNDS = 4;
+
+static volatile uint32_t benchSink;       // Keeps the loops from being optimised out
+
+// AccelStepper 1.64 computeNewSpeed() for a single move, including its float
+// fields mixed with double literals as in the library
+struct AccelStepperRef {
+  float speed = 0, accel, cn = 0, c0, cmin;
+  long n = 0;
+
+  AccelStepperRef(float maxSpeed, float acceleration) : accel(acceleration) {
+    c0 = 0.676 * sqrt(2.0 / acceleration) * 1000000.0;
+    cmin = 1000000.0 / maxSpeed;
+  }
+
+  uint32_t next(long distanceTo) {
+    long stepsToStop = (long)((speed * speed) / (2.0 * accel));
+    if (distanceTo > 0) {
+      if (n > 0) { if (stepsToStop >= distanceTo) n = -stepsToStop; }
+      else if (n < 0) { if (stepsToStop < distanceTo) n = -n; }
+    }
+    if (n == 0) { cn = c0; }
+    else { cn = cn - ((2.0 * cn) / ((4.0 * n) + 1)); cn = max(cn, cmin); }
+    n++;
+    speed = 1000000.0 / cn;
+    return (uint32_t)cn;
+  }
+};
+
+StepBenchResult benchmarkStepProfiles(float maxSpeed, float accel, float jerk) {
+  static MotionProfile profile;
+  StepBenchResult r = {};
+  r.steps = BENCH_STEPS;
+
+  uint32_t cb = ESP.getCycleCount();
+  profile.build(maxSpeed, accel, jerk, StepperAxis::TIMER_HZ);
+  uint32_t c0 = ESP.getCycleCount();
+  r.buildUs = (c0 - cb) / ESP.getCpuFreqMHz();
+  r.rampLength = profile.rampLength();
+
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (uint32_t i = 0; i < BENCH_STEPS; i++) benchSink = profile.interval(i, BENCH_STEPS);
+  }
+  uint32_t c1 = ESP.getCycleCount();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    AccelStepperRef ref(maxSpeed, accel);
+    for (uint32_t i = 0; i < BENCH_STEPS; i++) benchSink = ref.next(BENCH_STEPS - i);
+  }
+  uint32_t c2 = ESP.getCycleCount();
+
+  float total = (float)BENCH_STEPS * BENCH_ROUNDS;
+  r.tableCyclesPerStep = (c1 - c0) / total;
+  r.accelStepperCyclesPerStep = (c2 - c1) / total;
+  return r;
+}
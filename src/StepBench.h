@@ -0,0 +1,19 @@
+#pragma once
+#include <Arduino.h>
+
+// ==========================================
+//        STEP PROFILE BENCHMARK
+// ==========================================
+// Cycles spent on the per-step profile math: the S-curve table lookup the
+// step ISR does vs. AccelStepper's computeNewSpeed() recurrence (kept here
+// as a reference copy, the library itself is no longer linked).
+
+struct StepBenchResult {
+  uint32_t steps;              // Steps per timed move
+  float tableCyclesPerStep;
+  float accelStepperCyclesPerStep;
+  uint32_t buildUs;            // Time to solve the S-curve table once
+  uint32_t rampLength;         // Accel steps in that table
+};
+
+StepBenchResult benchmarkStepProfiles(float maxSpeed, float accel, float jerk);
@@ -0,0 +1,290 @@
+#include "StepperAxis.h"
+#include <soc/gpio_struct.h>
+
+// FULL4WIRE coil pattern, identical to AccelStepper::step4() (bit0 = pin1)
+static const uint8_t COIL_PATTERN[4] = { 0b0101, 0b0110, 0b1010, 0b1001 };
+
+// Alarm value used while idle so the timer never fires between moves
+static const uint64_t ALARM_PARKED = 1ULL << 50;
+
+static inline uint32_t IRAM_ATTR scaled(uint32_t interval, uint32_t scaleQ16) {
+  return (scaleQ16 == (1 << 16)) ? interval : (uint32_t)(((uint64_t)interval * scaleQ16) >> 16);
+}
+
+static bool IRAM_ATTR stepperTimerIsr(void *arg) {
+  static_cast<StepperAxis *>(arg)->onTimer();
+  return false;
+}
+
+void StepperAxis::begin(int timerNum, int pin1, int pin2, int pin3, int pin4) {
+  int pins[4] = { pin1, pin2, pin3, pin4 };
+  for (int i = 0; i < 4; i++) pinMode(pins[i], OUTPUT);
+
+  // Pre-compute the set masks for both GPIO banks so the ISR is 4 register writes
+  for (int p = 0; p < 4; p++) {
+    _maskLo[p] = 0; _maskHi[p] = 0;
+    for (int i = 0; i < 4; i++) {
+      if (!(COIL_PATTERN[p] & (1 << i))) continue;
+      if (pins[i] < 32) _maskLo[p] |= (1UL << pins[i]);
+      else _maskHi[p] |= (1UL << (pins[i] - 32));
+    }
+  }
+  _allLo = 0; _allHi = 0;
+  for (int i = 0; i < 4; i++) {
+    if (pins[i] < 32) _allLo |= (1UL << pins[i]);
+    else _allHi |= (1UL << (pins[i] - 32));
+  }
+
+  _group = timerNum / 2; _index = timerNum % 2;
+  timer_config_t cfg = {};
+  cfg.alarm_en = TIMER_ALARM_DIS;
+  cfg.counter_en = TIMER_PAUSE;
+  cfg.intr_type = TIMER_INTR_LEVEL;
+  cfg.counter_dir = TIMER_COUNT_UP;
+  cfg.auto_reload = TIMER_AUTORELOAD_EN;
+  cfg.divider = 80; // 80 MHz APB -> 1 us ticks
+  timer_init((timer_group_t)_group, (timer_idx_t)_index, &cfg);
+  timer_set_counter_value((timer_group_t)_group, (timer_idx_t)_index, 0);
+  timer_set_alarm_value((timer_group_t)_group, (timer_idx_t)_index, ALARM_PARKED);
+  timer_isr_callback_add((timer_group_t)_group, (timer_idx_t)_index, stepperTimerIsr, this, 0);
+  timer_start((timer_group_t)_group, (timer_idx_t)_index);
+
+  rebuildRamp();
+}
+
+// ------------------------------------------
+//  Profile
+// ------------------------------------------
+void StepperAxis::setMaxSpeed(float stepsPerSec) {
+  if (stepsPerSec <= 0 || stepsPerSec == _maxSpeed) return;
+  _maxSpeed = stepsPerSec; rebuildRamp();
+}
+
+void StepperAxis::setAcceleration(float stepsPerSec2) {
+  if (stepsPerSec2 <= 0 || stepsPerSec2 == _accel) return;
+  _accel = stepsPerSec2; rebuildRamp();
+}
+
+void StepperAxis::setJerk(float stepsPerSec3) {
+  if (stepsPerSec3 <= 0 || stepsPerSec3 == _jerk) return;
+  _jerk = stepsPerSec3; rebuildRamp();
+}
+
+// Solved outside the lock, then swapped in whole so the ISR never sees a
+// half-written table
+void StepperAxis::rebuildRamp() {
+  static MotionProfile scratch;
+  scratch.build(_maxSpeed, _accel, _jerk, TIMER_HZ);
+
+  portENTER_CRITICAL(&_mux);
+  _profile = scratch;
+  portEXIT_CRITICAL(&_mux);
+}
+
+// ------------------------------------------
+//  Commands
+// ------------------------------------------
+void StepperAxis::startLocked(uint32_t firstInterval) {
+  _running = true;
+  timer_set_counter_value((timer_group_t)_group, (timer_idx_t)_index, 0);
+  timer_set_alarm_value((timer_group_t)_group, (timer_idx_t)_index, firstInterval);
+  timer_set_alarm((timer_group_t)_group, (timer_idx_t)_index, TIMER_ALARM_EN);
+}
+
+// Shortest end of the current move that stays on the ramp: as many decel
+// steps as accel steps taken, capped at the table length
+void StepperAxis::decelerateLocked() {
+  uint32_t rampLen = _profile.rampLength();
+  uint32_t decel = (_stepIndex < rampLen) ? _stepIndex : rampLen;
+  uint32_t newTotal = _stepIndex + decel;
+  if (newTotal < _stepTotal) _stepTotal = (newTotal > _stepIndex) ? newTotal : _stepIndex + 1;
+}
+
+void StepperAxis::move(long relative) {
+  if (relative == 0) return;
+  int8_t dir = (relative > 0) ? 1 : -1;
+  uint32_t steps = (uint32_t)labs(relative);
+
+  portENTER_CRITICAL(&_mux);
+  long target = _position + relative;
+  if (_running && !_jogging && dir == _dir) {
+    // Same direction while moving: keep the current ramp position, just
+    // move the end of the move (the profile re-derives decel from it)
+    _reversePending = false;
+    _stepTotal = _stepIndex + steps;
+  } else if (_running && !_jogging && _stepIndex > 0) {
+    // Reversal: ramp down first, the ISR starts the way back from standstill
+    decelerateLocked();
+    _reverseTarget = target;
+    _reversePending = true;
+  } else {
+    _jogging = false; _reversePending = false;
+    _dir = dir; _stepIndex = 0; _stepTotal = steps;
+    _scaleQ16 = 1 << 16;
+    startLocked(_profile.interval(0, steps));
+  }
+  portEXIT_CRITICAL(&_mux);
+  if (_trace) _trace->record(TRACE_MOVE, _traceAxis, 256, target);
+}
+
+void StepperAxis::prepareMove(long relative, uint32_t durationTicks, uint32_t delayTicks) {
+  uint32_t steps = (uint32_t)labs(relative);
+  uint32_t natural = _profile.moveTicks(steps);
+  uint32_t scale = 1 << 16, first = steps ? _profile.interval(0, steps) : 0;
+
+  if (steps && durationTicks > natural) {
+    // Fixed-point stretch, rounded down; the rounding loss goes into the
+    // first interval so the move still ends on the requested tick
+    scale = (uint32_t)(((uint64_t)durationTicks << 16) / natural);
+    uint32_t stretched = 0;
+    for (uint32_t i = 0; i < steps; i++) stretched += scaled(_profile.interval(i, steps), scale);
+    first = scaled(first, scale) + (durationTicks > stretched ? durationTicks - stretched : 0);
+  }
+  _prepared = { steps, (int8_t)((relative > 0) ? 1 : -1), scale, first + delayTicks };
+}
+
+void StepperAxis::startPrepared() {
+  if (_prepared.steps == 0) return;
+  portENTER_CRITICAL(&_mux);
+  _jogging = false; _reversePending = false;
+  _dir = _prepared.dir; _stepIndex = 0; _stepTotal = _prepared.steps;
+  _scaleQ16 = _prepared.scaleQ16;
+  startLocked(_prepared.first);
+  long target = _position + (long)_prepared.steps * _prepared.dir;
+  portEXIT_CRITICAL(&_mux);
+  _prepared.steps = 0;
+  if (_trace) _trace->record(TRACE_MOVE, _traceAxis, (uint16_t)min<uint32_t>(_prepared.scaleQ16 >> 8, 0xFFFF), target);
+}
+
+void StepperAxis::moveTo(long absolute) { move(absolute - _position); }
+
+void StepperAxis::runAtSpeed(float stepsPerSec) {
+  if (stepsPerSec == 0) { halt(); return; }
+  uint32_t interval = (uint32_t)((float)TIMER_HZ / fabsf(stepsPerSec));
+  portENTER_CRITICAL(&_mux);
+  _dir = (stepsPerSec > 0) ? 1 : -1;
+  _jogInterval = interval;
+  _reversePending = false;
+  if (!_running || !_jogging) { _jogging = true; startLocked(interval); }
+  portEXIT_CRITICAL(&_mux);
+  if (_trace) _trace->record(TRACE_JOG, _traceAxis, traceInterval(interval), _position);
+}
+
+void StepperAxis::stop() {
+  if (_jogging) { halt(); return; }
+  portENTER_CRITICAL(&_mux);
+  _reversePending = false;
+  if (_running) decelerateLocked();
+  portEXIT_CRITICAL(&_mux);
+}
+
+void StepperAxis::halt() {
+  portENTER_CRITICAL(&_mux);
+  _jogging = false; _reversePending = false;
+  _stepTotal = _stepIndex;
+  _running = false;
+  timer_set_alarm_value((timer_group_t)_group, (timer_idx_t)_index, ALARM_PARKED);
+  portEXIT_CRITICAL(&_mux);
+  if (_trace) _trace->record(TRACE_HALT, _traceAxis, 0, _position);
+}
+
+void StepperAxis::setCurrentPosition(long pos) {
+  halt();
+  portENTER_CRITICAL(&_mux);
+  _position = pos;
+  portEXIT_CRITICAL(&_mux);
+}
+
+void StepperAxis::restore(long pos, uint8_t phase) {
+  halt();
+  portENTER_CRITICAL(&_mux);
+  _position = pos;
+  _phase = phase & 3;
+  portEXIT_CRITICAL(&_mux);
+}
+
+void StepperAxis::shiftPosition(long delta) {
+  portENTER_CRITICAL(&_mux);
+  _position += delta;
+  _reverseTarget += delta;
+  portEXIT_CRITICAL(&_mux);
+}
+
+void StepperAxis::correctPosition(long error) {
+  portENTER_CRITICAL(&_mux);
+  _position -= error;
+  if (_running && !_jogging) {
+    long steps = (long)(_stepTotal - _stepIndex) + error * _dir;
+    if (steps >= 1) _stepTotal = _stepIndex + (uint32_t)steps; // Else the next move picks it up
+  }
+  portEXIT_CRITICAL(&_mux);
+}
+
+long StepperAxis::targetPosition() const { return _position + distanceToGo(); }
+
+long StepperAxis::distanceToGo() const {
+  if (_jogging) return _dir;
+  if (_reversePending) return _reverseTarget - _position;
+  return (long)(_stepTotal - _stepIndex) * _dir;
+}
+
+void StepperAxis::enableOutputs() {
+  writeCoils(_phase);
+  if (_energized) return;
+  _energized = true;
+  if (_trace) _trace->record(TRACE_OUTPUTS, _traceAxis, 1, _position);
+}
+
+void StepperAxis::disableOutputs() {
+  GPIO.out_w1tc = _allLo;
+  GPIO.out1_w1tc.val = _allHi;
+  if (!_energized) return;
+  _energized = false;
+  if (_trace) _trace->record(TRACE_OUTPUTS, _traceAxis, 0, _position);
+}
+
+// ------------------------------------------
+//  ISR
+// ------------------------------------------
+void IRAM_ATTR StepperAxis::writeCoils(uint8_t phase) {
+  GPIO.out_w1tc = _allLo & ~_maskLo[phase];
+  GPIO.out1_w1tc.val = _allHi & ~_maskHi[phase];
+  GPIO.out_w1ts = _maskLo[phase];
+  GPIO.out1_w1ts.val = _maskHi[phase];
+}
+
+void IRAM_ATTR StepperAxis::onTimer() {
+  portENTER_CRITICAL_ISR(&_mux);
+  uint64_t next = ALARM_PARKED;
+  bool stepped = false;
+  if (_running && (_jogging || _stepIndex < _stepTotal)) {
+    // Auto-reload zeroed the counter at the alarm: it now reads our latency
+    _lateness.add((uint32_t)timer_group_get_counter_value_in_isr((timer_group_t)_group, (timer_idx_t)_index));
+    _phase = (_phase + _dir) & 3;
+    writeCoils(_phase);
+    _position += _dir;
+    stepped = true;
+    if (_jogging) {
+      next = _jogInterval;
+    } else {
+      _stepIndex++;
+      if (_stepIndex < _stepTotal) next = scaled(_profile.interval(_stepIndex, _stepTotal), _scaleQ16);
+      else if (_reversePending && _reverseTarget != _position) {
+        // Ramped down: the queued reversal starts from standstill
+        long steps = _reverseTarget - _position;
+        _reversePending = false;
+        _dir = (steps > 0) ? 1 : -1; _stepIndex = 0; _stepTotal = (uint32_t)labs(steps);
+        _scaleQ16 = 1 << 16;
+        next = _profile.interval(0, _stepTotal);
+      }
+      else { _reversePending = false; _running = false; _lastStepMicros = micros(); }
+    }
+  } else {
+    _running = false;
+  }
+  timer_group_set_alarm_value_in_isr((timer_group_t)_group, (timer_idx_t)_index, next);
+  timer_group_enable_alarm_in_isr((timer_group_t)_group, (timer_idx_t)_index);
+  long position = _position;
+  portEXIT_CRITICAL_ISR(&_mux);
+  if (stepped && _trace) _trace->record(TRACE_STEP, _traceAxis, next == ALARM_PARKED ? 0 : traceInterval(next), position);
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <Arduino.h>
+#include <driver/timer.h>
+#include "MotionProfile.h"
+#include "Metrics.h"
+#include "TraceRecorder.h"
+
+// ==========================================
+//          TIMER-DRIVEN STEP ENGINE
+// ==========================================
+// One spool = one hardware timer. The timer ISR emits a step and re-arms its
+// own alarm with the next interval taken from a precomputed S-curve table
+// (MotionProfile), so the step rate no longer depends on how often loop()
+// gets a chance to poll and the ISR does no math beyond an index.
+// The public API mirrors the subset of AccelStepper the clock relies on.
+
+class StepperAxis {
+  public:
+    static const uint32_t TIMER_HZ = 1000000;  // 1 us per timer tick
+
+    void begin(int timerNum, int pin1, int pin2, int pin3, int pin4);
+    // Steps, moves and output changes go to the trace as this axis
+    void attachTrace(TraceRecorder *trace, uint8_t axis) { _trace = trace; _traceAxis = axis; }
+
+    // Profile (rebuilds the ramp table, so call outside of a move)
+    void setMaxSpeed(float stepsPerSec);
+    void setAcceleration(float stepsPerSec2);
+    void setJerk(float stepsPerSec3);
+    float maxSpeed() const { return _maxSpeed; }
+
+    // Motion commands
+    // Relative to the current position. Against the running direction the
+    // move first decelerates along the ramp, then heads for the new target.
+    void move(long relative);
+    // Stretches the profile in time (lower speed, accel and jerk alike) so
+    // the move takes exactly durationTicks, after an extra delayTicks before
+    // the first step. Durations shorter than the natural move don't stretch.
+    // Prepare is the slow part (a pass over the table), so two axes can be
+    // prepared first and then started back to back.
+    void prepareMove(long relative, uint32_t durationTicks, uint32_t delayTicks = 0);
+    void startPrepared();
+    void moveTo(long absolute);
+    void runAtSpeed(float stepsPerSec); // Constant speed (no ramp) until stop()/halt()
+    void stop();                        // Decelerate to a standstill along the ramp
+    void halt();                        // Stop at the next step boundary
+
+    // State (safe to read from any context)
+    void setCurrentPosition(long pos);
+    void restore(long pos, uint8_t phase); // Warm start: position and coil phase from before a reset
+    void shiftPosition(long delta);     // Re-reference without stopping a move
+    // The spool is `error` steps behind its count: re-reference and stretch
+    // (or trim) a running move by the same amount so it still lands on target
+    void correctPosition(long error);
+    long currentPosition() const { return _position; }
+    long targetPosition() const;
+    long distanceToGo() const;
+    bool isRunning() const { return _running; }
+    uint8_t phase() const { return _phase; }
+    uint32_t lastStepMicros() const { return _lastStepMicros; } // micros() of the last step of a move
+
+    void enableOutputs();
+    void disableOutputs();
+
+    const MotionProfile &profile() const { return _profile; }
+    // How long after its alarm each step's ISR ran (1 us .. 1 ms buckets)
+    const Histogram &stepLateness() const { return _lateness; }
+
+    void onTimer(); // ISR body
+
+  private:
+    void rebuildRamp();
+    void startLocked(uint32_t firstInterval);
+    void decelerateLocked();
+    void writeCoils(uint8_t phase);
+
+    int _group = 0; int _index = 0;
+    uint32_t _maskLo[4] = {0}; uint32_t _maskHi[4] = {0};
+    uint32_t _allLo = 0; uint32_t _allHi = 0;
+
+    float _maxSpeed = 1000; float _accel = 1000; float _jerk = 40000;
+    MotionProfile _profile;
+
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+    volatile long _position = 0;
+    volatile uint32_t _stepIndex = 0;  // Steps done in the current move
+    volatile uint32_t _stepTotal = 0;  // Steps commanded for the current move
+    volatile int8_t _dir = 1;
+    volatile bool _jogging = false;
+    volatile uint32_t _jogInterval = 0;
+    volatile bool _reversePending = false;  // Decelerating before a move() the other way
+    volatile long _reverseTarget = 0;
+    volatile uint32_t _scaleQ16 = 1 << 16;  // Time stretch of the current move
+    volatile uint32_t _lastStepMicros = 0;
+    struct { uint32_t steps; int8_t dir; uint32_t scaleQ16; uint32_t first; } _prepared = {};
+    volatile bool _running = false;
+    volatile bool _energized = false;
+    uint8_t _phase = 0;
+    Histogram _lateness{0, 10};
+    TraceRecorder *_trace = nullptr;
+    uint8_t _traceAxis = 0;
+};
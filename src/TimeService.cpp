@@ -0,0 +1,32 @@
+#include "TimeService.h"
+
+Time clockTime(const struct tm &local, bool twelveHour) {
+  int hour = local.tm_hour;
+  if (twelveHour) {
+    hour = hour % 12;
+    if (hour == 0) hour = 12;
+  }
+  return { hour, local.tm_min, local.tm_hour >= 12 };
+}
+
+const TimeSnapshot &TimeService::now() {
+  time_t epoch = time(nullptr);
+  if (!_stale && epoch == _snap.epoch) return _snap;
+
+  TimeSnapshot s = {};
+  s.epoch = epoch;
+  localtime_r(&epoch, &s.local);
+  s.synced = s.local.tm_year > (2016 - 1900);  // Same test as getLocalTime()
+  if (s.synced) {
+    Time t = clockTime(s.local, _twelveHour);
+    s.hour = t.hour; s.minute = t.minute; s.isPm = t.isPm;
+    s.month = s.local.tm_mon + 1; s.day = s.local.tm_mday;
+    s.isDst = s.local.tm_isdst > 0;
+  } else {
+    s.hour = -1; s.minute = -1;
+  }
+  _snap = s;
+  _stale = false;
+  _conversions++;
+  return _snap;
+}
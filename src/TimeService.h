@@ -0,0 +1,44 @@
+#pragma once
+#include <Arduino.h>
+#include <time.h>
+
+// ==========================================
+//            CACHED WALL CLOCK
+// ==========================================
+// Everything on core 0 that needs the local time reads one snapshot. The
+// localtime/TZ conversion runs when the second changes, not per caller;
+// between conversions a read is one gettimeofday() and a compare. Core 0
+// only (loop and the web handlers run there), so no locking.
+
+struct Time { int hour; int minute; bool isPm; };
+
+// Hour as shown on the spool: 0-23, or 1-12 in 12h mode
+Time clockTime(const struct tm &local, bool twelveHour);
+
+struct TimeSnapshot {
+  bool synced;        // Wall clock is set (SNTP, or kept over a soft reset)
+  time_t epoch;       // The second this snapshot describes
+  struct tm local;
+  int hour;           // As shown, -1 until synced
+  int minute;         // -1 until synced
+  bool isPm;
+  int month;          // 1-12
+  int day;            // 1-31
+  bool isDst;
+};
+
+class TimeService {
+  public:
+    // After the 12/24h or time zone setting changed
+    void configure(bool twelveHour) { _twelveHour = twelveHour; _stale = true; }
+
+    const TimeSnapshot &now();
+
+    uint32_t conversions() const { return _conversions; }
+
+  private:
+    TimeSnapshot _snap = {};
+    bool _twelveHour = false;
+    bool _stale = true;
+    uint32_t _conversions = 0;
+};
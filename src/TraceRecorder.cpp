@@ -0,0 +1,46 @@
+#include "TraceRecorder.h"
+
+void TraceRecorder::arm(uint32_t mask, bool once) {
+  portENTER_CRITICAL(&_mux);
+  _head = 0; _count = 0; _dropped = 0;
+  _once = once;
+  _frozenMask = 0;
+  _mask = mask & TRACE_ALL;
+  portEXIT_CRITICAL(&_mux);
+}
+
+void TraceRecorder::stop() {
+  portENTER_CRITICAL(&_mux);
+  _mask = 0; _frozenMask = 0;
+  portEXIT_CRITICAL(&_mux);
+}
+
+uint32_t TraceRecorder::freeze() {
+  portENTER_CRITICAL(&_mux);
+  if (_mask) { _frozenMask = _mask; _mask = 0; }
+  uint32_t n = _count;
+  portEXIT_CRITICAL(&_mux);
+  return n;
+}
+
+void TraceRecorder::thaw() {
+  portENTER_CRITICAL(&_mux);
+  if (_frozenMask) { _mask = _frozenMask; _frozenMask = 0; }
+  portEXIT_CRITICAL(&_mux);
+}
+
+// Step ISR, hall reader task and motion task; the mask is tested again under
+// the lock because a freeze() on the other core may have won the race
+void IRAM_ATTR TraceRecorder::push(TraceEventType type, uint8_t axis, uint16_t arg, int32_t value) {
+  uint32_t now = micros();
+  portENTER_CRITICAL_SAFE(&_mux);
+  if (_mask & (1UL << type)) {
+    TraceEvent &e = _events[_head];
+    e.timeUs = now; e.type = type; e.axis = axis; e.arg = arg; e.value = value;
+    _head = (_head + 1) & (CAPACITY - 1);
+    if (_count < CAPACITY) _count++;
+    else _dropped++;
+    if (_once && _count == CAPACITY) _mask = 0;
+  }
+  portEXIT_CRITICAL_SAFE(&_mux);
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <Arduino.h>
+
+// ==========================================
+//          STEP / SENSOR TRACE RECORDER
+// ==========================================
+// A fixed ring of 12-byte binary events written straight from the step ISR,
+// the hall reader task and the motion task. Recording is a mask test and,
+// for enabled events, a micros() read and a short critical section, so the
+// recorder stays armed in normal operation: when a landing goes wrong, the
+// last few seconds of steps and sensor readings are already in RAM.
+// GET /trace downloads the ring; tools/decode_trace.py turns it into CSV.
+
+enum TraceEventType : uint8_t {
+  TRACE_STEP = 1,    // arg: commanded interval to the next step (traceInterval, 0 = last), value: position after the step
+  TRACE_HALL,        // axis: sensor channel, arg: ADC value, value: stamped position
+  TRACE_MOVE,        // arg: time stretch (Q8, 256 = natural profile), value: target position
+  TRACE_JOG,         // arg: constant step interval (traceInterval), value: position at the start
+  TRACE_HALT,        // value: position
+  TRACE_OUTPUTS,     // arg: 1 = coils energized, 0 = released
+  TRACE_HOMING,      // arg: new homing phase, value: position
+  TRACE_SHOW,        // arg: move kind, value: hour * 100 + minute the plan lands on
+  TRACE_TYPES
+};
+
+// Step intervals in 16 bits: us below 0x8000, 64 us units above (up to 2 s)
+inline uint16_t IRAM_ATTR traceInterval(uint32_t us) {
+  if (us < 0x8000) return us;
+  uint32_t coarse = us >> 6;
+  return 0x8000 | (coarse > 0x7FFF ? 0x7FFF : coarse);
+}
+
+const uint32_t TRACE_ALL = ((1UL << TRACE_TYPES) - 1) & ~1UL;
+
+struct TraceEvent {
+  uint32_t timeUs;   // micros()
+  uint8_t type;
+  uint8_t axis;   // 0 = hours, 1 = minutes
+  uint16_t arg;
+  int32_t value;
+};
+
+// Download layout: one header, then `count` events oldest first (little endian)
+struct TraceHeader {
+  char magic[4];        // "SFTR"
+  uint16_t version;
+  uint16_t eventSize;
+  uint32_t capacity;
+  uint32_t count;
+  uint32_t dropped;     // Overwritten by the ring since arming
+  uint32_t nowMicros;   // micros() when the download started
+  uint32_t epoch;       // time() at the same moment, 0 = not synced
+  uint16_t stepsRevHours;
+  uint16_t stepsRevMinutes;
+  float maxSpeed;       // Commanded profile: steps/s, steps/s^2, steps/s^3
+  float accel;
+  float jerk;
+  uint16_t hallEvery;   // One hall event per this many decimated samples
+  uint16_t flags;       // TRACE_FLAG_*
+};
+static_assert(sizeof(TraceEvent) == 12, "trace event layout");
+static_assert(sizeof(TraceHeader) == 48, "trace header layout");
+
+const uint16_t TRACE_VERSION = 1;
+const uint16_t TRACE_FLAG_ONCE = 1;     // Stops when full instead of wrapping
+const uint16_t TRACE_FLAG_ARMED = 2;    // Was recording when downloaded
+
+class TraceRecorder {
+  public:
+    static const uint32_t CAPACITY = 2048;   // Power of two, 24 KB
+    static const int HALL_EVERY = 10;        // 1 kHz decimated samples -> 100 Hz per sensor
+
+    // Clears the ring and records the event types in mask. once: stop when
+    // full instead of overwriting, to keep the start of what follows.
+    void arm(uint32_t mask = TRACE_ALL, bool once = false);
+    void stop();
+
+    inline void IRAM_ATTR record(TraceEventType type, uint8_t axis, uint16_t arg, int32_t value) {
+      if (_mask & (1UL << type)) push(type, axis, arg, value);
+    }
+
+    bool armed() const { return _mask != 0 || _frozenMask != 0; }
+    bool once() const { return _once; }
+    uint32_t mask() const { return _frozenMask ? _frozenMask : _mask; }
+    uint32_t count() const { return _count; }
+    uint32_t dropped() const { return _dropped; }
+
+    // Reading: freeze() pauses recording and returns the number of events,
+    // event(i) is oldest first, thaw() resumes. Events while frozen are lost.
+    uint32_t freeze();
+    const TraceEvent &event(uint32_t i) const { return _events[(_head - _count + i) & (CAPACITY - 1)]; }
+    void thaw();
+
+  private:
+    void push(TraceEventType type, uint8_t axis, uint16_t arg, int32_t value);
+
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+    volatile uint32_t _mask = 0;
+    uint32_t _frozenMask = 0;
+    bool _once = false;
+    uint32_t _head = 0;
+    volatile uint32_t _count = 0;
+    volatile uint32_t _dropped = 0;
+    TraceEvent _events[CAPACITY];
+};
@@ -0,0 +1,69 @@
+#include "WarmStart.h"
+#include <Preferences.h>
+#include <esp_system.h>
+
+static const uint32_t PARKED_MAGIC = 0x5041524B;  // "PARK"
+static const char *PARK_NS = "clock-park";
+static const char *PARK_KEY = "state";
+
+// Not zeroed at boot: whatever the last run left here, checked by CRC
+RTC_NOINIT_ATTR static ParkedState rtcState;
+
+static uint32_t stateCrc(const ParkedState &s) {
+  const uint8_t *p = reinterpret_cast<const uint8_t *>(&s);
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t n = 0; n < offsetof(ParkedState, crc); n++) {
+    crc ^= p[n];
+    for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static bool stateValid(const ParkedState &s) { return s.magic == PARKED_MAGIC && s.crc == stateCrc(s); }
+
+WarmStart::Source WarmStart::restore(ParkedState &state) {
+  // Power-on and brownout leave RTC memory undefined (and a brownout may
+  // have stalled a spool); every other reset kept it powered
+  esp_reset_reason_t reason = esp_reset_reason();
+  bool rtcKept = reason != ESP_RST_POWERON && reason != ESP_RST_BROWNOUT && reason != ESP_RST_UNKNOWN;
+
+  ParkedState parked = {};
+  Preferences prefs;
+  prefs.begin(PARK_NS, false);
+  bool haveParked = prefs.getBytes(PARK_KEY, &parked, sizeof(parked)) == sizeof(parked) && stateValid(parked);
+  if (prefs.isKey(PARK_KEY)) { prefs.remove(PARK_KEY); _nvsWrites++; }
+  prefs.end();
+
+  ParkedState rtc = rtcState;
+  rtcState.magic = 0;  // Trusted again only after the motion task confirms it
+  if (rtcKept && stateValid(rtc)) { state = rtc; return FROM_RTC; }
+  if (haveParked) { state = parked; return FROM_NVS; }
+  return COLD;
+}
+
+void WarmStart::update(int32_t posH, int32_t posM, uint8_t phaseH, uint8_t phaseM,
+                       int shownH, int shownM, int stepsRevH, int stepsRev) {
+  ParkedState s = { PARKED_MAGIC, posH, posM, phaseH, phaseM, (int8_t)shownH, (int8_t)shownM, stepsRevH, stepsRev, 0 };
+  if (_valid && memcmp(&s, &_last, offsetof(ParkedState, crc)) == 0) return;
+  s.crc = stateCrc(s);
+  _last = s;
+  rtcState = s;
+  _valid = true;
+}
+
+void WarmStart::invalidate() {
+  if (!_valid) return;
+  rtcState.magic = 0;
+  _valid = false;
+}
+
+bool WarmStart::park() {
+  ParkedState s = rtcState;  // Torn by a concurrent update = bad CRC = not parked
+  if (!stateValid(s)) return false;
+  Preferences prefs;
+  prefs.begin(PARK_NS, false);
+  bool ok = prefs.putBytes(PARK_KEY, &s, sizeof(s)) == sizeof(s);
+  prefs.end();
+  _nvsWrites++;
+  return ok;
+}
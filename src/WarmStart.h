@@ -0,0 +1,44 @@
+#pragma once
+#include <Arduino.h>
+
+// ==========================================
+//            WARM RESTART STATE
+// ==========================================
+// Where the spools are, so a reset does not have to home them. The motion
+// task keeps a copy in RTC slow memory (survives software resets, panics and
+// watchdog resets, not power loss) whenever both spools are at rest, and
+// voids it while anything moves. Deliberate restarts also park it in NVS,
+// which is read back once on the next boot and then erased, so a power cut
+// later on never resumes from a stale copy.
+
+struct ParkedState {
+  uint32_t magic;
+  int32_t posH, posM;
+  uint8_t phaseH, phaseM;     // Coil phase, so re-energizing doesn't jerk the rotor
+  int8_t shownH, shownM;
+  int32_t stepsRevH, stepsRev; // Positions only mean something with the same calibration
+  uint32_t crc;
+};
+
+class WarmStart {
+  public:
+    enum Source : uint8_t { COLD, FROM_RTC, FROM_NVS };
+
+    // Boot: the saved state if one can be trusted. Consumes the NVS copy.
+    Source restore(ParkedState &state);
+
+    // Motion task only
+    void update(int32_t posH, int32_t posM, uint8_t phaseH, uint8_t phaseM,
+                int shownH, int shownM, int stepsRevH, int stepsRev);  // At rest
+    void invalidate();                                                  // Moving or homing
+
+    // Core 0, right before ESP.restart()
+    bool park();
+
+    uint32_t nvsWrites() const { return _nvsWrites; }  // Parks, and the erase after a restore
+
+  private:
+    bool _valid = false;
+    ParkedState _last = {};
+    uint32_t _nvsWrites = 0;
+};
@@ -1,16 +1,34 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <time.h>
+#include <sys/time.h>
 #include <sntp.h>
-#include <AccelStepper.h>
 #include <WiFiManager.h>
-#include <WebServer.h>
-#include <Preferences.h>
 #include <ArduinoJson.h>
 #include <ESPmDNS.h>
 #include <ArduinoOTA.h>
 #include <esp_task_wdt.h>
-#include <Update.h>
+#if CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
+#include "StepperAxis.h"
+#include "MotionLink.h"
+#include "HallSampler.h"
+#include "MagnetEstimator.h"
+#include "EventStream.h"
+#include "StepBench.h"
+#include "MovePlanner.h"
+#include "DriftTracker.h"
+#include "ConfigStore.h"
+#include "WarmStart.h"
+#include "TimeService.h"
+#include "LedController.h"
+#include "Metrics.h"
+#include "TraceRecorder.h"
+#include "BenchSuite.h"
+#include "OtaUpdater.h"
+#include "HttpServer.h"
+#include "web_assets.h"
 
 // ==========================================
 //              HARDWARE CONFIG
@@ -23,23 +41,44 @@
 #define LED_AUX_PIN 23       // AUX Light
 
 // --- PWM Channels ---
-const int PWM_FREQ = 5000;
-const int PWM_RES = 8;
 const int PWM_CH_STATUS = 0;
 const int PWM_CH_COLON = 1; 
 const int PWM_CH_AMPM = 2; 
 const int PWM_CH_AUX = 3;    
 
 // --- Steppers (Positive = Forward) ---
-AccelStepper stepperHours(AccelStepper::FULL4WIRE, 26, 33, 25, 32);
-AccelStepper stepperMinutes(AccelStepper::FULL4WIRE, 27, 12, 14, 13);
+// Pin order IN1-IN3-IN2-IN4, each spool gets its own hardware timer
+StepperAxis stepperHours;
+StepperAxis stepperMinutes;
+const int STEPPER_TIMER_HOURS = 0;
+const int STEPPER_TIMER_MINUTES = 1;
+const float MOTOR_ACCEL = 1000;   // steps/s^2
+const float MOTOR_JERK = 40000;   // steps/s^3, S-curve rounding of the ramp ends
+MovePlanner planner;              // Both spools, synchronized arrival
+const int PREPOSITION_MS = 3000;  // Next minute is handed to the planner this early
+time_t prepositionedMinute = 0;
 
 // --- Sensors ---
+// Sampled continuously by I2S/DMA on ADC1, never with analogRead()
 const int hallEffectSensorHoursPin = 35;
 const int hallEffectSensorMinutesPin = 34;
+const int HALL_CH_HOURS = 0;
+const int HALL_CH_MINUTES = 1;
+HallSampler hallSampler;
+DriftTracker driftHours, driftMinutes;  // Re-centre on every magnet pass
+TraceRecorder traceRecorder;            // Steps, samples and moves; armed from boot (/trace)
 
 const int WDT_TIMEOUT = 30; 
 
+// --- Tasks ---
+// Arduino loop() (clock logic) is moved to core 0 via ARDUINO_RUNNING_CORE,
+// next to the WiFi stack and the HTTP server task. Motion and sensors get
+// core 1 to themselves.
+const int MOTION_CORE = 1;
+const int MOTION_PRIORITY = 5;
+const int MOTION_STACK = 8192;
+const int MOTION_PERIOD_MS = 5;
+
 // Calibration Globals
 int stepsPerRevolution = 2048; 
 float stepsPerUnit = 2048.0 / 60.0; 
@@ -53,8 +92,12 @@ const int MAX_VALID_STEPS = 2056;
 //              GLOBAL STATE
 // ==========================================
 
-Preferences preferences;
-WebServer server(80);
+ConfigStore configStore;     // Written from core 0 only
+WarmStart warmStart;
+TimeService timeService;     // Core 0: the one localtime() conversion per second
+HttpServer server(80);       // Own task; handlers hold appLock
+EventStream events;
+SemaphoreHandle_t appLock;   // Held by loop() for a clock pass and by every HTTP handler
 
 // --- Settings ---
 bool is12Hour = false;
@@ -90,59 +133,64 @@ bool ledStatusEnabled = true; int ledStatusBrightness = 255;
 bool ledColonEnabled = true; int ledColonBrightness = 255; 
 bool ledAmPmEnabled = true; int ledAmPmBrightness = 255;
 bool ledAuxEnabled = true; int ledAuxBrightness = 255; 
+LedEffect ledColonEffect = LED_BLINK, ledAmPmEffect = LED_SOLID, ledAuxEffect = LED_SOLID;
+
+const uint32_t CONFIG_SAVE_DELAY_MS = 2000;  // /api/config changes wait this long for the next one
+bool configSavePending = false;
+unsigned long configSaveDue = 0;
 
+// Owned by the motion task; core 0 reads them through motionStatus
 int currentDisplayedHour = -1;
 int currentDisplayedMinute = -1;
 bool manualMode = false;
 int manualHourTarget = 0;
 int manualMinuteTarget = 0;
 bool isCalibrating = false;
+bool positionUnconfirmed = false;  // Resumed from a warm start, no magnet seen yet
 bool isWifiSetup = false;
 unsigned long lastWifiCheck = 0;
+bool wifiPortalStarted = false;
+WiFiManager wifiManager;
+const unsigned long WIFI_CONNECT_TIMEOUT_MS = 20000; // Saved network, before falling back to the portal
+
+// Boot milestones, millis() since power-on (0 = not reached yet)
+struct BootTimes {
+  uint32_t homedMs;     // Spools at a known position (homed or resumed)
+  uint32_t wifiMs;      // Associated, web server up
+  uint32_t syncMs;      // First SNTP sync
+  uint32_t displayMs;   // First time the flaps showed the correct time
+};
+BootTimes bootTimes = {};
+bool homedThisBoot = false;  // A homing ended without errors (a warm resume doesn't count)
 unsigned long lastLogicLoop = 0; // For loop throttling
 
-struct HomingState { bool isHomed; };
-HomingState homeStateHours = {false};
-HomingState homeStateMinutes = {false};
-
-// ==========================================
-//             LED CONTROLLER
-// ==========================================
-class LedController {
-  private:
-    int pin; int channel; unsigned long lastToggle; bool state; bool usePWM;
-  public:
-    void begin(int p, int ch, bool pwm) {
-      pin = p; channel = ch; usePWM = pwm;
-      if(usePWM) {
-        ledcSetup(channel, PWM_FREQ, PWM_RES);
-        ledcAttachPin(pin, channel);
-      } else {
-        pinMode(pin, OUTPUT);
-      }
-      state = false; lastToggle = 0;
-    }
-    
-    void update(bool enabled, int brightness, int interval) {
-      if (!enabled) { forceOff(); return; }
-      if (millis() - lastToggle >= interval) {
-        lastToggle = millis();
-        state = !state;
-        if(usePWM) ledcWrite(channel, state ? brightness : 0);
-        else digitalWrite(pin, state ? HIGH : LOW);
-      }
-    }
-
-    void forceOff() { 
-        if(usePWM) ledcWrite(channel, 0); 
-        else digitalWrite(pin, LOW); 
-    }
-    
-    void forceOn(int brightness) { 
-        if(usePWM) ledcWrite(channel, brightness);
-        else digitalWrite(pin, HIGH);
-    }
-};
+// --- Scheduling ---
+TaskHandle_t loopTaskHandle = nullptr;  // Woken by the motion task and SNTP
+bool motionBusy = false;                // Motion task only
+uint32_t loopWakes = 0;
+
+// --- Metrics (/metrics), all in us ---
+Histogram loopPassTime(6, 20);      // One clockTick(): 64 us .. 1 s
+Histogram loopInterval(10, 21);     // Start to start of passes: 1 ms .. 2 s
+uint32_t loopOverruns = 0;          // Passes longer than POLL_MS
+Histogram homingTime(20, 27);       // Motion task: 1 s .. 2 min
+Histogram calibrationTime(20, 27);
+uint32_t homingStartedMs = 0;
+bool wifiLinkUp = false;
+uint32_t wifiReconnects = 0;
+
+// --- Motion Link ---
+SpscQueue<MotionCommand, 16> motionQueue;
+Snapshot<MotionStatus> motionStatus;
+uint32_t nextMotionCommandId = 1;   // Producer side (core 0) only
+uint32_t lastMotionCommandId = 0;   // Consumer side (core 1) only
+bool motionPowerSaver = false;      // Consumer side copy of powerSaverEnabled
+bool motionParked = false;          // Consumer side: MOTION_PARK (firmware update running)
+int32_t pendingMaxSpeed = 0;        // Consumer side: MOTION_SET_SPEED waiting for both spools to stop
+bool wasCalibrating = false;
+bool nightOutputsOff = false;
+
+OtaUpdater otaUpdater;
 
 LedController ledStatus; 
 LedController ledColon; 
@@ -152,648 +200,335 @@ LedController ledAux;
 // ==========================================
 //              HTML DASHBOARD
 // ==========================================
-const char index_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-  <title>Split Flap Clock</title>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <style>
-    body { font-family: 'Segoe UI', sans-serif; text-align: center; background-color: #f4f4f9; margin: 0; padding: 20px; color: #333; }
-    .card { background: white; max-width: 650px; margin: auto; padding: 25px; border-radius: 15px; box-shadow: 0 10px 20px rgba(0,0,0,0.1); }
-    h1 { color: #2c3e50; margin-bottom: 5px; }
-    
-    /* Flex layout for 5 columns */
-    .stat-box { display: flex; justify-content: space-between; margin: 20px 0; background: #eef2f5; padding: 10px; border-radius: 10px; }
-    
-    /* UPDATED: Width ~19% to fit 5 items */
-    .stat { width: 19%; display: flex; flex-direction: column; justify-content: center; }
-    
-    .stat h3 { margin: 5px 0; font-size: 11px; color: #7f8c8d; text-transform: uppercase; letter-spacing: 1px;}
-    
-    .time-display { font-size: 24px; font-weight: bold; color: #2c3e50; }
-    .sensor-text { font-size: 13px; color: #555; line-height: 1.4; word-wrap: break-word; }
-    
-    .active { color: #e74c3c; font-weight: bold; }
-    .inactive { color: #27ae60; font-weight: bold; }
-    
-    input, select, button { box-sizing: border-box; padding: 12px; margin: 8px 0; width: 100%; border: 1px solid #ddd; border-radius: 8px; font-size: 16px; }
-    input[type=checkbox] { width: 20px; height: 20px; vertical-align: middle; margin: 0 10px 0 0; }
-    input[type=range] { padding: 0; margin: 10px 0; }
-    button { background-color: #3498db; color: white; border: none; cursor: pointer; transition: 0.3s; font-weight: 600; }
-    button:hover { background-color: #2980b9; }
-    .btn-green { background-color: #2ecc71; } .btn-green:hover { background-color: #27ae60; }
-    .btn-orange { background-color: #f39c12; } .btn-orange:hover { background-color: #d35400; }
-    .btn-danger { background-color: #e74c3c; } .btn-danger:hover { background-color: #c0392b; }
-    .control-group { border-top: 2px solid #f0f0f0; padding-top: 20px; margin-top: 20px; text-align: left; }
-    .row { display: flex; align-items: center; gap: 10px; margin-bottom: 10px; }
-    .row input[type=number] { flex: 1; }
-    label { font-weight: bold; display: block; margin-top: 10px; }
-    .sub-label { font-weight: normal; font-size: 14px; color: #666; }
-    
-    #prog-wrap { display:none; background:#eee; height:20px; border-radius:10px; overflow:hidden; margin-top:10px;}
-    #prog-bar { background:#2ecc71; height:100%; width:0%; transition:width 0.2s;}
-    
-    #calib-overlay { display:none; position:fixed; top:0; left:0; width:100%; height:100%; background:rgba(0,0,0,0.8); z-index:99; align-items:center; justify-content:center; flex-direction:column; color:white; }
-    #calib-bar-wrap { width:80%; height:30px; background:#555; border-radius:15px; overflow:hidden; margin-top:20px; }
-    #calib-bar { width:0%; height:100%; background:#f1c40f; transition:width 0.2s; }
-  </style>
-</head>
-<body>
-  
-  <div id="calib-overlay">
-      <h2 id="calib-text">Calibrating...</h2>
-      <div id="calib-bar-wrap"><div id="calib-bar"></div></div>
-      <p>Do not turn off power.</p>
-  </div>
-
-  <div class="card">
-    <h1>Split Flap Clock</h1>
-    
-    <div class="stat-box">
-      <div class="stat">
-          <h3>WIFI</h3>
-          <div id="wifiStats" class="sensor-text">--</div>
-      </div>
-      <div class="stat">
-          <h3>TIME</h3>
-          <div id="dispTime" class="time-display">--:--</div>
-      </div>
-      <div class="stat">
-          <h3>DATE</h3>
-          <div id="dispDate" class="time-display" style="font-size:22px">--</div>
-      </div>
-      <div class="stat">
-          <h3>SENSORS</h3>
-          <div id="sensorStats" class="sensor-text">Loading...</div>
-      </div>
-      <div class="stat">
-          <h3>CALIBRATION</h3>
-          <div id="calibStats" class="sensor-text">Loading...</div>
-      </div>
-    </div>
-
-    <div class="control-group">
-      <h3>Manual Control</h3>
-      <div class="row">
-        <input type="number" id="manualH" placeholder="HH" min="0" max="23">
-        <input type="number" id="manualM" placeholder="MM" min="0" max="59">
-      </div>
-      <button onclick="setManual()">Move to Time</button>
-      <button onclick="resumeAuto()" class="btn-green">Resume Auto Clock</button>
-    </div>
-
-    <div class="control-group">
-      <h3>Configuration</h3>
-      <form action="/save" method="POST">
-        <label>Clock Mode</label>
-        <select id="is12h" name="is12h"><option value="0">24 Hour</option><option value="1">12 Hour</option></select>
-
-        <label>Region / Timezone</label>
-        <select id="tz" name="tz">
-            <option value="UTC0">Universal Time (UTC/GMT)</option>
-            <optgroup label="North America">
-                <option value="EST5EDT,M3.2.0,M11.1.0">Eastern Time (New York, Toronto)</option>
-                <option value="CST6CDT,M3.2.0,M11.1.0">Central Time (Chicago, Mexico City)</option>
-                <option value="MST7MDT,M3.2.0,M11.1.0">Mountain Time (Denver)</option>
-                <option value="MST7">Mountain - No DST (Arizona)</option>
-                <option value="PST8PDT,M3.2.0,M11.1.0">Pacific Time (LA, Vancouver)</option>
-                <option value="AKST9AKDT,M3.2.0,M11.1.0">Alaska (Anchorage)</option>
-                <option value="HST10">Hawaii (Honolulu)</option>
-            </optgroup>
-            <optgroup label="South America">
-                <option value="<-03>3">Brazil / Argentina (Sao Paulo, Buenos Aires)</option>
-                <option value="<-04>4<-03>,M9.1.6/24,M4.1.6/24">Chile (Santiago)</option>
-                <option value="<-05>5">Colombia / Peru (Bogota, Lima)</option>
-            </optgroup>
-            <optgroup label="Europe">
-                <option value="GMT0BST,M3.5.0/1,M10.5.0">UK / Ireland (London, Dublin)</option>
-                <option value="CET-1CEST,M3.5.0,M10.5.0/3">Central Europe (Paris, Berlin, Rome)</option>
-                <option value="EET-2EEST,M3.5.0/3,M10.5.0/4">Eastern Europe (Athens, Helsinki)</option>
-                <option value="MSK-3">Moscow (No DST)</option>
-            </optgroup>
-            <optgroup label="Africa & Middle East">
-                <option value="WAT-1">West Africa (Lagos, Algiers)</option>
-                <option value="SAST-2">South Africa (Johannesburg)</option>
-                <option value="EET-2EEST,M4.5.5/0,M10.5.4/24">Egypt (Cairo)</option>
-                <option value="<-03>3">Saudi Arabia (Riyadh)</option>
-                <option value="<-04>4">UAE (Dubai)</option>
-            </optgroup>
-            <optgroup label="Asia">
-                <option value="IST-5:30">India (New Delhi, Mumbai)</option>
-                <option value="<-07>7">Thailand / Vietnam (Bangkok, Hanoi)</option>
-                <option value="<-08>8">China / Singapore (Beijing, HK, Perth)</option>
-                <option value="JST-9">Japan / Korea (Tokyo, Seoul)</option>
-            </optgroup>
-            <optgroup label="Oceania">
-                <option value="ACST-9:30ACDT,M10.1.0,M4.1.0/3">Adelaide (South Australia)</option>
-                <option value="AEST-10">Brisbane (No DST)</option>
-                <option value="AEST-10AEDT,M10.1.0,M4.1.0/3">Sydney / Melbourne</option>
-                <option value="NZST-12NZDT,M9.5.0,M4.1.0/3">New Zealand (Auckland)</option>
-            </optgroup>
-        </select>
-        
-        <label>Maintenance</label>
-        <div class="row">
-            <span class="sub-label" style="width:200px">Auto-Home Every (Hours):</span>
-            <input type="number" id="homeInt" name="homeInt" min="0" max="168" placeholder="0 to Disable">
-        </div>
-
-        <label>Motor Settings</label>
-        <div class="row">
-            <span class="sub-label">Power Saver (Off 2s after move):</span>
-            <input type="checkbox" id="pwrSav" name="pwrSav" value="1">
-        </div>
-        <div class="row">
-             <span class="sub-label">Max Speed:</span>
-             <input type="range" id="spd" name="spd" min="100" max="1200" oninput="document.getElementById('spdVal').innerText=this.value">
-             <span id="spdVal" style="width:40px; text-align:right;">1000</span>
-        </div>
-
-        <label>Sensor Tuning</label>
-        <div class="row">
-             <span class="sub-label">Sensitivity:</span>
-             <input type="range" id="sens" name="sens" min="1" max="100" oninput="document.getElementById('sensVal').innerText=this.value">
-             <span id="sensVal" style="width:40px; text-align:right;">50</span>
-        </div>
-        <div class="row">
-             <button type="button" class="btn-orange" onclick="runCalibration('sensors')">Calibrate Sensors (Home)</button>
-             <button type="button" class="btn-orange" style="background:#d35400;" onclick="runCalibration('motors')">Calibrate Motors (Full)</button>
-        </div>
-
-      <label>Alternating Date Display</label>
-        
-        <div class="row">
-            <span class="sub-label">Enable Date Display:</span>
-            <input type="checkbox" id="dateEn" name="dateEn" value="1">
-        </div>
-
-        <div class="row">
-             <span class="sub-label" style="width:60%">Display date every (Minutes):</span>
-             <input type="number" id="dateInt" name="dateInt" min="1" max="60">
-        </div>
-
-        <div class="row">
-             <span class="sub-label" style="width:60%">Display duration (Seconds):</span>
-             <input type="number" id="dateDur" name="dateDur" min="2" max="60">
-        </div>
-
-        <label>Night Mode</label>
-        
-        <div class="row">
-            <span class="sub-label">Enable Night Mode:</span>
-            <input type="checkbox" id="nightEn" name="nightEn" value="1">
-        </div>
-
-        <div class="row">
-            <span class="sub-label" style="width:60%">Turn OFF at Hour (0-23):</span>
-            <input type="number" id="nStart" name="nStart" placeholder="22" min="0" max="23">
-        </div>
-
-        <div class="row">
-            <span class="sub-label" style="width:60%">Turn ON at Hour (0-23):</span>
-            <input type="number" id="nEnd" name="nEnd" placeholder="7" min="0" max="23">
-        </div>
-
-        <label>LED Settings</label>
-        
-        <div class="row">
-            <span class="sub-label">Internal Status LED:</span>
-            <input type="checkbox" id="ledS_en" name="ledS_en" value="1">
-        </div>
-        <input type="range" id="ledS_br" name="ledS_br" min="0" max="255">
-
-        <div class="row">
-            <span class="sub-label">Blinking Colon:</span>
-            <input type="checkbox" id="ledC_en" name="ledC_en" value="1">
-        </div>
-        <input type="range" id="ledC_br" name="ledC_br" min="0" max="255">
-        
-        <div class="row">
-            <span class="sub-label">Auxiliary Light (Solid):</span>
-            <input type="checkbox" id="ledX_en" name="ledX_en" value="1">
-        </div>
-        <input type="range" id="ledX_br" name="ledX_br" min="0" max="255">
-
-        <div class="row">
-            <span class="sub-label">PM Indicator:</span>
-            <input type="checkbox" id="ledA_en" name="ledA_en" value="1">
-        </div>
-        <input type="range" id="ledA_br" name="ledA_br" min="0" max="255">
-
-        <button type="submit">Save Settings</button>
-      </form>
-    </div>
-
-    <div class="control-group">
-      <h3>System</h3>
-      <div class="row">
-        <button class="btn-danger" type="button" onclick="if(confirm('Restart?')) location.href='/restart'">Restart</button>
-        <button class="btn-danger" type="button" onclick="if(confirm('Reset WiFi?')) location.href='/reset_wifi'">Reset WiFi</button>
-      </div>
-
-      <div style="margin-top:10px;">
-        <button class="btn-danger" style="background:#c0392b;" type="button" onclick="if(confirm('RESET CALIBRATION? Use this if clock spins wildly.')) location.href='/reset_cal'">Reset Calibration</button>
-      </div>
-
-      <div style="margin-top:15px; border-top:1px solid #ddd; padding-top:15px;">
-        <input type="file" id="fwFile" accept=".bin" style="display:none" onchange="uploadFirmware(this)">
-        <button style="background:#8e44ad;" onclick="document.getElementById('fwFile').click()">Update Firmware</button>
-        <div id="prog-wrap"><div id="prog-bar"></div></div>
-        <p id="updStatus" style="font-size:12px; color:#666;"></p>
-      </div>
-      
-      <p style="font-size:12px; text-align:center; color:#888; margin-top:20px;">Access via: http://splitflap.local</p>
-    </div>
-  </div>
-
-  <script>
-    function calcDiff(val) {
-        let diff = ((val - 2048) / 2048) * 100;
-        if(diff === 0) return '<span style="color:#27ae60; font-weight:bold;">0.00% (Default)</span>';
-        let color = (diff > 0.5 || diff < -0.5) ? '#e74c3c' : '#27ae60';
-        return '<span style="color:'+color+'; font-weight:bold;">' + (diff>0?'+':'') + diff.toFixed(2) + '%</span>';
-    }
+// Sources live in web/. tools/build_web.py gzips them at build time and
+// generates web_assets.h (byte arrays + content-hash ETags).
 
-    function updateStatus() {
-      fetch('/status').then(res => res.json()).then(data => {
-        // UPDATE WIFI
-        let sig = data.rssi;
-        let quality = (sig >= -50) ? "Excellent" : (sig >= -60) ? "Good" : (sig >= -70) ? "Fair" : "Weak";
-        let color = (sig >= -60) ? "#27ae60" : (sig >= -70) ? "#f39c12" : "#e74c3c";
-        document.getElementById('wifiStats').innerHTML = '<strong>' + data.ssid + '</strong><br><span style="color:' + color + ';">' + quality + ' (' + sig + 'dBm)</span>';
-
-        // UPDATE TIME
-        document.getElementById('dispTime').innerText = (data.h<10?'0':'')+data.h + ':' + (data.m<10?'0':'')+data.m;
-        
-        // UPDATE DATE (NEW)
-        document.getElementById('dispDate').innerText = data.date;
-
-        // UPDATE SENSORS
-        let sensHtml = 'H: ' + (data.sensH ? '<span class="active">MAG</span>' : '<span class="inactive">---</span>') + ' (' + data.baseH + ')<br>' +
-                       'M: ' + (data.sensM ? '<span class="active">MAG</span>' : '<span class="inactive">---</span>') + ' (' + data.baseM + ')';
-        document.getElementById('sensorStats').innerHTML = sensHtml;
-
-        // UPDATE CALIBRATION
-        let calHtml = 'H: ' + calcDiff(data.stepH) + '<br>M: ' + calcDiff(data.stepM);
-        document.getElementById('calibStats').innerHTML = calHtml;
-
-        if(!document.getElementById('tz').dataset.loaded) {
-           document.getElementById('is12h').value = data.conf_12h ? "1" : "0";
-           document.getElementById('tz').value = data.conf_tz; 
-           document.getElementById('homeInt').value = data.conf_homeInt;
-           
-           document.getElementById('dateEn').checked = data.conf_dEn;
-           document.getElementById('dateInt').value = data.conf_dInt;
-           document.getElementById('dateDur').value = data.conf_dDur;
-
-           document.getElementById('pwrSav').checked = data.conf_pwrSav;
-           document.getElementById('spd').value = data.conf_spd;
-           document.getElementById('spdVal').innerText = data.conf_spd;
-           document.getElementById('sens').value = data.conf_sens;
-           document.getElementById('sensVal').innerText = data.conf_sens;
-           document.getElementById('nightEn').checked = data.conf_nEn;
-           document.getElementById('nStart').value = data.conf_nStart;
-           document.getElementById('nEnd').value = data.conf_nEnd;
-           
-           document.getElementById('ledS_en').checked = data.ledS_en;
-           document.getElementById('ledS_br').value = data.ledS_br;
-           document.getElementById('ledC_en').checked = data.ledC_en;
-           document.getElementById('ledC_br').value = data.ledC_br;
-           document.getElementById('ledX_en').checked = data.ledX_en;
-           document.getElementById('ledX_br').value = data.ledX_br;
-           document.getElementById('ledA_en').checked = data.ledA_en;
-           document.getElementById('ledA_br').value = data.ledA_br;
-           document.getElementById('tz').dataset.loaded = true;
-        }
-      });
-    }
+// ==========================================
+//              CORE FUNCTIONS
+// ==========================================
 
-    function runCalibration(type) {
-        let msg = (type === 'motors') ? 
-            "Full Calibration: Will recalibrate sensors AND count motor steps. Continue?" :
-            "Sensor Calibration: Will recalibrate baseline and home to 00:00. Continue?";
-            
-        if(!confirm(msg)) return;
-        
-        document.getElementById('calib-overlay').style.display = 'flex';
-        fetch('/calibrate_' + type, { method: 'POST' });
-        
-        let pollTimer = setInterval(() => {
-            fetch('/calib_status').then(r=>r.json()).then(d => {
-                document.getElementById('calib-text').innerText = d.status;
-                document.getElementById('calib-bar').style.width = d.progress + "%";
-                if(d.progress >= 100) {
-                    clearInterval(pollTimer);
-                    setTimeout(() => { 
-                        document.getElementById('calib-overlay').style.display = 'none'; 
-                        location.reload(); 
-                    }, 1000);
-                }
-            });
-        }, 500);
-    }
+bool isNightHour(int h) {
+  if (!nightModeEnabled) return false;
+  if (nightStartHour > nightEndHour) return (h >= nightStartHour || h < nightEndHour);
+  else return (h >= nightStartHour && h < nightEndHour);
+}
 
-    function uploadFirmware(input) {
-        let file = input.files[0];
-        if(!file) return;
-        let formData = new FormData();
-        formData.append("update", file);
-        document.getElementById('prog-wrap').style.display = 'block';
-        document.getElementById('updStatus').innerText = "Uploading " + file.name + "...";
-        let xhr = new XMLHttpRequest();
-        xhr.open("POST", "/update");
-        xhr.upload.addEventListener("progress", function(evt) {
-            if (evt.lengthComputable) {
-                let percentComplete = (evt.loaded / evt.total) * 100;
-                document.getElementById('prog-bar').style.width = percentComplete + '%';
-            }
-        }, false);
-        xhr.onload = function() {
-            if (xhr.status == 200 && xhr.responseText == "OK") {
-                 document.getElementById('updStatus').innerText = "Success! Rebooting...";
-                 setTimeout(() => location.reload(), 5000);
-            } else {
-                 document.getElementById('updStatus').innerText = "Failed: " + xhr.responseText;
-            }
-        };
-        xhr.send(formData);
-    }
+bool isNightTime() {
+  const TimeSnapshot &t = timeService.now();
+  return t.synced && isNightHour(t.local.tm_hour);
+}
 
-    function setManual() {
-      let h = document.getElementById('manualH').value;
-      let m = document.getElementById('manualM').value;
-      fetch('/manual?h=' + h + '&m=' + m, { method: 'POST' });
-    }
-    function resumeAuto() { fetch('/resume', { method: 'POST' }); }
-    setInterval(updateStatus, 1000);
-    updateStatus();
-  </script>
-</body>
-</html>
-)rawliteral";
+int lastSensorHours = 0;
+int lastSensorMinutes = 0;
+
+// Motion task only: publish what core 0 is allowed to see
+void publishMotionStatus() {
+  MotionStatus st;
+  st.lastCommandId = lastMotionCommandId;
+  st.positionHours = stepperHours.currentPosition();
+  st.positionMinutes = stepperMinutes.currentPosition();
+  st.displayedHour = currentDisplayedHour;
+  st.displayedMinute = currentDisplayedMinute;
+  st.sensorHours = lastSensorHours;
+  st.sensorMinutes = lastSensorMinutes;
+  st.moving = stepperHours.isRunning() || stepperMinutes.isRunning();
+  st.queued = planner.pending();
+  st.calibrating = isCalibrating;
+  st.parked = motionParked && !st.moving;
+  st.calibrationProgress = calibrationProgress;
+  strlcpy(st.calibrationStatus, calibrationStatus.c_str(), sizeof(st.calibrationStatus));
+  const LandingStats &landing = planner.landing();
+  st.landings = landing.count; st.landingsOnTime = landing.onTime;
+  st.landingErrorUs = landing.lastErrorUs;
+  st.landingMeanAbsUs = landing.meanAbsErrorUs; st.landingMaxAbsUs = landing.maxAbsErrorUs;
+  for (int k = 0; k < MOVE_KINDS; k++) st.moveUs[k] = planner.timing((MoveKind)k).lastUs;
+  motionStatus.publish(st);
+}
 
 // ==========================================
-//              CORE FUNCTIONS
+//          HOMING STATE MACHINE
 // ==========================================
+// Homing, baseline measurement and the two-revolution step count run as one
+// resumable state machine per spool. The motion task ticks both axes every
+// MOTION_PERIOD_MS, so the spools home concurrently and a calibration can be
+// cancelled between any two ticks.
+//
+// Each magnet pass is recorded at sweep speed and handed to MagnetEstimator,
+// which returns a sub-step center. The position is re-zeroed on the fly, so
+// homing is a single forward pass; the spool then steps back the few dozen
+// steps it coasted past the center, so it rests on 00 while it waits for the
+// time instead of between two flaps.
+
+enum HomingPhase : uint8_t {
+  HOME_IDLE,
+  HOME_CLEAR,        // Move 600 steps away so the sensor isn't sitting on a magnet
+  HOME_BASELINE,     // Average the idle sensor level
+  HOME_SEEK,         // Sweep and record the first magnet pass
+  HOME_COUNT_BLIND,  // Step counting: skip past the first magnet pass
+  HOME_COUNT_SEEK,   // Step counting: record the second magnet pass
+  HOME_SETTLE,       // Back onto the center the sweep overran
+  HOME_DONE,
+  HOME_FAILED
+};
+
+const int HOME_BASELINE_SAMPLES = 200;
+const int HOME_SWEEP_SPEED = 500;  // Steps/s while recording a magnet pass
+
+struct AxisHoming {
+  const char *name;
+  StepperAxis *stepper;
+  int sensor;               // HallSampler channel
+  int *baseline;
+  HomingPhase phase;
+  long seekStart;
+  uint32_t sampleCursor;    // Next sampler sequence to feed the estimator
+  uint32_t baselineStart;   // Sampler sequence when baseline averaging began
+  MagnetEstimator estimator;
+  float measuredSteps;
+  String error;
+};
+
+AxisHoming homingHours = { "H", &stepperHours, HALL_CH_HOURS, &baselineHours };
+AxisHoming homingMinutes = { "M", &stepperMinutes, HALL_CH_MINUTES, &baselineMinutes };
+bool homingMeasureBaseline = false;
+bool homingCountSteps = false;
+int homingThreshold = 0;
+
+// Hall deviation that counts as the magnet, from the sensitivity setting
+int sensorThreshold() { return map(sensorSensitivity, 1, 100, 1500, 100); }
+
+// Every phase change goes through here so the trace sees it
+void setHomingPhase(AxisHoming &ax, HomingPhase phase) {
+  if (ax.phase == phase) return;
+  ax.phase = phase;
+  traceRecorder.record(TRACE_HOMING, ax.sensor, phase, ax.stepper->currentPosition());
+}
+
+void setHomingBaseline(AxisHoming &ax, int baseline) {
+  *ax.baseline = baseline;
+  hallSampler.setBaseline(ax.sensor, baseline);
+}
 
-struct Time { int hour; int minute; bool isPm; };
-
-Time getLocalTimeData() {
-  struct tm timeinfo;
-  if (!getLocalTime(&timeinfo)) return { -1, -1, false};
-  int rawHour = timeinfo.tm_hour;
-  bool pm = (rawHour >= 12); 
-  int iHour = rawHour;
-  int iMinute = timeinfo.tm_min;
-  if (is12Hour) {
-    iHour = (iHour % 12);
-    if (iHour == 0) iHour = 12;
+void armHomingEstimator(AxisHoming &ax) {
+  ax.estimator.begin(*ax.baseline, homingThreshold);
+  ax.sampleCursor = hallSampler.sequence(ax.sensor);
+}
+
+// Feed every sample taken since the last tick, returns true once a pass is complete
+bool feedHomingEstimator(AxisHoming &ax) {
+  uint32_t newest = hallSampler.sequence(ax.sensor);
+  HallSample s;
+  while (ax.sampleCursor < newest && ax.estimator.state() < MagnetEstimator::DONE) {
+    if (hallSampler.history(ax.sensor, ax.sampleCursor, s)) ax.estimator.add(s.position, s.value);
+    ax.sampleCursor++;
   }
-  return {iHour, iMinute, pm};
+  return ax.estimator.state() >= MagnetEstimator::DONE;
 }
 
-bool isNightTime() {
-  if (!nightModeEnabled) return false;
-  struct tm timeinfo;
-  if (!getLocalTime(&timeinfo)) return false;
-  int h = timeinfo.tm_hour;
-  if (nightStartHour > nightEndHour) return (h >= nightStartHour || h < nightEndHour);
-  else return (h >= nightStartHour && h < nightEndHour);
+void beginHomingSeek(AxisHoming &ax) {
+  ax.stepper->setMaxSpeed(600);
+  ax.stepper->runAtSpeed(HOME_SWEEP_SPEED);
+  ax.seekStart = ax.stepper->currentPosition();
+  armHomingEstimator(ax);
+  setHomingPhase(ax, HOME_SEEK);
 }
 
-int readSensorAverage(int pin) {
-    long sum = 0;
-    for(int i=0; i<10; i++) {
-        sum += analogRead(pin);
-        delay(1);
-    }
-    return sum / 10;
-}
-
-// Helper to find the center of the magnet
-// Returns the number of steps taken to cross the magnet width
-int centerOnMagnet(AccelStepper &stepper, int sensorPin, int baseline, int threshold) {
-    long startPos = stepper.currentPosition();
-    bool magnetLost = false;
-    
-    // We are already at the 'edge' (sensor triggered). 
-    // Now move slowly forward until the sensor turns OFF.
-    stepper.setSpeed(200); // Slow for precision
-    
-    // Limit search to 150 steps to prevent infinite loop if sensor stuck
-    while (!magnetLost && (stepper.currentPosition() - startPos < 150)) {
-        stepper.runSpeed();
-        // Check if we are back to baseline (sensor OFF)
-        if (abs(readSensorAverage(sensorPin) - baseline) < threshold) {
-             magnetLost = true;
+void settleHoming(AxisHoming &ax) {
+  ax.stepper->halt();
+  ax.stepper->moveTo(0);
+  setHomingPhase(ax, HOME_SETTLE);
+}
+
+void failHoming(AxisHoming &ax, const String &error) {
+  ax.stepper->halt();
+  ax.error = error;
+  setHomingPhase(ax, HOME_FAILED);
+}
+
+void tickAxisHoming(AxisHoming &ax) {
+  StepperAxis &stepper = *ax.stepper;
+  switch (ax.phase) {
+    case HOME_CLEAR:
+      if (!stepper.isRunning()) { ax.baselineStart = hallSampler.sequence(ax.sensor); setHomingPhase(ax, HOME_BASELINE); }
+      break;
+
+    case HOME_BASELINE:
+      if (hallSampler.sequence(ax.sensor) - ax.baselineStart >= HOME_BASELINE_SAMPLES) {
+        setHomingBaseline(ax, hallSampler.mean(ax.sensor, HOME_BASELINE_SAMPLES));
+        beginHomingSeek(ax);
+      }
+      break;
+
+    case HOME_SEEK:
+    case HOME_COUNT_SEEK:
+      if (feedHomingEstimator(ax)) {
+        if (!ax.estimator.done()) { failHoming(ax, "Err " + String(ax.name) + ": Magnet Profile"); break; }
+
+        // Re-zero on the magnet center while still moving
+        float center = ax.estimator.center();
+        long shift = lround(center);
+        stepper.shiftPosition(-shift);
+
+        if (ax.phase == HOME_COUNT_SEEK) {
+          // Counting started from a centered zero, so this is exactly two turns
+          ax.measuredSteps = center / 2.0;
+          settleHoming(ax);
+        } else if (homingCountSteps) {
+          setHomingPhase(ax, HOME_COUNT_BLIND);  // Keep sweeping for two more passes
+        } else {
+          settleHoming(ax);
         }
-        esp_task_wdt_reset();
-    }
-    
-    long endPos = stepper.currentPosition();
-    long magnetWidth = endPos - startPos;
-    
-    // Move backward to the exact center
-    long centerOffset = magnetWidth / 2;
-    stepper.setCurrentPosition(magnetWidth); // Temporarily call end "width"
-    stepper.runToNewPosition(centerOffset);  // Move back to "half width"
-    
-    // Now we are in the center. Set this as TRUE ZERO.
-    stepper.setCurrentPosition(0);
-    
-    return (int)magnetWidth;
-}
-
-void runHomingSequence(bool measureBaseline, bool countSteps) {
-  isCalibrating = true;
-  homeStateHours.isHomed = false;
-  homeStateMinutes.isHomed = false;
-  
-  stepperHours.enableOutputs();
-  stepperMinutes.enableOutputs();
-
-  // --- STAGE 1 & 2: BASELINE (Unchanged) ---
-  if (measureBaseline) {
-      calibrationStatus = "Clearing Sensors...";
-      calibrationProgress = 5;
-      server.handleClient();
-      stepperHours.move(600); stepperMinutes.move(600);
-      stepperHours.setMaxSpeed(600); stepperMinutes.setMaxSpeed(600);
-      while(stepperHours.distanceToGo() != 0 || stepperMinutes.distanceToGo() != 0) {
-          stepperHours.run(); stepperMinutes.run(); esp_task_wdt_reset();
+      } else if (stepper.currentPosition() - ax.seekStart > (MAX_VALID_STEPS * 5) / 2) {
+        failHoming(ax, "Err " + String(ax.name) + ": No Magnet");
       }
-      
-      calibrationStatus = "Measuring Baseline...";
-      calibrationProgress = 10;
-      server.handleClient();
-      long sumH = 0, sumM = 0;
-      for(int i=0; i<200; i++) {
-          sumH += analogRead(hallEffectSensorHoursPin);
-          sumM += analogRead(hallEffectSensorMinutesPin);
-          delay(2);
+      break;
+
+    case HOME_SETTLE:
+      if (!stepper.isRunning()) setHomingPhase(ax, HOME_DONE);
+      break;
+
+    case HOME_COUNT_BLIND:
+      // Sweep blindly past the first magnet pass (at ~2048)
+      if (stepper.currentPosition() >= 3000) {
+        ax.seekStart = 0; // Timeout still measured from the centered zero
+        armHomingEstimator(ax);
+        setHomingPhase(ax, HOME_COUNT_SEEK);
       }
-      baselineHours = sumH / 200;
-      baselineMinutes = sumM / 200;
-      
-      preferences.begin("clock-conf", false);
-      preferences.putInt("baseH", baselineHours);
-      preferences.putInt("baseM", baselineMinutes);
-      preferences.end();
+      break;
+
+    default:
+      break;
+  }
+}
+
+const char *homingPhaseName(HomingPhase phase) {
+  switch (phase) {
+    case HOME_CLEAR: return "Clearing";
+    case HOME_BASELINE: return "Baseline";
+    case HOME_SEEK: return "Seeking";
+    case HOME_COUNT_BLIND: case HOME_COUNT_SEEK: return "Counting";
+    case HOME_SETTLE: return "Centering";
+    case HOME_DONE: return "Done";
+    case HOME_FAILED: return "Failed";
+    default: return "Idle";
+  }
+}
+
+int homingPhaseProgress(const AxisHoming &ax) {
+  switch (ax.phase) {
+    case HOME_CLEAR: return 5;
+    case HOME_BASELINE: return 10;
+    case HOME_SEEK: return 25;
+    case HOME_COUNT_BLIND: return 40 + (int)(35 * max(0L, min(ax.stepper->currentPosition(), 3000L)) / 3000);
+    case HOME_COUNT_SEEK: return 80;
+    case HOME_SETTLE: return 95;
+    case HOME_DONE: case HOME_FAILED: return 100;
+    default: return 0;
+  }
+}
+
+bool homingAxisFinished(const AxisHoming &ax) { return ax.phase == HOME_DONE || ax.phase == HOME_FAILED; }
+
+void startAxisHoming(AxisHoming &ax) {
+  ax.measuredSteps = 0; ax.error = "";
+  ax.stepper->enableOutputs();
+  if (homingMeasureBaseline) {
+    ax.stepper->setMaxSpeed(600);
+    ax.stepper->move(600);
+    setHomingPhase(ax, HOME_CLEAR);
   } else {
-      if(baselineHours == 0) baselineHours = 1800; 
-      if(baselineMinutes == 0) baselineMinutes = 1800;
+    if (*ax.baseline == 0) setHomingBaseline(ax, 1800);
+    beginHomingSeek(ax);
   }
+}
 
-  // --- STAGE 3: FIND ZERO & CENTER (UPDATED) ---
-  calibrationStatus = "Centering on Home...";
-  int threshold = map(sensorSensitivity, 1, 100, 1500, 100);
-
-  stepperHours.setMaxSpeed(600); stepperHours.setSpeed(300); 
-  stepperMinutes.setMaxSpeed(600); stepperMinutes.setSpeed(300); 
-
-  // -- 3a. Find Edges --
-  while (!homeStateHours.isHomed || !homeStateMinutes.isHomed) {
-    esp_task_wdt_reset(); server.handleClient(); ledStatus.forceOn(255);
-    
-    if (!homeStateHours.isHomed) {
-      if (abs(readSensorAverage(hallEffectSensorHoursPin) - baselineHours) < threshold) { 
-          stepperHours.runSpeed(); 
-      } else { 
-          // Edge Found! Now perform Centering
-          stepperHours.stop();
-          centerOnMagnet(stepperHours, hallEffectSensorHoursPin, baselineHours, threshold);
-          homeStateHours.isHomed = true; 
-      }
+void startHoming(bool measureBaseline, bool countSteps) {
+  homingMeasureBaseline = measureBaseline;
+  homingCountSteps = countSteps;
+  homingThreshold = sensorThreshold();
+  homingStartedMs = millis();
+  planner.clear();
+  positionUnconfirmed = false;
+  driftHours.pause(); driftMinutes.pause();
+  isCalibrating = true;
+  calibrationStatus = "Starting...";
+  calibrationProgress = 0;
+  startAxisHoming(homingHours);
+  startAxisHoming(homingMinutes);
+}
+
+void endHoming() {
+  stepperHours.setMaxSpeed(motorMaxSpeed); stepperHours.setAcceleration(MOTOR_ACCEL);
+  stepperMinutes.setMaxSpeed(motorMaxSpeed); stepperMinutes.setAcceleration(MOTOR_ACCEL);
+  setHomingPhase(homingHours, HOME_IDLE); setHomingPhase(homingMinutes, HOME_IDLE);
+  calibrationProgress = 100;
+  isCalibrating = false;
+}
+
+void cancelHoming() {
+  if (!isCalibrating) return;
+  stepperHours.halt(); stepperMinutes.halt();
+  endHoming();
+  calibrationStatus = "Cancelled";
+  currentDisplayedHour = -1; currentDisplayedMinute = -1; // Position unknown
+}
+
+// Results reach flash from loop(), which saves the config once homing ends
+void finishHoming() {
+  String errors = "";
+  if (homingHours.phase == HOME_FAILED) errors += homingHours.error + " ";
+  if (homingMinutes.phase == HOME_FAILED) errors += homingMinutes.error + " ";
+
+  if (homingCountSteps) {
+    // Validate Steps (Check against limits)
+    float m = homingMinutes.measuredSteps, h = homingHours.measuredSteps;
+    if (homingMinutes.phase == HOME_DONE) {
+      if (m >= MIN_VALID_STEPS && m <= MAX_VALID_STEPS) {
+        stepsPerRevolution = (int)round(m); // Round to nearest whole step
+        stepsPerUnit = stepsPerRevolution / 60.0;
+      } else errors += "Err M: " + String(m) + " ";
     }
-    if (!homeStateMinutes.isHomed) {
-      if (abs(readSensorAverage(hallEffectSensorMinutesPin) - baselineMinutes) < threshold) { 
-          stepperMinutes.runSpeed(); 
-      } else { 
-          // Edge Found! Now perform Centering
-          stepperMinutes.stop();
-          centerOnMagnet(stepperMinutes, hallEffectSensorMinutesPin, baselineMinutes, threshold);
-          homeStateMinutes.isHomed = true; 
-      }
+    if (homingHours.phase == HOME_DONE) {
+      if (h >= MIN_VALID_STEPS && h <= MAX_VALID_STEPS) {
+        stepsPerRevolutionHours = (int)round(h);
+        stepsPerUnitHours = stepsPerRevolutionHours / 60.0;
+      } else errors += "Err H: " + String(h) + " ";
     }
   }
+  (homingCountSteps ? calibrationTime : homingTime).add((millis() - homingStartedMs) * 1000UL);
+  if (errors.length() > 0) calibrationStatus = errors;
+  else if (homingCountSteps) calibrationStatus = "Complete: M" + String(stepsPerRevolution) + " H" + String(stepsPerRevolutionHours);
+  else calibrationStatus = "Homed & Centered";
+
+  // Only a spool that found its magnet has a position worth correcting
+  if (homingHours.phase == HOME_DONE) driftHours.arm(baselineHours, homingThreshold);
+  if (homingMinutes.phase == HOME_DONE) driftMinutes.arm(baselineMinutes, homingThreshold);
+
+  endHoming();
+  // Settled on the centre, so normally 00; a failed axis shows wherever it stopped
+  currentDisplayedHour = (int)(max(0L, stepperHours.currentPosition()) / stepsPerUnitHours) % 60;
+  currentDisplayedMinute = (int)(max(0L, stepperMinutes.currentPosition()) / stepsPerUnit) % 60;
+}
 
-  if (!countSteps) {
-      // Just finish up if we aren't calibrating the step count
-      calibrationStatus = "Homed & Centered";
-      calibrationProgress = 100;
-      server.handleClient();
-      stepperHours.setMaxSpeed(motorMaxSpeed); stepperHours.setAcceleration(1000);
-      stepperMinutes.setMaxSpeed(motorMaxSpeed); stepperMinutes.setAcceleration(1000);
-      currentDisplayedHour = 0; currentDisplayedMinute = 0;
-      isCalibrating = false; ledStatus.forceOff();
-      return; 
-  }
-
-  // --- STAGE 4: CALIBRATE MOTOR STEPS (With Safety Check) ---
-   
-   // --- CALIBRATE MINUTES (2 TURNS) ---
-   calibrationStatus = "Counting M Steps (2 Turns)...";
-   calibrationProgress = 50;
-   server.handleClient();
-   
-   stepperMinutes.setCurrentPosition(0); 
-   stepperMinutes.move(6000);     // <--- UPDATED: Enough for 2.5 turns (was 3000)
-   stepperMinutes.setMaxSpeed(600);
-   
-   // Move away blindly past the first magnet trigger (at ~2048)
-   // We wait until 3000 steps to ensure we skipped the first turn completely
-   while(stepperMinutes.currentPosition() < 3000) { // <--- UPDATED: Blind zone extended
-       stepperMinutes.run(); esp_task_wdt_reset();
-   }
-   
-   bool magnetFound = false;
-   float measuredStepsM = 0; // Use float for division later
-   
-   while(stepperMinutes.distanceToGo() != 0 && !magnetFound) {
-       stepperMinutes.run(); esp_task_wdt_reset(); server.handleClient();
-       
-       if (abs(readSensorAverage(hallEffectSensorMinutesPin) - baselineMinutes) > threshold) {
-           magnetFound = true;
-           stepperMinutes.stop();
-           centerOnMagnet(stepperMinutes, hallEffectSensorMinutesPin, baselineMinutes, threshold);
-           
-           // Divide total by 2 to get the single revolution average
-           measuredStepsM = stepperMinutes.currentPosition() / 2.0; 
-           
-           stepperMinutes.setCurrentPosition(0); 
-       }
-   }
-   
-   // Validate Minute Steps (Check against limits)
-   if(magnetFound && measuredStepsM >= MIN_VALID_STEPS && measuredStepsM <= MAX_VALID_STEPS) {
-       stepsPerRevolution = (int)round(measuredStepsM); // Round to nearest whole step
-       stepsPerUnit = stepsPerRevolution / 60.0;
-       preferences.begin("clock-conf", false);
-       preferences.putInt("stepsRev", stepsPerRevolution);
-       preferences.end();
-   } else {
-       calibrationStatus = "Err M: " + String(measuredStepsM);
-       delay(2000); 
-   }
+// Motion task only: advance both spools by one tick
+void tickHoming() {
+  if (!isCalibrating) return;
+  tickAxisHoming(homingHours);
+  tickAxisHoming(homingMinutes);
 
-   // --- CALIBRATE HOURS (2 TURNS) ---
-   calibrationStatus = "Counting H Steps (2 Turns)...";
-   calibrationProgress = 80;
-   server.handleClient();
-   
-   stepperHours.setCurrentPosition(0);
-   stepperHours.move(6000);      // <--- UPDATED
-   stepperHours.setMaxSpeed(600); 
-   
-   while(stepperHours.currentPosition() < 3000) { // <--- UPDATED
-       stepperHours.run(); esp_task_wdt_reset();
-   }
-   
-   magnetFound = false;
-   float measuredStepsH = 0;
-   
-   while(stepperHours.distanceToGo() != 0 && !magnetFound) {
-       stepperHours.run(); esp_task_wdt_reset(); server.handleClient();
-
-       if (abs(readSensorAverage(hallEffectSensorHoursPin) - baselineHours) > threshold) {
-           magnetFound = true;
-           stepperHours.stop();
-           centerOnMagnet(stepperHours, hallEffectSensorHoursPin, baselineHours, threshold);
-           
-           // Divide total by 2
-           measuredStepsH = stepperHours.currentPosition() / 2.0;
-           
-           stepperHours.setCurrentPosition(0); 
-       }
-   }
-   
-   if(magnetFound && measuredStepsH >= MIN_VALID_STEPS && measuredStepsH <= MAX_VALID_STEPS) {
-       stepsPerRevolutionHours = (int)round(measuredStepsH);
-       stepsPerUnitHours = stepsPerRevolutionHours / 60.0;
-       preferences.begin("clock-conf", false);
-       preferences.putInt("stepsRevH", stepsPerRevolutionHours);
-       preferences.end();
-   } else {
-       calibrationStatus = "Err H: " + String(measuredStepsH);
-       delay(3000);
-   }
-   
-   calibrationStatus = "Complete: M" + String(stepsPerRevolution) + " H" + String(stepsPerRevolutionHours);
-   calibrationProgress = 100;
-   server.handleClient();
-   delay(3000); 
-  
-  stepperHours.setMaxSpeed(motorMaxSpeed); stepperHours.setAcceleration(1000); 
-  stepperMinutes.setMaxSpeed(motorMaxSpeed); stepperMinutes.setAcceleration(1000); 
+  if (homingAxisFinished(homingHours) && homingAxisFinished(homingMinutes)) { finishHoming(); return; }
 
-  currentDisplayedHour = 0; currentDisplayedMinute = 0;
-  isCalibrating = false; ledStatus.forceOff(); 
+  static HomingPhase shownH = HOME_IDLE, shownM = HOME_IDLE;
+  if (homingHours.phase != shownH || homingMinutes.phase != shownM) {
+    shownH = homingHours.phase; shownM = homingMinutes.phase;
+    calibrationStatus = String("H: ") + homingPhaseName(shownH) + " / M: " + homingPhaseName(shownM);
+  }
+  calibrationProgress = min(99, (homingPhaseProgress(homingHours) + homingPhaseProgress(homingMinutes)) / 2);
 }
 
-long calculateTargetPosition(int currentVal, int nextVal, bool isHour) {
-   // 1. Get the Motor and Calibration settings for this specific spool
-   long currentSteps = isHour ? stepperHours.currentPosition() : stepperMinutes.currentPosition();
+long calculateTargetPosition(long currentSteps, int currentVal, int nextVal, bool isHour) {
+   if (nextVal == currentVal) return 0;
+   // 1. Get the Calibration settings for this specific spool
    int stepsRev = isHour ? stepsPerRevolutionHours : stepsPerRevolution;
    
    // 2. Determine where we are inside the current rotation (0 to ~2048)
@@ -823,109 +558,764 @@ long calculateTargetPosition(int currentVal, int nextVal, bool isHour) {
    return diff;
 }
 
-void blinkIpAddress() {
-    IPAddress ip = WiFi.localIP();
-    int lastOctet = ip[3]; String ipStr = String(lastOctet);
-    Serial.print("Blinking IP Last Octet: "); Serial.println(ipStr);
-    ledAmPm.forceOff(); delay(1000); 
-    for (int i = 0; i < ipStr.length(); i++) {
-        char c = ipStr.charAt(i); int digit = c - '0'; int blinks = digit; if (blinks == 0) blinks = 10; 
-        for (int b = 0; b < blinks; b++) { ledAmPm.forceOn(255); delay(200); ledAmPm.forceOff(); delay(200); }
-        delay(2000); 
+// ==========================================
+//          MOTION TASK (CORE 1)
+// ==========================================
+
+void handleMotionCommand(const MotionCommand &cmd) {
+  switch (cmd.type) {
+    case MOTION_SHOW:
+      if (isCalibrating || motionParked) break;
+      planner.push({ (int16_t)cmd.a, (int16_t)cmd.b, (uint32_t)cmd.c, 0 });
+      break;
+    case MOTION_SHOW_AT:
+      if (isCalibrating || motionParked) break;
+      planner.push({ (int16_t)cmd.a, (int16_t)cmd.b, 0, (uint32_t)cmd.c | 1 });
+      break;
+    case MOTION_HOME:
+      if (motionParked) break;
+      startHoming(cmd.a != 0, cmd.b != 0);
+      break;
+    case MOTION_CANCEL_HOME:
+      cancelHoming();
+      break;
+    case MOTION_SET_SPEED:
+      // Rebuilding the tables mid-move would put the ISR on the new curve
+      // and leave a stretched plan timed against the old one
+      pendingMaxSpeed = cmd.a;
+      break;
+    case MOTION_OUTPUTS:
+      if (isCalibrating) break;
+      if (cmd.a) { stepperHours.enableOutputs(); stepperMinutes.enableOutputs(); }
+      else { stepperHours.disableOutputs(); stepperMinutes.disableOutputs(); }
+      break;
+    case MOTION_POWER_SAVER:
+      motionPowerSaver = (cmd.a != 0);
+      break;
+    case MOTION_PARK:
+      // The move under way finishes (a stop short of its target would leave
+      // the displayed time wrong); queued targets and homing do not
+      motionParked = (cmd.a != 0);
+      if (motionParked) { planner.clear(); cancelHoming(); }
+      break;
+  }
+  lastMotionCommandId = cmd.id;
+}
+
+#if CONFIG_PM_ENABLE
+esp_pm_lock_handle_t motionPmLock;
+#endif
+
+void motionTask(void *param) {
+  esp_task_wdt_add(NULL);
+  TickType_t lastWake = xTaskGetTickCount();
+
+  for (;;) {
+    MotionCommand cmd;
+    bool handled = false;
+    while (motionQueue.pop(cmd)) { handleMotionCommand(cmd); handled = true; }
+    tickHoming();
+
+    // Homing runs at its own speed and restores motorMaxSpeed when it ends
+    if (pendingMaxSpeed && !isCalibrating && !stepperHours.isRunning() && !stepperMinutes.isRunning()) {
+      stepperHours.setMaxSpeed(pendingMaxSpeed); stepperMinutes.setMaxSpeed(pendingMaxSpeed);
+      pendingMaxSpeed = 0;
     }
+
+    MovePlan plan;
+    if (!isCalibrating && planner.next(micros(), currentDisplayedHour, currentDisplayedMinute, plan)) {
+      if (motionPowerSaver) {
+        if (plan.stepsHours) stepperHours.enableOutputs();
+        if (plan.stepsMinutes) stepperMinutes.enableOutputs();
+      }
+      planner.start(plan);
+      traceRecorder.record(TRACE_SHOW, 0, plan.kind, plan.hour * 100 + plan.minute);
+      currentDisplayedHour = plan.hour; currentDisplayedMinute = plan.minute; lastMotorMoveTime = millis();
+    }
+    if (!isCalibrating) {
+      driftHours.tick(stepsPerRevolutionHours);
+      driftMinutes.tick(stepsPerRevolution);
+      // After a warm start the first pass of each magnet checks the saved
+      // position; one too far off to correct means it was wrong after all
+      if (positionUnconfirmed && !motionParked) {
+        if (driftHours.rejected() || driftMinutes.rejected()) startHoming(false, false);
+        else if (driftHours.confirmed() && driftMinutes.confirmed()) positionUnconfirmed = false;
+      }
+    }
+
+    if (isCalibrating || stepperHours.isRunning() || stepperMinutes.isRunning() || currentDisplayedHour < 0) {
+      warmStart.invalidate();
+    } else {
+      warmStart.update(stepperHours.currentPosition(), stepperMinutes.currentPosition(),
+                       stepperHours.phase(), stepperMinutes.phase(),
+                       currentDisplayedHour, currentDisplayedMinute, stepsPerRevolutionHours, stepsPerRevolution);
+    }
+
+    // Disable Motors if Idle
+    if (stepperHours.isRunning() || stepperMinutes.isRunning()) { lastMotorMoveTime = millis(); }
+    else if (motionPowerSaver && (millis() - lastMotorMoveTime > 2000)) { stepperHours.disableOutputs(); stepperMinutes.disableOutputs(); }
+
+    lastSensorHours = hallSampler.average(HALL_CH_HOURS);
+    lastSensorMinutes = hallSampler.average(HALL_CH_MINUTES);
+
+    publishMotionStatus();
+    // loop() sleeps between deadlines: wake it when commands were taken or
+    // the spools go busy / come to rest, instead of having it poll for that
+    bool busy = isCalibrating || stepperHours.isRunning() || stepperMinutes.isRunning() || planner.pending();
+    if (handled || busy != motionBusy) xTaskNotifyGive(loopTaskHandle);
+#if CONFIG_PM_ENABLE
+    // Step timers must not stop for light sleep or see the clock change mid-move
+    if (busy != motionBusy) { if (busy) esp_pm_lock_acquire(motionPmLock); else esp_pm_lock_release(motionPmLock); }
+#endif
+    motionBusy = busy;
+    esp_task_wdt_reset();
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(MOTION_PERIOD_MS));
+  }
+}
+
+// Core 0 only: queue a command for the motion task
+bool sendMotionCommand(MotionCommandType type, int32_t a = 0, int32_t b = 0, int32_t c = 0) {
+  MotionCommand cmd = { nextMotionCommandId, type, a, b, c };
+  if (!motionQueue.push(cmd)) return false;
+  nextMotionCommandId++;
+  return true;
+}
+
+// True once the motion task has consumed everything we sent it
+bool motionCaughtUp(const MotionStatus &st) { return st.lastCommandId == nextMotionCommandId - 1; }
+
+// Last octet of the IP on the AM/PM LED, one blink per unit of each digit
+// (10 for a 0) and a pause between digits. Stepped from loop().
+String ipBlinkDigits;
+int ipBlinkDigit = -1, ipBlinkCount = 0;
+bool ipBlinkLit = false;
+unsigned long ipBlinkNext = 0;
+
+void startIpBlink() {
+  ipBlinkDigits = String(WiFi.localIP()[3]);
+  Serial.print("Blinking IP Last Octet: "); Serial.println(ipBlinkDigits);
+  ledAmPm.forceOff();
+  ipBlinkDigit = 0; ipBlinkCount = 0; ipBlinkLit = false;
+  ipBlinkNext = millis() + 1000;
+}
+
+// True while the blink owns the AM/PM LED
+bool tickIpBlink() {
+  if (ipBlinkDigit < 0) return false;
+  if ((long)(millis() - ipBlinkNext) < 0) return true;
+  if (ipBlinkDigit >= (int)ipBlinkDigits.length()) { ipBlinkDigit = -1; return false; }
+  int blinks = ipBlinkDigits.charAt(ipBlinkDigit) - '0'; if (blinks == 0) blinks = 10;
+  if (!ipBlinkLit) { ledAmPm.forceOn(255); ipBlinkLit = true; ipBlinkNext = millis() + 200; return true; }
+  ledAmPm.forceOff(); ipBlinkLit = false;
+  if (++ipBlinkCount < blinks) { ipBlinkNext = millis() + 200; return true; }
+  ipBlinkCount = 0; ipBlinkDigit++;
+  ipBlinkNext = millis() + 2200;
+  return true;
+}
+
+// Runs beside the clock from loop(): the saved network gets a head start,
+// the setup portal only opens when there is none or it can't be reached
+void tickWifiBoot() {
+  if (isWifiSetup) {
+    // The SDK reconnects on its own; count the times it had to
+    bool up = WiFi.status() == WL_CONNECTED;
+    if (up && !wifiLinkUp) wifiReconnects++;
+    wifiLinkUp = up;
+    return;
+  }
+  if (WiFi.status() == WL_CONNECTED) {
+    isWifiSetup = true;
+    wifiLinkUp = true;
+    bootTimes.wifiMs = millis();
+    server.begin(appLock); // Only now: the portal has its own server on port 80
+    WiFi.setSleep(true); // Modem sleep: the radio naps between DTIM beacons
+    if (wifiPortalStarted && !motionStatus.read().calibrating) ledStatus.forceOff();
+    startIpBlink();
+    return;
+  }
+  if (!wifiPortalStarted && (!wifiManager.getWiFiIsSaved() || millis() > WIFI_CONNECT_TIMEOUT_MS)) {
+    wifiManager.startConfigPortal("SplitFlapClockSetup");
+    wifiPortalStarted = true;
+  }
+  if (wifiPortalStarted) wifiManager.process();
+}
+
+void onTimeSync(struct timeval *tv) {
+  if (!bootTimes.syncMs) bootTimes.syncMs = millis();
+  xTaskNotifyGive(loopTaskHandle); // First flip right away, not at the next deadline
+}
+
+// ==========================================
+//              SETTINGS
+// ==========================================
+void applyConfig(const ClockConfig &cfg) {
+  timeZoneString = cfg.timeZone; is12Hour = cfg.is12Hour;
+  powerSaverEnabled = cfg.powerSaver; motorMaxSpeed = cfg.motorMaxSpeed;
+  sensorSensitivity = cfg.sensorSensitivity;
+  nightModeEnabled = cfg.nightEnabled; nightStartHour = cfg.nightStartHour; nightEndHour = cfg.nightEndHour;
+  autoHomeIntervalHours = cfg.autoHomeHours;
+  dateDisplayEnabled = cfg.dateEnabled;
+  dateIntervalMinutes = cfg.dateIntervalMinutes;
+  dateDurationSeconds = cfg.dateDurationSeconds;
+  baselineHours = cfg.baselineHours; baselineMinutes = cfg.baselineMinutes;
+  stepsPerRevolution = cfg.stepsRev; stepsPerRevolutionHours = cfg.stepsRevH;
+  stepsPerUnit = stepsPerRevolution / 60.0; stepsPerUnitHours = stepsPerRevolutionHours / 60.0;
+  ledStatusEnabled = cfg.ledEnabled[0]; ledStatusBrightness = cfg.ledBrightness[0];
+  ledColonEnabled = cfg.ledEnabled[1]; ledColonBrightness = cfg.ledBrightness[1];
+  ledAuxEnabled = cfg.ledEnabled[2]; ledAuxBrightness = cfg.ledBrightness[2];
+  ledAmPmEnabled = cfg.ledEnabled[3]; ledAmPmBrightness = cfg.ledBrightness[3];
+  ledColonEffect = ledEffectOf(cfg.ledEffect[1]);
+  ledAuxEffect = ledEffectOf(cfg.ledEffect[2]);
+  ledAmPmEffect = ledEffectOf(cfg.ledEffect[3]);
+}
+
+ClockConfig captureConfig() {
+  ClockConfig cfg;
+  strncpy(cfg.timeZone, timeZoneString.c_str(), sizeof(cfg.timeZone) - 1);
+  cfg.is12Hour = is12Hour;
+  cfg.powerSaver = powerSaverEnabled; cfg.motorMaxSpeed = motorMaxSpeed;
+  cfg.sensorSensitivity = sensorSensitivity;
+  cfg.nightEnabled = nightModeEnabled; cfg.nightStartHour = nightStartHour; cfg.nightEndHour = nightEndHour;
+  cfg.autoHomeHours = autoHomeIntervalHours;
+  cfg.dateEnabled = dateDisplayEnabled;
+  cfg.dateIntervalMinutes = dateIntervalMinutes;
+  cfg.dateDurationSeconds = dateDurationSeconds;
+  cfg.baselineHours = baselineHours; cfg.baselineMinutes = baselineMinutes;
+  cfg.stepsRev = stepsPerRevolution; cfg.stepsRevH = stepsPerRevolutionHours;
+  cfg.ledEnabled[0] = ledStatusEnabled; cfg.ledBrightness[0] = ledStatusBrightness;
+  cfg.ledEnabled[1] = ledColonEnabled; cfg.ledBrightness[1] = ledColonBrightness;
+  cfg.ledEnabled[2] = ledAuxEnabled; cfg.ledBrightness[2] = ledAuxBrightness;
+  cfg.ledEnabled[3] = ledAmPmEnabled; cfg.ledBrightness[3] = ledAmPmBrightness;
+  cfg.ledEffect[1] = ledColonEffect; cfg.ledEffect[2] = ledAuxEffect; cfg.ledEffect[3] = ledAmPmEffect;
+  return cfg;
+}
+
+// No flash write unless something actually changed
+void saveConfig() { configStore.save(captureConfig()); configSavePending = false; }
+
+// Settings changed through /api/config reach flash once they have been quiet
+// for a while, so dragging a slider is one write instead of one per step
+void scheduleConfigSave() { configSavePending = true; configSaveDue = millis() + CONFIG_SAVE_DELAY_MS; }
+
+void tickConfigSave() {
+  if (configSavePending && (long)(millis() - configSaveDue) >= 0) saveConfig();
 }
 
 // ==========================================
 //              WEB HANDLERS
 // ==========================================
-void handleRoot() { server.send(200, "text/html", index_html); }
+// Serves one gzipped asset. The ETag is a hash of the content, so a browser
+// revalidating an unchanged page gets an empty 304 instead of the payload.
+void serveAsset(const WebAsset &asset) {
+  server.sendHeader("ETag", asset.etag);
+  server.sendHeader("Cache-Control", asset.immutable ? "public, max-age=31536000, immutable" : "no-cache");
+  if (server.header("If-None-Match") == asset.etag) { server.send(304); return; }
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, asset.contentType, (const char *)asset.data, asset.length);
+}
 
-void handleStatus() {
-  JsonDocument doc;
-  struct tm timeinfo;
-  if (getLocalTime(&timeinfo)) {
-      char dateBuf[16];
-      strftime(dateBuf, sizeof(dateBuf), "%b %d", &timeinfo); // Format: "Jan 18"
-      doc["date"] = String(dateBuf);
-  } else {
-      doc["date"] = "--";
-  }
+// Live values the dashboard shows. Pushed to /events subscribers as deltas,
+// so an idle clock costs nothing per client.
+struct LiveState {
+  int16_t h, m;
+  char date[8];
+  bool sensH, sensM;
+  int8_t rssi; uint8_t rssiBucket;
+  int baseH, baseM, stepH, stepM;
+  bool cal; uint8_t calProgress; char calStatus[48];
+};
+
+LiveState liveSent;                 // What the subscribers currently have
+LiveState liveNow;
+unsigned long lastLiveSlowSample = 0;
+
+uint8_t rssiBucket(int rssi) { return (rssi >= -50) ? 3 : (rssi >= -60) ? 2 : (rssi >= -70) ? 1 : 0; }
+
+// RSSI and date change slowly and cost a driver call, sample them at 1 Hz
+void sampleSlowLiveState(LiveState &ls) {
+  ls.rssi = WiFi.RSSI(); ls.rssiBucket = rssiBucket(ls.rssi);
+  const TimeSnapshot &t = timeService.now();
+  if (t.synced) strftime(ls.date, sizeof(ls.date), "%b %d", &t.local); // Format: "Jan 18"
+  else strlcpy(ls.date, "--", sizeof(ls.date));
+}
+
+void sampleLiveState(LiveState &ls, const MotionStatus &st) {
+  ls.h = st.displayedHour; ls.m = st.displayedMinute;
+  int th = map(sensorSensitivity, 1, 100, 1500, 100);
+  ls.sensH = (abs(st.sensorHours - baselineHours) > th);
+  ls.sensM = (abs(st.sensorMinutes - baselineMinutes) > th);
+  ls.baseH = baselineHours; ls.baseM = baselineMinutes;
+  ls.stepH = stepsPerRevolutionHours; ls.stepM = stepsPerRevolution;
+  ls.cal = st.calibrating; ls.calProgress = st.calibrationProgress;
+  strlcpy(ls.calStatus, st.calibrationStatus, sizeof(ls.calStatus));
+}
+
+void addLiveState(JsonDocument &doc, const LiveState &ls) {
+  doc["h"] = ls.h; doc["m"] = ls.m;
+  doc["date"] = ls.date;
   doc["ssid"] = WiFi.SSID();
-  doc["rssi"] = WiFi.RSSI();
+  doc["rssi"] = ls.rssi;
+  doc["sensH"] = ls.sensH; doc["sensM"] = ls.sensM;
+  doc["baseH"] = ls.baseH; doc["baseM"] = ls.baseM;
+  doc["stepH"] = ls.stepH; doc["stepM"] = ls.stepM;
+  doc["cal"] = ls.cal; doc["calProg"] = ls.calProgress; doc["calStatus"] = ls.calStatus;
+}
+
+// Per-axis pass errors (steps, oldest first) plus counters as <prefix>_*
+void addDriftHistory(JsonDocument &doc, const char *prefix, const DriftHistory &h) {
+  char key[16];
+  JsonArray errors = doc[prefix].to<JsonArray>();
+  for (int i = 0; i < h.count; i++) errors.add(roundf(h.entries[i].error * 10) / 10);
+  snprintf(key, sizeof(key), "%s_t", prefix);
+  JsonArray times = doc[key].to<JsonArray>();
+  for (int i = 0; i < h.count; i++) times.add(h.entries[i].epoch);
+  snprintf(key, sizeof(key), "%s_pass", prefix); doc[key] = h.passes;
+  snprintf(key, sizeof(key), "%s_fix", prefix); doc[key] = h.corrected;
+  snprintf(key, sizeof(key), "%s_rej", prefix); doc[key] = h.rejected;
+  snprintf(key, sizeof(key), "%s_sum", prefix); doc[key] = h.totalSteps;
+  snprintf(key, sizeof(key), "%s_ago", prefix);
+  doc[key] = h.lastPassMs ? (int32_t)((millis() - h.lastPassMs) / 1000) : -1;
+}
+
+// True when both spools had a trusted magnet pass in the last windowMs
+bool driftCorrectedWithin(uint32_t windowMs) {
+  DriftHistory h = driftHours.history(), m = driftMinutes.history();
+  return h.lastPassMs && m.lastPassMs && millis() - h.lastPassMs < windowMs && millis() - m.lastPassMs < windowMs;
+}
+
+void buildStatus(JsonDocument &doc) {
+  LiveState ls;
+  sampleSlowLiveState(ls);
+  sampleLiveState(ls, motionStatus.read());
+  addLiveState(doc, ls);
   doc["conf_dEn"] = dateDisplayEnabled;
   doc["conf_dInt"] = dateIntervalMinutes;
   doc["conf_dDur"] = dateDurationSeconds;
-  doc["h"] = currentDisplayedHour; doc["m"] = currentDisplayedMinute;
-  int th = map(sensorSensitivity, 1, 100, 1500, 100);
-  doc["sensH"] = (abs(analogRead(hallEffectSensorHoursPin) - baselineHours) > th); 
-  doc["sensM"] = (abs(analogRead(hallEffectSensorMinutesPin) - baselineMinutes) > th); 
-  doc["baseH"] = baselineHours; doc["baseM"] = baselineMinutes;
-  doc["stepH"] = stepsPerRevolutionHours;
-  doc["stepM"] = stepsPerRevolution;
   doc["conf_12h"] = is12Hour; doc["conf_tz"] = timeZoneString;
   doc["conf_pwrSav"] = powerSaverEnabled; doc["conf_spd"] = motorMaxSpeed;
   doc["conf_sens"] = sensorSensitivity;
   doc["conf_nEn"] = nightModeEnabled; doc["conf_nStart"] = nightStartHour; doc["conf_nEnd"] = nightEndHour;
   doc["conf_homeInt"] = autoHomeIntervalHours;
+  MotionStatus st = motionStatus.read();
+  doc["land_n"] = st.landings; doc["land_ok"] = st.landingsOnTime;
+  doc["land_lastMs"] = st.landingErrorUs / 1000.0f;
+  doc["land_meanMs"] = st.landingMeanAbsUs / 1000.0f; doc["land_maxMs"] = st.landingMaxAbsUs / 1000.0f;
+  doc["move_minMs"] = st.moveUs[MOVE_MINUTE] / 1000; doc["move_rollMs"] = st.moveUs[MOVE_ROLLOVER] / 1000;
+  doc["move_otherMs"] = st.moveUs[MOVE_OTHER] / 1000;
+  doc["boot_homedMs"] = bootTimes.homedMs; doc["boot_wifiMs"] = bootTimes.wifiMs;
+  doc["boot_syncMs"] = bootTimes.syncMs; doc["boot_displayMs"] = bootTimes.displayMs;
+  doc["loop_wakes"] = loopWakes;
+  doc["ota_trial"] = otaUpdater.onTrial();
+  doc["trace_on"] = traceRecorder.armed(); doc["trace_n"] = traceRecorder.count();
+  addDriftHistory(doc, "driftH", driftHours.history());
+  addDriftHistory(doc, "driftM", driftMinutes.history());
   doc["ledS_en"] = ledStatusEnabled; doc["ledS_br"] = ledStatusBrightness;
   doc["ledC_en"] = ledColonEnabled; doc["ledC_br"] = ledColonBrightness;
   doc["ledX_en"] = ledAuxEnabled; doc["ledX_br"] = ledAuxBrightness; 
   doc["ledA_en"] = ledAmPmEnabled; doc["ledA_br"] = ledAmPmBrightness;
+  doc["ledC_fx"] = (int)ledColonEffect; doc["ledX_fx"] = (int)ledAuxEffect; doc["ledA_fx"] = (int)ledAmPmEffect;
+}
+
+void handleStatus() {
+  JsonDocument doc;
+  buildStatus(doc);
   String json; serializeJson(doc, json); server.send(200, "application/json", json);
 }
 
+// Per-route handler time for /metrics; routes register through timed()
+struct RouteTiming { const char *route; Histogram time; };
+const int MAX_TIMED_ROUTES = 24;
+RouteTiming routeTimings[MAX_TIMED_ROUTES];
+int routeTimingCount = 0;
+
+HttpServer::THandlerFunction timed(const char *route, HttpServer::THandlerFunction handler) {
+  if (routeTimingCount == MAX_TIMED_ROUTES) return handler;
+  RouteTiming *rt = &routeTimings[routeTimingCount++];
+  rt->route = route;
+  return [rt, handler]() {
+    uint32_t started = micros();
+    handler();
+    rt->time.add(micros() - started);
+  };
+}
+
+// Prometheus text format, streamed in chunks
+void handleMetrics() {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/plain; version=0.0.4", "");
+  MetricsWriter w([](const String &chunk) { server.sendContent(chunk); });
+  char labels[64];
+
+  w.family("splitflap_loop_pass_seconds", "histogram", "Time spent in one main loop pass");
+  w.histogram("splitflap_loop_pass_seconds", "", loopPassTime);
+  w.family("splitflap_loop_interval_seconds", "histogram", "Time between the starts of main loop passes");
+  w.histogram("splitflap_loop_interval_seconds", "", loopInterval);
+  w.family("splitflap_loop_overruns_total", "counter", "Main loop passes longer than the 50 ms poll period");
+  w.sample("splitflap_loop_overruns_total", "", loopOverruns);
+  w.family("splitflap_loop_wakes_total", "counter", "Main loop passes");
+  w.sample("splitflap_loop_wakes_total", "", loopWakes);
+
+  w.family("splitflap_step_lateness_seconds", "histogram", "Step ISR latency after its timer alarm");
+  w.histogram("splitflap_step_lateness_seconds", "axis=\"hours\"", stepperHours.stepLateness());
+  w.histogram("splitflap_step_lateness_seconds", "axis=\"minutes\"", stepperMinutes.stepLateness());
+  w.family("splitflap_sensor_buffer_seconds", "histogram", "Hall sensor reader time per DMA buffer");
+  w.histogram("splitflap_sensor_buffer_seconds", "", hallSampler.bufferTime());
+  w.family("splitflap_homing_seconds", "histogram", "Duration of homing runs");
+  w.histogram("splitflap_homing_seconds", "kind=\"home\"", homingTime);
+  w.histogram("splitflap_homing_seconds", "kind=\"calibrate\"", calibrationTime);
+
+  w.family("splitflap_http_request_seconds", "histogram", "HTTP handler time per route");
+  for (int i = 0; i < routeTimingCount; i++) {
+    snprintf(labels, sizeof(labels), "handler=\"%s\"", routeTimings[i].route);
+    w.histogram("splitflap_http_request_seconds", labels, routeTimings[i].time);
+  }
+
+  w.family("splitflap_http_connections_total", "counter", "HTTP connections accepted");
+  w.sample("splitflap_http_connections_total", "", server.accepted());
+  w.family("splitflap_http_requests_total", "counter", "HTTP requests handled");
+  w.sample("splitflap_http_requests_total", "", server.requests());
+  w.family("splitflap_http_evictions_total", "counter", "Idle keep-alive connections closed for a new client");
+  w.sample("splitflap_http_evictions_total", "", server.evicted());
+  w.family("splitflap_http_open_connections", "gauge", "HTTP connections open now");
+  w.sample("splitflap_http_open_connections", "", server.openConnections());
+
+  w.family("splitflap_nvs_writes_total", "counter", "NVS writes per store");
+  w.sample("splitflap_nvs_writes_total", "store=\"config\"", configStore.writes());
+  w.sample("splitflap_nvs_writes_total", "store=\"park\"", warmStart.nvsWrites());
+  w.sample("splitflap_nvs_writes_total", "store=\"ota\"", otaUpdater.nvsWrites());
+  w.family("splitflap_heap_free_bytes", "gauge", "Free heap");
+  w.sample("splitflap_heap_free_bytes", "", ESP.getFreeHeap());
+  w.family("splitflap_heap_min_free_bytes", "gauge", "Lowest free heap since boot");
+  w.sample("splitflap_heap_min_free_bytes", "", ESP.getMinFreeHeap());
+  w.family("splitflap_heap_largest_block_bytes", "gauge", "Largest allocatable heap block");
+  w.sample("splitflap_heap_largest_block_bytes", "", ESP.getMaxAllocHeap());
+  w.family("splitflap_wifi_reconnects_total", "counter", "WiFi associations regained after a drop");
+  w.sample("splitflap_wifi_reconnects_total", "", wifiReconnects);
+  w.family("splitflap_wifi_rssi_dbm", "gauge", "WiFi signal strength");
+  w.sample("splitflap_wifi_rssi_dbm", "", WiFi.RSSI());
+  w.family("splitflap_uptime_seconds", "counter", "Time since boot");
+  w.sample("splitflap_uptime_seconds", "", millis() / 1000.0);
+  w.finish();
+  server.sendContent("");
+}
+
+// Hands the socket to the event stream and sends the full snapshot once
+void handleEvents() {
+  if (events.full()) { server.send(503, "text/plain", "Too many dashboards"); return; }
+  int slot = events.add(server.detachClient());
+  if (slot < 0) return;
+  JsonDocument doc;
+  buildStatus(doc);
+  String json; serializeJson(doc, json);
+  events.sendTo(slot, "full", json.c_str());
+}
+
+// Called from loop(): diff against what the subscribers last saw and push
+// only the fields that changed
+void pushLiveState(const MotionStatus &st) {
+  events.tick();
+  if (events.clientCount() == 0) return;
+
+  if (millis() - lastLiveSlowSample >= 1000) { lastLiveSlowSample = millis(); sampleSlowLiveState(liveNow); }
+  sampleLiveState(liveNow, st);
+
+  JsonDocument doc;
+  bool changed = false;
+  LiveState &a = liveNow; LiveState &b = liveSent;
+  if (a.h != b.h || a.m != b.m) { doc["h"] = a.h; doc["m"] = a.m; changed = true; }
+  if (strcmp(a.date, b.date) != 0) { doc["date"] = a.date; changed = true; }
+  if (a.sensH != b.sensH) { doc["sensH"] = a.sensH; changed = true; }
+  if (a.sensM != b.sensM) { doc["sensM"] = a.sensM; changed = true; }
+  if (a.rssiBucket != b.rssiBucket) { doc["rssi"] = a.rssi; changed = true; }
+  else a.rssi = b.rssi; // Within a bucket the shown dBm stays as last sent
+  if (a.baseH != b.baseH || a.baseM != b.baseM) { doc["baseH"] = a.baseH; doc["baseM"] = a.baseM; changed = true; }
+  if (a.stepH != b.stepH || a.stepM != b.stepM) { doc["stepH"] = a.stepH; doc["stepM"] = a.stepM; changed = true; }
+  if (a.cal != b.cal) { doc["cal"] = a.cal; changed = true; }
+  if (a.calProgress != b.calProgress) { doc["calProg"] = a.calProgress; changed = true; }
+  if (strcmp(a.calStatus, b.calStatus) != 0) { doc["calStatus"] = a.calStatus; changed = true; }
+  if (!changed) return;
+
+  // All fields changed plus a status of 47 escaped control characters is
+  // 483 bytes, so any delta fits; the check is for fields added later
+  char json[512];
+  size_t len = measureJson(doc);
+  if (len >= sizeof(json)) { Serial.printf("Live state: %u byte update does not fit, not sent\n", (unsigned)len); return; }
+  serializeJson(doc, json, sizeof(json));
+  events.send(nullptr, json);
+  liveSent = liveNow;
+}
+
 void handleCalibStatus() {
   JsonDocument doc;
-  doc["status"] = calibrationStatus;
-  doc["progress"] = calibrationProgress;
+  MotionStatus st = motionStatus.read();
+  doc["status"] = st.calibrationStatus;
+  doc["progress"] = st.calibrationProgress;
   String json;
   serializeJson(doc, json);
   server.send(200, "application/json", json);
 }
 
+// Per-step profile cost at the configured speed, table vs. AccelStepper math
+void handleStepBench() {
+  StepBenchResult r = benchmarkStepProfiles(motorMaxSpeed, MOTOR_ACCEL, MOTOR_JERK);
+  JsonDocument doc;
+  doc["steps"] = r.steps;
+  doc["cpuMHz"] = ESP.getCpuFreqMHz();
+  doc["tableCyclesPerStep"] = r.tableCyclesPerStep;
+  doc["accelStepperCyclesPerStep"] = r.accelStepperCyclesPerStep;
+  doc["tableBuildUs"] = r.buildUs;
+  doc["rampSteps"] = r.rampLength;
+  String json; serializeJson(doc, json); server.send(200, "application/json", json);
+}
+
+// Binary trace download (TraceHeader + events), decoded by tools/decode_trace.py.
+// Recording pauses while the ring is sent.
+void handleTrace() {
+  TraceHeader h = {};
+  memcpy(h.magic, "SFTR", 4);
+  h.version = TRACE_VERSION; h.eventSize = sizeof(TraceEvent);
+  h.capacity = TraceRecorder::CAPACITY;
+  h.flags = (traceRecorder.once() ? TRACE_FLAG_ONCE : 0) | (traceRecorder.armed() ? TRACE_FLAG_ARMED : 0);
+  h.count = traceRecorder.freeze();
+  h.dropped = traceRecorder.dropped();
+  h.nowMicros = micros();
+  h.epoch = bootTimes.syncMs ? (uint32_t)time(nullptr) : 0;
+  h.stepsRevHours = stepsPerRevolutionHours; h.stepsRevMinutes = stepsPerRevolution;
+  h.maxSpeed = motorMaxSpeed; h.accel = MOTOR_ACCEL; h.jerk = MOTOR_JERK;
+  h.hallEvery = TraceRecorder::HALL_EVERY;
+
+  server.setContentLength(sizeof(h) + h.count * sizeof(TraceEvent));
+  server.sendHeader("Content-Disposition", "attachment; filename=\"trace.bin\"");
+  server.send(200, "application/octet-stream", "");
+  server.sendContent((const char *)&h, sizeof(h));
+  TraceEvent chunk[64];
+  for (uint32_t i = 0; i < h.count; ) {
+    uint32_t n = min<uint32_t>(64, h.count - i);
+    for (uint32_t k = 0; k < n; k++) chunk[k] = traceRecorder.event(i + k);
+    server.sendContent((const char *)chunk, n * sizeof(TraceEvent));
+    i += n;
+  }
+  traceRecorder.thaw();
+}
+
+// Restarts the ring. mask: event types as bits (1 << TraceEventType), once=1
+// stops when full instead of wrapping
+void handleTraceArm() {
+  uint32_t mask = server.hasArg("mask") ? strtoul(server.arg("mask").c_str(), nullptr, 0) : TRACE_ALL;
+  if ((mask & TRACE_ALL) == 0) { server.send(400, "text/plain", "No event types in mask"); return; }
+  traceRecorder.arm(mask, server.arg("once") == "1");
+  server.send(200, "text/plain", "OK");
+}
+
+// Keeps what was recorded for a later download
+void handleTraceStop() { traceRecorder.stop(); server.send(200, "text/plain", "OK"); }
+
+// /save form fields -> settings. Args is the HttpServer, or a recorded form
+// for the benchmark suite.
+template <class Args> void applySaveArgs(Args &args) {
+  if (args.hasArg("is12h")) is12Hour = (args.arg("is12h") == "1");
+  if (args.hasArg("tz")) timeZoneString = args.arg("tz");
+  powerSaverEnabled = (args.hasArg("pwrSav"));
+  if (args.hasArg("spd")) motorMaxSpeed = args.arg("spd").toInt();
+  if (args.hasArg("sens")) sensorSensitivity = args.arg("sens").toInt();
+  nightModeEnabled = (args.hasArg("nightEn")); 
+  if (args.hasArg("nStart")) nightStartHour = args.arg("nStart").toInt();
+  if (args.hasArg("nEnd")) nightEndHour = args.arg("nEnd").toInt();
+  if (args.hasArg("homeInt")) autoHomeIntervalHours = args.arg("homeInt").toInt();
+  dateDisplayEnabled = (args.hasArg("dateEn"));
+  if (args.hasArg("dateInt")) dateIntervalMinutes = args.arg("dateInt").toInt();
+  if (args.hasArg("dateDur")) dateDurationSeconds = args.arg("dateDur").toInt();
+  ledStatusEnabled = (args.hasArg("ledS_en"));
+  if (args.hasArg("ledS_br")) ledStatusBrightness = args.arg("ledS_br").toInt();
+  ledColonEnabled = (args.hasArg("ledC_en"));
+  if (args.hasArg("ledC_br")) ledColonBrightness = args.arg("ledC_br").toInt();
+  ledAuxEnabled = (args.hasArg("ledX_en")); 
+  if (args.hasArg("ledX_br")) ledAuxBrightness = args.arg("ledX_br").toInt(); 
+  ledAmPmEnabled = (args.hasArg("ledA_en"));
+  if (args.hasArg("ledA_br")) ledAmPmBrightness = args.arg("ledA_br").toInt();
+  if (args.hasArg("ledC_fx")) ledColonEffect = ledEffectOf(args.arg("ledC_fx").toInt());
+  if (args.hasArg("ledX_fx")) ledAuxEffect = ledEffectOf(args.arg("ledX_fx").toInt());
+  if (args.hasArg("ledA_fx")) ledAmPmEffect = ledEffectOf(args.arg("ledA_fx").toInt());
+}
+
 void handleSave() {
-  if (server.hasArg("is12h")) is12Hour = (server.arg("is12h") == "1");
-  if (server.hasArg("tz")) timeZoneString = server.arg("tz");
-  powerSaverEnabled = (server.hasArg("pwrSav"));
-  if (server.hasArg("spd")) motorMaxSpeed = server.arg("spd").toInt();
-  if (server.hasArg("sens")) sensorSensitivity = server.arg("sens").toInt();
-  nightModeEnabled = (server.hasArg("nightEn")); 
-  if (server.hasArg("nStart")) nightStartHour = server.arg("nStart").toInt();
-  if (server.hasArg("nEnd")) nightEndHour = server.arg("nEnd").toInt();
-  if (server.hasArg("homeInt")) autoHomeIntervalHours = server.arg("homeInt").toInt();
-  dateDisplayEnabled = (server.hasArg("dateEn"));
-  if (server.hasArg("dateInt")) dateIntervalMinutes = server.arg("dateInt").toInt();
-  if (server.hasArg("dateDur")) dateDurationSeconds = server.arg("dateDur").toInt();
-  ledStatusEnabled = (server.hasArg("ledS_en"));
-  if (server.hasArg("ledS_br")) ledStatusBrightness = server.arg("ledS_br").toInt();
-  ledColonEnabled = (server.hasArg("ledC_en"));
-  if (server.hasArg("ledC_br")) ledColonBrightness = server.arg("ledC_br").toInt();
-  ledAuxEnabled = (server.hasArg("ledX_en")); 
-  if (server.hasArg("ledX_br")) ledAuxBrightness = server.arg("ledX_br").toInt(); 
-  ledAmPmEnabled = (server.hasArg("ledA_en"));
-  if (server.hasArg("ledA_br")) ledAmPmBrightness = server.arg("ledA_br").toInt();
-
-  preferences.begin("clock-conf", false);
-  preferences.putBool("12h", is12Hour); preferences.putString("tz", timeZoneString);
-  preferences.putBool("idle", powerSaverEnabled); preferences.putInt("spd", motorMaxSpeed);
-  preferences.putInt("sens", sensorSensitivity);
-  preferences.putBool("nEn", nightModeEnabled); preferences.putInt("nSt", nightStartHour); preferences.putInt("nEd", nightEndHour);
-  preferences.putInt("homeInt", autoHomeIntervalHours);
-  preferences.putBool("dEn", dateDisplayEnabled);
-  preferences.putInt("dInt", dateIntervalMinutes);
-  preferences.putInt("dDur", dateDurationSeconds);
-  preferences.putBool("lSe", ledStatusEnabled); preferences.putInt("lSb", ledStatusBrightness);
-  preferences.putBool("lCe", ledColonEnabled); preferences.putInt("lCb", ledColonBrightness);
-  preferences.putBool("lXe", ledAuxEnabled); preferences.putInt("lXb", ledAuxBrightness); 
-  preferences.putBool("lAe", ledAmPmEnabled); preferences.putInt("lAb", ledAmPmBrightness);
-  preferences.end();
+  applySaveArgs(server);
+  saveConfig();
 
   configTzTime(timeZoneString.c_str(), "pool.ntp.org", "time.nist.gov");
-  stepperHours.setMaxSpeed(motorMaxSpeed); stepperMinutes.setMaxSpeed(motorMaxSpeed);
-  if(!powerSaverEnabled) { stepperHours.enableOutputs(); stepperMinutes.enableOutputs(); }
+  timeService.configure(is12Hour);
+  sendMotionCommand(MOTION_SET_SPEED, motorMaxSpeed);
+  sendMotionCommand(MOTION_POWER_SAVER, powerSaverEnabled);
+  if(!powerSaverEnabled) sendMotionCommand(MOTION_OUTPUTS, 1);
   server.sendHeader("Location", "/"); server.send(303);
 }
 
+// --- GET / PATCH /api/config ---
+// The /save fields under the same names, as JSON. PATCH takes any subset,
+// e.g. {"ledC_br": 80}: the whole body is checked against CONFIG_SCHEMA
+// first (unknown key, wrong type or out of range is a 422 and changes
+// nothing), then only fields whose value differs are written, and only the
+// subsystems they feed are touched. A brightness drag leaves SNTP and the
+// motion task alone.
+enum ConfigReload : uint8_t {
+  RELOAD_NONE = 0,      // Read where it is used (sensitivity: next homing)
+  RELOAD_LEDS = 1,      // Next pass of loop(), woken right away
+  RELOAD_SPEED = 2,     // Profile rebuild in the motion task
+  RELOAD_POWER = 4,     // Power saver; outputs back on when it is turned off
+  RELOAD_TIME = 8,      // TZ rule and 12/24h, SNTP keeps running
+  RELOAD_SCHEDULE = 16, // Night, date and auto-home checks of the next pass
+};
+enum ConfigType : uint8_t { CFG_BOOL, CFG_INT, CFG_EFFECT, CFG_TEXT };
+
+struct ConfigField {
+  const char *key;
+  ConfigType type;
+  void *value;          // bool, int, LedEffect or String setting
+  int32_t min, max;     // CFG_TEXT: length
+  uint8_t reload;
+};
+
+// Ranges as the dashboard offers them
+const ConfigField CONFIG_SCHEMA[] = {
+  { "is12h", CFG_BOOL, &is12Hour, 0, 1, RELOAD_TIME },
+  { "tz", CFG_TEXT, &timeZoneString, 3, sizeof(ClockConfig::timeZone) - 1, RELOAD_TIME },
+  { "pwrSav", CFG_BOOL, &powerSaverEnabled, 0, 1, RELOAD_POWER },
+  { "spd", CFG_INT, &motorMaxSpeed, 100, 1500, RELOAD_SPEED },
+  { "sens", CFG_INT, &sensorSensitivity, 1, 100, RELOAD_NONE },
+  { "nightEn", CFG_BOOL, &nightModeEnabled, 0, 1, RELOAD_SCHEDULE },
+  { "nStart", CFG_INT, &nightStartHour, 0, 23, RELOAD_SCHEDULE },
+  { "nEnd", CFG_INT, &nightEndHour, 0, 23, RELOAD_SCHEDULE },
+  { "homeInt", CFG_INT, &autoHomeIntervalHours, 0, 168, RELOAD_SCHEDULE },
+  { "dateEn", CFG_BOOL, &dateDisplayEnabled, 0, 1, RELOAD_SCHEDULE },
+  { "dateInt", CFG_INT, &dateIntervalMinutes, 1, 60, RELOAD_SCHEDULE },
+  { "dateDur", CFG_INT, &dateDurationSeconds, 2, 60, RELOAD_SCHEDULE },
+  { "ledS_en", CFG_BOOL, &ledStatusEnabled, 0, 1, RELOAD_NONE },  // Stored; the LED shows WiFi and homing
+  { "ledS_br", CFG_INT, &ledStatusBrightness, 0, 255, RELOAD_NONE },
+  { "ledC_en", CFG_BOOL, &ledColonEnabled, 0, 1, RELOAD_LEDS },
+  { "ledC_br", CFG_INT, &ledColonBrightness, 0, 255, RELOAD_LEDS },
+  { "ledC_fx", CFG_EFFECT, &ledColonEffect, 0, LED_EFFECTS - 1, RELOAD_LEDS },
+  { "ledX_en", CFG_BOOL, &ledAuxEnabled, 0, 1, RELOAD_LEDS },
+  { "ledX_br", CFG_INT, &ledAuxBrightness, 0, 255, RELOAD_LEDS },
+  { "ledX_fx", CFG_EFFECT, &ledAuxEffect, 0, LED_EFFECTS - 1, RELOAD_LEDS },
+  { "ledA_en", CFG_BOOL, &ledAmPmEnabled, 0, 1, RELOAD_LEDS },
+  { "ledA_br", CFG_INT, &ledAmPmBrightness, 0, 255, RELOAD_LEDS },
+  { "ledA_fx", CFG_EFFECT, &ledAmPmEffect, 0, LED_EFFECTS - 1, RELOAD_LEDS },
+};
+const ConfigField *configField(const char *key) {
+  for (const ConfigField &f : CONFIG_SCHEMA) if (!strcmp(f.key, key)) return &f;
+  return nullptr;
+}
+
+// Why v cannot go into f, or nullptr if it can
+const char *configInvalid(const ConfigField &f, JsonVariantConst v) {
+  switch (f.type) {
+    case CFG_BOOL: return v.is<bool>() ? nullptr : "expected true or false";
+    case CFG_TEXT: {
+      if (!v.is<const char *>()) return "expected a string";
+      int32_t len = strlen(v.as<const char *>());
+      return (len >= f.min && len <= f.max) ? nullptr : "length out of range";
+    }
+    default:
+      if (!v.is<int32_t>()) return "expected an integer";
+      return (v.as<int32_t>() >= f.min && v.as<int32_t>() <= f.max) ? nullptr : "out of range";
+  }
+}
+
+// True if the setting changed
+bool configApply(const ConfigField &f, JsonVariantConst v) {
+  switch (f.type) {
+    case CFG_BOOL: {
+      bool &b = *(bool *)f.value;
+      if (b == v.as<bool>()) return false;
+      b = v.as<bool>(); return true;
+    }
+    case CFG_INT: {
+      int &i = *(int *)f.value;
+      if (i == v.as<int>()) return false;
+      i = v.as<int>(); return true;
+    }
+    case CFG_EFFECT: {
+      LedEffect &e = *(LedEffect *)f.value;
+      if (e == ledEffectOf(v.as<int>())) return false;
+      e = ledEffectOf(v.as<int>()); return true;
+    }
+    case CFG_TEXT: {
+      String &s = *(String *)f.value;
+      if (s == v.as<const char *>()) return false;
+      s = v.as<const char *>(); return true;
+    }
+  }
+  return false;
+}
+
+void configRead(const ConfigField &f, JsonDocument &doc) {
+  switch (f.type) {
+    case CFG_BOOL: doc[f.key] = *(bool *)f.value; break;
+    case CFG_INT: doc[f.key] = *(int *)f.value; break;
+    case CFG_EFFECT: doc[f.key] = (int)*(LedEffect *)f.value; break;
+    case CFG_TEXT: doc[f.key] = *(String *)f.value; break;
+  }
+}
+
+void reloadConfig(uint8_t reload) {
+  if (reload & RELOAD_SPEED) sendMotionCommand(MOTION_SET_SPEED, motorMaxSpeed);
+  if (reload & RELOAD_POWER) {
+    sendMotionCommand(MOTION_POWER_SAVER, powerSaverEnabled);
+    if (!powerSaverEnabled && !nightOutputsOff) sendMotionCommand(MOTION_OUTPUTS, 1);
+  }
+  if (reload & RELOAD_TIME) {
+    // configTzTime() would restart SNTP as well; the rule is all that changed
+    setenv("TZ", timeZoneString.c_str(), 1); tzset();
+    timeService.configure(is12Hour);
+  }
+  // loop() runs the pass once this handler lets go of the lock
+  if (reload & (RELOAD_LEDS | RELOAD_TIME | RELOAD_SCHEDULE)) xTaskNotifyGive(loopTaskHandle);
+}
+
+// PATCH body -> settings. Fills reply with "changed", or with "error" and
+// "field", and returns the HTTP status.
+int patchConfig(const String &body, JsonDocument &reply) {
+  JsonDocument patch;
+  if (deserializeJson(patch, body) || !patch.is<JsonObject>()) {
+    reply["error"] = "body is not a JSON object";
+    return 400;
+  }
+  JsonObjectConst fields = patch.as<JsonObjectConst>();
+  for (JsonPairConst kv : fields) {
+    const ConfigField *f = configField(kv.key().c_str());
+    const char *error = f ? configInvalid(*f, kv.value()) : "unknown setting";
+    if (error) { reply["error"] = error; reply["field"] = kv.key().c_str(); return 422; }
+  }
+  uint8_t reload = 0;
+  JsonArray changed = reply["changed"].to<JsonArray>();
+  for (JsonPairConst kv : fields) {
+    const ConfigField *f = configField(kv.key().c_str());
+    if (!configApply(*f, kv.value())) continue;
+    changed.add(f->key);
+    reload |= f->reload;
+  }
+  reloadConfig(reload);
+  if (changed.size()) scheduleConfigSave();
+  return 200;
+}
+
+void handleConfigApi() {
+  JsonDocument doc;
+  int code = 200;
+  if (server.method() == HTTP_PATCH) code = patchConfig(server.arg("plain"), doc);
+  else if (server.method() != HTTP_GET) {
+    server.sendHeader("Allow", "GET, PATCH");
+    doc["error"] = "use GET or PATCH";
+    code = 405;
+  }
+  if (code == 200) {
+    JsonDocument config;
+    for (const ConfigField &f : CONFIG_SCHEMA) configRead(f, config);
+    doc["config"] = config;
+  }
+  String json; serializeJson(doc, json); server.send(code, "application/json", json);
+}
+
 void handleManual() {
   if (server.hasArg("h") && server.hasArg("m")) {
     manualMode = true; manualHourTarget = server.arg("h").toInt(); manualMinuteTarget = server.arg("m").toInt();
@@ -934,42 +1324,244 @@ void handleManual() {
 }
 
 void handleResume() { manualMode = false; server.send(200, "text/plain", "OK"); }
-void handleResetWifi() { server.send(200, "text/plain", "Resetting WiFi..."); WiFiManager wm; wm.resetSettings(); delay(1000); ESP.restart(); }
-void handleRestart() { server.send(200, "text/plain", "Restarting..."); delay(1000); ESP.restart(); }
+// Deliberate restarts keep the spool positions, so the next boot skips homing
+void restartParked() { if (configSavePending) saveConfig(); warmStart.park(); ESP.restart(); }
+
+// --- Firmware update (see OtaUpdater) ---
+const uint32_t PARK_TIMEOUT_MS = 8000;  // Longest move is a full rollover
+
+// Blocks the upload (and loop(), which waits for the handler lock) until
+// the spools rest
+bool parkMotion() {
+  if (!sendMotionCommand(MOTION_PARK, 1)) return false;
+  uint32_t started = millis();
+  while (!motionStatus.read().parked) {
+    if (millis() - started > PARK_TIMEOUT_MS) return false;
+    delay(10);
+  }
+  return true;
+}
+
+// POST /update?sha256=<hex>, multipart "update". The spools stay parked
+// until the upload fails, or through the restart into the new image.
+void handleUpdateUpload() {
+  HTTPUpload &upload = server.upload();
+  switch (upload.status) {
+    case UPLOAD_FILE_START:
+      Serial.printf("Firmware update: %s\n", upload.filename.c_str());
+      if (parkMotion()) otaUpdater.start(server.arg("sha256"));
+      else otaUpdater.reject("Motion did not park, try again", 503);
+      break;
+    case UPLOAD_FILE_WRITE: otaUpdater.write(upload.buf, upload.currentSize); break;
+    case UPLOAD_FILE_END: otaUpdater.finish(); break;
+    case UPLOAD_FILE_ABORTED: otaUpdater.abort("Upload aborted"); break;
+  }
+}
+
+void handleUpdateDone() {
+  server.sendHeader("Connection", "close");
+  if (otaUpdater.state() == OtaUpdater::DONE) { server.send(200, "text/plain", "OK"); delay(100); restartParked(); return; }
+  sendMotionCommand(MOTION_PARK, 0);
+  if (otaUpdater.state() == OtaUpdater::IDLE) server.send(400, "text/plain", "No firmware image in the request");
+  else server.send(otaUpdater.errorCode(), "text/plain", otaUpdater.error());
+  otaUpdater.reset();
+}
+
+void handleResetWifi() { server.send(200, "text/plain", "Resetting WiFi..."); WiFiManager wm; wm.resetSettings(); delay(1000); restartParked(); }
+void handleRestart() { server.send(200, "text/plain", "Restarting..."); delay(1000); restartParked(); }
 void handleResetCal() {
-    preferences.begin("clock-conf", false); preferences.remove("stepsRev"); preferences.remove("stepsRevH"); preferences.end();
+    stepsPerRevolution = DEFAULT_STEPS; stepsPerRevolutionHours = DEFAULT_STEPS; saveConfig();
     server.send(200, "text/plain", "Calibration Reset. Restarting..."); delay(1000); ESP.restart();
 }
 
+// ==========================================
+//              BENCHMARKS
+// ==========================================
+// The hot functions as BenchSuite kernels: GET /bench on the clock, and
+// `program --bench` in the simulator (same kernels, host cycles).
+BenchSuite benchSuite;
+volatile uint32_t benchSink;  // Keeps results alive past the optimiser
+
+// A /save form as the dashboard posts it, matching the current settings so
+// applying it changes nothing
+struct SaveForm {
+  static const int MAX_FIELDS = 32;
+  String names[MAX_FIELDS], values[MAX_FIELDS];
+  int count = 0;
+
+  void set(const char *name, const String &value) { if (count < MAX_FIELDS) { names[count] = name; values[count++] = value; } }
+  void check(const char *name, bool on) { if (on) set(name, "on"); }
+  bool hasArg(const String &name) { for (int i = 0; i < count; i++) if (names[i] == name) return true; return false; }
+  String arg(const String &name) { for (int i = 0; i < count; i++) if (names[i] == name) return values[i]; return String(); }
+};
+
+void fillSaveForm(SaveForm &f) {
+  f.set("is12h", is12Hour ? "1" : "0"); f.set("tz", timeZoneString);
+  f.check("pwrSav", powerSaverEnabled);
+  f.set("spd", String(motorMaxSpeed)); f.set("sens", String(sensorSensitivity));
+  f.check("nightEn", nightModeEnabled);
+  f.set("nStart", String(nightStartHour)); f.set("nEnd", String(nightEndHour));
+  f.set("homeInt", String(autoHomeIntervalHours));
+  f.check("dateEn", dateDisplayEnabled);
+  f.set("dateInt", String(dateIntervalMinutes)); f.set("dateDur", String(dateDurationSeconds));
+  f.check("ledS_en", ledStatusEnabled); f.set("ledS_br", String(ledStatusBrightness));
+  f.check("ledC_en", ledColonEnabled); f.set("ledC_br", String(ledColonBrightness));
+  f.check("ledX_en", ledAuxEnabled); f.set("ledX_br", String(ledAuxBrightness));
+  f.check("ledA_en", ledAmPmEnabled); f.set("ledA_br", String(ledAmPmBrightness));
+  f.set("ledC_fx", String((int)ledColonEffect)); f.set("ledX_fx", String((int)ledAuxEffect));
+  f.set("ledA_fx", String((int)ledAmPmEffect));
+}
+
+// One magnet pass as the sampler sees it at sweep speed: 1 kHz, 2 steps apart
+const int BENCH_PASS_SAMPLES = 200;
+uint16_t benchPass[BENCH_PASS_SAMPLES];
+
+void registerBenchmarks() {
+  for (int i = 0; i < BENCH_PASS_SAMPLES; i++) {
+    float x = (i - BENCH_PASS_SAMPLES / 2) / 12.0f;
+    benchPass[i] = 1830 - (uint16_t)(1200 * expf(-x * x));
+  }
+
+  benchSuite.add("target_position", 3600, [](uint32_t ops) {
+    for (uint32_t i = 0; i < ops; i++) benchSink = calculateTargetPosition(i * 37, i % 60, (i * 7 + 1) % 60, i & 1);
+  });
+  benchSuite.add("step_interval", 2048, [](uint32_t ops) {
+    const MotionProfile &p = stepperMinutes.profile();
+    for (uint32_t i = 0; i < ops; i++) benchSink = p.interval(i, ops);
+  });
+  benchSuite.add("profile_build", 2, [](uint32_t ops) {
+    static MotionProfile p;
+    for (uint32_t i = 0; i < ops; i++) p.build(motorMaxSpeed, MOTOR_ACCEL, MOTOR_JERK, StepperAxis::TIMER_HZ);
+  });
+  benchSuite.add("status_json", 10, [](uint32_t ops) {
+    for (uint32_t i = 0; i < ops; i++) {
+      JsonDocument doc;
+      buildStatus(doc);
+      String json; serializeJson(doc, json);
+      benchSink = json.length();
+    }
+  });
+  benchSuite.add("save_args", 20, [](uint32_t ops) {
+    SaveForm form;
+    fillSaveForm(form);
+    for (uint32_t i = 0; i < ops; i++) applySaveArgs(form);
+  });
+  benchSuite.add("config_patch", 20, [](uint32_t ops) {
+    // One slider step as the dashboard sends it, at the current value
+    String body = String("{\"ledC_br\":") + ledColonBrightness + "}";
+    for (uint32_t i = 0; i < ops; i++) {
+      JsonDocument reply;
+      benchSink = patchConfig(body, reply);
+    }
+  });
+  benchSuite.add("sensor_threshold", 1000, [](uint32_t ops) {
+    // Is this sample the magnet? (threshold from the sensitivity setting)
+    for (uint32_t i = 0; i < ops; i++) benchSink = abs((int)benchPass[i % BENCH_PASS_SAMPLES] - baselineMinutes) > sensorThreshold();
+  });
+  benchSuite.add("magnet_pass", 4, [](uint32_t ops) {
+    static MagnetEstimator est;
+    for (uint32_t n = 0; n < ops; n++) {
+      est.begin(1830, sensorThreshold());
+      for (int i = 0; i < BENCH_PASS_SAMPLES && !est.done(); i++) est.add(i * 2, benchPass[i]);
+      benchSink = est.state();
+    }
+  });
+  benchSuite.add("hall_ingest", 2000, [](uint32_t ops) {
+    static HallSampler *sampler = new HallSampler();  // Not begun: no DMA, just the ingest path
+    for (uint32_t i = 0; i < ops; i++) sampler->ingest(i & 1, benchPass[(i / 2) % BENCH_PASS_SAMPLES], i);
+  });
+}
+
+// Runs the whole suite (about a second of loop time; motion and the LEDs
+// run on their own meanwhile)
+void handleBench() {
+  BenchResult results[BenchSuite::MAX_KERNELS];
+  int n = benchSuite.run(results, BenchSuite::MAX_KERNELS);
+  JsonDocument doc;
+  BenchSuite::report(doc, "esp32", results, n);
+  String json; serializeJson(doc, json); server.send(200, "application/json", json);
+}
+
+// ==========================================
+//              SCHEDULER
+// ==========================================
+// loop() sleeps until the next thing that can change: the minute boundary
+// (which also covers night mode and auto-home), a date toggle, an IP blink
+// step or a settings save; LED effects run on their own timers. The motion
+// task, SNTP and /api/config wake it early; HTTP requests are served by the
+// server's own task and need no wake. It only polls while WiFi is coming up
+// or a dashboard is connected.
+const uint32_t POLL_MS = 50;
+const uint32_t MAX_SLEEP_MS = 500;  // Bounds the effect of a missed wake
+
+uint32_t msUntil(unsigned long deadline) {
+  long left = (long)(deadline - millis());
+  return left > 0 ? left : 0;
+}
+
+uint32_t nextDeadlineMs() {
+  if (!isWifiSetup || events.clientCount() > 0) return POLL_MS;
+  uint32_t wait = MAX_SLEEP_MS;
+
+  // Next minute, handed to the planner PREPOSITION_MS ahead of the boundary
+  struct timeval tv; gettimeofday(&tv, nullptr);
+  uint32_t toBoundary = (uint32_t)(60 - tv.tv_sec % 60) * 1000 - tv.tv_usec / 1000;
+  wait = min(wait, toBoundary > (uint32_t)PREPOSITION_MS ? toBoundary - PREPOSITION_MS : toBoundary);
+
+  if (ipBlinkDigit >= 0) wait = min(wait, msUntil(ipBlinkNext));
+  if (configSavePending) wait = min(wait, msUntil(configSaveDue));
+  if (dateDisplayEnabled && !manualMode) {
+    unsigned long due = lastDateShowTime + (isShowingDate ? dateDurationSeconds * 1000UL : dateIntervalMinutes * 60000UL);
+    // Overdue means it waits for the spools, and the motion task wakes us then
+    uint32_t left = msUntil(due + 1); // The checks are strictly greater
+    if (left) wait = min(wait, left);
+  }
+  return wait;
+}
+
+void waitForNextDeadline() {
+  uint32_t wait = nextDeadlineMs();
+  if (wait) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+  loopWakes++;
+}
+
+// Between wakes the CPU drops to 80 MHz, and into automatic light sleep when
+// the SDK is built with tickless idle. Peripherals that need the clock (the
+// hall sensor DMA, the motion task while stepping) hold PM locks.
+void configurePowerManagement() {
+#if CONFIG_PM_ENABLE
+  esp_pm_config_esp32_t pm = {};
+  pm.max_freq_mhz = 240;
+  pm.min_freq_mhz = 80;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  pm.light_sleep_enable = true;
+#endif
+  esp_pm_configure(&pm);
+  esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "motion", &motionPmLock);
+#endif
+}
+
 // ==========================================
 //              SETUP
 // ==========================================
 void setup() {
   Serial.begin(115200);
   esp_task_wdt_init(WDT_TIMEOUT, true); esp_task_wdt_add(NULL);
-
-  preferences.begin("clock-conf", true);
-  is12Hour = preferences.getBool("12h", false);
-  timeZoneString = preferences.getString("tz", "EST5EDT,M3.2.0,M11.1.0"); 
-  powerSaverEnabled = preferences.getBool("idle", false);
-  motorMaxSpeed = preferences.getInt("spd", 1000);
-  sensorSensitivity = preferences.getInt("sens", 50);
-  nightModeEnabled = preferences.getBool("nEn", false);
-  nightStartHour = preferences.getInt("nSt", 22); nightEndHour = preferences.getInt("nEd", 7);
-  autoHomeIntervalHours = preferences.getInt("homeInt", 0);
-  dateDisplayEnabled = preferences.getBool("dEn", false);
-  dateIntervalMinutes = preferences.getInt("dInt", 5);
-  dateDurationSeconds = preferences.getInt("dDur", 5);
-  baselineHours = preferences.getInt("baseH", 1800); baselineMinutes = preferences.getInt("baseM", 1800);
-  stepsPerRevolution = preferences.getInt("stepsRev", 2048);
-  stepsPerRevolutionHours = preferences.getInt("stepsRevH", 2048);
-  stepsPerUnit = stepsPerRevolution / 60.0; stepsPerUnitHours = stepsPerRevolutionHours / 60.0;
-  
-  ledStatusEnabled = preferences.getBool("lSe", true); ledStatusBrightness = preferences.getInt("lSb", 255);
-  ledColonEnabled = preferences.getBool("lCe", true); ledColonBrightness = preferences.getInt("lCb", 255);
-  ledAuxEnabled = preferences.getBool("lXe", true); ledAuxBrightness = preferences.getInt("lXb", 255); 
-  ledAmPmEnabled = preferences.getBool("lAe", true); ledAmPmBrightness = preferences.getInt("lAb", 255);
-  preferences.end();
+  otaUpdater.begin();
+  appLock = xSemaphoreCreateMutex();
+  loopTaskHandle = xTaskGetCurrentTaskHandle();
+  configurePowerManagement();
+
+  ClockConfig cfg;
+  ConfigStore::Source source = configStore.load("clock-conf", cfg);
+  applyConfig(cfg);
+  if (source == ConfigStore::FROM_LEGACY) Serial.println("Settings migrated to the config blob");
+  ParkedState parked;
+  WarmStart::Source warm = warmStart.restore(parked);
+  // A calibration change since then moves where the flaps are. A new image
+  // on trial homes for real: finding the magnets is part of its test
+  bool resume = warm != WarmStart::COLD && parked.stepsRev == stepsPerRevolution && parked.stepsRevH == stepsPerRevolutionHours &&
+                !otaUpdater.onTrial();
 
   // Initialize LEDs
   ledStatus.begin(LED_STATUS_PIN, PWM_CH_STATUS, true);
@@ -977,157 +1569,258 @@ void setup() {
   ledAmPm.begin(LED_AMPM_PIN, PWM_CH_AMPM, true);
   ledAux.begin(LED_AUX_PIN, PWM_CH_AUX, true); 
 
-  WiFiManager wm;
-  wm.setAPCallback([](WiFiManager *myWiFiManager) { ledStatus.forceOn(255); });
-  if (!wm.autoConnect("SplitFlapClockSetup")) { ESP.restart(); }
-  blinkIpAddress(); 
-  configTzTime(timeZoneString.c_str(), "pool.ntp.org", "time.nist.gov");
-  
-  server.on("/", handleRoot);
-  server.on("/status", handleStatus);
-  server.on("/calib_status", handleCalibStatus); 
-  server.on("/save", HTTP_POST, handleSave);
-  server.on("/manual", HTTP_POST, handleManual);
-  server.on("/resume", HTTP_POST, handleResume);
-  server.on("/reset_wifi", handleResetWifi);
-  server.on("/restart", handleRestart);
-  server.on("/reset_cal", handleResetCal);
+  // Initialize Step Engines
+  traceRecorder.arm();
+  stepperHours.begin(STEPPER_TIMER_HOURS, 26, 33, 25, 32);
+  stepperMinutes.begin(STEPPER_TIMER_MINUTES, 27, 12, 14, 13);
+  stepperHours.attachTrace(&traceRecorder, HALL_CH_HOURS);
+  stepperMinutes.attachTrace(&traceRecorder, HALL_CH_MINUTES);
+
+  // Start the hall sensor DMA sampler (stamps samples with spool positions)
+  hallSampler.begin(hallEffectSensorHoursPin, &stepperHours, hallEffectSensorMinutesPin, &stepperMinutes);
+  hallSampler.setBaseline(HALL_CH_HOURS, baselineHours);
+  hallSampler.setBaseline(HALL_CH_MINUTES, baselineMinutes);
+  hallSampler.attachTrace(&traceRecorder);
+  driftHours.begin(&hallSampler, HALL_CH_HOURS, &stepperHours);
+  driftMinutes.begin(&hallSampler, HALL_CH_MINUTES, &stepperMinutes);
+  registerBenchmarks();
+
+  for (int i = 0; i < webAssetCount; i++) {
+    const WebAsset *asset = &webAssets[i];
+    server.on(asset->path, HTTP_GET, timed(asset->path, [asset]() { serveAsset(*asset); }));
+  }
+  server.on("/status", timed("/status", handleStatus));
+  server.on("/metrics", HTTP_GET, timed("/metrics", handleMetrics));
+  server.on("/events", HTTP_GET, timed("/events", handleEvents));
+  server.on("/calib_status", timed("/calib_status", handleCalibStatus)); 
+  server.on("/save", HTTP_POST, timed("/save", handleSave));
+  server.on("/api/config", timed("/api/config", handleConfigApi));
+  server.on("/manual", HTTP_POST, timed("/manual", handleManual));
+  server.on("/resume", HTTP_POST, timed("/resume", handleResume));
+  server.on("/reset_wifi", timed("/reset_wifi", handleResetWifi));
+  server.on("/restart", timed("/restart", handleRestart));
+  server.on("/reset_cal", timed("/reset_cal", handleResetCal));
+  server.on("/bench/steps", HTTP_GET, timed("/bench/steps", handleStepBench));
+  server.on("/bench", HTTP_GET, timed("/bench", handleBench));
+  server.on("/trace", HTTP_GET, timed("/trace", handleTrace));
+  server.on("/trace/arm", HTTP_POST, timed("/trace/arm", handleTraceArm));
+  server.on("/trace/stop", HTTP_POST, timed("/trace/stop", handleTraceStop));
   
   // --- SPLIT CALIBRATION ENDPOINTS ---
-  server.on("/calibrate_sensors", HTTP_POST, []() { 
-      server.send(200, "text/plain", "OK"); 
+  server.on("/calibrate_sensors", HTTP_POST, timed("/calibrate_sensors", []() { 
       // measureBaseline=TRUE, countSteps=FALSE
-      runHomingSequence(true, false); 
-  });
-  
-  server.on("/calibrate_motors", HTTP_POST, []() { 
+      sendMotionCommand(MOTION_HOME, true, false); 
       server.send(200, "text/plain", "OK"); 
+  }));
+  
+  server.on("/calibrate_motors", HTTP_POST, timed("/calibrate_motors", []() { 
       // measureBaseline=TRUE, countSteps=TRUE
-      runHomingSequence(true, true); 
-  });
+      sendMotionCommand(MOTION_HOME, true, true); 
+      server.send(200, "text/plain", "OK"); 
+  }));
 
-  server.on("/update", HTTP_POST, []() {
-      server.sendHeader("Connection", "close"); server.send(200, "text/plain", (Update.hasError()) ? "FAIL" : "OK"); ESP.restart();
-    }, []() {
-      HTTPUpload& upload = server.upload();
-      if (upload.status == UPLOAD_FILE_START) { if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {} } 
-      else if (upload.status == UPLOAD_FILE_WRITE) { if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) {} } 
-      else if (upload.status == UPLOAD_FILE_END) { if (Update.end(true)) {} }
-    });
+  server.on("/calibrate_cancel", HTTP_POST, timed("/calibrate_cancel", []() { 
+      sendMotionCommand(MOTION_CANCEL_HOME); 
+      server.send(200, "text/plain", "OK"); 
+  }));
+
+  server.on("/update", HTTP_POST, timed("/update", handleUpdateDone), handleUpdateUpload);
 
-  server.begin();
+  const char *cacheHeaders[] = { "If-None-Match" };
+  server.collectHeaders(cacheHeaders, 1);
   
   // Apply Acceleration on startup
-  stepperHours.setAcceleration(1000);
-  stepperMinutes.setAcceleration(1000);
+  stepperHours.setMaxSpeed(motorMaxSpeed); stepperHours.setAcceleration(MOTOR_ACCEL);
+  stepperMinutes.setMaxSpeed(motorMaxSpeed); stepperMinutes.setAcceleration(MOTOR_ACCEL);
+  stepperHours.setJerk(MOTOR_JERK); stepperMinutes.setJerk(MOTOR_JERK);
+  motionPowerSaver = powerSaverEnabled;
+  planner.begin(&stepperHours, &stepperMinutes, calculateTargetPosition);
+  if (resume) {
+    // Pick up where the last run stopped; magnet passes confirm it later
+    Serial.println(warm == WarmStart::FROM_RTC ? "Warm start from RTC memory" : "Warm start from NVS");
+    stepperHours.restore(parked.posH, parked.phaseH);
+    stepperMinutes.restore(parked.posM, parked.phaseM);
+    if (!powerSaverEnabled) { stepperHours.enableOutputs(); stepperMinutes.enableOutputs(); }
+    currentDisplayedHour = parked.shownH; currentDisplayedMinute = parked.shownM;
+    driftHours.arm(baselineHours, sensorThreshold());
+    driftMinutes.arm(baselineMinutes, sensorThreshold());
+    positionUnconfirmed = true;
+    bootTimes.homedMs = millis();
+  }
+  publishMotionStatus();
+  xTaskCreatePinnedToCore(motionTask, "motion", MOTION_STACK, NULL, MOTION_PRIORITY, NULL, MOTION_CORE);
   
-  // Initial Homing: Use existing calibration (Measure=False, Count=False)
-  runHomingSequence(false, false); 
+  if (!resume) {
+    // Initial Homing: Use existing calibration (Measure=False, Count=False)
+    sendMotionCommand(MOTION_HOME, false, false); 
+  }
   lastHomeTime = time(nullptr); // Initialize timer
+
+  // Homing is under way on core 1; WiFi and SNTP come up meanwhile and
+  // loop() finishes the job (tickWifiBoot)
+  WiFi.mode(WIFI_STA);
+  wifiManager.setConfigPortalBlocking(false);
+  wifiManager.setAPCallback([](WiFiManager *myWiFiManager) { ledStatus.forceOn(255); });
+  if (wifiManager.getWiFiIsSaved()) WiFi.begin();
+  sntp_set_time_sync_notification_cb(onTimeSync);
+  configTzTime(timeZoneString.c_str(), "pool.ntp.org", "time.nist.gov");
+  timeService.configure(is12Hour);
 }
 
 // ==========================================
 //              LOOP
 // ==========================================
-void loop() {
-  // 1. PRIORITY: Steppers must run EVERY cycle for max speed
-  stepperHours.run();
-  stepperMinutes.run();
-
-  // 2. THROTTLE: Only run WiFi, Time, and LED logic every 50ms
-  // This removes the "friction" causing the motors to slow down.
-  if (millis() - lastLogicLoop > 50) {
-      lastLogicLoop = millis();
-
-      server.handleClient();
-      esp_task_wdt_reset();
-      
-      // Update LEDs
-      ledColon.update(ledColonEnabled, ledColonBrightness, 500); 
-      if (ledAuxEnabled) { ledAux.forceOn(ledAuxBrightness); } else { ledAux.forceOff(); }
-      
-      Time t = getLocalTimeData();
-      if (ledAmPmEnabled && t.isPm) { ledAmPm.forceOn(ledAmPmBrightness); } else { ledAmPm.forceOff(); }
-
-      // --- AUTO HOME LOGIC ---
-      if (autoHomeIntervalHours > 0) {
-          time_t now = time(nullptr);
-          // Check if time is valid (> 2020) and interval has passed
-          if (now > 1600000000 && (now - lastHomeTime) >= (autoHomeIntervalHours * 3600)) {
+// One pass of the clock: WiFi, LEDs, time and motor targets
+void clockTick() {
+  lastLogicLoop = millis();
+
+  tickWifiBoot();
+  tickConfigSave();
+  esp_task_wdt_reset();
+  
+  // Update LEDs
+  ledColon.set(ledColonEnabled, ledColonBrightness, ledColonEffect);
+  ledAux.set(ledAuxEnabled, ledAuxBrightness, ledAuxEffect);
+  
+  const TimeSnapshot &t = timeService.now();
+  if (tickIpBlink()) {} // Blinking the IP owns the LED for now
+  else ledAmPm.set(ledAmPmEnabled && t.isPm, ledAmPmBrightness, ledAmPmEffect);
+
+  MotionStatus st = motionStatus.read();
+  if (st.calibrating != wasCalibrating) {
+      wasCalibrating = st.calibrating;
+      if (st.calibrating) ledStatus.forceOn(255); else ledStatus.forceOff();
+      if (!st.calibrating) saveConfig(); // Baselines / steps per rev from homing
+      if (!st.calibrating && !bootTimes.homedMs) bootTimes.homedMs = millis();
+      if (!st.calibrating && strncmp(st.calibrationStatus, "Err", 3) != 0 && strcmp(st.calibrationStatus, "Cancelled") != 0) {
+        homedThisBoot = true;
+      }
+  }
+  pushLiveState(st);
+
+  // A new image proves itself by homing without errors and answering a
+  // request; otherwise back we go
+  if (otaUpdater.onTrial() &&
+      otaUpdater.checkTrial(homedThisBoot, server.requests() > 0) == OtaUpdater::TRIAL_FAILED) {
+      Serial.println("Firmware failed its trial, rolling back");
+      warmStart.park();
+      otaUpdater.rollback();
+  }
+
+  if (!bootTimes.displayMs && t.hour != -1 && !st.calibrating && !st.moving && !st.queued &&
+      st.displayedHour == t.hour && st.displayedMinute == t.minute) {
+      bootTimes.displayMs = millis();
+      Serial.printf("Boot: correct time shown after %u ms (homed %u, WiFi %u, SNTP %u)\n",
+                    (unsigned)bootTimes.displayMs, (unsigned)bootTimes.homedMs, (unsigned)bootTimes.wifiMs, (unsigned)bootTimes.syncMs);
+  }
+
+  // --- AUTO HOME LOGIC ---
+  if (autoHomeIntervalHours > 0) {
+      time_t now = time(nullptr);
+      // Check if time is valid (> 2020) and interval has passed
+      if (now > 1600000000 && lastHomeTime < 1600000000) lastHomeTime = now; // Interval runs from the first sync
+      if (now > 1600000000 && (now - lastHomeTime) >= (autoHomeIntervalHours * 3600)) {
+          lastHomeTime = now;
+          // Skipped while both spools keep getting re-centred on magnet passes
+          if (!driftCorrectedWithin((uint32_t)autoHomeIntervalHours * 3600000UL)) {
               Serial.println("Auto-Homing Triggered...");
               // Just home, do not measure baseline or count steps
-              runHomingSequence(false, false); 
-              lastHomeTime = time(nullptr);
-              return; // Sequence is blocking, so return after
+              sendMotionCommand(MOTION_HOME, false, false); 
+              return;
           }
       }
+  }
 
-      // Check Night Mode
-      if (isNightTime()) { 
-          stepperHours.disableOutputs(); 
-          stepperMinutes.disableOutputs(); 
-          return; 
+  // Check Night Mode
+  if (isNightTime()) { 
+      if (!nightOutputsOff) nightOutputsOff = sendMotionCommand(MOTION_OUTPUTS, 0);
+      return; 
+  }
+  nightOutputsOff = false;
+  
+  // Pre-position: hand the next minute over a few seconds early with the
+  // micros() of the boundary, the planner starts it so the flaps settle
+  // on the boundary instead of a loop tick (or a whole move) after it
+  if (!manualMode && !isShowingDate && t.hour != -1 && !st.calibrating && !st.queued && motionCaughtUp(st)) {
+    struct timeval tv; gettimeofday(&tv, nullptr);
+    time_t boundary = (tv.tv_sec / 60 + 1) * 60;
+    int32_t untilUs = (int32_t)(boundary - tv.tv_sec) * 1000000 - tv.tv_usec;
+    if (boundary != prepositionedMinute && untilUs <= PREPOSITION_MS * 1000) {
+      struct tm next; localtime_r(&boundary, &next);
+      Time nt = clockTime(next, is12Hour);
+      if (!isNightHour(next.tm_hour) && sendMotionCommand(MOTION_SHOW_AT, nt.hour, nt.minute, micros() + untilUs)) {
+        prepositionedMinute = boundary;
       }
-      
-      // Update Motor Targets (Clock Logic)
-      if (stepperHours.distanceToGo() == 0 && stepperMinutes.distanceToGo() == 0) {
-        int targetH, targetM;
+    }
+  }
 
-        if (manualMode) { 
-             targetH = manualHourTarget; targetM = manualMinuteTarget; 
-        } else {
-             // --- DATE DISPLAY LOGIC START ---
-             unsigned long now = millis();
-             // Check if we should switch TO Date mode
-             if (dateDisplayEnabled && !isShowingDate && (now - lastDateShowTime > (dateIntervalMinutes * 60000))) {
-                 isShowingDate = true;
-                 lastDateShowTime = now;
-             }
-             // Check if we should switch BACK to Time mode
-             if (isShowingDate && (now - lastDateShowTime > (dateDurationSeconds * 1000))) {
-                 isShowingDate = false;
-                 lastDateShowTime = now; // Reset timer so interval starts from now
-             }
-             
-             struct tm timeinfo;
-             if (!getLocalTime(&timeinfo)) return;
-
-             if (isShowingDate) {
-                 // Month (0-11) + 1 -> 1-12
-                 targetH = timeinfo.tm_mon + 1; 
-                 // Day of month (1-31)
-                 targetM = timeinfo.tm_mday;   
-             } else {
-                 // Standard Time Logic
-                 if (t.hour == -1) return;
-                 targetH = t.hour; 
-                 targetM = t.minute;
-             }
-             // --- DATE DISPLAY LOGIC END ---
-        }
+  // The time moved on while the date is held: queue the new time too,
+  // the planner folds it into the way back instead of flipping twice
+  static int queuedReturnH = -1, queuedReturnM = -1;
+  if (st.queued && isShowingDate && !manualMode && t.hour != -1 && motionCaughtUp(st) &&
+      (t.hour != queuedReturnH || t.minute != queuedReturnM)) {
+    if (sendMotionCommand(MOTION_SHOW, t.hour, t.minute)) { queuedReturnH = t.hour; queuedReturnM = t.minute; }
+  }
 
-        bool moved = false; 
-        if (targetM != currentDisplayedMinute) {
-          long steps = calculateTargetPosition(currentDisplayedMinute, targetM, false);
-          if (powerSaverEnabled) stepperMinutes.enableOutputs(); 
-          stepperMinutes.move(steps); currentDisplayedMinute = targetM; lastMotorMoveTime = millis(); moved = true;
-        }
-        if (targetH != currentDisplayedHour) {
-          long steps = calculateTargetPosition(currentDisplayedHour, targetH, true);
-          if (powerSaverEnabled) stepperHours.enableOutputs(); 
-          stepperHours.move(steps); currentDisplayedHour = targetH; lastMotorMoveTime = millis(); moved = true;
-        }
-      }
-      
-      // Disable Motors if Idle
-      if (stepperHours.distanceToGo() != 0 || stepperMinutes.distanceToGo() != 0) { lastMotorMoveTime = millis(); } 
-      else { if (powerSaverEnabled && (millis() - lastMotorMoveTime > 2000)) { stepperHours.disableOutputs(); stepperMinutes.disableOutputs(); } }
-      
-      if (powerSaverEnabled && (stepperMinutes.distanceToGo() == 0 && stepperHours.distanceToGo() == 0)) {
-            // Double check before killing power
-            if(millis() - lastMotorMoveTime > 2000) {
-                stepperMinutes.disableOutputs(); stepperHours.disableOutputs();
-            }
+  // Update Motor Targets (Clock Logic)
+  if (!st.moving && !st.queued && !st.calibrating && motionCaughtUp(st)) {
+    int targetH, targetM;
+
+    if (manualMode) { 
+         targetH = manualHourTarget; targetM = manualMinuteTarget; 
+    } else {
+         // --- DATE DISPLAY LOGIC START ---
+         unsigned long now = millis();
+         // Check if we should switch TO Date mode
+         if (dateDisplayEnabled && !isShowingDate && (now - lastDateShowTime > (dateIntervalMinutes * 60000))) {
+             isShowingDate = true;
+             lastDateShowTime = now;
+         }
+         // Check if we should switch BACK to Time mode
+         if (isShowingDate && (now - lastDateShowTime > (dateDurationSeconds * 1000))) {
+             isShowingDate = false;
+             lastDateShowTime = now; // Reset timer so interval starts from now
+             xTaskNotifyGive(loopTaskHandle); // Pass again now: pre-position above still saw the date
+         }
+         
+         if (!t.synced) return;
+
+         if (isShowingDate) {
+             targetH = t.month; // 1-12
+             targetM = t.day;   // 1-31
+         } else {
+             // Standard Time Logic
+             if (t.hour == -1) return;
+             targetH = t.hour; 
+             targetM = t.minute;
+         }
+         // --- DATE DISPLAY LOGIC END ---
+    }
+
+    if (targetH != st.displayedHour || targetM != st.displayedMinute) {
+      // The way back to the time is already known: queue it behind the
+      // date so the motion task returns on its own once the hold ends
+      sendMotionCommand(MOTION_SHOW, targetH, targetM, isShowingDate ? dateDurationSeconds * 1000 : 0);
+      if (isShowingDate && !manualMode && t.hour != -1 && sendMotionCommand(MOTION_SHOW, t.hour, t.minute)) {
+        queuedReturnH = t.hour; queuedReturnM = t.minute;
       }
-  } // End of throttled logic
+    }
+  }
+}
+
+void loop() {
+  // Motion runs in its own task on core 1, so nothing here is timing
+  // critical: do a pass, then sleep until something is due
+  static uint32_t lastPassStart = 0;
+  uint32_t started = micros();
+  if (lastPassStart) loopInterval.add(started - lastPassStart);
+  lastPassStart = started;
+  // An upload chunk can hold the lock through a flash erase: stay fed meanwhile
+  while (xSemaphoreTake(appLock, pdMS_TO_TICKS(1000)) != pdTRUE) esp_task_wdt_reset();
+  clockTick();
+  xSemaphoreGive(appLock);
+  uint32_t took = micros() - started;
+  loopPassTime.add(took);
+  if (took > POLL_MS * 1000) loopOverruns++;
+  waitForNextDeadline();
 }
\ No newline at end of file
@@ -0,0 +1,421 @@
+// Generated by tools/build_web.py from web/ -- do not edit.
+#pragma once
+#include <Arduino.h>
+
+struct WebAsset {
+  const char *path;
+  const char *contentType;
+  const char *etag;
+  bool immutable;       // Fingerprinted URL, cache forever
+  const uint8_t *data;  // gzip
+  size_t length;
+};
+
+// app.css: 2657 bytes -> 1059 gzipped
+const uint8_t web_app_css[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x56, 0x51, 0x8f, 0xe2, 0x36, 0x10, 0x7e, 0xe7, 0x57,
+  0x58, 0x42, 0xa7, 0x6b, 0x4f, 0x6b, 0xce, 0x49, 0x80, 0x85, 0x44, 0x7d, 0xa8, 0x74, 0xad, 0xd4, 0xb7, 0x4a, 0xed, 0xa9,
+  0x0f, 0x55, 0x1f, 0x1c, 0xdb, 0x09, 0xee, 0x86, 0x38, 0x72, 0x9c, 0x03, 0xb6, 0xda, 0xfe, 0xf6, 0x8e, 0xed, 0x38, 0x31,
+  0x2c, 0xbb, 0x55, 0x24, 0x04, 0xce, 0xf8, 0x9b, 0x99, 0x6f, 0xbe, 0x99, 0xa1, 0x54, 0xfc, 0x82, 0xfe, 0x41, 0x95, 0x6a,
+  0x0d, 0xae, 0xe8, 0x51, 0x36, 0x97, 0x1c, 0x7d, 0xfc, 0x4d, 0xd4, 0x4a, 0xa0, 0xaf, 0xbf, 0x7c, 0x7c, 0x40, 0x3d, 0x6d,
+  0x7b, 0xdc, 0x0b, 0x2d, 0xab, 0x02, 0x19, 0x71, 0x36, 0x98, 0x36, 0xb2, 0x6e, 0x73, 0xc4, 0x44, 0x6b, 0x84, 0x2e, 0x50,
+  0x49, 0xd9, 0x53, 0xad, 0xd5, 0xd0, 0x72, 0xcc, 0x54, 0xa3, 0x74, 0x8e, 0x96, 0xd5, 0x1a, 0x9e, 0x7d, 0x81, 0x8e, 0x54,
+  0xd7, 0x12, 0x4c, 0x49, 0x81, 0x3a, 0xca, 0xb9, 0x6c, 0xeb, 0x1c, 0xa5, 0xa4, 0x3b, 0x17, 0x28, 0x58, 0x66, 0x59, 0x56,
+  0xa0, 0x97, 0xc5, 0x8a, 0x51, 0xcd, 0x21, 0x88, 0x19, 0x2b, 0x47, 0xa7, 0x83, 0x34, 0xc2, 0x62, 0x9c, 0xf1, 0x49, 0x72,
+  0x73, 0xc8, 0xd1, 0x76, 0xe3, 0xee, 0x06, 0x54, 0x3a, 0x18, 0x15, 0x03, 0x6f, 0xec, 0xcb, 0x52, 0x69, 0x2e, 0x34, 0xd6,
+  0x94, 0xcb, 0xa1, 0xcf, 0x51, 0x32, 0x1e, 0x9e, 0x71, 0x7f, 0xa0, 0x5c, 0x9d, 0x20, 0x16, 0x94, 0x00, 0x8a, 0x0b, 0x03,
+  0xe9, 0xba, 0xa4, 0xdf, 0x91, 0x07, 0xf7, 0xac, 0x92, 0xef, 0x6d, 0x24, 0x87, 0x04, 0xc2, 0x08, 0xd1, 0xa5, 0x2c, 0x13,
+  0x1b, 0x12, 0x3c, 0xe2, 0x52, 0x19, 0xa3, 0x8e, 0x39, 0x72, 0x98, 0x2f, 0x8b, 0xc5, 0xe7, 0x4f, 0xe8, 0xe7, 0x46, 0x9c,
+  0x51, 0x43, 0x2f, 0x6a, 0x30, 0xc0, 0xa0, 0x46, 0x1b, 0x7b, 0x77, 0x38, 0xb6, 0x3d, 0xfa, 0xf4, 0x79, 0xb1, 0xea, 0x0d,
+  0x35, 0x70, 0xeb, 0x0c, 0x90, 0x5c, 0xf6, 0x1d, 0xd8, 0xe5, 0xa8, 0x82, 0x1b, 0x05, 0xfa, 0x7b, 0xe8, 0x8d, 0xac, 0x2e,
+  0xc0, 0x18, 0x90, 0xd8, 0x9a, 0x1c, 0xf5, 0x1d, 0x65, 0x02, 0x97, 0xc2, 0x9c, 0x84, 0x68, 0xe7, 0x1c, 0x5d, 0x98, 0xa4,
+  0xb8, 0x22, 0x66, 0x29, 0x44, 0x95, 0x56, 0x9b, 0x28, 0xf5, 0x84, 0xdc, 0x4b, 0x9d, 0xcc, 0x61, 0x7e, 0xfd, 0xf5, 0xcb,
+  0x8f, 0xbf, 0xff, 0xf4, 0x25, 0x47, 0x7f, 0x58, 0x26, 0xd1, 0xbf, 0xc9, 0xfe, 0x03, 0x32, 0x0a, 0x55, 0xd2, 0x40, 0xc4,
+  0x40, 0xf3, 0x71, 0x8e, 0x17, 0x62, 0x1d, 0xe9, 0x06, 0xa3, 0xe2, 0x36, 0x6e, 0xfb, 0x89, 0xb9, 0xd4, 0x82, 0x19, 0xa9,
+  0xac, 0x08, 0x5c, 0xb6, 0x77, 0xf2, 0x09, 0xea, 0x00, 0xff, 0x1e, 0xf6, 0x90, 0x01, 0x72, 0x48, 0x6b, 0xe3, 0xb3, 0x72,
+  0x9a, 0xeb, 0xe5, 0xb3, 0x00, 0x67, 0x49, 0x2c, 0x8b, 0xc7, 0x6a, 0xc7, 0x76, 0x7c, 0xd4, 0x9b, 0xd1, 0xa0, 0x40, 0x20,
+  0x17, 0x98, 0x1f, 0xba, 0x4e, 0x68, 0x46, 0x7b, 0xd0, 0x45, 0x23, 0x0c, 0x38, 0xc0, 0x96, 0x37, 0xcf, 0x01, 0xdc, 0xb7,
+  0xce, 0x8c, 0x3c, 0x0a, 0x3c, 0x46, 0x1d, 0x64, 0xed, 0x5d, 0xa4, 0x6b, 0xeb, 0xc2, 0x1d, 0x9c, 0x84, 0xac, 0x0f, 0x10,
+  0x65, 0xa9, 0x1a, 0x5e, 0xbc, 0x2a, 0x37, 0xe8, 0xb1, 0x17, 0x6d, 0xaf, 0x34, 0xb6, 0xfe, 0xaf, 0x41, 0x92, 0x2c, 0x8e,
+  0x73, 0xb3, 0x81, 0x32, 0x34, 0xb2, 0x15, 0xf8, 0x30, 0x22, 0x26, 0xab, 0x75, 0x81, 0x4e, 0x50, 0x09, 0x7c, 0xd2, 0xb4,
+  0x03, 0x0f, 0x5a, 0xd0, 0x27, 0x6c, 0x0f, 0x3c, 0x17, 0x14, 0x88, 0xfb, 0x26, 0x22, 0x8d, 0x89, 0xc7, 0x35, 0xcb, 0xd8,
+  0xdd, 0xb8, 0x20, 0x0e, 0xd9, 0xbe, 0xba, 0x90, 0x3e, 0x52, 0xb1, 0x25, 0x6f, 0x5c, 0x58, 0xc8, 0xb6, 0x1b, 0x0c, 0x34,
+  0xad, 0x68, 0xa0, 0x44, 0x0f, 0xa8, 0x1c, 0x40, 0xb2, 0xad, 0xed, 0x2c, 0xdb, 0x02, 0xf2, 0xd9, 0x51, 0x35, 0x0a, 0x05,
+  0x8e, 0x62, 0x0d, 0xa5, 0x71, 0x6f, 0xed, 0x7c, 0x81, 0x82, 0x12, 0x08, 0xf9, 0x10, 0xf4, 0xe5, 0x98, 0x46, 0xbd, 0x6a,
+  0x24, 0x47, 0x4b, 0xce, 0xf9, 0x2b, 0xdd, 0xed, 0x26, 0x96, 0x47, 0xc6, 0xb6, 0x5e, 0x87, 0x2e, 0xb2, 0x3f, 0xcd, 0xa5,
+  0x13, 0x3f, 0xb0, 0x83, 0x60, 0x4f, 0xe0, 0xfe, 0xaf, 0x59, 0x6c, 0x7e, 0x2c, 0x04, 0x16, 0xfd, 0xaf, 0x6f, 0x42, 0x1b,
+  0xc9, 0x68, 0x13, 0x26, 0xce, 0x51, 0x72, 0xde, 0x88, 0x68, 0xac, 0xf8, 0x56, 0x26, 0x88, 0xdc, 0xe0, 0x83, 0x60, 0x6a,
+  0x61, 0xc1, 0xa7, 0xec, 0xc8, 0x7c, 0x2b, 0x19, 0x5b, 0xea, 0x65, 0x31, 0x93, 0xf3, 0x7a, 0x84, 0x65, 0xeb, 0xfd, 0x8e,
+  0x97, 0x53, 0xa5, 0xc7, 0x61, 0x14, 0x28, 0x68, 0x55, 0x0b, 0xbf, 0xd8, 0xa0, 0x7b, 0xfb, 0xb2, 0x53, 0xd2, 0x8b, 0xdd,
+  0x29, 0x55, 0xfa, 0xce, 0x20, 0xab, 0xac, 0xbf, 0x29, 0xd2, 0x96, 0x44, 0x6e, 0xf3, 0x83, 0x82, 0xfc, 0xee, 0x3b, 0x4f,
+  0xf7, 0x3b, 0x52, 0xee, 0x9d, 0x00, 0x4a, 0xd3, 0xe2, 0x5a, 0xc3, 0x4c, 0x78, 0xc3, 0x52, 0x30, 0xf6, 0x98, 0x80, 0x25,
+  0x9a, 0x2d, 0xdf, 0x45, 0x1e, 0xc5, 0x33, 0x22, 0x2b, 0xc7, 0xd4, 0x7d, 0xd3, 0x2a, 0xdb, 0xb3, 0x24, 0x9d, 0xa0, 0xbd,
+  0xe9, 0x7b, 0xd8, 0x3c, 0xdb, 0xac, 0xc9, 0x8c, 0xcd, 0xad, 0xfd, 0x1b, 0xa6, 0x41, 0xf4, 0x23, 0xb6, 0x37, 0x7d, 0x0f,
+  0x9b, 0x91, 0x6c, 0x9f, 0x96, 0x7e, 0x55, 0x00, 0xa5, 0x5a, 0x35, 0xd8, 0x5a, 0x74, 0x4e, 0xd9, 0x4e, 0x7e, 0x46, 0x41,
+  0xb7, 0xa5, 0xb3, 0x34, 0x2b, 0x62, 0x9f, 0x49, 0xe0, 0xe3, 0xfb, 0x68, 0x81, 0xc4, 0x27, 0xf1, 0x5e, 0x6b, 0x44, 0x65,
+  0x9c, 0x23, 0xad, 0x4e, 0xaf, 0x07, 0xb7, 0x33, 0xc2, 0x6e, 0x64, 0xce, 0x43, 0xae, 0xb6, 0x9d, 0x9e, 0xc4, 0xd8, 0x61,
+  0x55, 0x84, 0x21, 0xec, 0xc0, 0x22, 0x85, 0xb6, 0xc3, 0xb1, 0x14, 0xda, 0x4a, 0xd4, 0xc2, 0x82, 0x9d, 0x35, 0x6a, 0x68,
+  0x29, 0x9a, 0x30, 0x6e, 0xae, 0x3b, 0x7b, 0x8a, 0xa2, 0x6c, 0x14, 0x7b, 0xba, 0x4e, 0x61, 0xf2, 0xd1, 0x0f, 0x25, 0xbe,
+  0x8b, 0xd1, 0xc2, 0xf0, 0xa4, 0xcd, 0x75, 0x57, 0xae, 0xe3, 0x39, 0xb6, 0xdd, 0x6e, 0xdd, 0xf4, 0x58, 0x76, 0x5a, 0xd5,
+  0x6e, 0x72, 0x45, 0x99, 0x7b, 0xb1, 0x47, 0x1b, 0x08, 0x16, 0x90, 0x98, 0x7a, 0x35, 0xbd, 0xb3, 0x7b, 0x7c, 0x44, 0xb6,
+  0x9a, 0x55, 0x03, 0x3b, 0xf7, 0x00, 0x7d, 0x3b, 0x2f, 0x35, 0x17, 0xb4, 0xb3, 0x78, 0x19, 0xfd, 0x95, 0xf4, 0xba, 0xea,
+  0xf9, 0x24, 0xeb, 0xd1, 0x87, 0x9f, 0x3f, 0x7e, 0x52, 0xd8, 0x6f, 0x51, 0x9f, 0xb9, 0x43, 0x68, 0xb6, 0xb4, 0xb7, 0xd3,
+  0x7f, 0x09, 0xd3, 0x42, 0x96, 0xd8, 0x7a, 0xf6, 0xe3, 0xff, 0x3a, 0x87, 0x4e, 0x8d, 0xb7, 0x2a, 0x79, 0x16, 0x76, 0xbd,
+  0x40, 0x24, 0xa4, 0x70, 0x15, 0xcf, 0xa7, 0x69, 0xe7, 0x9d, 0x5d, 0x79, 0x8e, 0x42, 0xbb, 0xfa, 0xcb, 0xb0, 0x83, 0xbf,
+  0x0c, 0xcf, 0x58, 0xb6, 0x1c, 0x4a, 0xb8, 0xdf, 0x5f, 0x8b, 0x23, 0x68, 0xe3, 0x76, 0x33, 0x86, 0xf3, 0x9b, 0x4d, 0x1a,
+  0x16, 0xa9, 0xaf, 0xc8, 0x38, 0x6e, 0x5e, 0x42, 0x42, 0xc0, 0x50, 0xa8, 0x8a, 0x0f, 0x72, 0x17, 0xc5, 0x98, 0xf9, 0x0a,
+  0x44, 0xf4, 0xb9, 0xb5, 0x74, 0x53, 0x92, 0xcd, 0xff, 0x95, 0x24, 0x1d, 0x65, 0x34, 0xbb, 0x9c, 0xbc, 0xbd, 0x47, 0xc8,
+  0xb2, 0x4a, 0xd8, 0x9a, 0x54, 0x6f, 0x15, 0x05, 0x00, 0xff, 0x03, 0x9b, 0x68, 0x30, 0xa6, 0x61, 0x0a, 0x00, 0x00,
+};
+
+// app.js: 10651 bytes -> 3920 gzipped
+const uint8_t web_app_js[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x5a, 0x7b, 0x73, 0xa3, 0x46, 0x12, 0xff, 0xdf, 0x9f,
+  0x62, 0xa2, 0x54, 0x02, 0x44, 0x32, 0x06, 0xc4, 0x4b, 0xd6, 0xda, 0x5b, 0x5e, 0x3f, 0x62, 0x5f, 0xd6, 0xbb, 0x5b, 0x2b,
+  0x6f, 0xe2, 0x2a, 0x97, 0x6f, 0x6b, 0x80, 0x41, 0x10, 0x23, 0x50, 0x00, 0xd9, 0x56, 0x76, 0x7d, 0x9f, 0xfd, 0xba, 0x67,
+  0x40, 0x42, 0x32, 0xb2, 0x95, 0xba, 0x3a, 0x57, 0x59, 0x62, 0x1e, 0xfd, 0xeb, 0xe7, 0xcc, 0xf4, 0x34, 0x0a, 0x67, 0xa9,
+  0x5f, 0xc6, 0x59, 0x4a, 0x7c, 0x9a, 0xf8, 0x27, 0x71, 0x18, 0xca, 0xf7, 0x34, 0x51, 0xc8, 0xb7, 0x1d, 0x02, 0x7f, 0x09,
+  0x2b, 0x49, 0x00, 0x7d, 0xe4, 0x80, 0xc8, 0xd8, 0x4f, 0x76, 0x89, 0xa1, 0x99, 0xae, 0x42, 0xf6, 0xaa, 0xef, 0x5f, 0x88,
+  0xae, 0x69, 0x43, 0x3e, 0x37, 0x0e, 0x65, 0x31, 0xf5, 0xe0, 0x80, 0x68, 0x0a, 0xc9, 0x59, 0x39, 0xcb, 0x53, 0x22, 0xbd,
+  0x29, 0xa6, 0x34, 0x25, 0x45, 0x39, 0x4f, 0xd8, 0x41, 0xc7, 0xcf, 0x92, 0x2c, 0xdf, 0xff, 0xd1, 0x70, 0x28, 0xb3, 0xb5,
+  0x21, 0x09, 0xb3, 0xb4, 0xdc, 0x7d, 0x60, 0xf1, 0x38, 0x2a, 0xf7, 0xbd, 0x2c, 0x09, 0x86, 0x9d, 0x43, 0x4d, 0xd5, 0xb4,
+  0x9f, 0x88, 0x7c, 0xc2, 0x42, 0x3a, 0x4b, 0x4a, 0xe5, 0xcd, 0x1e, 0x92, 0x1f, 0x4a, 0xc3, 0x85, 0x38, 0x1c, 0x02, 0xe5,
+  0xe1, 0xcc, 0x0e, 0x89, 0xa6, 0x5a, 0xe4, 0xfb, 0x77, 0x21, 0xe5, 0x1b, 0xb2, 0x0b, 0x4d, 0x85, 0xbc, 0x25, 0xd2, 0x8f,
+  0xcc, 0x31, 0xfd, 0xbe, 0x2f, 0x91, 0x7d, 0x78, 0x16, 0xfc, 0x2a, 0x90, 0x17, 0x04, 0x93, 0xba, 0xfc, 0xbb, 0x2b, 0xb5,
+  0x8a, 0x26, 0x91, 0xae, 0xe0, 0x7a, 0xa8, 0xbd, 0x95, 0xba, 0xd2, 0xbe, 0x24, 0x29, 0xd0, 0x83, 0x1d, 0x6a, 0x99, 0x9d,
+  0xc5, 0x8f, 0x2c, 0x90, 0x0d, 0xec, 0x91, 0x7e, 0x5a, 0x4a, 0xfd, 0xb4, 0xb3, 0xb3, 0xb7, 0x47, 0xde, 0xc7, 0xf7, 0x0c,
+  0x38, 0xd1, 0x92, 0x91, 0xe9, 0xac, 0x88, 0x58, 0x40, 0xbc, 0x39, 0xd9, 0x63, 0xf7, 0x2c, 0x2d, 0x8b, 0x7d, 0x92, 0xa5,
+  0x8c, 0x74, 0xc2, 0x59, 0x92, 0x74, 0x48, 0x91, 0xd2, 0x69, 0x11, 0x65, 0x25, 0x41, 0x7f, 0x64, 0x69, 0xca, 0xfc, 0xb2,
+  0x47, 0xca, 0x88, 0xa5, 0x88, 0x32, 0x61, 0x45, 0x41, 0xc7, 0xac, 0x00, 0x4f, 0xe5, 0xf9, 0x3c, 0x4e, 0xc7, 0x30, 0x2b,
+  0x99, 0xe3, 0x30, 0x09, 0x63, 0x96, 0x04, 0x05, 0x3c, 0x52, 0x30, 0x50, 0x44, 0xd3, 0x31, 0x0b, 0x76, 0xd0, 0x58, 0x09,
+  0x32, 0x3e, 0x20, 0xdf, 0x9e, 0x86, 0x3b, 0x3b, 0x61, 0xed, 0xe8, 0x9c, 0xa5, 0x01, 0xcb, 0x47, 0x20, 0xce, 0xac, 0x90,
+  0x83, 0xda, 0xd5, 0xc0, 0xe0, 0xcb, 0xa7, 0x93, 0xa3, 0xab, 0x53, 0xf2, 0xc7, 0xc5, 0xd9, 0x45, 0xe5, 0x51, 0x22, 0x4b,
+  0x79, 0x51, 0xc4, 0x12, 0x89, 0x53, 0x12, 0xa0, 0x99, 0x25, 0x68, 0x05, 0xa2, 0x59, 0x13, 0x0a, 0xb7, 0x14, 0xf1, 0x18,
+  0x18, 0x21, 0x3f, 0x15, 0x29, 0x86, 0x8d, 0xa1, 0xbf, 0x66, 0x34, 0x89, 0xcb, 0x39, 0xfa, 0x0c, 0x67, 0x1d, 0x1e, 0x90,
+  0x5d, 0x4b, 0x43, 0x27, 0x75, 0x4e, 0x1f, 0x7d, 0x96, 0x24, 0x60, 0x85, 0x0e, 0xb8, 0x69, 0x31, 0x68, 0x8b, 0xc1, 0x5f,
+  0xb3, 0x2c, 0x58, 0xe9, 0x77, 0x44, 0xff, 0x19, 0x8d, 0x73, 0xec, 0xef, 0xfc, 0xc1, 0xe8, 0x5d, 0xa7, 0xc9, 0x68, 0x11,
+  0x1a, 0x6b, 0x48, 0x95, 0xff, 0xdb, 0xc0, 0x7e, 0x0c, 0xfb, 0x03, 0x5f, 0x37, 0x38, 0x5e, 0x15, 0x32, 0x0b, 0xc8, 0x20,
+  0xf3, 0x67, 0x13, 0x10, 0x4e, 0x1d, 0xb3, 0xf2, 0x34, 0x61, 0xf8, 0xf8, 0x6e, 0x7e, 0x11, 0xc8, 0xd2, 0x43, 0x1c, 0xc6,
+  0x68, 0xbe, 0x42, 0x52, 0xd4, 0x18, 0x9c, 0x94, 0x9f, 0x5f, 0x5d, 0xbe, 0x07, 0xbe, 0x10, 0x52, 0x65, 0x9e, 0xa5, 0x63,
+  0x1e, 0x29, 0xdc, 0x14, 0x68, 0x2d, 0x8c, 0x08, 0x08, 0x08, 0x31, 0xf2, 0xc6, 0xcb, 0x0f, 0xdb, 0x02, 0x0f, 0x26, 0x09,
+  0xe9, 0x61, 0x72, 0x15, 0x6a, 0xb5, 0xd9, 0xa0, 0x07, 0xdc, 0x00, 0x5f, 0x28, 0x3a, 0x34, 0x82, 0x77, 0x93, 0xb5, 0x65,
+  0x01, 0x41, 0xb6, 0xea, 0xc1, 0xab, 0x8b, 0xcb, 0xd3, 0xa5, 0x07, 0xa3, 0x86, 0xfb, 0x26, 0xeb, 0xbe, 0xdb, 0xa8, 0x64,
+  0x10, 0x17, 0xd3, 0xab, 0x78, 0xc2, 0x6a, 0x1d, 0xaf, 0xd8, 0x63, 0x89, 0xb6, 0xe5, 0x7a, 0x45, 0x6f, 0x74, 0x58, 0x03,
+  0x1a, 0x5f, 0x03, 0x5d, 0xd1, 0x83, 0xa2, 0x71, 0x3d, 0xc4, 0x8c, 0xc9, 0xb3, 0x19, 0x93, 0x0d, 0xc2, 0xe2, 0xc7, 0x52,
+  0xd8, 0x00, 0x16, 0x49, 0x2d, 0xe3, 0x8b, 0xb2, 0x9d, 0xe0, 0xc4, 0x55, 0xd9, 0x38, 0x1b, 0x04, 0x18, 0xae, 0xf3, 0x18,
+  0x9d, 0x7e, 0x18, 0x7d, 0xfc, 0x3c, 0x5a, 0xb2, 0x29, 0x58, 0x5a, 0x9c, 0x37, 0xc3, 0x1a, 0xda, 0x97, 0x8d, 0xb6, 0x47,
+  0x0b, 0x76, 0xbe, 0xd6, 0xbe, 0x6c, 0x8d, 0x7b, 0x04, 0x2a, 0x27, 0x09, 0xba, 0xff, 0x1c, 0xf6, 0x9a, 0x85, 0x01, 0xf8,
+  0x00, 0xee, 0x44, 0xc2, 0xdd, 0x7e, 0x42, 0x8b, 0xe2, 0xa0, 0x43, 0x61, 0x09, 0xde, 0xb3, 0xce, 0xe1, 0xe5, 0xd1, 0xaf,
+  0xb5, 0x0f, 0x71, 0x87, 0x5a, 0x99, 0x13, 0xa7, 0xf5, 0xac, 0xdd, 0xdd, 0xdd, 0x7a, 0x96, 0xb2, 0x8c, 0x03, 0x0e, 0xcf,
+  0x05, 0xc4, 0x3e, 0x05, 0x43, 0x0a, 0xba, 0x2b, 0x99, 0xd6, 0xfe, 0xa4, 0xcb, 0x75, 0x99, 0x2e, 0xff, 0xbf, 0x32, 0x5d,
+  0x72, 0x99, 0xa4, 0x57, 0xd7, 0x10, 0x8a, 0x92, 0xe5, 0x6d, 0xab, 0xa8, 0xb6, 0xe8, 0x86, 0x70, 0x39, 0x3e, 0x7a, 0x7f,
+  0xf1, 0xee, 0xf3, 0xd1, 0xd5, 0xc5, 0xc7, 0x0f, 0x0d, 0x77, 0x96, 0x6c, 0xba, 0xe2, 0x4e, 0x68, 0xb7, 0xba, 0x0b, 0x0e,
+  0xb9, 0x35, 0x6f, 0x2d, 0x8e, 0x3d, 0x61, 0x21, 0x04, 0xe2, 0x7a, 0xa1, 0x59, 0x2f, 0x37, 0x4d, 0xb9, 0x54, 0x5e, 0x55,
+  0x10, 0x88, 0x62, 0xaf, 0x4d, 0xbf, 0x4a, 0x84, 0x5a, 0xbd, 0x85, 0x0e, 0xd0, 0x2f, 0xf6, 0xe4, 0x57, 0xc3, 0x9f, 0x43,
+  0xef, 0x96, 0x10, 0xf4, 0x6d, 0x0b, 0x60, 0x81, 0x33, 0x5c, 0xc1, 0xfe, 0x94, 0x67, 0xe3, 0x2d, 0x91, 0x3d, 0x9a, 0x03,
+  0x30, 0xdf, 0xa0, 0xd4, 0x87, 0x38, 0x28, 0xa3, 0x06, 0x34, 0xc2, 0x80, 0x49, 0x3a, 0x3f, 0x75, 0x56, 0xe1, 0xdb, 0x8c,
+  0x9d, 0xdd, 0xb3, 0x3c, 0xa1, 0xb8, 0xf1, 0xbf, 0xc2, 0xb0, 0x9a, 0x28, 0x2d, 0xac, 0x8a, 0xa8, 0x35, 0x47, 0xa5, 0xc6,
+  0xa9, 0x24, 0xc2, 0xc5, 0x2f, 0x50, 0xa5, 0x30, 0x61, 0x8f, 0x8b, 0x50, 0x63, 0x49, 0xc1, 0x38, 0xe1, 0x86, 0xe9, 0x07,
+  0x35, 0x81, 0x02, 0x21, 0x56, 0xe2, 0xd6, 0x96, 0xcd, 0x4a, 0x59, 0x56, 0xc8, 0xc1, 0x21, 0xf9, 0xb6, 0x99, 0x47, 0x0a,
+  0xc7, 0x33, 0xe4, 0x03, 0x4f, 0x3d, 0xcc, 0x74, 0x34, 0xa5, 0x76, 0xdb, 0x53, 0xe3, 0x40, 0x4d, 0x32, 0x1a, 0x1c, 0x67,
+  0x69, 0x18, 0x8f, 0x65, 0xd8, 0x7d, 0x68, 0x6d, 0x84, 0x8d, 0x4a, 0xc7, 0x85, 0x6e, 0x44, 0x60, 0x61, 0x48, 0xa8, 0x66,
+  0x78, 0x3c, 0x23, 0x91, 0x0a, 0xc7, 0x7d, 0xf8, 0x15, 0xfa, 0xf1, 0x54, 0xd2, 0xf9, 0x79, 0xa4, 0x55, 0x26, 0xde, 0x88,
+  0x53, 0xfe, 0xdd, 0x0a, 0x52, 0xfe, 0x3d, 0x24, 0x2f, 0x13, 0x46, 0xd9, 0x84, 0x5d, 0xa4, 0x65, 0x2b, 0x75, 0x35, 0x26,
+  0x58, 0xbf, 0x0c, 0x83, 0x5b, 0xed, 0x69, 0x0a, 0x28, 0x7e, 0xc4, 0xfc, 0x3b, 0xc8, 0x6a, 0x9a, 0x38, 0xc1, 0x69, 0x3a,
+  0x7c, 0x9d, 0x7c, 0x93, 0x14, 0xc1, 0x42, 0x84, 0x17, 0xc9, 0x4f, 0x66, 0x79, 0x3b, 0x39, 0x0c, 0x54, 0x87, 0xc0, 0x46,
+  0xfa, 0xe9, 0x43, 0x3e, 0xa2, 0xf7, 0x1b, 0xa4, 0x17, 0x83, 0xaf, 0x48, 0x50, 0x4c, 0x83, 0x56, 0xee, 0xd0, 0xff, 0x3a,
+  0xe5, 0xef, 0xb0, 0x66, 0x56, 0x57, 0xef, 0x3f, 0x02, 0x80, 0x4d, 0xb2, 0x9d, 0x37, 0x0c, 0x6c, 0x41, 0xfb, 0x22, 0xf7,
+  0xd7, 0x21, 0x52, 0xcc, 0x8b, 0x37, 0xba, 0x3e, 0x7d, 0xd5, 0xf5, 0x29, 0xec, 0x50, 0x79, 0xbb, 0xe7, 0xc5, 0xd0, 0x6b,
+  0xf4, 0xa7, 0x69, 0xbb, 0xe9, 0x71, 0x60, 0x9b, 0xd0, 0x4d, 0x58, 0x30, 0xfa, 0xca, 0x5a, 0x14, 0xa8, 0x06, 0x86, 0x5b,
+  0x90, 0x7b, 0xcf, 0x62, 0xaf, 0xea, 0x7e, 0x9d, 0xf8, 0x78, 0x13, 0xef, 0xe3, 0xad, 0x78, 0x1f, 0xb7, 0xf3, 0x3e, 0xde,
+  0x92, 0x77, 0xf8, 0xd8, 0x4a, 0x1c, 0x3e, 0xbe, 0x4e, 0x7c, 0xbd, 0x49, 0xf0, 0xeb, 0xad, 0x04, 0xbf, 0x6e, 0x17, 0xfc,
+  0x7a, 0x2b, 0xc1, 0xaf, 0xdb, 0x05, 0xbf, 0xde, 0x4a, 0xf0, 0xa3, 0x4d, 0x82, 0x1f, 0x6d, 0x25, 0xf8, 0x51, 0xbb, 0xe0,
+  0x47, 0x5b, 0x09, 0x7e, 0xd4, 0x2e, 0xf8, 0xd1, 0xeb, 0x82, 0xf3, 0x1d, 0x1e, 0xe7, 0xc3, 0x89, 0xa5, 0xe2, 0x31, 0xc3,
+  0x45, 0x2f, 0xf3, 0x19, 0x1b, 0xae, 0x9c, 0x40, 0xd5, 0x5d, 0xf1, 0x94, 0xdf, 0x28, 0x65, 0x71, 0x00, 0xe1, 0x09, 0x0c,
+  0x97, 0xc5, 0x03, 0x92, 0xb2, 0x07, 0xc2, 0x47, 0x46, 0xd9, 0x2c, 0xf7, 0x99, 0x2c, 0x55, 0x37, 0x4f, 0x71, 0xdc, 0xb2,
+  0x42, 0xa5, 0x41, 0xc0, 0xc7, 0xdf, 0xc7, 0x90, 0xdb, 0xc0, 0x8e, 0x20, 0x4b, 0x78, 0x1b, 0x95, 0x7a, 0x84, 0xf1, 0xb3,
+  0x51, 0x5c, 0xbd, 0xc5, 0x4d, 0xf2, 0x5f, 0xa3, 0x8f, 0x1f, 0xd4, 0x29, 0xcd, 0x0b, 0x26, 0xf3, 0x54, 0x9b, 0x2a, 0xf5,
+  0xa5, 0xba, 0x71, 0xa7, 0xc4, 0xb9, 0xca, 0xa2, 0x28, 0xf0, 0xc3, 0x3f, 0xd1, 0x4e, 0x69, 0x1e, 0xa6, 0x0b, 0x9c, 0xa7,
+  0x5a, 0xd2, 0x2c, 0xad, 0x2e, 0xc1, 0x20, 0x4a, 0x53, 0x38, 0x2c, 0x53, 0xbc, 0x20, 0xdd, 0x47, 0xef, 0x4f, 0xb0, 0x8e,
+  0x0a, 0x99, 0x6c, 0x3c, 0x4e, 0x39, 0x6c, 0x0f, 0x72, 0x95, 0x16, 0xc9, 0x45, 0xe7, 0x13, 0x7e, 0x40, 0xc6, 0xd9, 0x30,
+  0x1a, 0x4c, 0xab, 0x6c, 0x5c, 0xe0, 0xdd, 0x3c, 0xc6, 0xaf, 0x87, 0x94, 0xd0, 0x34, 0x20, 0xa0, 0x55, 0x41, 0x28, 0x09,
+  0x73, 0x56, 0x44, 0xeb, 0xf7, 0xf8, 0x15, 0x27, 0xe5, 0xb3, 0xf4, 0x18, 0xd3, 0x9d, 0x9c, 0x62, 0x53, 0x2e, 0xe7, 0x53,
+  0xd6, 0xac, 0xb3, 0x4c, 0x0a, 0xbc, 0x41, 0xf3, 0x6e, 0x91, 0xac, 0x4c, 0xb2, 0x32, 0xcb, 0xc1, 0x4b, 0x90, 0x11, 0x2c,
+  0x92, 0xfb, 0xce, 0x19, 0xe0, 0x93, 0x06, 0xcc, 0x3e, 0xf9, 0x23, 0x86, 0x1e, 0x10, 0xaf, 0xea, 0x63, 0x44, 0xa4, 0xd6,
+  0x05, 0x39, 0xfa, 0x70, 0x02, 0x81, 0x31, 0x4b, 0x01, 0x1a, 0x91, 0x08, 0x26, 0xae, 0x85, 0x4a, 0xc0, 0xb8, 0x65, 0x9c,
+  0xce, 0xd8, 0x5b, 0x48, 0x32, 0x96, 0xb8, 0x23, 0x4e, 0xf4, 0x0a, 0x32, 0x26, 0xf8, 0x49, 0x9c, 0x32, 0xae, 0x37, 0x26,
+  0x0a, 0xa4, 0xcc, 0x88, 0xa6, 0xed, 0x6b, 0x5a, 0x13, 0x76, 0xb8, 0x40, 0x5d, 0x84, 0x00, 0xee, 0xcd, 0x71, 0x3e, 0x91,
+  0x41, 0x47, 0xa5, 0x2e, 0x0d, 0x6d, 0xb3, 0x4d, 0xaf, 0xa5, 0x87, 0x2f, 0x66, 0x80, 0x21, 0x2b, 0xfd, 0x08, 0x82, 0x7b,
+  0x21, 0xee, 0x57, 0xcc, 0xdd, 0xd1, 0x9c, 0x3d, 0xc8, 0xef, 0x26, 0xac, 0x8c, 0xb2, 0x00, 0xf2, 0xf9, 0x4f, 0x1f, 0x47,
+  0x57, 0x52, 0x15, 0x51, 0xdc, 0xcb, 0x98, 0xd1, 0x82, 0xef, 0xc0, 0x87, 0x79, 0x0e, 0x91, 0x51, 0xf0, 0x54, 0xb0, 0xae,
+  0xce, 0x54, 0x05, 0x9c, 0xd1, 0xf9, 0xd1, 0xae, 0x61, 0xd9, 0x24, 0x0b, 0x79, 0xb9, 0x25, 0x9e, 0x40, 0x08, 0xf6, 0xd0,
+  0xd0, 0x25, 0x79, 0x88, 0x21, 0x3f, 0x8e, 0xcb, 0x7d, 0x3e, 0xe0, 0x27, 0x99, 0x7f, 0x27, 0xca, 0x32, 0x5e, 0x96, 0x61,
+  0x5c, 0xa4, 0x62, 0x32, 0x2f, 0xcd, 0x20, 0x92, 0x60, 0x12, 0x40, 0xb6, 0x5c, 0xc2, 0x8d, 0x4a, 0x25, 0x7e, 0x3e, 0x9f,
+  0x96, 0x99, 0x5a, 0xcc, 0xbc, 0x32, 0x61, 0xb0, 0x54, 0x59, 0x50, 0x90, 0xa8, 0x2c, 0xa7, 0x05, 0xc0, 0x67, 0x04, 0xd4,
+  0x84, 0xb4, 0x1a, 0xdb, 0x64, 0x56, 0x80, 0x68, 0x45, 0x44, 0x41, 0x0c, 0x58, 0xe0, 0x1e, 0x4b, 0xb2, 0x07, 0x75, 0x19,
+  0x5b, 0xd5, 0x80, 0x37, 0x0b, 0xeb, 0x90, 0x02, 0x93, 0x17, 0x25, 0xf9, 0x0d, 0x8c, 0x74, 0xa3, 0x3d, 0x9a, 0x86, 0x4b,
+  0x8d, 0x70, 0xe0, 0xf6, 0xb4, 0x47, 0x47, 0xef, 0x3b, 0xa6, 0x39, 0xd0, 0xe1, 0xd1, 0xb3, 0x7c, 0x2d, 0xf4, 0xfc, 0x10,
+  0x1e, 0xd9, 0xc0, 0xb3, 0x02, 0x8f, 0x5a, 0xf0, 0xd8, 0x1f, 0x58, 0xb6, 0x6f, 0x58, 0x1e, 0x3c, 0x5a, 0x83, 0x50, 0xd7,
+  0xf5, 0x10, 0xe7, 0x0e, 0x8c, 0x7e, 0xe8, 0x1a, 0xd4, 0x84, 0x47, 0xea, 0xe9, 0xbe, 0xc5, 0x02, 0xab, 0xb7, 0xf0, 0xb3,
+  0xf6, 0x18, 0xb8, 0x9a, 0x43, 0x29, 0x67, 0xa0, 0x1b, 0x6e, 0xdf, 0xf2, 0x34, 0x24, 0x32, 0xcc, 0xbe, 0xee, 0x5a, 0x1e,
+  0x43, 0x28, 0x4b, 0xf3, 0x9d, 0xc0, 0xef, 0xa3, 0x04, 0x86, 0xc7, 0xac, 0xc0, 0x41, 0x28, 0x57, 0x0b, 0x98, 0xa7, 0x87,
+  0x38, 0x61, 0xe0, 0x05, 0xbe, 0x66, 0x53, 0x07, 0x1e, 0x7d, 0x7d, 0xe0, 0x85, 0x3a, 0x4c, 0x68, 0x30, 0x60, 0xe6, 0xc0,
+  0xb3, 0x07, 0x3e, 0xa2, 0xb2, 0xd0, 0x63, 0xa6, 0xe3, 0xda, 0xf0, 0xa8, 0x85, 0x30, 0x37, 0xf0, 0x6d, 0xce, 0x4b, 0xf3,
+  0xa9, 0xee, 0xfb, 0xf8, 0x18, 0xb0, 0x81, 0xe1, 0xdb, 0xa8, 0x97, 0x49, 0x1d, 0xd3, 0x35, 0x29, 0x45, 0x09, 0x7c, 0x4f,
+  0xa3, 0x30, 0x19, 0x25, 0xb0, 0xc1, 0x16, 0x6e, 0x40, 0x9b, 0x0c, 0x06, 0x6e, 0x9f, 0x59, 0xba, 0x65, 0xa0, 0x82, 0x6e,
+  0x5f, 0xf7, 0x6d, 0x3b, 0x40, 0x13, 0x69, 0x5a, 0xdf, 0x70, 0x7c, 0xd4, 0xcb, 0x0b, 0xad, 0x81, 0x13, 0xfa, 0x5c, 0x40,
+  0x9b, 0x69, 0x9a, 0x17, 0xa2, 0x32, 0x81, 0x45, 0x9d, 0x81, 0x6e, 0x62, 0xaf, 0x66, 0xfb, 0xd4, 0xee, 0x5b, 0x28, 0xa2,
+  0x6e, 0x1a, 0x03, 0x63, 0x60, 0x3b, 0x4d, 0x06, 0x86, 0xe3, 0x39, 0x1a, 0x75, 0xd1, 0xc4, 0x06, 0xd3, 0x3d, 0x43, 0xef,
+  0x23, 0xaa, 0x19, 0x80, 0xa4, 0x41, 0x88, 0x52, 0x59, 0xfd, 0x3e, 0xd8, 0x43, 0x47, 0x54, 0xdb, 0xd2, 0xa8, 0xd3, 0xb7,
+  0x4c, 0x2e, 0xab, 0x4d, 0x35, 0xea, 0xa1, 0x3b, 0x5c, 0xdd, 0x37, 0xfc, 0x81, 0xc1, 0xad, 0x65, 0x38, 0x86, 0xe1, 0xbb,
+  0x2b, 0x3e, 0xa0, 0x86, 0x17, 0x32, 0x97, 0xea, 0x5c, 0x03, 0x9d, 0xda, 0xb6, 0x89, 0x44, 0xbe, 0x61, 0x7a, 0x2e, 0x70,
+  0xc6, 0x47, 0xc7, 0xf6, 0x2d, 0x9d, 0x72, 0xb1, 0x75, 0xc0, 0x71, 0xf5, 0x01, 0x3e, 0xda, 0x83, 0x81, 0x66, 0x1b, 0xc8,
+  0x2b, 0x34, 0x35, 0xd6, 0xb7, 0xb8, 0x88, 0x3a, 0xf8, 0x82, 0x6a, 0x40, 0xd6, 0x60, 0xa0, 0x0f, 0xa8, 0xe9, 0xeb, 0x3a,
+  0x5a, 0x5b, 0x67, 0x7d, 0x00, 0xd3, 0x50, 0x03, 0x03, 0x2c, 0xec, 0x38, 0x26, 0x6a, 0xd0, 0x37, 0x3d, 0xcd, 0xf3, 0x3d,
+  0x11, 0x45, 0xba, 0xaf, 0xf9, 0x1e, 0xf2, 0x32, 0x59, 0xe0, 0x52, 0x6a, 0x72, 0x1f, 0x78, 0x03, 0xdf, 0xa7, 0x26, 0x7a,
+  0xc6, 0x76, 0x0d, 0x66, 0x87, 0x60, 0xc3, 0x06, 0x03, 0x40, 0x82, 0x20, 0x63, 0xa8, 0xa0, 0xe3, 0x52, 0xcb, 0xee, 0x73,
+  0x1f, 0xba, 0xa6, 0xef, 0x3a, 0xae, 0xce, 0xe3, 0xc5, 0xf7, 0x1d, 0xcd, 0xe0, 0x6c, 0x07, 0x9a, 0xc7, 0xc2, 0x30, 0x44,
+  0x54, 0x6a, 0x5a, 0x60, 0x7b, 0x86, 0xda, 0x42, 0xdf, 0x80, 0xf6, 0x43, 0xe1, 0x24, 0x47, 0x77, 0xdc, 0xd0, 0xb8, 0x5d,
+  0xd6, 0x8e, 0x53, 0x58, 0x0d, 0xb0, 0x44, 0x54, 0x6f, 0x5e, 0xb2, 0xf7, 0x2c, 0x1d, 0x97, 0x51, 0x8f, 0x4c, 0xe1, 0xf4,
+  0xe3, 0xa7, 0x2a, 0x1e, 0x93, 0x5f, 0x60, 0x59, 0xba, 0x47, 0x79, 0x4e, 0xe7, 0xb2, 0x2c, 0xa7, 0xb0, 0x7d, 0x0c, 0xe0,
+  0xdf, 0xee, 0x2b, 0xe4, 0xf0, 0x90, 0xd8, 0x0a, 0x79, 0xf3, 0x06, 0x3e, 0x05, 0x9c, 0x20, 0x53, 0xe1, 0xe4, 0x92, 0xd7,
+  0x08, 0x71, 0x0d, 0xae, 0x4c, 0xba, 0x49, 0x6f, 0x01, 0x1e, 0x83, 0x7d, 0x29, 0xc9, 0x7d, 0x0c, 0x44, 0x82, 0xe7, 0x09,
+  0x9c, 0x53, 0xbf, 0x43, 0x53, 0xae, 0x20, 0x81, 0x3e, 0x64, 0x79, 0x85, 0x80, 0xf3, 0x90, 0x09, 0xe2, 0xf7, 0x8d, 0x7a,
+  0x4a, 0xc2, 0x65, 0x27, 0xbb, 0xc4, 0xed, 0x91, 0x4b, 0x5a, 0x46, 0x6a, 0x98, 0x64, 0x59, 0x0e, 0x02, 0xef, 0x61, 0x9c,
+  0x69, 0xe2, 0x4f, 0xd9, 0x0e, 0xc2, 0xec, 0x11, 0x20, 0xfc, 0x85, 0xb8, 0xa8, 0xe4, 0x21, 0xa9, 0x6f, 0xb8, 0x28, 0x64,
+  0x24, 0x36, 0x0f, 0x88, 0xbf, 0x01, 0xb3, 0x6d, 0xb4, 0xa9, 0xe7, 0xd9, 0x0e, 0x65, 0x3c, 0x40, 0xfa, 0xb0, 0x08, 0xc2,
+  0xbe, 0xc3, 0xd7, 0x8b, 0x65, 0x86, 0xa1, 0xd5, 0xe7, 0x0e, 0xd6, 0x35, 0x66, 0x19, 0x4e, 0xc8, 0x17, 0xb4, 0x66, 0xd9,
+  0xae, 0x8b, 0x71, 0xa1, 0x87, 0x6e, 0x3f, 0x18, 0x50, 0xbe, 0xa5, 0x78, 0x4c, 0xf3, 0x21, 0xfa, 0x1a, 0x5e, 0x79, 0x68,
+  0x18, 0xbf, 0x6f, 0x08, 0x23, 0xda, 0xa6, 0xd2, 0x23, 0xb9, 0xa8, 0xe6, 0x3e, 0xf6, 0xc8, 0x1d, 0xbf, 0xa5, 0xcb, 0x8f,
+  0x5c, 0x44, 0x68, 0x7c, 0xc7, 0x67, 0xf0, 0x86, 0xdc, 0x37, 0x40, 0x85, 0xbb, 0x5a, 0xd5, 0x10, 0x08, 0x64, 0x5e, 0x79,
+  0xe0, 0xaf, 0x2c, 0xb4, 0x21, 0x7f, 0x78, 0x43, 0x56, 0x74, 0x16, 0x9d, 0xdd, 0x03, 0x02, 0x3c, 0x16, 0xe5, 0x8a, 0x06,
+  0x6d, 0x2c, 0x28, 0x63, 0xa0, 0xd3, 0x6d, 0xf8, 0xee, 0x76, 0x15, 0xf2, 0x70, 0x13, 0xa3, 0x0f, 0xb9, 0x29, 0xc7, 0x0b,
+  0x53, 0x72, 0x1c, 0x62, 0x82, 0xf1, 0x62, 0x65, 0xd8, 0x0e, 0xc4, 0x11, 0x00, 0xc9, 0x36, 0x2b, 0xa4, 0x6f, 0x2b, 0x75,
+  0x3a, 0x5e, 0x41, 0xd4, 0x60, 0x1e, 0xa8, 0x2a, 0x03, 0x93, 0x5d, 0xdd, 0xba, 0xed, 0x11, 0x47, 0x21, 0xff, 0x5e, 0xed,
+  0xd1, 0x5d, 0xec, 0xaa, 0xdb, 0xdc, 0x0a, 0xfd, 0x06, 0xcb, 0x05, 0x94, 0xde, 0x80, 0x32, 0x90, 0x6e, 0x05, 0x8a, 0xf7,
+  0x0c, 0x16, 0x48, 0x86, 0x00, 0xd2, 0xb5, 0x35, 0xa4, 0x4a, 0x59, 0xce, 0xcc, 0xbe, 0xc5, 0xc2, 0xb3, 0x06, 0x1f, 0xd8,
+  0x74, 0x78, 0x4b, 0x5f, 0x4e, 0x7f, 0xda, 0x69, 0xb2, 0xbf, 0xa1, 0x3d, 0xe2, 0xf5, 0x88, 0x0f, 0xc9, 0x15, 0xe4, 0x8e,
+  0x3d, 0x12, 0xf6, 0xc8, 0xb8, 0x47, 0xa2, 0x08, 0xd1, 0xa2, 0xe1, 0x8b, 0x96, 0x7e, 0xc1, 0x3e, 0x25, 0x2a, 0x25, 0x47,
+  0x58, 0x60, 0x96, 0x51, 0x13, 0x00, 0xb6, 0x6b, 0xad, 0xe0, 0x59, 0xd7, 0x1b, 0x0d, 0xc3, 0x52, 0xb0, 0x78, 0x27, 0xcb,
+  0x8c, 0xfc, 0x4c, 0x42, 0xae, 0xe9, 0x7f, 0xf0, 0x71, 0xcc, 0xbb, 0x7f, 0x43, 0xc5, 0xb8, 0x26, 0xb7, 0x18, 0x42, 0xda,
+  0x73, 0x03, 0x96, 0x06, 0x7f, 0xd3, 0x85, 0x68, 0xa0, 0x8b, 0x51, 0x23, 0xc3, 0xb3, 0xde, 0x6f, 0x34, 0x0c, 0xa3, 0x62,
+  0x43, 0x01, 0xdb, 0xe3, 0x6c, 0xf0, 0xc9, 0xe7, 0x4f, 0x1e, 0x7f, 0x52, 0x5a, 0x38, 0x44, 0xb8, 0xa0, 0xc6, 0x43, 0x82,
+  0x79, 0x5e, 0x38, 0x24, 0x18, 0xa2, 0x6c, 0x88, 0x79, 0x2c, 0x91, 0xf1, 0x2d, 0x41, 0xa9, 0x0b, 0x1a, 0x9e, 0xca, 0xfa,
+  0x43, 0xe2, 0xe3, 0x6e, 0x35, 0x24, 0x1e, 0x7c, 0xd1, 0x21, 0x64, 0x98, 0x98, 0x1c, 0xea, 0x38, 0xcf, 0x58, 0xc3, 0x5e,
+  0x7a, 0x81, 0xaf, 0xd8, 0xe8, 0x46, 0xbb, 0xed, 0x82, 0x94, 0xd1, 0x8d, 0x7e, 0xdb, 0xf5, 0xf0, 0xdb, 0xb8, 0xed, 0xfa,
+  0xf8, 0xdd, 0xbf, 0xed, 0x06, 0xf8, 0x6d, 0xde, 0x76, 0x19, 0x7e, 0x5b, 0xb7, 0xdd, 0x10, 0xbf, 0xed, 0xdb, 0x2e, 0x3a,
+  0xea, 0xc6, 0xb9, 0xed, 0x82, 0xb7, 0xd4, 0x09, 0x9d, 0xc2, 0xf2, 0x82, 0x05, 0xf7, 0x88, 0x7c, 0x94, 0x66, 0xa5, 0xb2,
+  0x7a, 0x79, 0x16, 0x2d, 0xe7, 0x54, 0x8b, 0x52, 0x53, 0xd4, 0x32, 0x1b, 0x95, 0x79, 0x9c, 0x8e, 0x65, 0xdd, 0x56, 0x20,
+  0x0b, 0x0f, 0xf8, 0x45, 0x5e, 0x86, 0x2d, 0x4a, 0xd2, 0x24, 0x45, 0x51, 0xff, 0xcc, 0xe2, 0x54, 0x96, 0xf0, 0xd2, 0x21,
+  0x72, 0x2a, 0xb5, 0x08, 0x67, 0x24, 0x8c, 0x13, 0x48, 0x6b, 0xe4, 0x32, 0xcb, 0x92, 0x62, 0x2f, 0x2b, 0xe9, 0xd7, 0x29,
+  0xf5, 0xef, 0xd4, 0xe9, 0x5c, 0x81, 0x44, 0x09, 0xd2, 0xa9, 0x6c, 0x32, 0xc5, 0xd4, 0x0c, 0xf6, 0x67, 0x88, 0x19, 0x4a,
+  0x02, 0x96, 0x94, 0x54, 0x64, 0x5a, 0x41, 0x3c, 0x66, 0x05, 0x2e, 0x74, 0x84, 0x5a, 0xe4, 0x64, 0xf8, 0x34, 0x27, 0x13,
+  0x7a, 0x07, 0xed, 0x02, 0x2b, 0x92, 0xd0, 0x8e, 0x73, 0x12, 0x31, 0xb8, 0x5b, 0xe4, 0x3b, 0xb4, 0x98, 0xa7, 0x3e, 0x59,
+  0xe4, 0x4c, 0x9c, 0xe2, 0x84, 0xe3, 0xc8, 0x28, 0x47, 0x33, 0x19, 0x87, 0x4d, 0x18, 0xcd, 0xfe, 0x40, 0xe3, 0x92, 0xcb,
+  0xa8, 0x52, 0xdc, 0x96, 0xde, 0xf1, 0xad, 0x59, 0x6e, 0x6e, 0x91, 0x80, 0xfc, 0xfc, 0xec, 0x00, 0xea, 0x1e, 0xd1, 0xaa,
+  0xbd, 0x79, 0x02, 0x6a, 0xaf, 0x1f, 0x3a, 0xa6, 0xa9, 0x28, 0xcb, 0xfa, 0x29, 0x82, 0xd4, 0x1b, 0x32, 0x24, 0xfe, 0xa6,
+  0x49, 0x7e, 0xfe, 0x99, 0x08, 0x5b, 0xaa, 0x61, 0x9e, 0x4d, 0x8e, 0x23, 0x9a, 0x1f, 0x67, 0x01, 0x93, 0x55, 0x55, 0xe5,
+  0x73, 0x8b, 0x24, 0x86, 0x7b, 0x1c, 0x30, 0x00, 0x18, 0xa4, 0xe8, 0x8c, 0xce, 0xbe, 0xe8, 0x9d, 0xe6, 0xe2, 0xa9, 0xfc,
+  0xc4, 0xc5, 0xe1, 0x18, 0x72, 0x83, 0x50, 0x37, 0xb8, 0x04, 0x3d, 0x22, 0x9c, 0xbc, 0xc1, 0x71, 0xc6, 0x73, 0xc7, 0xad,
+  0x56, 0xac, 0x1f, 0xe2, 0x34, 0x80, 0x24, 0x54, 0x64, 0xb0, 0x28, 0xf2, 0x4a, 0x2e, 0xdb, 0x94, 0xa6, 0xbe, 0x9f, 0xad,
+  0x99, 0x49, 0x98, 0x77, 0x85, 0x4a, 0x15, 0x7e, 0x95, 0xa5, 0x2a, 0xe3, 0x86, 0x4b, 0x68, 0xe3, 0x3c, 0x6d, 0xd7, 0x2c,
+  0xf8, 0x5f, 0x14, 0xa9, 0xe0, 0x1a, 0xf9, 0x33, 0x8f, 0xcf, 0xb5, 0x50, 0x99, 0x4d, 0xf1, 0x5a, 0x7a, 0x06, 0x57, 0x98,
+  0x07, 0x88, 0x4b, 0x39, 0x4e, 0xa7, 0xb3, 0xb2, 0x19, 0x2e, 0x18, 0x22, 0xa0, 0x1f, 0xef, 0x57, 0x79, 0x4c, 0xc3, 0x1a,
+  0x5c, 0xde, 0x80, 0x45, 0x74, 0x35, 0xaf, 0x3d, 0x7c, 0xb7, 0xe6, 0x77, 0xce, 0x97, 0xaa, 0xe3, 0xb3, 0x69, 0x50, 0xbd,
+  0x12, 0xa8, 0x64, 0x16, 0x24, 0x2b, 0x75, 0xbb, 0xce, 0x31, 0x96, 0x34, 0xf0, 0x6d, 0x70, 0x07, 0xf6, 0x06, 0x1e, 0xab,
+  0x29, 0x85, 0x9b, 0x59, 0x97, 0x74, 0x20, 0x5c, 0x3a, 0xc3, 0xc6, 0x7b, 0x7c, 0xbe, 0x62, 0xea, 0xa8, 0x7e, 0x16, 0xfd,
+  0xcb, 0x99, 0xb0, 0x41, 0x4f, 0x30, 0x2b, 0xa9, 0x3c, 0x76, 0x56, 0x35, 0xe5, 0xe5, 0x29, 0xcb, 0xdb, 0x2a, 0x9d, 0x4e,
+  0xe1, 0xf2, 0x2c, 0x77, 0x40, 0x4c, 0xb8, 0x6e, 0x75, 0x7a, 0xa4, 0x81, 0xb3, 0xb9, 0xec, 0x0a, 0xd7, 0xad, 0xdd, 0x87,
+  0x9c, 0x4e, 0xdb, 0xae, 0x73, 0x1e, 0xde, 0x9f, 0xa4, 0xcd, 0xba, 0x7e, 0xe1, 0x7e, 0xd8, 0x42, 0xd9, 0xc7, 0x28, 0xaf,
+  0xa4, 0xbf, 0xbe, 0x7c, 0x7f, 0x0e, 0xf7, 0xa7, 0xcf, 0xec, 0xaf, 0x19, 0xaa, 0x5a, 0x89, 0x07, 0xe3, 0x6a, 0x06, 0xd2,
+  0xcb, 0x1d, 0xbc, 0x0f, 0x82, 0xe8, 0x9d, 0x3d, 0xa1, 0xc5, 0x5b, 0x11, 0x09, 0x07, 0x1d, 0xfe, 0x6a, 0x1f, 0xad, 0xd3,
+  0xa0, 0x10, 0x61, 0xf0, 0xbc, 0x5e, 0xd2, 0x99, 0x56, 0x77, 0x48, 0xb4, 0x41, 0x15, 0x33, 0x32, 0xbb, 0x2f, 0x9b, 0x6b,
+  0x00, 0x57, 0x0c, 0x74, 0x55, 0xeb, 0xfc, 0x18, 0x76, 0xb6, 0x59, 0x49, 0xbd, 0xd5, 0x75, 0x52, 0x4b, 0x3f, 0x65, 0xb9,
+  0x0f, 0xf8, 0x38, 0x09, 0x9a, 0xfc, 0x80, 0xe0, 0xa4, 0xa2, 0x00, 0xb4, 0x47, 0xb0, 0x51, 0xc2, 0x6e, 0x99, 0xac, 0xfc,
+  0x00, 0xa3, 0xfe, 0x7b, 0xd9, 0xf4, 0x6d, 0x2f, 0x77, 0xd6, 0xf9, 0xe1, 0x6f, 0x18, 0xa4, 0xf5, 0xf3, 0xe5, 0x09, 0x74,
+  0xa3, 0x49, 0xc1, 0x9a, 0x16, 0x4c, 0x51, 0x24, 0x3c, 0xcd, 0x6a, 0xa5, 0xd7, 0x35, 0xc6, 0x59, 0x75, 0x9c, 0x1f, 0x10,
+  0x48, 0x4d, 0x71, 0x9f, 0xc0, 0x4e, 0xb0, 0xd6, 0x14, 0x6e, 0xa8, 0x4c, 0x78, 0x16, 0x5c, 0xfb, 0xf1, 0xb7, 0xce, 0xba,
+  0x29, 0x5a, 0x43, 0x60, 0x34, 0xf3, 0x7d, 0xb0, 0xf4, 0x0f, 0xe4, 0x33, 0xc3, 0x2b, 0x36, 0xee, 0x91, 0x0b, 0xcf, 0x2f,
+  0x09, 0xd7, 0x5f, 0xf0, 0x40, 0x5c, 0xf1, 0xa2, 0x06, 0xf0, 0x45, 0x91, 0x65, 0xd8, 0xfc, 0xac, 0xe5, 0xeb, 0x1c, 0xae,
+  0x9e, 0x78, 0x81, 0xb4, 0x85, 0x04, 0x67, 0x14, 0xe2, 0x2e, 0x20, 0x32, 0x86, 0x48, 0x43, 0x3f, 0x88, 0x41, 0x65, 0x9f,
+  0xd4, 0x9d, 0x4d, 0xfd, 0x9e, 0x59, 0xb2, 0x69, 0x41, 0x96, 0x8b, 0x34, 0xb7, 0x69, 0xc2, 0x17, 0xd8, 0xee, 0xd7, 0xb5,
+  0x3e, 0xf1, 0xe2, 0x09, 0x16, 0x74, 0x30, 0xc3, 0x2d, 0x8f, 0x9f, 0x81, 0x22, 0x3e, 0x3b, 0xc3, 0x9a, 0x83, 0xd8, 0x8f,
+  0xea, 0xba, 0x63, 0xa7, 0xb3, 0xe4, 0x5b, 0xe0, 0xc2, 0xad, 0x17, 0xb2, 0xb2, 0x5a, 0x4c, 0x04, 0xe3, 0x5d, 0xd2, 0x74,
+  0x46, 0x93, 0x46, 0x21, 0x31, 0x7a, 0x69, 0x9b, 0x9a, 0xf0, 0xd9, 0xe7, 0x75, 0x89, 0x73, 0x58, 0xd1, 0x4c, 0x5e, 0xa7,
+  0xb9, 0x6c, 0xd2, 0xd4, 0x05, 0x1c, 0x31, 0xf4, 0x36, 0x3a, 0xc0, 0xfa, 0x0d, 0xff, 0x5d, 0xc1, 0xcf, 0x13, 0xfe, 0x3c,
+  0xd9, 0x50, 0xc8, 0x79, 0x6a, 0xfe, 0xb6, 0xa5, 0x00, 0x7e, 0x47, 0xb3, 0x32, 0xe3, 0x76, 0xac, 0x21, 0x45, 0xb7, 0xd4,
+  0x4e, 0x4f, 0xaa, 0x1f, 0xe9, 0x9c, 0x62, 0xb9, 0x2c, 0x2d, 0x73, 0x48, 0x45, 0x48, 0x89, 0x29, 0x04, 0xdc, 0x2f, 0xc1,
+  0xd0, 0x84, 0x16, 0x55, 0x5a, 0x91, 0xdd, 0xb3, 0x7d, 0xf2, 0xe9, 0xe8, 0xea, 0xf8, 0x9c, 0xec, 0xd1, 0x69, 0xbc, 0xc7,
+  0xab, 0x5a, 0x63, 0x51, 0x01, 0xaa, 0x7f, 0x8a, 0x83, 0x48, 0x2d, 0xbf, 0xc6, 0xe9, 0xf1, 0x5f, 0xf9, 0xe4, 0x62, 0x13,
+  0x22, 0xd0, 0x4f, 0x49, 0x09, 0x01, 0x8a, 0x79, 0x63, 0x90, 0xd3, 0x31, 0x96, 0x92, 0x80, 0x02, 0xcb, 0x8a, 0x09, 0x6c,
+  0x42, 0x30, 0x85, 0x5b, 0x05, 0xc1, 0xb2, 0xd4, 0xe7, 0x69, 0x0d, 0x81, 0x4c, 0xe8, 0x3e, 0xce, 0x66, 0x05, 0x47, 0x8a,
+  0xb1, 0xb4, 0x54, 0x3c, 0xb0, 0x9c, 0x05, 0x8a, 0x4a, 0x46, 0xf4, 0x9e, 0x91, 0x11, 0x2b, 0x71, 0x35, 0x14, 0x10, 0x3c,
+  0x58, 0xb7, 0x9b, 0x42, 0x6c, 0x14, 0xe2, 0xc7, 0x41, 0xe0, 0x66, 0x55, 0xfc, 0x1c, 0x88, 0x05, 0x9f, 0x28, 0x58, 0x84,
+  0xff, 0x24, 0xa8, 0xb7, 0x68, 0xbe, 0x9b, 0x15, 0xb8, 0xfb, 0xf2, 0xd5, 0x3d, 0x6c, 0xc6, 0x41, 0x1a, 0xbc, 0xaf, 0xa6,
+  0x2c, 0x16, 0x36, 0x7f, 0x33, 0xdb, 0xa4, 0xfb, 0xfe, 0x9d, 0xfc, 0x50, 0xd5, 0x57, 0xef, 0xd8, 0xbc, 0x58, 0x0c, 0x2a,
+  0xd5, 0x4e, 0xf7, 0xfc, 0xdc, 0xf3, 0xb2, 0x60, 0x5e, 0x17, 0x6b, 0x0b, 0x7e, 0x5e, 0xc7, 0xe1, 0x7c, 0x49, 0x57, 0x4f,
+  0x6c, 0x88, 0xba, 0xda, 0x55, 0x89, 0x2b, 0xaa, 0xe0, 0xcd, 0xca, 0xdf, 0xd2, 0x27, 0x6b, 0x9e, 0x46, 0x97, 0x41, 0x97,
+  0x48, 0x03, 0x8b, 0x7d, 0x18, 0x93, 0xb0, 0x5c, 0x09, 0xc1, 0xb8, 0x7b, 0x35, 0x9f, 0x32, 0x09, 0xe6, 0xc0, 0x59, 0x06,
+  0xb9, 0x11, 0xdf, 0x23, 0xf6, 0xfe, 0x2c, 0xb2, 0x54, 0xc2, 0xfd, 0x0e, 0x25, 0xdd, 0x17, 0xf2, 0x3e, 0x29, 0x8b, 0x45,
+  0xac, 0xfa, 0xdc, 0x22, 0xd5, 0x9b, 0xe3, 0xe6, 0x40, 0x18, 0xa7, 0x34, 0x49, 0xe6, 0x8b, 0x97, 0xca, 0xad, 0x06, 0x5e,
+  0xb3, 0xeb, 0x70, 0x3d, 0x84, 0xa7, 0xd8, 0x0f, 0xe3, 0x32, 0x0f, 0xa3, 0x9e, 0x88, 0x04, 0xa5, 0x81, 0x76, 0xc3, 0x07,
+  0xf8, 0x7d, 0x94, 0x2f, 0x9d, 0xe7, 0x80, 0x3b, 0x37, 0xd2, 0x08, 0xf4, 0x95, 0x8e, 0xf1, 0xe3, 0x1a, 0x3f, 0x8e, 0xa4,
+  0x5b, 0x15, 0xe2, 0xe0, 0x94, 0xc2, 0x8c, 0xbb, 0xd5, 0xc2, 0x39, 0x4b, 0x5f, 0x5a, 0xa7, 0xc0, 0x14, 0x97, 0xde, 0x1d,
+  0x2e, 0x43, 0xfe, 0x0a, 0x05, 0xac, 0x92, 0x6f, 0x4d, 0x80, 0x2f, 0x4d, 0x1a, 0x79, 0xc5, 0xe3, 0xd6, 0x84, 0xf8, 0xc2,
+  0x44, 0x10, 0xb2, 0xb4, 0xe5, 0xfd, 0x84, 0x58, 0x55, 0xa0, 0x98, 0xb0, 0xf4, 0xc2, 0x64, 0x30, 0x39, 0xc6, 0xbb, 0x67,
+  0x5a, 0xbf, 0xe8, 0xa9, 0x33, 0x47, 0x2f, 0x6f, 0x41, 0xe1, 0xdb, 0xe3, 0x73, 0x10, 0x98, 0x8b, 0x20, 0xfc, 0x3d, 0xc2,
+  0x45, 0x5a, 0x62, 0x5b, 0xf8, 0xa0, 0x99, 0xb3, 0x87, 0x8f, 0x0a, 0xe8, 0xf3, 0x0f, 0x44, 0x83, 0xc9, 0x2b, 0xa8, 0xd0,
+  0x5e, 0xa2, 0x62, 0x08, 0xec, 0xac, 0xbd, 0xc4, 0x19, 0xee, 0xfc, 0x17, 0x21, 0xda, 0x16, 0xd8, 0x9b, 0x29, 0x00, 0x00,
+};
+
+// index.html: 10447 bytes -> 2807 gzipped
+const uint8_t web_index_html[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x1a, 0x6b, 0x73, 0xdb, 0x36, 0xf2, 0x7b, 0x7f, 0x05,
+  0x8e, 0x9d, 0x3b, 0xcb, 0x33, 0x7a, 0xbf, 0xe2, 0xc8, 0x92, 0x3a, 0xb4, 0x2c, 0xd7, 0x6e, 0x2c, 0xdb, 0x63, 0x2a, 0x4d,
+  0xda, 0x2f, 0x1d, 0x88, 0x84, 0x44, 0xd4, 0x14, 0xc0, 0x01, 0x41, 0xcb, 0xca, 0xcd, 0xfd, 0xf7, 0x5b, 0x80, 0x0f, 0x93,
+  0x0a, 0x99, 0x48, 0x56, 0xaf, 0xa7, 0x0f, 0x36, 0x41, 0x02, 0xfb, 0xde, 0xc5, 0xee, 0x02, 0xc3, 0x7f, 0x5c, 0xde, 0x4f,
+  0xe6, 0xbf, 0x3d, 0x4c, 0x91, 0x2b, 0xd7, 0xde, 0xf8, 0x87, 0x61, 0xf2, 0x8f, 0x60, 0x67, 0xfc, 0x03, 0x42, 0x43, 0x49,
+  0xa5, 0x47, 0xc6, 0x96, 0xef, 0x51, 0x89, 0xae, 0x3c, 0xec, 0xa3, 0x89, 0xc7, 0xed, 0xa7, 0x61, 0x23, 0x7a, 0xaf, 0x66,
+  0xac, 0x89, 0xc4, 0x88, 0xe1, 0x35, 0x19, 0x19, 0xcf, 0x94, 0x6c, 0x7c, 0x2e, 0xa4, 0x81, 0x6c, 0xce, 0x24, 0x61, 0x72,
+  0x64, 0x6c, 0xa8, 0x23, 0xdd, 0x91, 0x43, 0x9e, 0xa9, 0x4d, 0x6a, 0x7a, 0x50, 0x45, 0x94, 0x51, 0x49, 0xb1, 0x57, 0x0b,
+  0x6c, 0xec, 0x91, 0x51, 0xcb, 0xd0, 0x60, 0x3c, 0xca, 0x9e, 0x90, 0x20, 0xde, 0xc8, 0x08, 0xe4, 0xd6, 0x23, 0x81, 0x4b,
+  0x08, 0xc0, 0x71, 0x05, 0x59, 0x8e, 0x8c, 0x06, 0xf6, 0xfd, 0xba, 0x1d, 0x04, 0x3f, 0x3d, 0x8f, 0xc8, 0xb2, 0xdd, 0x6b,
+  0xbd, 0x7b, 0xf7, 0x6e, 0x49, 0xfa, 0x3d, 0xbb, 0x6b, 0x63, 0x58, 0x3c, 0x6c, 0x44, 0xd4, 0x0e, 0x17, 0xdc, 0xd9, 0x2a,
+  0x58, 0x0a, 0x9c, 0x43, 0x9f, 0x11, 0x75, 0x46, 0x06, 0xa0, 0xa0, 0x8b, 0x1a, 0x7f, 0x26, 0xc2, 0xc3, 0x5b, 0x8d, 0x49,
+  0xfd, 0x86, 0x6e, 0x3b, 0xf3, 0x55, 0x92, 0x17, 0x69, 0x8c, 0x27, 0xea, 0x59, 0x60, 0x49, 0xd9, 0xaa, 0x5e, 0xaf, 0x03,
+  0xd0, 0x76, 0x3a, 0x3b, 0x0f, 0x6c, 0x81, 0x45, 0x6d, 0x23, 0xb0, 0x6f, 0x8c, 0xbf, 0xfe, 0x00, 0xef, 0x1a, 0xf0, 0x32,
+  0xfe, 0x9b, 0xac, 0xf7, 0xc7, 0x97, 0x1c, 0x31, 0x2e, 0x91, 0x0c, 0x05, 0x43, 0x7c, 0xb9, 0x44, 0x3e, 0xdf, 0x10, 0x01,
+  0x48, 0xfc, 0x74, 0xce, 0x22, 0x94, 0x92, 0x33, 0x64, 0x7b, 0x38, 0x08, 0x46, 0xc6, 0x42, 0xb2, 0x9a, 0x83, 0xd9, 0x8a,
+  0x08, 0x03, 0x69, 0x79, 0xc4, 0x92, 0x1c, 0xb4, 0x9b, 0x4d, 0xff, 0xe5, 0xdc, 0x40, 0x9c, 0xd9, 0x1e, 0xb5, 0x9f, 0x46,
+  0xc6, 0x92, 0x48, 0xdb, 0xad, 0x9c, 0x34, 0xec, 0x98, 0x7c, 0xf2, 0x87, 0x8d, 0x99, 0x4d, 0xbc, 0x93, 0x2a, 0xfa, 0x37,
+  0x02, 0xdd, 0xb8, 0xdc, 0x19, 0xa0, 0x93, 0x87, 0x7b, 0x6b, 0x7e, 0x82, 0xfe, 0x73, 0xaa, 0xd8, 0x54, 0x5f, 0x87, 0x8d,
+  0x08, 0x9f, 0x16, 0x7d, 0x44, 0x6b, 0x22, 0xb5, 0x98, 0x02, 0x1b, 0x0b, 0x27, 0x96, 0xd7, 0xd0, 0x6d, 0x15, 0x58, 0x00,
+  0xbc, 0xd4, 0x5f, 0x7f, 0x48, 0x45, 0x14, 0xaf, 0x0c, 0x24, 0x96, 0xb5, 0x05, 0x7f, 0x31, 0x72, 0xf2, 0xcb, 0x7c, 0x4c,
+  0x3f, 0x44, 0xc0, 0x3b, 0xe3, 0x4f, 0x37, 0x57, 0x37, 0x00, 0xb0, 0x93, 0x7b, 0x9f, 0xc8, 0x76, 0x43, 0x97, 0xd4, 0x82,
+  0x55, 0x81, 0x91, 0xc2, 0x20, 0x2c, 0xe0, 0x22, 0x56, 0x5b, 0xad, 0x96, 0x97, 0x75, 0x6e, 0xf0, 0x3d, 0xc4, 0xf3, 0x9b,
+  0xd9, 0xb4, 0x14, 0xb1, 0x43, 0x03, 0x7f, 0x4e, 0xd7, 0x24, 0xc5, 0x2b, 0x61, 0x50, 0x53, 0x6f, 0xb5, 0x29, 0xd5, 0x6a,
+  0x83, 0xa3, 0x70, 0x5f, 0x9a, 0xf3, 0x6f, 0xe3, 0xbe, 0x04, 0x65, 0x16, 0xe3, 0x4e, 0x4c, 0x62, 0x09, 0x5e, 0x56, 0x0b,
+  0xe8, 0x17, 0x32, 0x68, 0xb7, 0xfd, 0x97, 0x23, 0x65, 0x61, 0x4d, 0xef, 0xac, 0xfb, 0x47, 0xab, 0x94, 0xa4, 0x48, 0xea,
+  0xdf, 0xd0, 0xc4, 0x2d, 0xc7, 0x4e, 0xe2, 0x3c, 0x6f, 0xa6, 0x62, 0x62, 0xde, 0xde, 0x5c, 0x3c, 0x9a, 0xf3, 0x9b, 0xfb,
+  0xbb, 0x52, 0x4a, 0xb4, 0xa9, 0x1f, 0x45, 0xc8, 0xab, 0xc9, 0xef, 0x18, 0x3d, 0x08, 0x54, 0x70, 0xaf, 0xb6, 0x12, 0x3c,
+  0xf4, 0x33, 0xd1, 0xa2, 0x33, 0x9e, 0x61, 0x16, 0x62, 0x0f, 0x4d, 0xa2, 0x09, 0x59, 0xd2, 0xb2, 0xeb, 0x05, 0xdf, 0x64,
+  0x38, 0x1a, 0x52, 0xe6, 0x87, 0xe0, 0xf4, 0x5b, 0x1f, 0x74, 0xc5, 0xc2, 0xf5, 0x42, 0x79, 0xb3, 0x62, 0x60, 0xad, 0x81,
+  0x5d, 0x1b, 0x08, 0xb4, 0x69, 0x13, 0x97, 0x7b, 0x0e, 0x11, 0x23, 0xe3, 0x1a, 0x5e, 0xac, 0x29, 0x1b, 0x19, 0x4d, 0xf8,
+  0x8f, 0x5f, 0x46, 0x46, 0xbb, 0xb3, 0x3f, 0xb0, 0xd9, 0x0e, 0xb0, 0xd9, 0x6c, 0x07, 0x58, 0xef, 0xbd, 0x51, 0xac, 0x91,
+  0x38, 0xf0, 0xa4, 0x01, 0x25, 0x20, 0x32, 0x62, 0xb6, 0x02, 0xd1, 0x62, 0x06, 0x91, 0x13, 0x49, 0x8e, 0x94, 0x1f, 0x64,
+  0x63, 0x46, 0xe1, 0x4a, 0x41, 0x82, 0x70, 0x4d, 0xcc, 0x50, 0x72, 0x58, 0x9a, 0x8d, 0x64, 0x2b, 0x41, 0x08, 0x33, 0xc6,
+  0x8f, 0xfa, 0x3b, 0x52, 0x13, 0x92, 0x20, 0x92, 0x85, 0x78, 0xb8, 0x52, 0x40, 0x1b, 0x4b, 0xba, 0x0a, 0x55, 0xd0, 0xe6,
+  0x2c, 0xa7, 0x93, 0x25, 0x17, 0x6b, 0x84, 0x6d, 0xf5, 0x1e, 0xb6, 0x8f, 0x00, 0x3f, 0x83, 0x27, 0x45, 0xc1, 0x70, 0x64,
+  0xa8, 0x58, 0x98, 0x15, 0xac, 0x87, 0x17, 0xc4, 0x1b, 0x6b, 0x82, 0xd0, 0x8c, 0x3b, 0xc0, 0x67, 0xf4, 0xe6, 0x75, 0x46,
+  0x40, 0x3c, 0x62, 0x4b, 0x2d, 0x6d, 0x1a, 0xb4, 0xda, 0xae, 0x11, 0xef, 0x77, 0xd1, 0x60, 0x3c, 0xe4, 0xbe, 0x42, 0x84,
+  0x9e, 0xb1, 0x17, 0x12, 0x25, 0xf1, 0x71, 0xbb, 0x8b, 0xae, 0x79, 0x28, 0x86, 0x8d, 0xe8, 0xcb, 0xee, 0x0c, 0xd8, 0xf2,
+  0x5a, 0xed, 0x9d, 0x19, 0x8d, 0x08, 0x49, 0xcc, 0x7f, 0x86, 0xb0, 0x47, 0xb2, 0x52, 0x4b, 0x1b, 0x5a, 0x07, 0x5f, 0x38,
+  0xfb, 0x36, 0x7d, 0xf2, 0x4b, 0x42, 0x1c, 0x3c, 0x65, 0xbd, 0x07, 0xa6, 0xe5, 0x89, 0xf8, 0x38, 0x9f, 0x00, 0xa5, 0x1f,
+  0x19, 0x85, 0xbd, 0x31, 0x00, 0xd3, 0x56, 0xe0, 0x51, 0x05, 0xde, 0x36, 0x7e, 0x9e, 0xcd, 0x4f, 0x53, 0xc2, 0xbe, 0x02,
+  0xa1, 0xd5, 0x80, 0x34, 0x09, 0x23, 0xe3, 0x0e, 0x76, 0x7b, 0x17, 0x99, 0x6b, 0x22, 0xa8, 0xde, 0x8b, 0xd1, 0xce, 0x6f,
+  0x07, 0xe7, 0xd4, 0x9a, 0xf7, 0xa6, 0x97, 0xf3, 0xea, 0xac, 0x53, 0x6f, 0xd7, 0x9b, 0xd5, 0x59, 0xab, 0x55, 0x6f, 0xd5,
+  0x81, 0x8a, 0x29, 0x0e, 0x24, 0x81, 0xad, 0x31, 0xa2, 0xe1, 0x8e, 0x6c, 0xd0, 0x6f, 0x5c, 0x3c, 0x55, 0xd1, 0x9c, 0x0b,
+  0x50, 0x3e, 0x2f, 0xa1, 0xa6, 0x00, 0xc1, 0xc4, 0x9a, 0xf7, 0x27, 0x05, 0x08, 0x26, 0x90, 0x8c, 0x88, 0x94, 0xc9, 0x89,
+  0x0b, 0xd4, 0xae, 0x78, 0x15, 0xcd, 0xc8, 0x0b, 0xb5, 0xc1, 0x18, 0xa9, 0xdc, 0xee, 0x8f, 0x63, 0x66, 0xcd, 0xdf, 0xcd,
+  0x0a, 0x70, 0xcc, 0x78, 0xc8, 0x24, 0xa6, 0x09, 0x17, 0x97, 0x84, 0x81, 0x64, 0x0f, 0x03, 0x9b, 0x01, 0x52, 0x43, 0x77,
+  0x1c, 0x5d, 0x5a, 0x73, 0x54, 0x31, 0x05, 0x05, 0xb5, 0xe3, 0xfd, 0x21, 0x3d, 0x58, 0xf3, 0xb3, 0x87, 0x02, 0x02, 0x1f,
+  0xb0, 0x0d, 0x7b, 0xa9, 0x1d, 0xd3, 0x77, 0x6b, 0x56, 0xd1, 0xaf, 0x90, 0x0c, 0xf0, 0xf0, 0x20, 0x32, 0xcd, 0x0f, 0xd6,
+  0xfc, 0xbd, 0xf9, 0xa1, 0x00, 0xbc, 0x09, 0xee, 0xfa, 0x84, 0x81, 0x5e, 0x66, 0xbb, 0x5c, 0xe0, 0x15, 0xd9, 0x1f, 0xe8,
+  0xb5, 0x35, 0x6f, 0x01, 0x84, 0x6b, 0xbc, 0xc1, 0x94, 0xa2, 0xca, 0x35, 0x67, 0xdc, 0x0b, 0xbd, 0xb0, 0xcc, 0x0a, 0x1b,
+  0x89, 0x19, 0x7e, 0xc7, 0x3a, 0x2d, 0x1e, 0x1e, 0x62, 0x9d, 0xc3, 0x5a, 0xb3, 0x33, 0x86, 0x98, 0x7b, 0x21, 0xf0, 0x17,
+  0xea, 0x81, 0xc7, 0x99, 0x62, 0x05, 0x76, 0x43, 0x19, 0x30, 0x65, 0x61, 0x8e, 0x1e, 0x70, 0xe8, 0x81, 0xd1, 0x5c, 0x84,
+  0x84, 0xf1, 0x00, 0x99, 0x14, 0xe2, 0xdd, 0xfe, 0x2c, 0x02, 0xf0, 0xee, 0xb8, 0xab, 0x51, 0x54, 0x67, 0xef, 0x41, 0x62,
+  0xfd, 0x46, 0xbb, 0x5b, 0x9d, 0x75, 0xe3, 0x27, 0x30, 0x51, 0x97, 0x7a, 0x44, 0x21, 0x02, 0x8c, 0x60, 0x9c, 0x07, 0x41,
+  0xee, 0x8d, 0x7b, 0x00, 0x80, 0x7b, 0x7c, 0xbd, 0xa0, 0x18, 0x08, 0x7f, 0x20, 0x22, 0x44, 0x95, 0x0b, 0xbe, 0xe2, 0x12,
+  0x57, 0xd1, 0x2d, 0x5d, 0xe3, 0x63, 0x45, 0x39, 0x0d, 0x05, 0xf7, 0xc9, 0xf7, 0x65, 0x08, 0xb1, 0xa3, 0x79, 0x61, 0x69,
+  0xe3, 0xe8, 0xd5, 0x9b, 0x8d, 0x16, 0x98, 0x47, 0x53, 0x3d, 0x41, 0xa4, 0xf9, 0x00, 0x84, 0xdd, 0x40, 0x86, 0x8f, 0x99,
+  0x03, 0xd6, 0xc7, 0x99, 0xc3, 0x59, 0x15, 0x5d, 0x86, 0x0b, 0xc8, 0xfc, 0x0f, 0x70, 0xf0, 0xe9, 0xbc, 0xd6, 0x9a, 0x4c,
+  0x53, 0x0c, 0x09, 0xfc, 0x46, 0xe7, 0xd5, 0xc9, 0x23, 0x5a, 0x51, 0xe5, 0x01, 0x0b, 0x1a, 0x80, 0xbe, 0x20, 0xf7, 0xa7,
+  0x80, 0xea, 0x91, 0xaf, 0x0f, 0x30, 0xc9, 0x29, 0x20, 0x6a, 0x4f, 0x5f, 0x11, 0x35, 0x3a, 0x29, 0xaa, 0xee, 0x6b, 0xc0,
+  0x4a, 0x50, 0x99, 0xd2, 0x85, 0x0c, 0xa4, 0x8a, 0xae, 0x89, 0x17, 0x40, 0x21, 0x43, 0x0f, 0x71, 0xfb, 0x0f, 0xb5, 0x8e,
+  0xf2, 0xfb, 0xc0, 0xe6, 0x1b, 0x88, 0x7d, 0xda, 0xe9, 0x8f, 0xd5, 0x96, 0xb9, 0x54, 0x16, 0x8f, 0xfe, 0x85, 0x66, 0xd4,
+  0x71, 0xc0, 0xaa, 0x14, 0xb9, 0xdf, 0xd7, 0xdd, 0x27, 0x13, 0x64, 0x6b, 0x8c, 0x3f, 0x91, 0x40, 0xa2, 0x18, 0x42, 0xe5,
+  0x16, 0x4c, 0x11, 0xf8, 0x32, 0xbd, 0x15, 0x85, 0x6d, 0x62, 0x7f, 0xb6, 0x2c, 0xd3, 0x02, 0xf9, 0x19, 0xe3, 0xd8, 0x05,
+  0x63, 0x68, 0xbf, 0x70, 0x17, 0x33, 0x46, 0x82, 0x45, 0x28, 0x56, 0x6f, 0x52, 0x45, 0x17, 0x14, 0xd0, 0x6b, 0x24, 0x5a,
+  0xef, 0x6a, 0xc7, 0x99, 0xae, 0xb6, 0xbe, 0x84, 0xa0, 0x8e, 0xa9, 0x38, 0xcc, 0x6b, 0xb4, 0xb3, 0x5b, 0x38, 0x74, 0x28,
+  0x78, 0x3a, 0x56, 0x9e, 0x53, 0x79, 0xa4, 0x5b, 0xec, 0xb8, 0x87, 0x7a, 0x35, 0x18, 0xb7, 0x39, 0x85, 0x88, 0x1f, 0x2e,
+  0x30, 0x3d, 0x5a, 0x75, 0x01, 0xdd, 0x23, 0x54, 0xdd, 0x80, 0x74, 0x7b, 0x83, 0x0e, 0xb8, 0xd5, 0x0d, 0x73, 0x14, 0xe1,
+  0x6a, 0xcf, 0xbc, 0x24, 0x9e, 0x4b, 0x61, 0x53, 0x83, 0xe4, 0x10, 0xd3, 0x83, 0x78, 0x78, 0x37, 0x86, 0xad, 0x67, 0xee,
+  0x62, 0xaa, 0x9d, 0xb3, 0x81, 0x7e, 0xa5, 0x44, 0x42, 0x16, 0x01, 0x21, 0x04, 0x6a, 0xd0, 0x27, 0x0e, 0x3b, 0xf1, 0x35,
+  0x66, 0xfc, 0x30, 0x98, 0x67, 0xe3, 0x33, 0x1d, 0xd4, 0x98, 0x0a, 0x48, 0x16, 0xe4, 0xe3, 0xd8, 0xe7, 0x02, 0x5c, 0xe5,
+  0x82, 0xd0, 0x3f, 0x61, 0x04, 0x20, 0x3f, 0x54, 0x55, 0xa0, 0x92, 0x07, 0x88, 0xfb, 0x17, 0x60, 0x1b, 0xf2, 0xd8, 0x5f,
+  0xb0, 0x8f, 0x55, 0x46, 0xf4, 0x01, 0x00, 0x02, 0xef, 0x73, 0xfe, 0xb4, 0x85, 0xb8, 0x6c, 0x11, 0x1e, 0x7a, 0xc7, 0x8a,
+  0xff, 0xde, 0x26, 0x98, 0xed, 0xa3, 0x01, 0x73, 0xa2, 0x68, 0x01, 0x15, 0x98, 0x3a, 0xdf, 0x00, 0x7b, 0x6c, 0xa9, 0x68,
+  0xa4, 0xe2, 0xb9, 0x0e, 0x46, 0xa6, 0x03, 0x91, 0x8e, 0x3a, 0x2a, 0xa2, 0x47, 0x2e, 0x10, 0x06, 0x2a, 0x38, 0xd1, 0x03,
+  0xf6, 0x71, 0x13, 0x4c, 0xbe, 0xa6, 0xf6, 0xc5, 0x0b, 0x88, 0x63, 0x0b, 0xcc, 0xc8, 0x77, 0xc2, 0x43, 0x39, 0x08, 0x73,
+  0x5a, 0x48, 0xa3, 0xb5, 0x75, 0x18, 0xd9, 0x82, 0x20, 0x67, 0xc4, 0x5b, 0x40, 0x36, 0xaa, 0x72, 0xcb, 0x3d, 0x01, 0xdf,
+  0xfd, 0xae, 0x00, 0xb7, 0xef, 0x7e, 0x57, 0x80, 0xdf, 0x47, 0x91, 0x38, 0x85, 0xab, 0x8c, 0xf1, 0x77, 0x82, 0xa3, 0x48,
+  0x6f, 0x86, 0xf6, 0x93, 0x7a, 0x3a, 0x40, 0x33, 0xaf, 0xc9, 0x70, 0xf2, 0x66, 0x37, 0x29, 0x9e, 0x41, 0x8a, 0x24, 0x09,
+  0x53, 0xbd, 0x8c, 0xaf, 0xd3, 0xe1, 0xd2, 0x82, 0x2c, 0x4a, 0x96, 0x95, 0xed, 0x24, 0x65, 0x63, 0xb8, 0xa8, 0xe9, 0xd5,
+  0x45, 0x5d, 0x16, 0xd0, 0x21, 0x54, 0x2a, 0xb5, 0x6b, 0xd8, 0x36, 0xd0, 0x14, 0x72, 0xa4, 0xad, 0x4a, 0x4c, 0x42, 0x08,
+  0x82, 0x03, 0xa0, 0x0f, 0x80, 0xec, 0xc0, 0x2d, 0xab, 0xcf, 0x5c, 0x58, 0x7f, 0xc3, 0x64, 0x92, 0x96, 0xa7, 0xc3, 0x5c,
+  0x75, 0xd6, 0xea, 0x9f, 0xed, 0x14, 0x70, 0x4d, 0x55, 0x76, 0x5d, 0xd2, 0x00, 0x2f, 0xbc, 0xec, 0xb6, 0x9b, 0x2d, 0x92,
+  0xb2, 0xf2, 0xe0, 0x92, 0x0b, 0xf0, 0x00, 0xa9, 0xda, 0x57, 0xc1, 0x5f, 0x23, 0x92, 0xf1, 0x83, 0x6a, 0x52, 0x21, 0x0b,
+  0x8a, 0x27, 0x81, 0x2a, 0xf7, 0xcb, 0x25, 0x6a, 0x07, 0x08, 0x2f, 0x61, 0xdf, 0x43, 0x6b, 0x28, 0x0b, 0xf7, 0x10, 0x83,
+  0xed, 0x12, 0xfb, 0x49, 0x75, 0x82, 0xb4, 0x20, 0xfc, 0x8d, 0x00, 0x58, 0x89, 0x1c, 0x92, 0xd1, 0x6b, 0x49, 0xb4, 0xcb,
+  0xe3, 0x7e, 0xc4, 0x97, 0x52, 0x3f, 0xc3, 0x2f, 0xc8, 0xf2, 0x09, 0x71, 0x0a, 0xe9, 0xcc, 0x13, 0x2a, 0x54, 0xab, 0x2d,
+  0xa2, 0x32, 0xf0, 0x9d, 0x84, 0x44, 0xfd, 0xa8, 0xd5, 0xd4, 0x6a, 0xa6, 0x8a, 0xea, 0xa9, 0x47, 0xce, 0xf4, 0xea, 0x91,
+  0xe1, 0x70, 0x1b, 0x4a, 0x5a, 0x26, 0xeb, 0x2b, 0x22, 0xa7, 0x1e, 0x51, 0x8f, 0x17, 0xdb, 0x1b, 0xa7, 0x72, 0x02, 0x6b,
+  0x7f, 0xc5, 0xde, 0xc9, 0x69, 0x9d, 0xc2, 0x7e, 0x27, 0xe6, 0xe4, 0x45, 0x8e, 0xa4, 0x4b, 0x83, 0xba, 0x66, 0xb7, 0x98,
+  0x85, 0x18, 0x3b, 0x2c, 0xdb, 0xb1, 0xc6, 0xae, 0x6a, 0xf9, 0x21, 0xd5, 0xdb, 0xa8, 0x41, 0x00, 0x59, 0xb1, 0x81, 0xa0,
+  0x2b, 0x57, 0x9e, 0x43, 0x11, 0xd9, 0x6c, 0x36, 0x77, 0x99, 0x2b, 0x31, 0x10, 0x4b, 0x37, 0x48, 0xd0, 0x3c, 0x04, 0xca,
+  0x57, 0x07, 0xda, 0x47, 0xa9, 0x88, 0x15, 0x50, 0x2a, 0xe9, 0x33, 0x94, 0x4f, 0x07, 0x0a, 0x19, 0x16, 0xa6, 0x52, 0xd6,
+  0xcf, 0x91, 0x98, 0x13, 0x21, 0xef, 0x29, 0x63, 0x58, 0xf9, 0x26, 0x21, 0x47, 0xeb, 0xf6, 0x95, 0x72, 0xaf, 0x4c, 0xc6,
+  0xfb, 0x4a, 0x2f, 0xee, 0x93, 0x44, 0x52, 0x88, 0x06, 0xb9, 0xf6, 0x08, 0x8f, 0x25, 0xf3, 0xda, 0x48, 0x09, 0x59, 0xda,
+  0x8d, 0xe6, 0x2c, 0x62, 0x94, 0x8b, 0xe0, 0xe4, 0xf4, 0xb5, 0x4b, 0x4d, 0x50, 0xa4, 0xd1, 0x40, 0x05, 0x25, 0x9d, 0xd7,
+  0xe6, 0x9b, 0x33, 0x87, 0xe2, 0x8e, 0x45, 0xb1, 0xc0, 0xf6, 0x93, 0x0a, 0xc6, 0xcc, 0x19, 0xfc, 0xe8, 0x74, 0x7a, 0xdd,
+  0x66, 0xf3, 0xfc, 0x1b, 0x74, 0xad, 0x55, 0xd4, 0xd9, 0x21, 0x4b, 0x47, 0x22, 0xa0, 0xea, 0x2a, 0xf4, 0xbc, 0x02, 0xaa,
+  0xf2, 0xe6, 0x19, 0x1b, 0xa7, 0xe9, 0xa9, 0x64, 0x5a, 0xb7, 0xde, 0x91, 0xea, 0x7a, 0xaa, 0xb8, 0xa7, 0x1a, 0x9d, 0x5f,
+  0xd9, 0xe9, 0x91, 0x01, 0x6d, 0xca, 0x54, 0x34, 0xcd, 0xa1, 0x38, 0x34, 0x88, 0x39, 0xb0, 0x76, 0xca, 0x12, 0xdb, 0x4d,
+  0x46, 0xe5, 0x41, 0xec, 0x48, 0x17, 0xcb, 0x9b, 0x68, 0xbf, 0xf9, 0x4f, 0x63, 0x1c, 0x13, 0x8e, 0x14, 0x6e, 0x44, 0xa2,
+  0x7d, 0x69, 0x46, 0x59, 0x28, 0x49, 0xc9, 0xce, 0x54, 0xbe, 0x35, 0x29, 0x10, 0x99, 0xad, 0x29, 0x1d, 0xe6, 0x9c, 0xb1,
+  0xdf, 0xfc, 0x5b, 0xb9, 0x8a, 0xbb, 0x79, 0x90, 0x36, 0x11, 0x1b, 0x6a, 0xc4, 0x37, 0xf1, 0x74, 0x19, 0x8a, 0x2c, 0x4f,
+  0x7a, 0xa8, 0x79, 0x6a, 0xef, 0xc5, 0x53, 0x64, 0x74, 0x77, 0xca, 0xfd, 0x8b, 0x1b, 0x82, 0x7f, 0x8d, 0x19, 0xbe, 0x22,
+  0x38, 0xd4, 0x08, 0x99, 0x5a, 0xf9, 0x6a, 0x85, 0xe9, 0xf0, 0x68, 0x33, 0xdc, 0x5f, 0x5f, 0x73, 0x75, 0x92, 0x75, 0x7f,
+  0x75, 0x85, 0xb0, 0xd4, 0x8d, 0x4c, 0x54, 0x69, 0xd6, 0xda, 0x9d, 0x03, 0x53, 0x23, 0x66, 0x49, 0x2c, 0x52, 0xf3, 0x4b,
+  0x46, 0xb9, 0x34, 0xa8, 0xdd, 0xfe, 0x66, 0x53, 0xfc, 0x7f, 0xca, 0xdd, 0xdd, 0x71, 0xcc, 0x4d, 0x59, 0x9a, 0x49, 0x44,
+  0xcf, 0x39, 0xc6, 0xde, 0x1d, 0xc4, 0x57, 0x64, 0x80, 0xb7, 0xd3, 0xcb, 0xf2, 0x1c, 0xef, 0x48, 0xa3, 0x04, 0xc7, 0x57,
+  0x31, 0xd8, 0x43, 0xea, 0x60, 0x25, 0x0c, 0x10, 0xe0, 0x3a, 0xd4, 0x2c, 0x3d, 0xe2, 0x58, 0x7f, 0x90, 0xd4, 0x2c, 0xd3,
+  0xe1, 0x1e, 0x29, 0x5e, 0x49, 0x9e, 0xa0, 0x41, 0x2c, 0x44, 0x0e, 0xe2, 0x42, 0xec, 0x4a, 0xae, 0xd7, 0x33, 0x8e, 0xb5,
+  0x01, 0xdd, 0x3c, 0x63, 0x6f, 0x60, 0x78, 0x92, 0x67, 0x78, 0x72, 0x3c, 0xc3, 0x93, 0x3c, 0xc3, 0x93, 0x32, 0x86, 0x8b,
+  0xba, 0xff, 0x7a, 0xfe, 0xf2, 0x25, 0xb7, 0x1c, 0x86, 0x05, 0x27, 0x14, 0x16, 0xf7, 0xa8, 0xf3, 0x8d, 0xf3, 0x89, 0x0b,
+  0x75, 0x1e, 0x5f, 0xf6, 0xbd, 0xad, 0x4a, 0x52, 0x82, 0xa5, 0x4b, 0x0a, 0xce, 0x2f, 0xfe, 0x22, 0x7b, 0x34, 0xc3, 0x17,
+  0x0a, 0xd5, 0x32, 0xec, 0x6e, 0xb7, 0x2a, 0xbc, 0xbd, 0x41, 0x35, 0x9f, 0xf3, 0xaa, 0xf9, 0x7c, 0xbc, 0x6a, 0x3e, 0xe7,
+  0x55, 0xf3, 0xf9, 0x40, 0xd5, 0x7c, 0xce, 0xab, 0xe6, 0xf3, 0xdf, 0xae, 0x9a, 0x63, 0xeb, 0xc1, 0x19, 0x52, 0xdd, 0x26,
+  0x1b, 0x43, 0x86, 0xf7, 0x06, 0x7d, 0x98, 0x79, 0x7d, 0x98, 0xc7, 0xeb, 0xc3, 0xcc, 0xeb, 0xc3, 0x3c, 0x50, 0x1f, 0x66,
+  0x5e, 0x1f, 0xe6, 0xff, 0x51, 0x1f, 0xb9, 0x34, 0x1d, 0x44, 0xbe, 0xa6, 0x52, 0xb5, 0x26, 0x9f, 0x49, 0x26, 0xde, 0xef,
+  0x9c, 0xbe, 0x36, 0xd4, 0x19, 0xe7, 0x5b, 0x4f, 0x4e, 0xad, 0x6d, 0x20, 0xc9, 0x7a, 0xcf, 0x63, 0xec, 0xf2, 0xab, 0x29,
+  0xf9, 0xb2, 0x22, 0xad, 0x13, 0xe8, 0xb2, 0x62, 0xab, 0xa3, 0x59, 0xb1, 0xae, 0x9c, 0x3c, 0x92, 0x40, 0x6d, 0xeb, 0x3f,
+  0x9d, 0x9c, 0x9e, 0x22, 0x8f, 0xdb, 0x3a, 0xb9, 0xab, 0xeb, 0x6b, 0x3d, 0x27, 0x0d, 0x11, 0x7d, 0x3b, 0xd1, 0x47, 0xc3,
+  0xea, 0xa9, 0xa0, 0x5e, 0x38, 0x16, 0x39, 0x91, 0xe8, 0x13, 0xbd, 0xa2, 0x65, 0xf8, 0x89, 0xfc, 0x43, 0x5d, 0x30, 0x89,
+  0x48, 0x88, 0xe7, 0x7e, 0x2d, 0xea, 0x5c, 0xcd, 0xa2, 0x04, 0x15, 0xa7, 0x0c, 0x6b, 0x2c, 0x56, 0x94, 0xd5, 0x24, 0xf7,
+  0x07, 0x2d, 0x7d, 0x2f, 0x67, 0x2f, 0xc2, 0x0b, 0x6a, 0x2d, 0xbb, 0xd9, 0x79, 0xdf, 0x5e, 0x9c, 0xef, 0xc7, 0xd4, 0xd4,
+  0x9a, 0xce, 0x51, 0xe6, 0xa2, 0xc4, 0x4f, 0xe8, 0x63, 0x40, 0x90, 0xaa, 0x7c, 0x11, 0x5d, 0x02, 0x42, 0x75, 0x90, 0x1d,
+  0xf8, 0x94, 0x05, 0x68, 0x43, 0x3d, 0xc7, 0xdb, 0xd6, 0xcb, 0x79, 0xb7, 0xa1, 0x7c, 0x4e, 0x58, 0xcf, 0x94, 0x76, 0x6f,
+  0x93, 0x40, 0x4f, 0x15, 0xd0, 0x0b, 0x2e, 0x20, 0xbf, 0x89, 0x5e, 0xf8, 0x2f, 0x28, 0x50, 0xce, 0x83, 0x7e, 0x74, 0x1c,
+  0xe7, 0x1c, 0xf9, 0xd8, 0x51, 0xf7, 0x32, 0x5e, 0x27, 0x97, 0x5d, 0x6f, 0x58, 0x52, 0x2f, 0x76, 0xf2, 0xe5, 0xe6, 0x4a,
+  0x3f, 0x63, 0xdb, 0x26, 0xbe, 0x1c, 0x19, 0xf5, 0x05, 0x65, 0xd5, 0x7a, 0xb0, 0x0c, 0x53, 0x29, 0xc6, 0x77, 0x62, 0x06,
+  0x8c, 0xb3, 0xa8, 0x84, 0x76, 0x95, 0x94, 0x47, 0x46, 0xe8, 0x7b, 0x1c, 0x3b, 0x57, 0x20, 0xb1, 0x0d, 0x16, 0xa4, 0xa2,
+  0xa4, 0x73, 0x5a, 0xa0, 0x9e, 0x02, 0x5d, 0x9c, 0x91, 0x6e, 0x17, 0x3b, 0xd9, 0xba, 0xb7, 0xb4, 0x03, 0x11, 0x91, 0x77,
+  0x72, 0x5a, 0xd7, 0x13, 0xd5, 0x85, 0x89, 0x8f, 0xbe, 0xae, 0xcb, 0x12, 0xbc, 0x05, 0x06, 0x9d, 0xdc, 0x62, 0xf1, 0x05,
+  0x5f, 0xed, 0xde, 0x23, 0xd3, 0xef, 0xca, 0xae, 0x91, 0xa9, 0x8b, 0x64, 0x7a, 0x56, 0xe8, 0x3b, 0x51, 0x92, 0x56, 0x70,
+  0x11, 0xa8, 0xd5, 0x56, 0x4a, 0xb0, 0x21, 0x9b, 0x11, 0x83, 0x1f, 0xfb, 0xfd, 0xfe, 0xb9, 0x02, 0xe5, 0x17, 0xde, 0xfc,
+  0x48, 0x6f, 0xa7, 0x95, 0x41, 0xc9, 0xf4, 0x42, 0x6c, 0xa2, 0xd2, 0xc3, 0x14, 0xf0, 0xd9, 0xd9, 0xd9, 0x39, 0xca, 0xa8,
+  0xbe, 0x1d, 0x19, 0xbf, 0x09, 0x5a, 0x0a, 0x02, 0xf4, 0x4c, 0xf1, 0x00, 0xb9, 0x52, 0xfa, 0x83, 0x06, 0x6c, 0x12, 0x1e,
+  0x95, 0x4b, 0x0f, 0xfb, 0x75, 0x65, 0x80, 0x5e, 0x4a, 0x4b, 0x4a, 0x49, 0xe6, 0xf6, 0x59, 0x60, 0x0b, 0xea, 0x4b, 0x14,
+  0x08, 0x3b, 0xbe, 0xf2, 0xf7, 0xa7, 0xba, 0xf1, 0xd7, 0x77, 0x96, 0xcd, 0x45, 0xbb, 0xd3, 0xef, 0x9f, 0xf5, 0x7a, 0x9d,
+  0xe5, 0x59, 0x5f, 0x31, 0x14, 0xcd, 0x54, 0x57, 0xff, 0xa2, 0x3b, 0x7f, 0x10, 0xc8, 0xf4, 0xbd, 0xc5, 0xff, 0x02, 0x4c,
+  0x34, 0x99, 0x90, 0xcf, 0x28, 0x00, 0x00,
+};
+
+const WebAsset webAssets[] = {
+  { "/app.css", "text/css", "\"ef251777fe65c4ca\"", true, web_app_css, sizeof(web_app_css) },
+  { "/app.js", "application/javascript", "\"6df0b23668553f86\"", true, web_app_js, sizeof(web_app_js) },
+  { "/", "text/html", "\"38462bf7ada614e8\"", false, web_index_html, sizeof(web_index_html) },
+};
+const int webAssetCount = sizeof(webAssets) / sizeof(webAssets[0]);
@@ -0,0 +1,58 @@
+"""Compare two benchmark result files and fail on a slowdown.
+
+    .pio/build/native/program --bench-out bench.json      # host
+    curl http://splitflap.local/bench > bench.json        # on the clock
+    python tools/bench_compare.py baseline.json bench.json --tolerance 15
+
+Both files come from BenchSuite::report() (src/BenchSuite.h). Kernels are
+compared by cycles per operation; any kernel slower than the baseline by more
+than the tolerance (percent) makes the exit status 1. Host and device numbers
+are not comparable, so the platforms have to match.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("baseline")
+    ap.add_argument("current")
+    ap.add_argument("--tolerance", type=float, default=20.0, help="allowed slowdown in percent (default 20)")
+    args = ap.parse_args()
+
+    base, cur = load(args.baseline), load(args.current)
+    if base.get("platform") != cur.get("platform"):
+        print("platform mismatch: %s vs %s" % (base.get("platform"), cur.get("platform")), file=sys.stderr)
+        return 2
+
+    failed = []
+    print("%-18s %14s %14s %9s" % ("kernel", "baseline", "current", "change"))
+    for name, now in cur["results"].items():
+        was = base["results"].get(name)
+        if was is None:
+            print("%-18s %14s %14.1f %9s" % (name, "-", now["cyclesPerOp"], "new"))
+            continue
+        change = (now["cyclesPerOp"] / was["cyclesPerOp"] - 1) * 100 if was["cyclesPerOp"] else 0
+        slower = change > args.tolerance
+        print("%-18s %14.1f %14.1f %+8.1f%%%s" % (name, was["cyclesPerOp"], now["cyclesPerOp"], change,
+                                               "  ** SLOWER **" if slower else ""))
+        if slower:
+            failed.append(name)
+    for name in base["results"]:
+        if name not in cur["results"]:
+            print("%-18s %14.1f %14s %9s" % (name, base["results"][name]["cyclesPerOp"], "-", "gone"))
+
+    if failed:
+        print("slower than %.0f%% over baseline: %s" % (args.tolerance, ", ".join(failed)), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,85 @@
+"""Gzip the dashboard in web/ into src/web_assets.h.
+
+Runs as a PlatformIO pre-build script (extra_scripts = pre:tools/build_web.py)
+and can also be run by hand: python tools/build_web.py
+
+Each asset becomes a PROGMEM byte array plus a content-hash ETag. index.html
+references app.css / app.js as "{{app.css}}" / "{{app.js}}"; those are replaced
+with the assets' hashes so the browser can cache them forever.
+"""
+import gzip
+import hashlib
+import os
+
+ASSETS = [
+    # (file in web/, URL path, content type, immutable)
+    ("app.css", "/app.css", "text/css", True),
+    ("app.js", "/app.js", "application/javascript", True),
+    ("index.html", "/", "text/html", False),  # Last: needs the other hashes
+]
+
+
+def build(project_dir):
+    web_dir = os.path.join(project_dir, "web")
+    out_path = os.path.join(project_dir, "src", "web_assets.h")
+
+    hashes = {}
+    blobs = []
+    for name, path, ctype, immutable in ASSETS:
+        with open(os.path.join(web_dir, name), "rb") as f:
+            raw = f.read()
+        for ref, digest in hashes.items():
+            raw = raw.replace(("{{%s}}" % ref).encode(), digest.encode())
+        digest = hashlib.sha256(raw).hexdigest()[:16]
+        hashes[name] = digest
+        blobs.append((name, path, ctype, immutable, digest, len(raw), gzip.compress(raw, 9, mtime=0)))
+
+    lines = [
+        "// Generated by tools/build_web.py from web/ -- do not edit.",
+        "#pragma once",
+        "#include <Arduino.h>",
+        "",
+        "struct WebAsset {",
+        "  const char *path;",
+        "  const char *contentType;",
+        "  const char *etag;",
+        "  bool immutable;       // Fingerprinted URL, cache forever",
+        "  const uint8_t *data;  // gzip",
+        "  size_t length;",
+        "};",
+        "",
+    ]
+    for name, path, ctype, immutable, digest, raw_len, gz in blobs:
+        ident = "web_" + name.replace(".", "_")
+        lines.append("// %s: %d bytes -> %d gzipped" % (name, raw_len, len(gz)))
+        lines.append("const uint8_t %s[] PROGMEM = {" % ident)
+        for i in range(0, len(gz), 20):
+            lines.append("  " + ", ".join("0x%02x" % b for b in gz[i:i + 20]) + ",")
+        lines.append("};")
+        lines.append("")
+
+    lines.append("const WebAsset webAssets[] = {")
+    for name, path, ctype, immutable, digest, raw_len, gz in blobs:
+        ident = "web_" + name.replace(".", "_")
+        lines.append('  { "%s", "%s", "\\"%s\\"", %s, %s, sizeof(%s) },'
+                     % (path, ctype, digest, "true" if immutable else "false", ident, ident))
+    lines.append("};")
+    lines.append("const int webAssetCount = sizeof(webAssets) / sizeof(webAssets[0]);")
+    lines.append("")
+
+    content = "\n".join(lines)
+    if os.path.exists(out_path):
+        with open(out_path) as f:
+            if f.read() == content:
+                return  # Unchanged, don't trigger a rebuild
+    with open(out_path, "w") as f:
+        f.write(content)
+    print("build_web: wrote %s" % out_path)
+
+
+try:
+    Import("env")  # noqa: F821 (PlatformIO/SCons)
+    build(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        build(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -0,0 +1,195 @@
+"""Decode a step/sensor trace downloaded from the clock's /trace endpoint.
+
+    python tools/decode_trace.py trace.bin -o trace.csv
+    python tools/decode_trace.py http://splitflap.local/trace -o trace.csv
+
+Writes one CSV row per event (time relative to the first event). Step rows
+also get the achieved velocity and acceleration, from the step timestamps,
+next to the commanded ones, from the intervals the step ISR was told to use.
+A per-move summary (peak velocity / acceleration against the profile limits
+in the header, worst interval error) goes to stderr.
+
+Layout: see TraceHeader / TraceEvent in src/TraceRecorder.h.
+"""
+import argparse
+import csv
+import struct
+import sys
+import urllib.request
+
+HEADER = struct.Struct("<4sHHIIIIIHHfffHH")
+EVENT = struct.Struct("<IBBHi")
+TYPES = {1: "step", 2: "hall", 3: "move", 4: "jog", 5: "halt", 6: "outputs", 7: "homing", 8: "show"}
+AXES = {0: "hours", 1: "minutes"}
+HOMING_PHASES = ["idle", "clear", "baseline", "seek", "count_blind", "count_seek", "settle", "done", "failed"]
+MOVE_KINDS = ["minute", "rollover", "other"]
+FLAG_ONCE, FLAG_ARMED = 1, 2
+
+
+def load(source):
+    if source.startswith("http://") or source.startswith("https://"):
+        with urllib.request.urlopen(source, timeout=30) as r:
+            return r.read()
+    with open(source, "rb") as f:
+        return f.read()
+
+
+def parse(data):
+    if len(data) < HEADER.size:
+        raise ValueError("too short for a trace header")
+    fields = HEADER.unpack_from(data, 0)
+    keys = ("magic", "version", "event_size", "capacity", "count", "dropped", "now_us", "epoch",
+            "steps_rev_hours", "steps_rev_minutes", "max_speed", "accel", "jerk", "hall_every", "flags")
+    header = dict(zip(keys, fields))
+    if header["magic"] != b"SFTR":
+        raise ValueError("not a trace (magic %r)" % header["magic"])
+    if header["version"] != 1 or header["event_size"] != EVENT.size:
+        raise ValueError("unsupported trace version %d" % header["version"])
+    count = min(header["count"], (len(data) - HEADER.size) // EVENT.size)
+
+    # micros() wraps every ~71 minutes; events are in order, so unwrap by delta
+    events = []
+    elapsed = 0
+    last = None
+    for i in range(count):
+        us, etype, axis, arg, value = EVENT.unpack_from(data, HEADER.size + i * EVENT.size)
+        if last is not None:
+            elapsed += (us - last) & 0xFFFFFFFF
+        last = us
+        events.append((elapsed, etype, axis, arg, value))
+    return header, events
+
+
+def interval_us(arg):
+    """Step event arg: us below 0x8000, else 64 us units (see TraceEventType)."""
+    return arg if arg < 0x8000 else (arg & 0x7FFF) << 6
+
+
+class AxisSteps:
+    """Per-axis state to turn step timestamps into velocity / acceleration.
+
+    Both are taken over `window` steps, so the 1 us resolution of the
+    timestamps does not swamp the acceleration at speed. The commanded side
+    goes through the same arithmetic, on the times the intervals add up to.
+    """
+
+    def __init__(self, window):
+        self.window = window
+        self.moves = []
+        self.reset()
+
+    def reset(self):
+        self.times = []      # Achieved step times in this move (us)
+        self.planned = []    # Commanded step times, from the first step on
+        self.next_cmd = 0    # Commanded interval from the last step to the next
+
+    def begin_move(self, t, kind, target):
+        self.reset()
+        self.moves.append({"t": t, "kind": kind, "target": target, "steps": 0, "end": t,
+                           "peak_v": 0.0, "peak_cmd_v": 0.0, "peak_a": 0.0, "peak_cmd_a": 0.0,
+                           "max_err": 0, "err_sum": 0, "err_n": 0})
+
+    def _derive(self, times):
+        n, k = self.window, len(times) - 1
+        if k < n:
+            return None, None
+        v = n * 1e6 / (times[k] - times[k - n]) if times[k] > times[k - n] else None
+        if v is None or k < 2 * n or times[k - n] <= times[k - 2 * n]:
+            return v, None
+        v_prev = n * 1e6 / (times[k - n] - times[k - 2 * n])
+        centre, centre_prev = (times[k] + times[k - n]) / 2, (times[k - n] + times[k - 2 * n]) / 2
+        return v, (v - v_prev) * 1e6 / (centre - centre_prev)
+
+    def step(self, t, arg):
+        """Returns achieved v, commanded v, achieved a, commanded a (None where unknown)."""
+        move = self.moves[-1] if self.moves else None
+        if self.times and self.next_cmd:
+            err = (t - self.times[-1]) - self.next_cmd
+            self.planned.append(self.planned[-1] + self.next_cmd)
+            if move is not None:
+                move["max_err"] = max(move["max_err"], abs(err))
+                move["err_sum"] += abs(err)
+                move["err_n"] += 1
+        else:
+            self.times, self.planned = [], [t]  # First step we know the move by
+        self.times.append(t)
+        v, a = self._derive(self.times)
+        cmd_v, cmd_a = self._derive(self.planned)
+        if move is not None:
+            move["steps"] += 1
+            move["end"] = t
+            for key, x in (("peak_v", v), ("peak_cmd_v", cmd_v), ("peak_a", a), ("peak_cmd_a", cmd_a)):
+                if x is not None:
+                    move[key] = max(move[key], abs(x))
+        self.next_cmd = interval_us(arg)
+        if arg == 0:
+            self.reset()  # Last step of the move
+        return v, cmd_v, a, cmd_a
+
+
+def fmt(x):
+    return "" if x is None else "%.1f" % x
+
+
+def describe(etype, arg, value):
+    if etype == 7:
+        return HOMING_PHASES[arg] if arg < len(HOMING_PHASES) else str(arg)
+    if etype == 8:
+        kind = MOVE_KINDS[arg] if arg < len(MOVE_KINDS) else str(arg)
+        return "%02d:%02d %s" % (value // 100, value % 100, kind)
+    if etype == 6:
+        return "on" if arg else "off"
+    return ""
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("trace", help="trace.bin, or the /trace URL to download it from")
+    ap.add_argument("-o", "--output", help="CSV file (default: stdout)")
+    ap.add_argument("--window", type=int, default=4, help="steps per velocity estimate (default 4)")
+    ap.add_argument("--no-hall", action="store_true", help="leave hall samples out of the CSV")
+    args = ap.parse_args()
+
+    header, events = parse(load(args.trace))
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(["t_ms", "event", "axis", "arg", "value", "detail",
+                     "velocity", "commanded_velocity", "accel", "commanded_accel"])
+
+    axes = {0: AxisSteps(args.window), 1: AxisSteps(args.window)}
+    for t, etype, axis, arg, value in events:
+        name = TYPES.get(etype, str(etype))
+        row = ["%.3f" % (t / 1000.0), name, AXES.get(axis, axis), arg, value, describe(etype, arg, value)]
+        state = axes.get(axis)
+        if etype == 1 and state is not None:
+            row += [fmt(x) for x in state.step(t, arg)]
+        elif etype in (3, 4) and state is not None:
+            state.begin_move(t, name, value)
+        elif etype == 5 and state is not None:
+            state.reset()
+        if etype == 2 and args.no_hall:
+            continue
+        writer.writerow(row)
+    if args.output:
+        out.close()
+
+    span = events[-1][0] / 1e6 if events else 0
+    mode = "once" if header["flags"] & FLAG_ONCE else "ring"
+    state = "armed" if header["flags"] & FLAG_ARMED else "stopped"
+    print("%d events over %.2f s (%s, %s, %d overwritten); profile %.0f steps/s, %.0f steps/s^2, %.0f steps/s^3"
+          % (len(events), span, mode, state, header["dropped"], header["max_speed"], header["accel"], header["jerk"]),
+          file=sys.stderr)
+    for axis, state in axes.items():
+        for m in state.moves:
+            if m["steps"] < 2:
+                continue
+            mean_err = m["err_sum"] / m["err_n"] if m["err_n"] else 0
+            print("%-7s %-4s t=%8.3f s  %5d steps in %7.1f ms  v %6.0f/%6.0f  a %7.0f/%7.0f (limit %.0f)  "
+                  "interval error mean %.1f max %d us"
+                  % (AXES[axis], m["kind"], m["t"] / 1e6, m["steps"], (m["end"] - m["t"]) / 1000.0,
+                     m["peak_v"], m["peak_cmd_v"], m["peak_a"], m["peak_cmd_a"], header["accel"],
+                     mean_err, m["max_err"]), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
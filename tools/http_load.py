@@ -0,0 +1,129 @@
+"""Load the clock's web server and report throughput and latency.
+
+    python tools/http_load.py splitflap.local --connections 4 --seconds 20
+    .pio/build/native/program --serve 8080 --days 1 &    # simulated clock
+    python tools/http_load.py 127.0.0.1:8080 --path /status --path /metrics
+
+Each connection sends one GET after the other over keep-alive (reconnecting
+when the server closes it), cycling through the paths. Prints requests per
+second and p50/p90/p99/max latency over all of them, plus failures (refused
+or reset connections, non-2xx answers, timeouts). Like a browser, a request
+on a kept-alive connection the server has just closed (evicted to admit
+another client) is sent again on a new one and only counted as a retry.
+Exit status 1 if any request failed.
+"""
+import argparse
+import asyncio
+import sys
+import time
+
+
+async def read_response(reader):
+    """Status code and whether the server keeps the connection open."""
+    head = await reader.readuntil(b"\r\n\r\n")
+    lines = head.decode("latin-1").split("\r\n")
+    code = int(lines[0].split(" ")[1])
+    headers = {}
+    for line in lines[1:]:
+        if ":" in line:
+            name, value = line.split(":", 1)
+            headers[name.strip().lower()] = value.strip()
+    if headers.get("transfer-encoding") == "chunked":
+        while True:
+            size = int((await reader.readuntil(b"\r\n")).split(b";")[0], 16)
+            await reader.readexactly(size + 2)
+            if not size:
+                break
+    elif "content-length" in headers:
+        await reader.readexactly(int(headers["content-length"]))
+    else:
+        await reader.read()
+        return code, False
+    return code, headers.get("connection", "").lower() != "close"
+
+
+async def client(host, port, paths, offset, deadline, timeout, latencies, failures, retries):
+    reader = writer = None
+    reused = False
+    n = offset
+    while time.monotonic() < deadline:
+        path = paths[n % len(paths)]
+        n += 1
+        started = time.monotonic()
+        while True:
+            try:
+                if writer is None:
+                    reader, writer = await asyncio.wait_for(asyncio.open_connection(host, port), timeout)
+                writer.write(("GET %s HTTP/1.1\r\nHost: %s\r\n\r\n" % (path, host)).encode())
+                code, keep = await asyncio.wait_for(read_response(reader), timeout)
+                break
+            except (OSError, asyncio.TimeoutError, asyncio.IncompleteReadError, ValueError) as e:
+                if writer is not None:
+                    writer.close()
+                writer = None
+                closed = isinstance(e, (ConnectionResetError, BrokenPipeError)) or \
+                    (isinstance(e, asyncio.IncompleteReadError) and not e.partial)
+                if reused and closed:
+                    retries.append(path)
+                    reused = False
+                    continue
+                failures.append(type(e).__name__)
+                code = None
+                break
+        if code is None:
+            reused = False
+            await asyncio.sleep(0.05)
+            continue
+        reused = keep
+        latencies.append(time.monotonic() - started)
+        if not 200 <= code < 300:
+            failures.append("HTTP %d" % code)
+        if not keep:
+            writer.close()
+            writer = None
+    if writer is not None:
+        writer.close()
+
+
+def percentile(values, p):
+    return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+
+async def run(args):
+    host, _, port = args.host.partition(":")
+    port = int(port or 80)
+    paths = args.path or ["/status"]
+    latencies, failures, retries = [], [], []
+    started = time.monotonic()
+    deadline = started + args.seconds
+    await asyncio.gather(*(client(host, port, paths, i, deadline, args.timeout, latencies, failures, retries)
+                           for i in range(args.connections)))
+    elapsed = time.monotonic() - started
+
+    latencies.sort()
+    print("%d connections, %.1f s: %d requests, %.1f req/s, %d failed, %d retried"
+          % (args.connections, elapsed, len(latencies), len(latencies) / elapsed, len(failures), len(retries)))
+    if latencies:
+        print("latency ms: p50 %.1f  p90 %.1f  p99 %.1f  max %.1f"
+              % tuple(1000 * v for v in (percentile(latencies, 50), percentile(latencies, 90),
+                                         percentile(latencies, 99), latencies[-1])))
+    if failures:
+        kinds = {}
+        for f in failures:
+            kinds[f] = kinds.get(f, 0) + 1
+        print("failures: " + ", ".join("%s x%d" % kv for kv in sorted(kinds.items())))
+    return 1 if failures else 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("host", help="host[:port] of the clock")
+    ap.add_argument("--path", action="append", help="path to request, repeatable (default /status)")
+    ap.add_argument("--connections", type=int, default=4, help="concurrent keep-alive connections (default 4)")
+    ap.add_argument("--seconds", type=float, default=10.0, help="test duration (default 10)")
+    ap.add_argument("--timeout", type=float, default=5.0, help="per request, in seconds (default 5)")
+    return asyncio.run(run(ap.parse_args()))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,248 @@
+"""Make compressed and delta firmware images for the clock's /update.
+
+    python tools/ota_pack.py compress firmware.bin -o firmware.sfu
+    python tools/ota_pack.py delta old/firmware.bin firmware.bin -o update.sfu
+    python tools/ota_pack.py apply old/firmware.bin update.sfu -o check.bin
+    python tools/ota_pack.py roundtrip old/firmware.bin firmware.bin [--sim .pio/build/native/program]
+
+Upload the .sfu file from the dashboard like a .bin. A delta only applies
+to the exact image it was made from (the clock checks the running image's
+SHA-256 first); `old/firmware.bin` is the build that is on the clock now.
+
+Layout (little endian), see OtaUpdater.h:
+    "SFU1", version u8, kind u8 (1 = image, 2 = delta), window bits u8, 0,
+    target size u32, target SHA-256, source size u32, source SHA-256,
+    then raw deflate of the image (kind 1) or of the delta records (kind 2,
+    see DeltaPatcher.h). The clock needs 1 << window bits of RAM to inflate.
+
+`roundtrip` builds a delta and a compressed image, checks that they decode
+back to the new build here, and with --sim also has the simulated clock
+install each one through /update.
+"""
+import argparse
+import hashlib
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+import zlib
+
+HEADER = struct.Struct("<4sBBBBI32sI32s")
+MAGIC = b"SFU1"
+KIND_IMAGE, KIND_DELTA = 1, 2
+MIN_MATCH = 16   # Shorter copies cost more than the literal bytes
+STRIDE = 4       # Source positions indexed; matches are extended both ways
+
+
+def varint(n):
+    out = bytearray()
+    while True:
+        b = n & 0x7F
+        n >>= 7
+        if n:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def zigzag(n):
+    return (n << 1) if n >= 0 else ((-n << 1) - 1)
+
+
+def read_varint(data, pos):
+    value, shift = 0, 0
+    while True:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return value, pos
+        shift += 7
+
+
+def match_length(a, i, b, j, limit):
+    """Equal bytes of a[i:] and b[j:], up to limit, compared in slices."""
+    n, step = 0, 256
+    while n < limit:
+        k = min(step, limit - n)
+        if a[i + n:i + n + k] == b[j + n:j + n + k]:
+            n += k
+            continue
+        if step == 1:
+            break
+        step = max(1, step // 16)
+    return n
+
+
+def make_delta(old, new):
+    """Greedy copy/literal records: try the spot the last copy left off
+    (changed bytes in otherwise equal code), else a hashed source position."""
+    index = {}
+    for p in range(0, len(old) - MIN_MATCH + 1, STRIDE):
+        index.setdefault(old[p:p + MIN_MATCH], p)
+
+    records = bytearray()
+    cursor = 0          # As DeltaPatcher counts it
+    literal_start = 0
+    i = 0
+    while i + MIN_MATCH <= len(new):
+        expect = cursor + (i - literal_start)
+        best, best_len = None, 0
+        if 0 <= expect <= len(old) - MIN_MATCH and old[expect:expect + MIN_MATCH] == new[i:i + MIN_MATCH]:
+            best, best_len = expect, match_length(old, expect, new, i, min(len(old) - expect, len(new) - i))
+        else:
+            p = index.get(new[i:i + MIN_MATCH])
+            if p is not None:
+                # Hashed positions are STRIDE aligned: the real start may be a few bytes back
+                back = 0
+                while back < STRIDE and p - back > 0 and i - back > literal_start and old[p - back - 1] == new[i - back - 1]:
+                    back += 1
+                p, i = p - back, i - back
+                best, best_len = p, match_length(old, p, new, i, min(len(old) - p, len(new) - i))
+        if best is None or best_len < MIN_MATCH:
+            i += 1
+            continue
+        literal = new[literal_start:i]
+        cursor += len(literal)
+        records += varint(len(literal)) + literal + varint(best_len) + varint(zigzag(best - cursor))
+        cursor = best + best_len
+        i += best_len
+        literal_start = i
+    if literal_start < len(new):
+        literal = new[literal_start:]
+        records += varint(len(literal)) + literal + varint(0) + varint(0)
+    return bytes(records)
+
+
+def apply_delta(old, records, target_size):
+    """Reference decoder, record for record what DeltaPatcher does."""
+    out = bytearray()
+    pos, cursor = 0, 0
+    while pos < len(records):
+        n, pos = read_varint(records, pos)
+        out += records[pos:pos + n]
+        pos += n
+        cursor += n
+        n, pos = read_varint(records, pos)
+        z, pos = read_varint(records, pos)
+        if not n:
+            continue    # Literal-only record: the cursor may be past the end
+        start = cursor + ((z >> 1) ^ -(z & 1))
+        if start < 0 or start + n > len(old):
+            raise ValueError("copy outside the source image")
+        out += old[start:start + n]
+        cursor = start + n
+    if len(out) != target_size:
+        raise ValueError("delta makes %d bytes, header says %d" % (len(out), target_size))
+    return bytes(out)
+
+
+def deflate(data, window_bits):
+    c = zlib.compressobj(9, zlib.DEFLATED, -window_bits, 9)
+    return c.compress(data) + c.flush()
+
+
+def pack(kind, window_bits, target, payload, source=b""):
+    header = HEADER.pack(MAGIC, 1, kind, window_bits, 0, len(target), hashlib.sha256(target).digest(),
+                         len(source), hashlib.sha256(source).digest() if source else bytes(32))
+    return header + deflate(payload, window_bits)
+
+
+def unpack(blob, source=None):
+    magic, version, kind, window_bits, _, size, digest, source_size, source_digest = HEADER.unpack_from(blob)
+    if magic != MAGIC or version != 1:
+        raise ValueError("not an .sfu image")
+    payload = zlib.decompress(blob[HEADER.size:], -window_bits)
+    if kind == KIND_DELTA:
+        if source is None or len(source) != source_size or hashlib.sha256(source).digest() != source_digest:
+            raise ValueError("delta was made from a different source image")
+        image = apply_delta(source, payload, size)
+    else:
+        image = payload
+    if hashlib.sha256(image).digest() != digest:
+        raise ValueError("SHA-256 of the result does not match the header")
+    return image
+
+
+def read(path):
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def write(path, data):
+    with open(path, "wb") as f:
+        f.write(data)
+
+
+def report(name, size, base):
+    print("%-9s %8d bytes (%5.1f%% of %d)" % (name, size, 100.0 * size / max(base, 1), base), file=sys.stderr)
+
+
+def sim_install(sim, old_path, upload_path, new_path):
+    """The simulated clock runs old_path, takes upload_path through /update
+    and must end up with new_path installed (see SimMain --ota)."""
+    cmd = [sim, "--days", "0.05", "--ota", "--ota-base", old_path, "--ota-file", upload_path, "--ota-expect", new_path]
+    r = subprocess.run(cmd, stdout=subprocess.PIPE, universal_newlines=True)
+    lines = [l for l in r.stdout.splitlines() if l.startswith("ota:") or l.startswith("result:")]
+    print("\n".join("  " + l for l in lines), file=sys.stderr)
+    return r.returncode == 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    sub = ap.add_subparsers(dest="cmd", required=True)
+    c = sub.add_parser("compress", help="compressed full image")
+    c.add_argument("image")
+    d = sub.add_parser("delta", help="delta against the running image")
+    d.add_argument("old")
+    d.add_argument("image")
+    for p in (c, d):
+        p.add_argument("-o", "--output", required=True)
+        p.add_argument("--window-bits", type=int, default=12, choices=range(8, 16),
+                       help="deflate window, RAM on the clock (default 12 = 4 KB)")
+    a = sub.add_parser("apply", help="decode an .sfu here, to check it")
+    a.add_argument("old", nargs="?", help="source image (deltas only)")
+    a.add_argument("sfu")
+    a.add_argument("-o", "--output", required=True)
+    r = sub.add_parser("roundtrip", help="delta and compressed image between two builds, decoded back")
+    r.add_argument("old")
+    r.add_argument("image")
+    r.add_argument("--window-bits", type=int, default=12, choices=range(8, 16))
+    r.add_argument("--sim", help="simulator binary: also install both through the firmware's /update")
+    args = ap.parse_args()
+
+    if args.cmd == "compress":
+        image = read(args.image)
+        blob = pack(KIND_IMAGE, args.window_bits, image, image)
+        write(args.output, blob)
+        report("image", len(blob), len(image))
+    elif args.cmd == "delta":
+        old, image = read(args.old), read(args.image)
+        blob = pack(KIND_DELTA, args.window_bits, image, make_delta(old, image), old)
+        write(args.output, blob)
+        report("delta", len(blob), len(image))
+    elif args.cmd == "apply":
+        write(args.output, unpack(read(args.sfu), read(args.old) if args.old else None))
+    else:
+        old, image = read(args.old), read(args.image)
+        delta = pack(KIND_DELTA, args.window_bits, image, make_delta(old, image), old)
+        compressed = pack(KIND_IMAGE, args.window_bits, image, image)
+        ok = unpack(delta, old) == image and unpack(compressed) == image
+        report("delta", len(delta), len(image))
+        report("image", len(compressed), len(image))
+        print("decode:   %s" % ("OK" if ok else "MISMATCH"), file=sys.stderr)
+        if ok and args.sim:
+            with tempfile.TemporaryDirectory() as tmp:
+                for name, blob in (("delta", delta), ("image", compressed)):
+                    path = os.path.join(tmp, name + ".sfu")
+                    write(path, blob)
+                    print("sim %s:" % name, file=sys.stderr)
+                    ok &= sim_install(args.sim, args.old, path, args.image)
+        print("roundtrip: %s" % ("PASS" if ok else "FAIL"), file=sys.stderr)
+        sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,221 @@
+function calcDiff(val) {
+    let diff = ((val - 2048) / 2048) * 100;
+    if(diff === 0) return '<span style="color:#27ae60; font-weight:bold;">0.00% (Default)</span>';
+    let color = (diff > 0.5 || diff < -0.5) ? '#e74c3c' : '#27ae60';
+    return '<span style="color:'+color+'; font-weight:bold;">' + (diff>0?'+':'') + diff.toFixed(2) + '%</span>';
+}
+
+// Live state pushed by /events: one "full" snapshot on connect, then
+// messages carrying only the fields that changed
+let live = {};
+
+function renderStatus(d) {
+    // UPDATE WIFI
+    if ('rssi' in d || 'ssid' in d) {
+      let sig = live.rssi;
+      let quality = (sig >= -50) ? "Excellent" : (sig >= -60) ? "Good" : (sig >= -70) ? "Fair" : "Weak";
+      let color = (sig >= -60) ? "#27ae60" : (sig >= -70) ? "#f39c12" : "#e74c3c";
+      document.getElementById('wifiStats').innerHTML = '<strong>' + live.ssid + '</strong><br><span style="color:' + color + ';">' + quality + ' (' + sig + 'dBm)</span>';
+    }
+
+    // UPDATE TIME
+    if ('h' in d || 'm' in d) {
+      document.getElementById('dispTime').innerText = (live.h<10?'0':'')+live.h + ':' + (live.m<10?'0':'')+live.m;
+    }
+
+    // UPDATE DATE
+    if ('date' in d) document.getElementById('dispDate').innerText = live.date;
+
+    // UPDATE SENSORS
+    if ('sensH' in d || 'sensM' in d || 'baseH' in d || 'baseM' in d) {
+      let sensHtml = 'H: ' + (live.sensH ? '<span class="active">MAG</span>' : '<span class="inactive">---</span>') + ' (' + live.baseH + ')<br>' +
+                     'M: ' + (live.sensM ? '<span class="active">MAG</span>' : '<span class="inactive">---</span>') + ' (' + live.baseM + ')';
+      document.getElementById('sensorStats').innerHTML = sensHtml;
+    }
+
+    // UPDATE CALIBRATION
+    if ('stepH' in d || 'stepM' in d) {
+      let calHtml = 'H: ' + calcDiff(live.stepH) + '<br>M: ' + calcDiff(live.stepM);
+      document.getElementById('calibStats').innerHTML = calHtml;
+    }
+    if ('calStatus' in d) document.getElementById('calib-text').innerText = live.calStatus;
+    if ('calProg' in d) document.getElementById('calib-bar').style.width = live.calProg + "%";
+    if ('cal' in d) {
+      let overlay = document.getElementById('calib-overlay');
+      if (live.cal) overlay.style.display = 'flex';
+      else if (overlay.style.display === 'flex') setTimeout(() => { overlay.style.display = 'none'; }, 1000);
+    }
+}
+
+function loadConfig(data) {
+    document.getElementById('is12h').value = data.conf_12h ? "1" : "0";
+    document.getElementById('tz').value = data.conf_tz; 
+    document.getElementById('homeInt').value = data.conf_homeInt;
+    
+    document.getElementById('dateEn').checked = data.conf_dEn;
+    document.getElementById('dateInt').value = data.conf_dInt;
+    document.getElementById('dateDur').value = data.conf_dDur;
+
+    document.getElementById('pwrSav').checked = data.conf_pwrSav;
+    document.getElementById('spd').value = data.conf_spd;
+    document.getElementById('spdVal').innerText = data.conf_spd;
+    document.getElementById('sens').value = data.conf_sens;
+    document.getElementById('sensVal').innerText = data.conf_sens;
+    document.getElementById('nightEn').checked = data.conf_nEn;
+    document.getElementById('nStart').value = data.conf_nStart;
+    document.getElementById('nEnd').value = data.conf_nEnd;
+    
+    document.getElementById('ledS_en').checked = data.ledS_en;
+    document.getElementById('ledS_br').value = data.ledS_br;
+    document.getElementById('ledC_en').checked = data.ledC_en;
+    document.getElementById('ledC_br').value = data.ledC_br;
+    document.getElementById('ledC_fx').value = data.ledC_fx;
+    document.getElementById('ledX_en').checked = data.ledX_en;
+    document.getElementById('ledX_br').value = data.ledX_br;
+    document.getElementById('ledX_fx').value = data.ledX_fx;
+    document.getElementById('ledA_en').checked = data.ledA_en;
+    document.getElementById('ledA_br').value = data.ledA_br;
+    document.getElementById('ledA_fx').value = data.ledA_fx;
+    document.getElementById('tz').dataset.loaded = true;
+}
+
+function connectEvents() {
+  let es = new EventSource('/events');
+  es.addEventListener('full', e => {
+    live = JSON.parse(e.data);
+    renderStatus(live);
+    if(!document.getElementById('tz').dataset.loaded) loadConfig(live);
+  });
+  es.onmessage = e => {
+    let d = JSON.parse(e.data);
+    Object.assign(live, d);
+    renderStatus(d);
+  };
+  // EventSource reconnects on its own and gets a fresh "full" snapshot
+}
+
+function runCalibration(type) {
+    let msg = (type === 'motors') ? 
+        "Full Calibration: Will recalibrate sensors AND count motor steps. Continue?" :
+        "Sensor Calibration: Will recalibrate baseline and home to 00:00. Continue?";
+        
+    if(!confirm(msg)) return;
+    
+    document.getElementById('calib-overlay').style.display = 'flex';
+    fetch('/calibrate_' + type, { method: 'POST' });
+    // Progress arrives over /events
+}
+
+// SHA-256 of the image, sent with it: the clock only boots an image that
+// arrived intact. crypto.subtle needs https, so plain http uses sha256() below.
+function sha256(buf) {
+    const K = [0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
+        0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+        0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
+        0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+        0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,
+        0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+        0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,
+        0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2];
+    let n = buf.byteLength, padded = new Uint8Array(((n + 9 + 63) >> 6) << 6);
+    padded.set(new Uint8Array(buf));
+    padded[n] = 0x80;
+    let view = new DataView(padded.buffer);
+    view.setUint32(padded.length - 8, Math.floor(n / 0x20000000));
+    view.setUint32(padded.length - 4, (n * 8) >>> 0);
+    let h = [0x6a09e667,0xbb67ae85,0x3c6ef372,0xa54ff53a,0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19];
+    let w = new Uint32Array(64), ror = (x, k) => (x >>> k) | (x << (32 - k));
+    for (let off = 0; off < padded.length; off += 64) {
+        for (let i = 0; i < 16; i++) w[i] = view.getUint32(off + 4 * i);
+        for (let i = 16; i < 64; i++) {
+            let s0 = ror(w[i-15], 7) ^ ror(w[i-15], 18) ^ (w[i-15] >>> 3);
+            let s1 = ror(w[i-2], 17) ^ ror(w[i-2], 19) ^ (w[i-2] >>> 10);
+            w[i] = w[i-16] + s0 + w[i-7] + s1;
+        }
+        let [a, b, c, d, e, f, g, hh] = h;
+        for (let i = 0; i < 64; i++) {
+            let t1 = (hh + (ror(e, 6) ^ ror(e, 11) ^ ror(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i]) | 0;
+            let t2 = ((ror(a, 2) ^ ror(a, 13) ^ ror(a, 22)) + ((a & b) ^ (a & c) ^ (b & c))) | 0;
+            hh = g; g = f; f = e; e = (d + t1) | 0; d = c; c = b; b = a; a = (t1 + t2) | 0;
+        }
+        h = [h[0]+a, h[1]+b, h[2]+c, h[3]+d, h[4]+e, h[5]+f, h[6]+g, h[7]+hh].map(x => x | 0);
+    }
+    return h.map(x => (x >>> 0).toString(16).padStart(8, '0')).join('');
+}
+
+// .sfu files (tools/ota_pack.py) are compressed or a delta: the digest of
+// the image they make is in their header
+async function imageDigest(file) {
+    let buf = await file.arrayBuffer();
+    let head = new Uint8Array(buf, 0, Math.min(buf.byteLength, 44));
+    if (head.length == 44 && String.fromCharCode(...head.slice(0, 4)) == "SFU1") {
+        return Array.from(head.slice(12, 44), x => x.toString(16).padStart(2, '0')).join('');
+    }
+    if (window.crypto && crypto.subtle) {
+        let d = new Uint8Array(await crypto.subtle.digest('SHA-256', buf));
+        return Array.from(d, x => x.toString(16).padStart(2, '0')).join('');
+    }
+    return sha256(buf);
+}
+
+async function uploadFirmware(input) {
+    let file = input.files[0];
+    if(!file) return;
+    let status = document.getElementById('updStatus');
+    status.innerText = "Checking " + file.name + "...";
+    let digest = await imageDigest(file);
+    let formData = new FormData();
+    formData.append("update", file);
+    document.getElementById('prog-wrap').style.display = 'block';
+    status.innerText = "Uploading " + file.name + "...";
+    let xhr = new XMLHttpRequest();
+    xhr.open("POST", "/update?sha256=" + digest);
+    xhr.upload.addEventListener("progress", function(evt) {
+        if (evt.lengthComputable) {
+            let percentComplete = (evt.loaded / evt.total) * 100;
+            document.getElementById('prog-bar').style.width = percentComplete + '%';
+        }
+    }, false);
+    xhr.onload = function() {
+        if (xhr.status == 200 && xhr.responseText == "OK") {
+             status.innerText = "Success! Rebooting...";
+             setTimeout(() => location.reload(), 5000);
+        } else {
+             status.innerText = "Failed (" + xhr.status + "): " + xhr.responseText;
+        }
+    };
+    xhr.onerror = function() { status.innerText = "Failed: connection lost during the upload"; };
+    input.value = "";
+    xhr.send(formData);
+}
+
+function setManual() {
+  let h = document.getElementById('manualH').value;
+  let m = document.getElementById('manualM').value;
+  fetch('/manual?h=' + h + '&m=' + m, { method: 'POST' });
+}
+function resumeAuto() { fetch('/resume', { method: 'POST' }); }
+
+// LED controls take effect as they move: PATCH /api/config with only the
+// fields that changed, one request at a time (a drag sends its latest value
+// once the previous one is answered). Save Settings still posts the form.
+let ledPatch = {}, ledPatchBusy = false;
+function sendLedPatch() {
+    if (ledPatchBusy || !Object.keys(ledPatch).length) return;
+    let body = JSON.stringify(ledPatch);
+    ledPatch = {};
+    ledPatchBusy = true;
+    fetch('/api/config', { method: 'PATCH', headers: { 'Content-Type': 'application/json' }, body: body })
+        .catch(() => {})
+        .finally(() => { ledPatchBusy = false; sendLedPatch(); });
+}
+function patchLed(field, value) { ledPatch[field] = value; sendLedPatch(); }
+['S', 'C', 'X', 'A'].forEach(k => {
+    let en = document.getElementById('led' + k + '_en'), br = document.getElementById('led' + k + '_br');
+    let fx = document.getElementById('led' + k + '_fx');
+    en.addEventListener('change', () => patchLed(en.id, en.checked));
+    br.addEventListener('input', () => patchLed(br.id, parseInt(br.value)));
+    if (fx) fx.addEventListener('change', () => patchLed(fx.id, parseInt(fx.value)));
+});
+
+connectEvents();